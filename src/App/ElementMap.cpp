@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -386,6 +387,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
         stream >> std::hex;
 
         indices.names.resize(outerCount);
+        this->mappedNames.reserve(outerCount);
         for (int j = 0; j < outerCount; ++j) {
             idx.setIndex(j);
             auto* ref = &indices.names[j];
@@ -448,7 +450,10 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                     }
                 }
 
-                this->mappedNames.emplace(ref->name, idx);
+                auto hash = hashName(ref->name);
+                if (!findName(ref->name, hash).second) {
+                    this->mappedNames.insert(hash, idx);
+                }
 
                 if (!hasherRef) {
                     if (offset + 1 < (int)tokens.size()) {
@@ -515,25 +520,28 @@ MappedName ElementMap::addName(MappedName& name,
         if (overwrite) {
             erase(idx);
         }
-        auto ret = mappedNames.insert(std::make_pair(name, idx));
-        if (ret.second) {                // element just inserted did not exist yet in the map
-            ret.first->first.compact();  // FIXME see MappedName.cpp
-            mappedRef(idx).append(ret.first->first, sids);
+        auto hash = hashName(name);
+        auto found = findName(name, hash);
+        if (!found.second) {  // element did not exist yet in the map
+            name.compact();   // FIXME see MappedName.cpp
+            mappedRef(idx).append(name, sids);
+            mappedNames.insert(hash, idx);
             FC_TRACE(idx << " -> " << name);  // NOLINT
-            return ret.first->first;
+            return name;
         }
-        if (ret.first->second == idx) {
+        IndexedName foundIdx = mappedNames[found.first].indexedName();
+        if (foundIdx == idx) {
             FC_TRACE("duplicate " << idx << " -> " << name);  // NOLINT
-            return ret.first->first;
+            return found.second->name;
         }
         if (!overwrite) {
             if (existing) {
-                *existing = ret.first->second;
+                *existing = foundIdx;
             }
             return {};
         }
 
-        erase(ret.first->first);
+        erase(MappedName(found.second->name));
     };
 }
 
@@ -781,16 +789,13 @@ MappedName ElementMap::renameDuplicateElement(int index,
 
 void ElementMap::erase(const MappedName& name)
 {
-    auto it = this->mappedNames.find(name);
-    if (it == this->mappedNames.end()) {
-        return;
-    }
-    MappedNameRef* ref = findMappedRef(it->second);
-    if (!ref) {
+    auto found = findName(name, hashName(name));
+    if (!found.second) {
         return;
     }
+    MappedNameRef* ref = findMappedRef(this->mappedNames[found.first].indexedName());
+    this->mappedNames.erase(found.first);
     ref->erase(name);
-    this->mappedNames.erase(it);
 }
 
 void ElementMap::erase(const IndexedName& idx)
@@ -805,7 +810,7 @@ void ElementMap::erase(const IndexedName& idx)
     }
     auto& ref = indices.names[idx.getIndex()];
     for (auto* nameRef = &ref; nameRef; nameRef = nameRef->next.get()) {
-        this->mappedNames.erase(nameRef->name);
+        eraseName(nameRef->name, idx);
     }
     ref.clear();
 }
@@ -822,8 +827,8 @@ bool ElementMap::empty() const
 
 IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
 {
-    auto nameIter = mappedNames.find(name);
-    if (nameIter == mappedNames.end()) {
+    auto found = findName(name, hashName(name));
+    if (!found.second) {
         if (childElements.isEmpty()) {
             return IndexedName();
         }
@@ -860,20 +865,14 @@ IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
     }
 
     if (sids) {
-        const MappedNameRef* ref = findMappedRef(nameIter->second);
-        for (; ref; ref = ref->next.get()) {
-            if (ref->name == name) {
-                if (sids->empty()) {
-                    *sids = ref->sids;
-                }
-                else {
-                    *sids += ref->sids;
-                }
-                break;
-            }
+        if (sids->empty()) {
+            *sids = found.second->sids;
+        }
+        else {
+            *sids += found.second->sids;
         }
     }
-    return nameIter->second;
+    return mappedNames[found.first].indexedName();
 }
 
 MappedName ElementMap::find(const IndexedName& idx, ElementIDRefs* sids) const
@@ -974,6 +973,118 @@ std::vector<std::pair<MappedName, ElementIDRefs>> ElementMap::findAll(const Inde
     return res;
 }
 
+void ElementMap::NameIndex::reserve(std::size_t extra)
+{
+    // keep the load factor at most 3/4, so that there is always an empty slot to end a probe
+    std::size_t needed = 16;
+    while ((count + extra) * 4 > needed * 3) {
+        needed *= 2;
+    }
+    if (needed <= slots.size()) {
+        return;
+    }
+
+    std::vector<Slot> old(needed);
+    old.swap(slots);
+    std::size_t mask = slots.size() - 1;
+    for (const Slot& slot : old) {
+        if (slot.type) {
+            std::size_t pos = slot.hash & mask;
+            while (slots[pos].type) {
+                pos = (pos + 1) & mask;
+            }
+            slots[pos] = slot;
+        }
+    }
+}
+
+template<typename Match>
+std::size_t ElementMap::NameIndex::find(std::uint32_t hash, Match match) const
+{
+    if (slots.empty()) {
+        return npos;
+    }
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t pos = hash & mask; slots[pos].type; pos = (pos + 1) & mask) {
+        if (slots[pos].hash == hash && match(slots[pos])) {
+            return pos;
+        }
+    }
+    return npos;
+}
+
+void ElementMap::NameIndex::insert(std::uint32_t hash, const IndexedName& idx)
+{
+    reserve(1);
+    std::size_t mask = slots.size() - 1;
+    std::size_t pos = hash & mask;
+    while (slots[pos].type) {
+        pos = (pos + 1) & mask;
+    }
+    slots[pos].type = idx.getType();
+    slots[pos].index = idx.getIndex();
+    slots[pos].hash = hash;
+    ++count;
+}
+
+void ElementMap::NameIndex::erase(std::size_t pos)
+{
+    // Backward shift deletion: move the following slots of the probe sequence up, so that no
+    // tombstones are needed.
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t next = (pos + 1) & mask; slots[next].type; next = (next + 1) & mask) {
+        std::size_t home = slots[next].hash & mask;
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            slots[pos] = slots[next];
+            pos = next;
+        }
+    }
+    slots[pos] = Slot();
+    --count;
+}
+
+std::uint32_t ElementMap::hashName(const MappedName& name)
+{
+    // FNV-1a
+    std::uint32_t hash = 2166136261U;
+    auto add = [&hash](const QByteArray& bytes) {
+        for (char byte : bytes) {
+            hash = (hash ^ static_cast<unsigned char>(byte)) * 16777619U;
+        }
+    };
+    add(name.dataBytes());
+    add(name.postfixBytes());
+    return hash;
+}
+
+std::pair<std::size_t, const MappedNameRef*> ElementMap::findName(const MappedName& name,
+                                                                  std::uint32_t hash) const
+{
+    const MappedNameRef* found = nullptr;
+    std::size_t pos = mappedNames.find(hash, [&](const NameIndex::Slot& slot) {
+        for (auto ref = findMappedRef(slot.indexedName()); ref; ref = ref->next.get()) {
+            if (ref->name == name) {
+                found = ref;
+                return true;
+            }
+        }
+        return false;
+    });
+    return {pos, found};
+}
+
+void ElementMap::eraseName(const MappedName& name, const IndexedName& idx)
+{
+    // The same name may have been restored for more than one element, but only the first one owns
+    // the slot.
+    std::size_t pos = mappedNames.find(hashName(name), [&](const NameIndex::Slot& slot) {
+        return slot.indexedName() == idx;
+    });
+    if (pos != NameIndex::npos) {
+        mappedNames.erase(pos);
+    }
+}
+
 const MappedNameRef* ElementMap::findMappedRef(const IndexedName& idx) const
 {
     auto iter = this->indexedNames.find(idx.getType());
@@ -1076,8 +1187,12 @@ void ElementMap::collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
         }
     }
 
-    for (auto& mappedName : this->mappedNames) {
-        addPostfix(mappedName.first.constPostfix(), postfixMap, postfixes);
+    for (auto& indexedName : this->indexedNames) {
+        for (const MappedNameRef& mappedName : indexedName.second.names) {
+            for (const MappedNameRef* ref = &mappedName; ref && ref->name; ref = ref->next.get()) {
+                addPostfix(ref->name.postfixBytes(), postfixMap, postfixes);
+            }
+        }
     }
 
     childMaps.push_back(this);
@@ -1307,9 +1422,23 @@ std::vector<MappedElement> ElementMap::getAll() const
 {
     std::vector<MappedElement> ret;
     ret.reserve(size());
-    for (auto& mappedName : this->mappedNames) {
-        ret.emplace_back(mappedName.first, mappedName.second);
+    for (auto& indexedName : this->indexedNames) {
+        IndexedName idx = IndexedName::fromConst(indexedName.first, 0);
+        for (const MappedNameRef& mappedName : indexedName.second.names) {
+            for (const MappedNameRef* ref = &mappedName; ref && ref->name; ref = ref->next.get()) {
+                // skip names that are bound to another element
+                auto found = findName(ref->name, hashName(ref->name));
+                if (found.second && mappedNames[found.first].indexedName() == idx) {
+                    ret.emplace_back(ref->name, idx);
+                }
+            }
+            ++idx;
+        }
     }
+    // in the order of the names, as before the names were hashed
+    std::sort(ret.begin(), ret.end(), [](const MappedElement& a, const MappedElement& b) {
+        return a.name < b.name;
+    });
     for (auto& childElement : this->childElements) {
         auto& child = *childElement.childMap;
         IndexedName idx(child.indexedName);
@@ -31,11 +31,13 @@
 #include "MappedElement.h"
 #include "StringHasher.h"
 
+#include <cstdint>
 #include <cstring>
 #include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <vector>
 
 
 namespace Data
@@ -75,7 +77,9 @@ typedef std::function<bool(const MappedName&, int, long, long)> TraceCallback;
  * - `indexedNames` maps a string to both a name queue and children.  Each of
  * those children store an IndexedName, offset details, postfix, ids, and
  * possibly a recursive elementmap.
- * - `mappedNames` maps a MappedName to a specific IndexedName.
+ * - `mappedNames` maps a MappedName to a specific IndexedName. It is a hash
+ * table that refers to the names stored in `indexedNames` instead of holding
+ * copies of them.
  */
 class AppExport ElementMap
     : public std::enable_shared_from_this<ElementMap>  // TODO can remove shared_from_this?
@@ -399,7 +403,68 @@ private:
 
     std::map<const char*, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName, IndexedName, std::less<>> mappedNames;
+    /** Open addressing hash table of the mapped names.
+     *
+     * A slot only holds the element a name is bound to and the hash of the name. The name itself
+     * is stored once in \c indexedNames, and a slot with a matching hash is confirmed by looking
+     * for the name among the names of its element. This takes a fraction of the memory of a map
+     * keyed by the names and avoids a heap allocation per name.
+     */
+    class NameIndex
+    {
+    public:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        struct Slot
+        {
+            const char* type = nullptr;  ///< nullptr for an empty slot
+            int index = 0;
+            std::uint32_t hash = 0;
+
+            IndexedName indexedName() const
+            {
+                return IndexedName::fromConst(type, index);
+            }
+        };
+
+        std::size_t size() const
+        {
+            return count;
+        }
+        bool empty() const
+        {
+            return count == 0;
+        }
+        const Slot& operator[](std::size_t pos) const
+        {
+            return slots[pos];
+        }
+        /// Makes room for \a extra more names without growing the table
+        void reserve(std::size_t extra);
+        /// Returns the position of the first slot with \a hash for which \a match returns true
+        template<typename Match>
+        std::size_t find(std::uint32_t hash, Match match) const;
+        void insert(std::uint32_t hash, const IndexedName& idx);
+        void erase(std::size_t pos);
+
+    private:
+        std::vector<Slot> slots;
+        std::size_t count = 0;
+    };
+
+    NameIndex mappedNames;
+
+    /// Hashes the name as one string of its data and postfix, the same way names are compared
+    static std::uint32_t hashName(const MappedName& name);
+
+    /** Looks up \c name in \c mappedNames.
+     * @return the position of its slot and the stored name, or NameIndex::npos and nullptr
+     */
+    std::pair<std::size_t, const MappedNameRef*> findName(const MappedName& name,
+                                                          std::uint32_t hash) const;
+
+    /// Removes the slot of \c name bound to \c idx from \c mappedNames only
+    void eraseName(const MappedName& name, const IndexedName& idx);
 
     struct ChildMapInfo
     {
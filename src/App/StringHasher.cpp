@@ -24,6 +24,7 @@
 #include <QCryptographicHash>
 #include <QHash>
 #include <deque>
+#include <mutex>
 
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -82,6 +83,8 @@ class StringHasher::HashMap: public HashMapBase
 public:
     bool SaveAll = false;
     int Threshold = 0;
+    /// Guards the table. It is recursive because getID() encodes postfixes by calling itself.
+    std::recursive_mutex mutex;
 };
 
 ///////////////////////////////////////////////////////////
@@ -91,6 +94,7 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
 StringID::~StringID()
 {
     if (_hasher) {
+        std::lock_guard<std::recursive_mutex> lock(_hasher->_hashes->mutex);
         _hasher->_hashes->right.erase(_id);
     }
 }
@@ -182,6 +186,7 @@ StringHasher::~StringHasher()
 
 void StringHasher::setSaveAll(bool enable)
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     if (_hashes->SaveAll == enable) {
         return;
     }
@@ -191,6 +196,7 @@ void StringHasher::setSaveAll(bool enable)
 
 void StringHasher::compact()
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     if (_hashes->SaveAll) {
         return;
     }
@@ -243,6 +249,7 @@ int StringHasher::getThreshold() const
 
 long StringHasher::lastID() const
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     if (_hashes->right.empty()) {
         return 0;
     }
@@ -261,6 +268,7 @@ StringIDRef StringHasher::getID(const char* text, int len, bool hashable)
 
 StringIDRef StringHasher::getID(const QByteArray& data, Options options)
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     bool binary = options.testFlag(Option::Binary);
     bool hashable = options.testFlag(Option::Hashable);
     bool nocopy = options.testFlag(Option::NoCopy);
@@ -300,6 +308,7 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
 
 StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<StringIDRef>& sids)
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     StringID tempID;
     tempID._postfix = name.postfixBytes();
 
@@ -434,6 +443,7 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
 
 StringIDRef StringHasher::getID(long id, int index) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     if (id <= 0) {
         return {};
     }
@@ -461,6 +471,7 @@ const std::string& StringHasher::getPersistenceFileName() const
 
 void StringHasher::Save(Base::Writer& writer) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
 
     std::size_t count = _hashes->SaveAll ? _hashes->size() : this->count();
 
@@ -489,6 +500,7 @@ void StringHasher::Save(Base::Writer& writer) const
 
 void StringHasher::SaveDocFile(Base::Writer& writer) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     std::size_t count = _hashes->SaveAll ? this->size() : this->count();
     writer.Stream() << "StringTableStart v1 " << count << '\n';
     saveStream(writer.Stream());
@@ -593,6 +605,7 @@ void StringHasher::saveStream(std::ostream& stream) const
 
 void StringHasher::RestoreDocFile(Base::Reader& reader)
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     std::string marker;
     std::string ver;
     reader >> marker;
@@ -728,6 +741,7 @@ void StringHasher::restoreStreamNew(std::istream& stream, std::size_t count)
 
 StringID* StringHasher::insert(const StringIDRef& sid)
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     assert(sid && sid._sid->_hasher == nullptr);
     auto& hasher = *sid._sid;
     hasher._hasher = this;
@@ -743,6 +757,7 @@ StringID* StringHasher::insert(const StringIDRef& sid)
 
 void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     _hashes->clear();
     std::string content;
     for (uint32_t i = 0; i < count; ++i) {
@@ -762,6 +777,7 @@ void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 
 void StringHasher::clear()
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_hasher = nullptr;
         hasher.second->unref();
@@ -771,11 +787,13 @@ void StringHasher::clear()
 
 size_t StringHasher::size() const
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     return _hashes->size();
 }
 
 size_t StringHasher::count() const
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     size_t count = 0;
     for (auto& hasher : _hashes->right) {
         if (hasher.second->isMarked() || hasher.second->isPersistent()) {
@@ -787,6 +805,7 @@ size_t StringHasher::count() const
 
 void StringHasher::Restore(Base::XMLReader& reader)
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     clear();
     reader.readElement("StringHasher");
     _hashes->SaveAll = reader.getAttribute<long>("saveall") != 0L;
@@ -853,6 +872,7 @@ PyObject* StringHasher::getPyObject()
 
 std::map<long, StringIDRef> StringHasher::getIDMap() const
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     std::map<long, StringIDRef> ret;
     for (auto& hasher : _hashes->right) {
         ret.emplace_hint(ret.end(), hasher.first, StringIDRef(hasher.second));
@@ -862,6 +882,7 @@ std::map<long, StringIDRef> StringHasher::getIDMap() const
 
 void StringHasher::clearMarks() const
 {
+    std::lock_guard<std::recursive_mutex> lock(_hashes->mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_flags.setFlag(StringID::Flag::Marked, false);
     }
@@ -629,6 +629,9 @@ private:
 /// If the string is longer than a given threshold, instead of storing the string, its SHA1 hash is
 /// stored (and the original string discarded). This allows an upper threshold on the length of a
 /// stored string, while still effectively guaranteeing uniqueness in the table.
+///
+/// The table is guarded by a mutex, so strings may be looked up and added from several threads at
+/// the same time, e.g. while element maps are generated in parallel.
 class AppExport StringHasher: public Base::Persistence, public Base::Handled
 {
 
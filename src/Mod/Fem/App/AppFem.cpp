@@ -22,6 +22,9 @@
  ***************************************************************************/
 
 
+#include <cstdlib>
+#include <cstring>
+
 #include <SMESH_Version.h>
 
 #include <Base/Console.h>
@@ -68,6 +71,8 @@
 # include "FemPostPipeline.h"
 # include "FemPostBranchFilter.h"
 # include "PropertyPostDataObject.h"
+# include <vtkSMPTools.h>
+# include <vtkVersion.h>
 #endif
 
 
@@ -223,5 +228,16 @@ PyMOD_INIT_FUNC(Fem)
 #endif
     // clang-format on
 
+#ifdef FC_USE_VTK
+# if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 1, 0)
+    // Let the VTK filters that support it (clip, cut, contours, warp, ...) run in parallel
+    // unless a backend was explicitly chosen
+    if (!std::getenv("VTK_SMP_BACKEND_IN_USE")
+        && std::strcmp(vtkSMPTools::GetBackend(), "Sequential") == 0) {
+        vtkSMPTools::SetBackend("STDThread");
+    }
+# endif
+#endif
+
     PyMOD_Return(femModule);
 }
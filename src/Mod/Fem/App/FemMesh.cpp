@@ -21,23 +21,39 @@
  ***************************************************************************/
 
 #include <Python.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
 #include <cstdlib>
+#include <limits>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 
+#include <BRepAdaptor_Curve.hxx>
 #include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepTopAdaptor_FClass2d.hxx>
 #include <BRep_Tool.hxx>
 #include <Bnd_Box.hxx>
+#include <Precision.hxx>
 #include <SMDS_MeshGroup.hxx>
 #include <SMESHDS_Group.hxx>
 #include <SMESHDS_GroupBase.hxx>
 #include <SMESHDS_Mesh.hxx>
+#include <SMESHDS_SubMesh.hxx>
 #include <SMESH_Gen.hxx>
 #include <SMESH_Group.hxx>
 #include <SMESH_Mesh.hxx>
 #include <SMESH_MeshEditor.hxx>
+#include <ShapeAnalysis_Curve.hxx>
 #include <ShapeAnalysis_ShapeTolerance.hxx>
+#include <ShapeAnalysis_Surface.hxx>
 #include <StdMeshers_Deflection1D.hxx>
 #include <StdMeshers_LocalLength.hxx>
 #include <StdMeshers_MaxElementArea.hxx>
@@ -47,11 +63,15 @@
 #include <StdMeshers_Quadrangle_2D.hxx>
 #include <StdMeshers_Regular_1D.hxx>
 #include <StdMeshers_StartEndLength.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Solid.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
 
 #include <boost/assign/list_of.hpp>
 #include <boost/tokenizer.hpp>  //to simplify parsing input files we use the boost lib
@@ -62,9 +82,11 @@
 #include <Base/FileInfo.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 #include <Base/TimeInfo.h>
 #include <Base/Writer.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Part/App/TopoShapeMapper.h>
 
 #include "FemMesh.h"
 #include <FemMeshPy.h>
@@ -80,6 +102,15 @@ using namespace boost;
 
 SMESH_Gen* FemMesh::_mesh_gen = nullptr;
 
+struct FemMesh::NodeCache
+{
+    /// The state of the mesh the nodes were looked up for
+    int numNodes {0};
+    int numElements {0};
+    Base::Matrix4D transform;
+    std::unordered_map<TopoDS_Shape, std::vector<int>, Part::ShapeHasher, Part::ShapeHasher> nodes;
+};
+
 TYPESYSTEM_SOURCE(Fem::FemMesh, Base::Persistence)
 
 FemMesh::FemMesh()
@@ -138,6 +169,7 @@ FemMesh& FemMesh::operator=(const FemMesh& mesh)
 void FemMesh::copyMeshData(const FemMesh& mesh)
 {
     _Mtrx = mesh._Mtrx;
+    nodeCache.reset();
 
     // 1. Get source mesh
     SMESHDS_Mesh* srcMeshDS = mesh.myMesh->GetMeshDS();
@@ -274,6 +306,11 @@ SMESH_Mesh* FemMesh::getSMesh()
     return myMesh;
 }
 
+void FemMesh::clearNodeCache()
+{
+    nodeCache.reset();
+}
+
 SMESH_Gen* FemMesh::getGenerator()
 {
     if (!FemMesh::_mesh_gen) {
@@ -330,6 +367,7 @@ void FemMesh::setStandardHypotheses()
 
 void FemMesh::compute()
 {
+    nodeCache.reset();
     getGenerator()->Compute(*myMesh, myMesh->GetShapeToMesh());
 }
 
@@ -344,7 +382,7 @@ std::set<long> FemMesh::getSurfaceNodes(long /*ElemId*/, short /*FaceId*/, float
 std::list<std::pair<int, int>> FemMesh::getVolumesByFace(const TopoDS_Face& face) const
 {
     std::list<std::pair<int, int>> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+    std::vector<int> nodes_on_face = getNodesByFace(face);
 
     // SMDS_MeshVolume::facesIterator() is broken with SMESH7 as it is impossible
     // to iterate volume faces
@@ -416,7 +454,7 @@ std::list<int> FemMesh::getFacesByFace(const TopoDS_Face& face) const
 {
     // TODO: This function is broken with SMESH7 as it is impossible to iterate volume faces
     std::list<int> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+    std::vector<int> nodes_on_face = getNodesByFace(face);
 
     SMDS_FaceIteratorPtr face_iter = myMesh->GetMeshDS()->facesIterator();
     while (face_iter->more()) {
@@ -450,7 +488,7 @@ std::list<int> FemMesh::getFacesByFace(const TopoDS_Face& face) const
 std::list<int> FemMesh::getEdgesByEdge(const TopoDS_Edge& edge) const
 {
     std::list<int> result;
-    std::set<int> nodes_on_edge = getNodesByEdge(edge);
+    std::vector<int> nodes_on_edge = getNodesByEdge(edge);
 
     SMDS_EdgeIteratorPtr edge_iter = myMesh->GetMeshDS()->edgesIterator();
     while (edge_iter->more()) {
@@ -487,7 +525,7 @@ std::list<int> FemMesh::getEdgesByEdge(const TopoDS_Edge& edge) const
 std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
 {
     std::map<int, int> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+    std::vector<int> nodes_on_face = getNodesByFace(face);
 
     static std::map<int, std::vector<int>> elem_order;
     if (elem_order.empty()) {
@@ -569,200 +607,288 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
     return result;
 }
 
-std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
+namespace
 {
-    std::set<int> result;
-
-    Bnd_Box box;
-    BRepBndLib::Add(solid, box);
-
-    // limit where the mesh node belongs to the solid
-    TopAbs_ShapeEnum shapetype = TopAbs_SHAPE;
-    ShapeAnalysis_ShapeTolerance analysis;
-    double limit = analysis.Tolerance(solid, 1, shapetype);
-    Base::Console().log("The limit if a node is in or out: %.12lf in scientific: %.4e \n", limit, limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+/// A node of the mesh with its position in absolute space
+struct PlacedNode
+{
+    int id;
+    gp_Pnt pnt;
+};
 
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
+/// Returns the nodes of the mesh that lie inside the box
+std::vector<PlacedNode> getNodesInBox(
+    SMESH_Mesh* mesh,
+    const Base::Matrix4D& mat,
+    const Bnd_Box& box
+)
+{
+    std::vector<PlacedNode> nodes;
+    SMDS_NodeIteratorPtr aNodeIter = mesh->GetMeshDS()->nodesIterator();
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
         double xyz[3];
         aNode->GetXYZ(xyz);
         Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
         // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(solid, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
+        vec = mat * vec;
+        gp_Pnt pnt(vec.x, vec.y, vec.z);
+        if (!box.IsOut(pnt)) {
+            nodes.push_back({aNode->GetID(), pnt});
+        }
+    }
+    return nodes;
+}
 
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
+/// Returns the sorted ids of the selected nodes
+std::vector<int> collectNodes(
+    const std::vector<PlacedNode>& nodes,
+    const std::vector<char>& selected
+)
+{
+    std::vector<int> result;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (selected[i]) {
+            result.push_back(nodes[i].id);
         }
     }
+    std::sort(result.begin(), result.end());
     return result;
 }
 
-std::set<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
+/// Returns the ids of the nodes for which \a accept is true, sorted
+template<typename Func>
+std::vector<int> selectNodes(const std::vector<PlacedNode>& nodes, Func accept)
 {
-    std::set<int> result;
+    std::vector<char> selected(nodes.size(), 0);
+#pragma omp parallel for schedule(dynamic)
+    for (long i = 0; i < static_cast<long>(nodes.size()); ++i) {
+        selected[i] = accept(nodes[i].pnt) ? 1 : 0;
+    }
 
-    Bnd_Box box;
-    BRepBndLib::Add(
-        face,
-        box,
-        Standard_False
-    );  // https://forum.freecad.org/viewtopic.php?f=18&t=21571&start=70#p221591
-    // limit where the mesh node belongs to the face:
-    double limit = BRep_Tool::Tolerance(face);
-    box.Enlarge(limit);
-
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+    return collectNodes(nodes, selected);
+}
 
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
+/// Checks with the exact distance whether a point lies on a shape
+bool isOnShape(const TopoDS_Shape& shape, const gp_Pnt& pnt, double limit)
+{
+    // create a vertex
+    BRepBuilderAPI_MakeVertex aBuilder(pnt);
+    TopoDS_Shape s = aBuilder.Vertex();
+    // measure distance
+    BRepExtrema_DistShapeShape measure(shape, s);
+    measure.Perform();
+    if (!measure.IsDone() || measure.NbSolution() < 1) {
+        return false;
     }
+    return measure.Value() < limit;
+}
 
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(face, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
+/** Returns the nodes the mesher has put on the shape and its sub-shapes.
+ * Nothing is returned if the mesh wasn't computed for a shape that contains \a shape, e.g.
+ * because it was read from a file, or if \a shape isn't meshed.
+ */
+std::optional<std::vector<int>> getNodesOfSubMeshes(
+    SMESH_Mesh* mesh,
+    const Base::Matrix4D& mat,
+    const TopoDS_Shape& shape
+)
+{
+    const SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
+    if (meshDS->ShapeToMesh().IsNull() || !meshDS->MeshElements(shape)) {
+        return std::nullopt;
+    }
 
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
+    // the map contains the shape itself, too
+    TopTools_IndexedMapOfShape subShapes;
+    TopExp::MapShapes(shape, subShapes);
+    std::vector<int> result;
+    for (int i = 1; i <= subShapes.Extent(); ++i) {
+        const SMESHDS_SubMesh* subMesh = meshDS->MeshElements(subShapes(i));
+        if (!subMesh) {
+            continue;
         }
+        SMDS_NodeIteratorPtr aNodeIter = subMesh->GetNodes();
+        while (aNodeIter && aNodeIter->more()) {
+            result.push_back(aNodeIter->next()->GetID());
+        }
+    }
+    if (result.empty()) {
+        return std::nullopt;
     }
 
+    // The mesh could have been moved away from the shape it was computed for
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box);
+    box.Enlarge(Precision::Confusion());
+    const SMDS_MeshNode* aNode = meshDS->FindNode(result.front());
+    Base::Vector3d vec = mat * Base::Vector3d(aNode->X(), aNode->Y(), aNode->Z());
+    if (box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
+        return std::nullopt;
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
     return result;
 }
 
-std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge& edge) const
-{
-    std::set<int> result;
+}  // namespace
 
-    Bnd_Box box;
-    BRepBndLib::Add(edge, box);
-    // limit where the mesh node belongs to the edge:
-    double limit = BRep_Tool::Tolerance(edge);
-    box.Enlarge(limit);
+std::vector<int> FemMesh::getCachedNodes(
+    const TopoDS_Shape& shape,
+    const std::function<std::vector<int>()>& lookup
+) const
+{
+    const SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
+    int numNodes = meshDS->NbNodes();
+    int numElements = meshDS->GetMeshInfo().NbElements();
+    if (!nodeCache || nodeCache->numNodes != numNodes || nodeCache->numElements != numElements
+        || nodeCache->transform != _Mtrx) {
+        nodeCache = std::make_unique<NodeCache>();
+        nodeCache->numNodes = numNodes;
+        nodeCache->numElements = numElements;
+        nodeCache->transform = _Mtrx;
+    }
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+    auto it = nodeCache->nodes.find(shape);
+    if (it != nodeCache->nodes.end()) {
+        return it->second;
+    }
 
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
+    std::vector<int> result;
+    if (auto nodes = getNodesOfSubMeshes(myMesh, _Mtrx, shape)) {
+        result = std::move(*nodes);
+    }
+    else {
+        result = lookup();
     }
+    nodeCache->nodes.emplace(shape, result);
+    return result;
+}
 
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(edge, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
+std::vector<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
+{
+    return getCachedNodes(solid, [&]() {
+        Bnd_Box box;
+        BRepBndLib::Add(solid, box);
 
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
-        }
-    }
+        // limit where the mesh node belongs to the solid
+        TopAbs_ShapeEnum shapetype = TopAbs_SHAPE;
+        ShapeAnalysis_ShapeTolerance analysis;
+        double limit = analysis.Tolerance(solid, 1, shapetype);
+        Base::Console().log(
+            "The limit if a node is in or out: %.12lf in scientific: %.4e \n",
+            limit,
+            limit
+        );
 
-    return result;
+        std::vector<PlacedNode> nodes = getNodesInBox(myMesh, _Mtrx, box);
+        return selectNodes(nodes, [&](const gp_Pnt& pnt) {
+            return isOnShape(solid, pnt, limit);
+        });
+    });
 }
 
-std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex& vertex) const
+std::vector<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
 {
-    std::set<int> result;
+    return getCachedNodes(face, [&]() {
+        Bnd_Box box;
+        BRepBndLib::Add(
+            face,
+            box,
+            Standard_False
+        );  // https://forum.freecad.org/viewtopic.php?f=18&t=21571&start=70#p221591
+        // limit where the mesh node belongs to the face:
+        double limit = BRep_Tool::Tolerance(face);
+        box.Enlarge(limit);
 
-    double limit = BRep_Tool::Tolerance(vertex);
-    limit *= limit;  // use square to improve speed
-    gp_Pnt pnt = BRep_Tool::Pnt(vertex);
-    Base::Vector3d node(pnt.X(), pnt.Y(), pnt.Z());
+        std::vector<PlacedNode> nodes = getNodesInBox(myMesh, _Mtrx, box);
+        Handle(Geom_Surface) surface = BRep_Tool::Surface(face);
+        std::vector<char> onFace(nodes.size(), 0);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+#pragma omp parallel
+        {
+            // The projection onto the surface and the classification in its parameter space are
+            // much faster than the distance to the face. The projector caches data so that each
+            // thread needs its own one.
+            ShapeAnalysis_Surface projector(surface);
+            BRepTopAdaptor_FClass2d classifier(face, Precision::PConfusion());
+
+#pragma omp for schedule(dynamic)
+            for (long i = 0; i < static_cast<long>(nodes.size()); ++i) {
+                const gp_Pnt& pnt = nodes[i].pnt;
+                gp_Pnt2d uv = projector.ValueOfUV(pnt, limit);
+                if (projector.Gap() >= limit) {
+                    continue;
+                }
 
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
+                TopAbs_State state = classifier.Perform(uv);
+                // near the boundary the classification may fail
+                if (state != TopAbs_OUT || isOnShape(face, pnt, limit)) {
+                    onFace[i] = 1;
+                }
+            }
+        }
 
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        vec = Mtrx * vec;
+        return collectNodes(nodes, onFace);
+    });
+}
+
+std::vector<int> FemMesh::getNodesByEdge(const TopoDS_Edge& edge) const
+{
+    return getCachedNodes(edge, [&]() {
+        Bnd_Box box;
+        BRepBndLib::Add(edge, box);
+        // limit where the mesh node belongs to the edge:
+        double limit = BRep_Tool::Tolerance(edge);
+        box.Enlarge(limit);
+
+        std::vector<PlacedNode> nodes = getNodesInBox(myMesh, _Mtrx, box);
+        if (BRep_Tool::Degenerated(edge)) {
+            return selectNodes(nodes, [&](const gp_Pnt& pnt) {
+                return isOnShape(edge, pnt, limit);
+            });
+        }
 
-        if (Base::DistanceP2(node, vec) <= limit)
-#pragma omp critical
+        std::vector<char> onEdge(nodes.size(), 0);
+
+#pragma omp parallel
         {
-            result.insert(aNode->GetID());
+            // The projection onto the curve is much faster than the distance to the edge. The
+            // curve caches data so that each thread needs its own one.
+            BRepAdaptor_Curve curve(edge);
+            ShapeAnalysis_Curve projector;
+
+#pragma omp for schedule(dynamic)
+            for (long i = 0; i < static_cast<long>(nodes.size()); ++i) {
+                gp_Pnt proj;
+                double param;
+                if (projector.Project(curve, nodes[i].pnt, limit, proj, param) < limit) {
+                    onEdge[i] = 1;
+                }
+            }
         }
-    }
 
-    return result;
+        return collectNodes(nodes, onEdge);
+    });
+}
+
+std::vector<int> FemMesh::getNodesByVertex(const TopoDS_Vertex& vertex) const
+{
+    return getCachedNodes(vertex, [&]() {
+        double limit = BRep_Tool::Tolerance(vertex);
+        gp_Pnt pnt = BRep_Tool::Pnt(vertex);
+        Bnd_Box box;
+        box.Add(pnt);
+        box.Enlarge(limit);
+
+        limit *= limit;  // use square to improve speed
+        std::vector<PlacedNode> nodes = getNodesInBox(myMesh, _Mtrx, box);
+        return selectNodes(nodes, [&](const gp_Pnt& node) {
+            return node.SquareDistance(pnt) <= limit;
+        });
+    });
 }
 
 std::list<int> FemMesh::getElementNodes(int id) const
@@ -1632,6 +1758,7 @@ void FemMesh::read(const char* FileName)
 {
     Base::FileInfo File(FileName);
     _Mtrx = Base::Matrix4D();
+    nodeCache.reset();
 
     // checking on the file
     if (!File.isReadable()) {
@@ -1716,13 +1843,121 @@ void FemMesh::writeVTKWithGroups(
 #endif
 }
 
+namespace
+{
+
+void appendNumber(std::string& out, int value)
+{
+    char buf[16];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+// Same as the stream output with a precision of 13
+// https://forum.freecad.org/viewtopic.php?f=18&t=22759#p176669
+void appendNumber(std::string& out, double value)
+{
+    char buf[32];
+#if defined(__cpp_lib_to_chars)
+    auto res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, 13);
+    out.append(buf, res.ptr);
+#else
+    // older standard libraries, e.g. libc++ of macOS, lack to_chars for floating point
+    int len = std::snprintf(buf, sizeof(buf), "%.13g", value);
+    out.append(buf, std::min<std::size_t>(std::max(len, 0), sizeof(buf) - 1));
+#endif
+}
+
+// Formats the lines 0 to count - 1 in parallel into buffers of some thousand lines each and
+// writes the buffers in order. Only a few buffers per thread are kept in memory at a time.
+template<typename Format>
+void writeLines(std::ostream& out, std::size_t count, Format format)
+{
+    constexpr std::size_t linesPerBuffer = 16384;
+    std::size_t numBuffers = (count + linesPerBuffer - 1) / linesPerBuffer;
+    std::size_t batchSize = 4 * std::max(1U, std::thread::hardware_concurrency());
+    std::vector<std::string> buffers(std::min(batchSize, numBuffers));
+
+    for (std::size_t first = 0; first < numBuffers; first += batchSize) {
+        int size = static_cast<int>(std::min(batchSize, numBuffers - first));
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < size; ++i) {
+            std::string& buffer = buffers[i];
+            buffer.clear();
+            std::size_t begin = (first + i) * linesPerBuffer;
+            std::size_t end = std::min(begin + linesPerBuffer, count);
+            for (std::size_t line = begin; line < end; ++line) {
+                format(buffer, line);
+            }
+        }
+        for (int i = 0; i < size; ++i) {
+            out.write(buffers[i].data(), static_cast<std::streamsize>(buffers[i].size()));
+        }
+    }
+}
+
+// The elements of one type with the node IDs in the order of the inp file
+struct InpElements
+{
+    std::size_t numNodes {0};
+    std::vector<int> ids;
+    std::vector<int> nodes;
+
+    void add(const SMDS_MeshElement* elem, const std::vector<int>& order)
+    {
+        numNodes = order.size();
+        ids.push_back(elem->GetID());
+        for (int index : order) {
+            nodes.push_back(elem->GetNode(index)->GetID());
+        }
+    }
+    void sort()
+    {
+        if (std::is_sorted(ids.begin(), ids.end())) {
+            return;
+        }
+        std::vector<std::size_t> perm(ids.size());
+        std::iota(perm.begin(), perm.end(), 0);
+        std::sort(perm.begin(), perm.end(), [this](std::size_t a, std::size_t b) {
+            return ids[a] < ids[b];
+        });
+        std::vector<int> sortedIds;
+        std::vector<int> sortedNodes;
+        sortedIds.reserve(ids.size());
+        sortedNodes.reserve(nodes.size());
+        for (std::size_t index : perm) {
+            sortedIds.push_back(ids[index]);
+            auto it = nodes.begin() + static_cast<std::ptrdiff_t>(index * numNodes);
+            sortedNodes.insert(sortedNodes.end(), it, it + static_cast<std::ptrdiff_t>(numNodes));
+        }
+        ids.swap(sortedIds);
+        nodes.swap(sortedNodes);
+    }
+    void write(std::ostream& out) const
+    {
+        writeLines(out, ids.size(), [this](std::string& buffer, std::size_t index) {
+            appendNumber(buffer, ids[index]);
+            const int* node = nodes.data() + index * numNodes;
+            // Calculix allows max 16 entries in one line, a hexa20 has more !
+            for (std::size_t i = 0; i < numNodes; ++i) {
+                buffer.append(i == 15 ? ",\n" : ", ");
+                appendNumber(buffer, node[i]);
+            }
+            buffer.push_back('\n');
+        });
+    }
+};
+
+}  // namespace
+
 void FemMesh::writeABAQUS(
     const std::string& Filename,
     int elemParam,
     bool groupParam,
     ABAQUS_VolumeVariant volVariant,
     ABAQUS_FaceVariant faceVariant,
-    ABAQUS_EdgeVariant edgeVariant
+    ABAQUS_EdgeVariant edgeVariant,
+    bool splitFiles
 ) const
 {
     /*
@@ -1737,6 +1972,10 @@ void FemMesh::writeABAQUS(
 
      * volVariant, faceVariant, edgeVariant:
      * Element type according to availability in CalculiX
+     *
+     * splitFiles:
+     * true = write nodes, elements and groups into the include files <name>_Nodes.inp,
+     *        <name>_Elements.inp and <name>_Sets.inp next to the file
      */
 
     std::map<std::string, std::string> variants;
@@ -1948,37 +2187,46 @@ void FemMesh::writeABAQUS(
 
 
     // get all data --> Extract Nodes and Elements of the current SMESH datastructure
-    using VertexMap = std::map<int, Base::Vector3d>;
-    using NodesMap = std::map<int, std::vector<int>>;
-    using ElementsMap = std::map<std::string, NodesMap>;
+    using ElementsMap = std::map<std::string, InpElements>;
+    const SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
 
-    // get nodes
-    VertexMap vertexMap;  // empty nodes map
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    Base::Vector3d current_node;
+    // get nodes, they are transformed when writing them
+    struct InpNode
+    {
+        int id;
+        double x, y, z;
+    };
+    std::vector<InpNode> nodes;
+    nodes.reserve(meshDS->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
-        current_node.Set(aNode->X(), aNode->Y(), aNode->Z());
-        current_node = _Mtrx * current_node;
-        vertexMap[aNode->GetID()] = current_node;
+        nodes.push_back({aNode->GetID(), aNode->X(), aNode->Y(), aNode->Z()});
+    }
+    // This way we get sorted output.
+    // See https://forum.freecad.org/viewtopic.php?f=18&t=12646&start=40#p103004
+    if (!std::is_sorted(nodes.begin(), nodes.end(), [](const InpNode& a, const InpNode& b) {
+            return a.id < b.id;
+        })) {
+        std::sort(nodes.begin(), nodes.end(), [](const InpNode& a, const InpNode& b) {
+            return a.id < b.id;
+        });
     }
 
+    auto addElement = [&](ElementsMap& elements,
+                          const std::map<int, std::string>& typeMap,
+                          const SMDS_MeshElement* elem) {
+        auto it = typeMap.find(elem->NbNodes());
+        if (it != typeMap.end()) {
+            elements[it->second].add(elem, elemOrderMap[it->second]);
+        }
+    };
+
     // get volumes
     ElementsMap elementsMapVol;  // empty volumes map
-    SMDS_VolumeIteratorPtr aVolIter = myMesh->GetMeshDS()->volumesIterator();
+    SMDS_VolumeIteratorPtr aVolIter = meshDS->volumesIterator();
     while (aVolIter->more()) {
-        const SMDS_MeshVolume* aVol = aVolIter->next();
-        std::pair<int, std::vector<int>> apair;
-        apair.first = aVol->GetID();
-        int numNodes = aVol->NbNodes();
-        std::map<int, std::string>::iterator it = volTypeMap.find(numNodes);
-        if (it != volTypeMap.end()) {
-            const std::vector<int>& order = elemOrderMap[it->second];
-            for (int jt : order) {
-                apair.second.push_back(aVol->GetNode(jt)->GetID());
-            }
-            elementsMapVol[it->second].insert(apair);
-        }
+        addElement(elementsMapVol, volTypeMap, aVolIter->next());
     }
 
     // get faces
@@ -1987,38 +2235,16 @@ void FemMesh::writeABAQUS(
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty())) {
         // for elemParam = 1 we only fill the elementsMapFac if the elmentsMapVol is empty
         // we're going to fill the elementsMapFac with all faces
-        SMDS_FaceIteratorPtr aFaceIter = myMesh->GetMeshDS()->facesIterator();
+        SMDS_FaceIteratorPtr aFaceIter = meshDS->facesIterator();
         while (aFaceIter->more()) {
-            const SMDS_MeshFace* aFace = aFaceIter->next();
-            std::pair<int, std::vector<int>> apair;
-            apair.first = aFace->GetID();
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
-            if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aFace->GetNode(jt)->GetID());
-                }
-                elementsMapFac[it->second].insert(apair);
-            }
+            addElement(elementsMapFac, faceTypeMap, aFaceIter->next());
         }
     }
     if (elemParam == 2) {
         // we're going to fill the elementsMapFac with the facesOnly
         std::set<int> facesOnly = getFacesOnly();
         for (int itfa : facesOnly) {
-            std::pair<int, std::vector<int>> apair;
-            apair.first = itfa;
-            const SMDS_MeshElement* aFace = myMesh->GetMeshDS()->FindElement(itfa);
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
-            if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aFace->GetNode(jt)->GetID());
-                }
-                elementsMapFac[it->second].insert(apair);
-            }
+            addElement(elementsMapFac, faceTypeMap, meshDS->FindElement(itfa));
         }
     }
 
@@ -2028,38 +2254,22 @@ void FemMesh::writeABAQUS(
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty() && elementsMapFac.empty())) {
         // for elemParam = 1 we only fill the elementsMapEdg if the elmentsMapVol
         // and elmentsMapFac are empty we're going to fill the elementsMapEdg with all edges
-        SMDS_EdgeIteratorPtr aEdgeIter = myMesh->GetMeshDS()->edgesIterator();
+        SMDS_EdgeIteratorPtr aEdgeIter = meshDS->edgesIterator();
         while (aEdgeIter->more()) {
-            const SMDS_MeshEdge* aEdge = aEdgeIter->next();
-            std::pair<int, std::vector<int>> apair;
-            apair.first = aEdge->GetID();
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
-            if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aEdge->GetNode(jt)->GetID());
-                }
-                elementsMapEdg[it->second].insert(apair);
-            }
+            addElement(elementsMapEdg, edgeTypeMap, aEdgeIter->next());
         }
     }
     if (elemParam == 2) {
         // we're going to fill the elementsMapEdg with the edgesOnly
         std::set<int> edgesOnly = getEdgesOnly();
         for (int ited : edgesOnly) {
-            std::pair<int, std::vector<int>> apair;
-            apair.first = ited;
-            const SMDS_MeshElement* aEdge = myMesh->GetMeshDS()->FindElement(ited);
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
-            if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aEdge->GetNode(jt)->GetID());
-                }
-                elementsMapEdg[it->second].insert(apair);
-            }
+            addElement(elementsMapEdg, edgeTypeMap, meshDS->FindElement(ited));
+        }
+    }
+
+    for (auto* elementsMap : {&elementsMapVol, &elementsMapFac, &elementsMapEdg}) {
+        for (auto& it : *elementsMap) {
+            it.second.sort();
         }
     }
 
@@ -2068,24 +2278,37 @@ void FemMesh::writeABAQUS(
     // https://forum.freecad.org/viewtopic.php?f=10&t=37436
     Base::FileInfo fi(Filename);
     Base::ofstream anABAQUS_Output(fi);
-    // https://forum.freecad.org/viewtopic.php?f=18&t=22759#p176669
-    anABAQUS_Output.precision(13);
+
+    // With split files the big blocks are written into include files and the main file only
+    // references them
+    Base::ofstream nodesFile;
+    Base::ofstream elementsFile;
+    Base::ofstream setsFile;
+    auto openInclude = [&](Base::ofstream& file, const char* suffix) -> std::ostream& {
+        if (!splitFiles) {
+            return anABAQUS_Output;
+        }
+        std::string name = fi.fileNamePure() + suffix;
+        file.open(Base::FileInfo(fi.dirPath() + "/" + name));
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open include file " + name);
+        }
+        anABAQUS_Output << "*INCLUDE,INPUT=" << name << '\n';
+        return file;
+    };
 
     // add some text and make sure one of the known elemParam values is used
-    anABAQUS_Output << "** written by FreeCAD inp file writer for CalculiX,Abaqus meshes"
-                    << std::endl;
+    anABAQUS_Output << "** written by FreeCAD inp file writer for CalculiX,Abaqus meshes\n";
     switch (elemParam) {
         case 0:
-            anABAQUS_Output << "** all mesh elements." << std::endl << std::endl;
+            anABAQUS_Output << "** all mesh elements.\n\n";
             break;
         case 1:
-            anABAQUS_Output << "** highest dimension mesh elements only." << std::endl << std::endl;
+            anABAQUS_Output << "** highest dimension mesh elements only.\n\n";
             break;
         case 2:
             anABAQUS_Output << "** FEM mesh elements only (edges if they do not belong to faces "
-                               "and faces if they do not belong to volumes)."
-                            << std::endl
-                            << std::endl;
+                               "and faces if they do not belong to volumes).\n\n";
             break;
         default:
             anABAQUS_Output << "** Problem on writing" << std::endl;
@@ -2093,12 +2316,9 @@ void FemMesh::writeABAQUS(
             throw std::runtime_error("Unknown ABAQUS element choice parameter, [0|1|2] are allowed.");
     }
 
-    // write nodes
-    anABAQUS_Output << "** Nodes" << std::endl;
-    anABAQUS_Output << "*Node, NSET=Nall" << std::endl;
-
     // Axisymmetric, plane strain and plane stress elements expect nodes in the plane z=0.
     // Set the z coordinate to 0 to avoid possible rounding errors.
+    std::vector<bool> planarNodes;
     switch (faceVariant) {
         case ABAQUS_FaceVariant::Stress:
         case ABAQUS_FaceVariant::Stress_Reduced:
@@ -2106,13 +2326,10 @@ void FemMesh::writeABAQUS(
         case ABAQUS_FaceVariant::Strain_Reduced:
         case ABAQUS_FaceVariant::Axisymmetric:
         case ABAQUS_FaceVariant::Axisymmetric_Reduced:
+            planarNodes.resize(nodes.empty() ? 0 : nodes.back().id + 1);
             for (const auto& elMap : elementsMapFac) {
-                const NodesMap& nodeMap = elMap.second;
-                for (const auto& nodes : nodeMap) {
-                    for (int n : nodes.second) {
-                        Base::Vector3d& vertex = vertexMap[n];
-                        vertex.z = 0.0;
-                    }
+                for (int n : elMap.second.nodes) {
+                    planarNodes[n] = true;
                 }
             }
             break;
@@ -2120,106 +2337,69 @@ void FemMesh::writeABAQUS(
             break;
     }
 
-    // This way we get sorted output.
-    // See https://forum.freecad.org/viewtopic.php?f=18&t=12646&start=40#p103004
-    for (const auto& it : vertexMap) {
-        anABAQUS_Output << it.first << ", " << it.second.x << ", " << it.second.y << ", "
-                        << it.second.z << std::endl;
-    }
-    anABAQUS_Output << std::endl << std::endl;
-    ;
-
-
-    // write volumes to file
+    // write nodes
+    anABAQUS_Output << "** Nodes\n";
+    std::ostream& nodesOutput = openInclude(nodesFile, "_Nodes.inp");
+    nodesOutput << "*Node, NSET=Nall\n";
+    writeLines(nodesOutput, nodes.size(), [&](std::string& buffer, std::size_t index) {
+        const InpNode& node = nodes[index];
+        Base::Vector3d pnt = _Mtrx * Base::Vector3d(node.x, node.y, node.z);
+        if (!planarNodes.empty() && planarNodes[node.id]) {
+            pnt.z = 0.0;
+        }
+        appendNumber(buffer, node.id);
+        buffer.append(", ");
+        appendNumber(buffer, pnt.x);
+        buffer.append(", ");
+        appendNumber(buffer, pnt.y);
+        buffer.append(", ");
+        appendNumber(buffer, pnt.z);
+        buffer.push_back('\n');
+    });
+    anABAQUS_Output << "\n\n";
+
+    std::ostream& elementsOutput = elementsMapVol.empty() && elementsMapFac.empty()
+            && elementsMapEdg.empty()
+        ? anABAQUS_Output
+        : openInclude(elementsFile, "_Elements.inp");
     std::string elsetname;
-    if (!elementsMapVol.empty()) {
-        for (const auto& it : elementsMapVol) {
-            anABAQUS_Output << "** Volume elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Evolumes" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                // Calculix allows max 16 entries in one line, a hexa20 has more !
-                int ct = 0;  // counter
-                bool first_line = true;
-                for (auto kt = jt.second.begin(); kt != jt.second.end(); ++kt, ++ct) {
-                    if (ct < 15) {
-                        anABAQUS_Output << ", " << *kt;
-                    }
-                    else {
-                        if (first_line) {
-                            anABAQUS_Output << "," << std::endl << *kt;
-                            first_line = false;
-                        }
-                        else {
-                            anABAQUS_Output << ", " << *kt;
-                        }
-                    }
-                }
-                anABAQUS_Output << std::endl;
-            }
-        }
-        elsetname += "Evolumes";
-        anABAQUS_Output << std::endl;
-    }
-
-    // write faces to file
-    if (!elementsMapFac.empty()) {
-        for (const auto& it : elementsMapFac) {
-            anABAQUS_Output << "** Face elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Efaces" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                for (int kt : jt.second) {
-                    anABAQUS_Output << ", " << kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
+    auto writeElements = [&](const ElementsMap& elementsMap, const char* title, const char* elset) {
+        if (elementsMap.empty()) {
+            return;
         }
-        if (elsetname.empty()) {
-            elsetname += "Efaces";
+        for (const auto& it : elementsMap) {
+            elementsOutput << "** " << title << " elements\n";
+            elementsOutput << "*Element, TYPE=" << it.first << ", ELSET=" << elset << '\n';
+            it.second.write(elementsOutput);
         }
-        else {
-            elsetname += ", Efaces";
+        if (!elsetname.empty()) {
+            elsetname += ", ";
         }
-        anABAQUS_Output << std::endl;
-    }
+        elsetname += elset;
+        elementsOutput << '\n';
+    };
 
-    // write edges to file
-    if (!elementsMapEdg.empty()) {
-        for (const auto& it : elementsMapEdg) {
-            anABAQUS_Output << "** Edge elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Eedges" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                for (int kt : jt.second) {
-                    anABAQUS_Output << ", " << kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
-        }
-        if (elsetname.empty()) {
-            elsetname += "Eedges";
-        }
-        else {
-            elsetname += ", Eedges";
-        }
-        anABAQUS_Output << std::endl;
-    }
+    // write volumes, faces and edges to file
+    writeElements(elementsMapVol, "Volume", "Evolumes");
+    writeElements(elementsMapFac, "Face", "Efaces");
+    writeElements(elementsMapEdg, "Edge", "Eedges");
+    elementsMapVol.clear();
+    elementsMapFac.clear();
+    elementsMapEdg.clear();
 
     // write elset Eall
-    anABAQUS_Output << "** Define element set Eall" << std::endl;
-    anABAQUS_Output << "*ELSET, ELSET=Eall" << std::endl;
-    anABAQUS_Output << elsetname << std::endl;
+    anABAQUS_Output << "** Define element set Eall\n";
+    anABAQUS_Output << "*ELSET, ELSET=Eall\n";
+    anABAQUS_Output << elsetname << '\n';
 
     // groups
-    if (!groupParam) {
-        anABAQUS_Output.close();
-    }
-    else {
+    if (groupParam) {
         // get and write group data
-        anABAQUS_Output << std::endl << "** Group data" << std::endl;
-
+        anABAQUS_Output << "\n** Group data\n";
         std::list<int> groupIDs = myMesh->GetGroupIds();
+        std::ostream& setsOutput = groupIDs.empty() ? anABAQUS_Output
+                                                    : openInclude(setsFile, "_Sets.inp");
+
         for (int it : groupIDs) {
 
             // get and write group info and group definition
@@ -2254,34 +2434,45 @@ void FemMesh::writeABAQUS(
                     break;
             }
             const char* groupName = myMesh->GetGroup(it)->GetName();
-            anABAQUS_Output << "** GroupID: " << (it) << " --> GroupName: " << groupName
-                            << " --> GroupElementType: " << groupElementType << std::endl;
+            setsOutput << "** GroupID: " << (it) << " --> GroupName: " << groupName
+                       << " --> GroupElementType: " << groupElementType << '\n';
 
             if (aElementType == SMDSAbs_Node) {
-                anABAQUS_Output << "*NSET, NSET=" << groupName << std::endl;
+                setsOutput << "*NSET, NSET=" << groupName << '\n';
             }
             else {
-                anABAQUS_Output << "*ELSET, ELSET=" << groupName << std::endl;
+                setsOutput << "*ELSET, ELSET=" << groupName << '\n';
             }
 
             // get and write group elements
-            std::set<int> ids;
+            std::vector<int> ids;
+            ids.reserve(myMesh->GetGroup(it)->GetGroupDS()->Extent());
             SMDS_ElemIteratorPtr aElemIter = myMesh->GetGroup(it)->GetGroupDS()->GetElements();
             while (aElemIter->more()) {
                 const SMDS_MeshElement* aElement = aElemIter->next();
-                ids.insert(aElement->GetID());
-            }
-            for (int it : ids) {
-                anABAQUS_Output << it << std::endl;
+                ids.push_back(aElement->GetID());
             }
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            writeLines(setsOutput, ids.size(), [&ids](std::string& buffer, std::size_t index) {
+                appendNumber(buffer, ids[index]);
+                buffer.push_back('\n');
+            });
 
             // write newline after each group
-            anABAQUS_Output << std::endl;
+            setsOutput << '\n';
         }
-        anABAQUS_Output.close();
     }
-}
 
+    for (std::ofstream* file : {&nodesFile, &elementsFile, &setsFile, &anABAQUS_Output}) {
+        if (file->is_open()) {
+            file->close();
+            if (file->fail()) {
+                throw std::runtime_error("Failed to write the ABAQUS file " + Filename);
+            }
+        }
+    }
+}
 
 void FemMesh::writeZ88(const std::string& FileName) const
 {
@@ -2379,12 +2570,384 @@ unsigned int FemMesh::getMemSize() const
     return 0;
 }
 
+namespace
+{
+
+// The binary format of the mesh in project files. All values are little-endian.
+//
+//   char[8] magic, uint32 version
+//   uint64 number of nodes, int32 ids[], double coordinates[3 * number of nodes]
+//   uint32 number of element blocks, for each block:
+//     uint8 SMDSAbs_ElementType, uint8 poly, uint8 quadratic, uint32 nodes per element,
+//     uint64 number of elements, int32 ids[],
+//     polyhedra: int32 faces per element[], int32 nodes per face[], int32 nodes[]
+//     balls: double diameters[], int32 nodes[]
+//     others: int32 nodes[nodes per element * number of elements]
+//   uint32 number of groups, for each group:
+//     uint32 length of name, char name[], uint8 SMDSAbs_ElementType,
+//     uint64 number of members, int32 ids[]
+constexpr const char binaryMeshMagic[8] = {'F', 'C', 'F', 'e', 'm', 'M', 's', 'h'};
+constexpr uint32_t binaryMeshVersion = 1;
+
+bool isBigEndian()
+{
+    return Base::SwapOrder() == HIGH_ENDIAN;
+}
+
+template<typename T>
+void writeValue(std::ostream& out, T value)
+{
+    if (isBigEndian()) {
+        Base::SwapEndian(value);
+    }
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void writeArray(std::ostream& out, const std::vector<T>& values)
+{
+    if (isBigEndian() && sizeof(T) > 1) {
+        std::vector<T> swapped(values);
+        for (auto& it : swapped) {
+            Base::SwapEndian(it);
+        }
+        writeArray<T>(out, swapped);
+        return;
+    }
+    out.write(
+        reinterpret_cast<const char*>(values.data()),
+        static_cast<std::streamsize>(values.size() * sizeof(T))
+    );
+}
+
+void checkStream(const std::istream& in)
+{
+    if (!in) {
+        throw Base::FileException("Unexpected end of binary FEM mesh data");
+    }
+}
+
+template<typename T>
+T readValue(std::istream& in)
+{
+    T value {};
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    checkStream(in);
+    if (isBigEndian()) {
+        Base::SwapEndian(value);
+    }
+    return value;
+}
+
+/// Returns the number of bytes left in the stream, or -1 if the stream cannot be positioned
+std::streamoff bytesLeft(std::istream& in)
+{
+    std::streampos pos = in.tellg();
+    if (pos == std::streampos(-1)) {
+        return -1;
+    }
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.clear();
+    in.seekg(pos);
+    if (end == std::streampos(-1) || !in) {
+        in.clear();
+        return -1;
+    }
+    return end - pos;
+}
+
+template<typename T>
+std::vector<T> readArray(std::istream& in, uint64_t count)
+{
+    // a count that exceeds the data left can only come from corrupt data
+    std::streamoff left = bytesLeft(in);
+    if (count > static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()) / sizeof(T)
+        || (left >= 0 && count * sizeof(T) > static_cast<uint64_t>(left))) {
+        throw Base::FileException("Invalid size in binary FEM mesh data");
+    }
+
+    // Project files are read from a zip stream whose size is unknown, so the array is read in
+    // chunks to not allocate a huge amount of memory for a corrupt count
+    constexpr uint64_t chunkSize = (uint64_t(1) << 20) / sizeof(T);
+    std::vector<T> values;
+    while (values.size() < count) {
+        std::size_t offset = values.size();
+        std::size_t num = static_cast<std::size_t>(std::min(count - offset, chunkSize));
+        values.resize(offset + num);
+        in.read(
+            reinterpret_cast<char*>(values.data() + offset),
+            static_cast<std::streamsize>(num * sizeof(T))
+        );
+        checkStream(in);
+    }
+    if (isBigEndian() && sizeof(T) > 1) {
+        for (auto& it : values) {
+            Base::SwapEndian(it);
+        }
+    }
+    return values;
+}
+
+/// The elements of the same type and number of nodes
+struct ElementBlock
+{
+    std::vector<int32_t> ids;
+    std::vector<int32_t> faces;
+    std::vector<int32_t> quantities;
+    std::vector<double> diameters;
+    std::vector<int32_t> nodes;
+};
+
+/// Element type, poly, quadratic and the number of nodes per element
+using ElementBlockKey = std::tuple<uint8_t, uint8_t, uint8_t, uint32_t>;
+
+std::vector<int> getQuantities(const SMDS_MeshElement* elem)
+{
+#if SMESH_VERSION_MAJOR >= 9
+    return static_cast<const SMDS_MeshVolume*>(elem)->GetQuantities();
+#else
+    return static_cast<const SMDS_VtkVolume*>(elem)->GetQuantities();
+#endif
+}
+
+void writeBinaryMesh(std::ostream& out, SMESH_Mesh* mesh)
+{
+    const SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
+    out.write(binaryMeshMagic, sizeof(binaryMeshMagic));
+    writeValue<uint32_t>(out, binaryMeshVersion);
+
+    std::vector<int32_t> nodeIds;
+    std::vector<double> coords;
+    nodeIds.reserve(meshDS->NbNodes());
+    coords.reserve(3 * std::size_t(meshDS->NbNodes()));
+    SMDS_NodeIteratorPtr nodeIt = meshDS->nodesIterator();
+    while (nodeIt->more()) {
+        const SMDS_MeshNode* node = nodeIt->next();
+        nodeIds.push_back(node->GetID());
+        coords.push_back(node->X());
+        coords.push_back(node->Y());
+        coords.push_back(node->Z());
+    }
+    writeValue<uint64_t>(out, nodeIds.size());
+    writeArray(out, nodeIds);
+    writeArray(out, coords);
+
+    std::map<ElementBlockKey, ElementBlock> blocks;
+    SMDS_ElemIteratorPtr elemIt = meshDS->elementsIterator();
+    while (elemIt->more()) {
+        const SMDS_MeshElement* elem = elemIt->next();
+        SMDSAbs_ElementType type = elem->GetType();
+        if (type == SMDSAbs_Node) {
+            continue;
+        }
+
+        bool polyhedron = type == SMDSAbs_Volume && elem->IsPoly();
+        // all polyhedra are put into one block, polygons into one block per number of nodes
+        uint32_t numNodes = polyhedron ? 0 : elem->NbNodes();
+        ElementBlockKey key(type, elem->IsPoly(), elem->IsQuadratic(), numNodes);
+        ElementBlock& block = blocks[key];
+        block.ids.push_back(elem->GetID());
+        if (polyhedron) {
+            std::vector<int> quantities = getQuantities(elem);
+            block.faces.push_back(static_cast<int32_t>(quantities.size()));
+            block.quantities.insert(block.quantities.end(), quantities.begin(), quantities.end());
+        }
+        else if (type == SMDSAbs_Ball) {
+            block.diameters.push_back(static_cast<const SMDS_BallElement*>(elem)->GetDiameter());
+        }
+        SMDS_ElemIteratorPtr it = elem->nodesIterator();
+        while (it->more()) {
+            block.nodes.push_back(it->next()->GetID());
+        }
+    }
+
+    writeValue<uint32_t>(out, blocks.size());
+    for (const auto& [key, block] : blocks) {
+        writeValue<uint8_t>(out, std::get<0>(key));
+        writeValue<uint8_t>(out, std::get<1>(key));
+        writeValue<uint8_t>(out, std::get<2>(key));
+        writeValue<uint32_t>(out, std::get<3>(key));
+        writeValue<uint64_t>(out, block.ids.size());
+        writeArray(out, block.ids);
+        if (std::get<0>(key) == SMDSAbs_Volume && std::get<3>(key) == 0) {
+            writeArray(out, block.faces);
+            writeArray(out, block.quantities);
+        }
+        else if (std::get<0>(key) == SMDSAbs_Ball) {
+            writeArray(out, block.diameters);
+        }
+        writeArray(out, block.nodes);
+    }
+
+    std::vector<SMESH_Group*> groups;
+    SMESH_Mesh::GroupIteratorPtr groupIt = mesh->GetGroups();
+    while (groupIt->more()) {
+        groups.push_back(groupIt->next());
+    }
+    writeValue<uint32_t>(out, groups.size());
+    for (SMESH_Group* group : groups) {
+        const SMESHDS_GroupBase* groupDS = group->GetGroupDS();
+        std::string name(group->GetName());
+        std::vector<int32_t> ids;
+        ids.reserve(groupDS->Extent());
+        SMDS_ElemIteratorPtr it = groupDS->GetElements();
+        while (it->more()) {
+            ids.push_back(it->next()->GetID());
+        }
+        writeValue<uint32_t>(out, name.size());
+        out.write(name.c_str(), static_cast<std::streamsize>(name.size()));
+        writeValue<uint8_t>(out, groupDS->GetType());
+        writeValue<uint64_t>(out, ids.size());
+        writeArray(out, ids);
+    }
+}
+
+uint64_t sum(const std::vector<int32_t>& values)
+{
+    return std::accumulate(values.begin(), values.end(), uint64_t(0), [](uint64_t sum, int32_t v) {
+        if (v < 0) {
+            throw Base::FileException("Invalid size in binary FEM mesh data");
+        }
+        return sum + v;
+    });
+}
+
+void readBinaryMesh(std::istream& in, SMESH_Mesh* mesh)
+{
+    char magic[sizeof(binaryMeshMagic)];
+    in.read(magic, sizeof(magic));
+    checkStream(in);
+    if (!std::equal(magic, magic + sizeof(magic), binaryMeshMagic)) {
+        throw Base::FileException("No binary FEM mesh data");
+    }
+    auto version = readValue<uint32_t>(in);
+    if (version > binaryMeshVersion) {
+        throw Base::FileException("Binary FEM mesh data of a newer version");
+    }
+
+    SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
+    auto numNodes = readValue<uint64_t>(in);
+    auto nodeIds = readArray<int32_t>(in, numNodes);
+    auto coords = readArray<double>(in, 3 * numNodes);
+    for (std::size_t i = 0; i < nodeIds.size(); ++i) {
+        const double* xyz = &coords[3 * i];
+        meshDS->AddNodeWithID(xyz[0], xyz[1], xyz[2], nodeIds[i]);
+    }
+
+    auto findNodes = [meshDS](const int32_t* ids, std::size_t count) {
+        std::vector<const SMDS_MeshNode*> nodes(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            nodes[i] = meshDS->FindNode(ids[i]);
+            if (!nodes[i]) {
+                throw Base::FileException("Unknown node in binary FEM mesh data");
+            }
+        }
+        return nodes;
+    };
+
+    SMESH_MeshEditor editor(mesh);
+    auto numBlocks = readValue<uint32_t>(in);
+    for (uint32_t i = 0; i < numBlocks; ++i) {
+        auto type = static_cast<SMDSAbs_ElementType>(readValue<uint8_t>(in));
+        bool poly = readValue<uint8_t>(in) != 0;
+        bool quad = readValue<uint8_t>(in) != 0;
+        auto nodesPerElement = readValue<uint32_t>(in);
+        auto count = readValue<uint64_t>(in);
+        if (type <= SMDSAbs_Node || type >= SMDSAbs_NbElementTypes) {
+            throw Base::FileException("Invalid element type in binary FEM mesh data");
+        }
+        auto ids = readArray<int32_t>(in, count);
+
+        if (type == SMDSAbs_Volume && nodesPerElement == 0) {
+            auto faces = readArray<int32_t>(in, count);
+            auto quantities = readArray<int32_t>(in, sum(faces));
+            auto nodes = readArray<int32_t>(in, sum(quantities));
+            std::size_t face = 0;
+            std::size_t node = 0;
+            for (std::size_t j = 0; j < ids.size(); ++j) {
+                std::vector<int> elemQuantities(
+                    quantities.begin() + face,
+                    quantities.begin() + face + faces[j]
+                );
+                face += faces[j];
+                auto elemNodes = std::accumulate(
+                    elemQuantities.begin(),
+                    elemQuantities.end(),
+                    std::size_t(0)
+                );
+                SMESH_MeshEditor::ElemFeatures features;
+                features.Init(elemQuantities, quad).SetID(ids[j]);
+                if (!editor.AddElement(findNodes(nodes.data() + node, elemNodes), features)) {
+                    throw Base::FileException("Invalid element in binary FEM mesh data");
+                }
+                node += elemNodes;
+            }
+            continue;
+        }
+
+        std::vector<double> diameters;
+        if (type == SMDSAbs_Ball) {
+            diameters = readArray<double>(in, count);
+        }
+        auto nodes = readArray<int32_t>(in, count * nodesPerElement);
+        for (std::size_t j = 0; j < ids.size(); ++j) {
+            SMESH_MeshEditor::ElemFeatures features(type, poly, quad);
+            if (type == SMDSAbs_Ball) {
+                features.Init(diameters[j]);
+            }
+            features.SetID(ids[j]);
+            auto elemNodes = findNodes(nodes.data() + j * nodesPerElement, nodesPerElement);
+            if (!editor.AddElement(elemNodes, features)) {
+                throw Base::FileException("Invalid element in binary FEM mesh data");
+            }
+        }
+    }
+
+    auto numGroups = readValue<uint32_t>(in);
+    for (uint32_t i = 0; i < numGroups; ++i) {
+        auto name = readArray<char>(in, readValue<uint32_t>(in));
+        auto type = static_cast<SMDSAbs_ElementType>(readValue<uint8_t>(in));
+        auto ids = readArray<int32_t>(in, readValue<uint64_t>(in));
+        if (type >= SMDSAbs_NbElementTypes) {
+            throw Base::FileException("Invalid group type in binary FEM mesh data");
+        }
+
+        int aId = -1;
+        std::string groupName(name.begin(), name.end());
+        SMESH_Group* group = mesh->AddGroup(type, groupName.c_str(), aId);
+        auto groupDS = group ? dynamic_cast<SMESHDS_Group*>(group->GetGroupDS()) : nullptr;
+        if (!groupDS) {
+            throw Base::FileException("Failed to create group of binary FEM mesh data");
+        }
+        SMDS_MeshGroup& smdsGroup = groupDS->SMDSGroup();
+        for (int32_t id : ids) {
+            const SMDS_MeshElement* elem = type == SMDSAbs_Node ? meshDS->FindNode(id)
+                                                                : meshDS->FindElement(id);
+            if (elem) {
+                smdsGroup.Add(elem);
+            }
+        }
+    }
+
+    meshDS->Modified();
+}
+
+}  // namespace
+
 void FemMesh::Save(Base::Writer& writer) const
 {
     if (!writer.isForceXML()) {
+        // Versions before the binary format only read UNV files, so it must be enabled
+        // explicitly as long as projects are shared with them.
         // See SaveDocFile(), RestoreDocFile()
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Fem/General"
+        );
+        saveBinary = hGrp->GetBool("BinaryMeshFormat", false);
         writer.Stream() << writer.ind() << "<FemMesh file=\"";
-        writer.Stream() << writer.addFile("FemMesh.unv", this) << "\"";
+        writer.Stream() << writer.addFile(saveBinary ? "FemMesh.bin" : "FemMesh.unv", this)
+                        << "\"";
         writer.Stream() << " a11=\"" << _Mtrx[0][0] << "\" a12=\"" << _Mtrx[0][1] << "\" a13=\""
                         << _Mtrx[0][2] << "\" a14=\"" << _Mtrx[0][3] << "\"";
         writer.Stream() << " a21=\"" << _Mtrx[1][0] << "\" a22=\"" << _Mtrx[1][1] << "\" a23=\""
@@ -2443,6 +3006,11 @@ void FemMesh::Restore(Base::XMLReader& reader)
 
 void FemMesh::SaveDocFile(Base::Writer& writer) const
 {
+    if (saveBinary) {
+        writeBinaryMesh(writer.Stream(), myMesh);
+        return;
+    }
+
     // create a temporary file and copy the content to the zip stream
     Base::FileInfo fi(App::Application::getTempFileName().c_str());
 
@@ -2461,7 +3029,14 @@ void FemMesh::SaveDocFile(Base::Writer& writer) const
 
 void FemMesh::RestoreDocFile(Base::Reader& reader)
 {
-    // create a temporary file and copy the content from the zip stream
+    nodeCache.reset();
+    if (!Base::FileInfo(reader.getFileName()).hasExtension("unv")) {
+        readBinaryMesh(reader, myMesh);
+        return;
+    }
+
+    // Projects of older versions and without BinaryMeshFormat store the mesh as UNV file.
+    // Create a temporary file and copy the content from the zip stream
     Base::FileInfo fi(App::Application::getTempFileName().c_str());
 
     // read in the ASCII file and write back to the file stream
@@ -2481,6 +3056,7 @@ void FemMesh::RestoreDocFile(Base::Reader& reader)
 void FemMesh::transformGeometry(const Base::Matrix4D& rclTrf)
 {
     // We perform a translation and rotation of the current active Mesh object
+    nodeCache.reset();
     Base::Matrix4D clMatrix(rclTrf);
     SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
     Base::Vector3d current_node;
@@ -2496,6 +3072,7 @@ void FemMesh::setTransform(const Base::Matrix4D& rclTrf)
 {
     // Placement handling, no geometric transformation
     _Mtrx = rclTrf;
+    nodeCache.reset();
 }
 
 Base::Matrix4D FemMesh::getTransform() const
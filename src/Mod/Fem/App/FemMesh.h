@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <vector>
@@ -91,6 +92,8 @@ public:
     FemMesh& operator=(const FemMesh&);
     const SMESH_Mesh* getSMesh() const;
     SMESH_Mesh* getSMesh();
+    /// Must be called after the nodes or elements were edited through getSMesh()
+    void clearNodeCache();
     static SMESH_Gen* getGenerator();
     void addHypothesis(const TopoDS_Shape& aSubShape, SMESH_HypothesisPtr hyp);
     void setStandardHypotheses();
@@ -129,14 +132,17 @@ public:
     //@{
     /// retrieving by region growing
     std::set<long> getSurfaceNodes(long ElemId, short FaceId, float Angle = 360) const;
+    // The following return the sorted IDs of the nodes on a shape. If the mesh was computed for
+    // a shape that contains it, the nodes the mesher has put on it are returned, otherwise the
+    // nodes are searched by their distance. The result is cached until the mesh changes.
     /// retrieving by solid
-    std::set<int> getNodesBySolid(const TopoDS_Solid& solid) const;
+    std::vector<int> getNodesBySolid(const TopoDS_Solid& solid) const;
     /// retrieving by face
-    std::set<int> getNodesByFace(const TopoDS_Face& face) const;
+    std::vector<int> getNodesByFace(const TopoDS_Face& face) const;
     /// retrieving by edge
-    std::set<int> getNodesByEdge(const TopoDS_Edge& edge) const;
+    std::vector<int> getNodesByEdge(const TopoDS_Edge& edge) const;
     /// retrieving by vertex
-    std::set<int> getNodesByVertex(const TopoDS_Vertex& vertex) const;
+    std::vector<int> getNodesByVertex(const TopoDS_Vertex& vertex) const;
     /// retrieving node IDs by element ID
     std::list<int> getElementNodes(int id) const;
     /// retrieving elements IDs by node ID
@@ -220,7 +226,8 @@ public:
         bool groupParam,
         ABAQUS_VolumeVariant volVariant = ABAQUS_VolumeVariant::Standard,
         ABAQUS_FaceVariant faceVariant = ABAQUS_FaceVariant::Shell,
-        ABAQUS_EdgeVariant edgeVariant = ABAQUS_EdgeVariant::Beam
+        ABAQUS_EdgeVariant edgeVariant = ABAQUS_EdgeVariant::Beam,
+        bool splitFiles = false
     ) const;
     void writeVTK(const std::string& FileName, bool highest = true) const;
     // write vtk file, and writes the groups into the provided cell array.
@@ -240,6 +247,11 @@ public:
     void writeZ88(const std::string& FileName) const;
 
 private:
+    struct NodeCache;
+    std::vector<int> getCachedNodes(
+        const TopoDS_Shape& shape,
+        const std::function<std::vector<int>()>& lookup
+    ) const;
     void copyMeshData(const FemMesh&);
     void readNastran(const std::string& Filename);
     void readNastran95(const std::string& Filename);
@@ -255,6 +267,9 @@ private:
 #endif
 
     std::list<SMESH_HypothesisPtr> hypoth;
+    mutable std::unique_ptr<NodeCache> nodeCache;
+    /// Set by Save() if SaveDocFile() writes the binary format instead of UNV
+    mutable bool saveBinary {false};
     static SMESH_Gen* _mesh_gen;
 };
 
@@ -132,6 +132,7 @@ class FemMesh(ComplexGeoData):
         volVariant: str = "standard",
         faceVariant: str = "shell",
         edgeVariant: str = "beam",
+        splitFiles: bool = False,
     ) -> None:
         """
         Write out as ABAQUS inp.
@@ -174,6 +175,10 @@ class FemMesh(ComplexGeoData):
         For example if volume variant "modified" is selected, Tetra10 mesh
         elements are assigned to C3D10T and remain elements uses "standard".
         Axisymmetric, plane strain and plane stress elements expect nodes in the plane z=0.
+
+        splitFiles:
+            True: Write nodes, elements and group data into the include files
+            <name>_Nodes.inp, <name>_Elements.inp and <name>_Sets.inp next to the file
         """
         ...
 
@@ -33,6 +33,7 @@
 #include <TopoDS_Shape.hxx>
 #include <algorithm>
 #include <stdexcept>
+#include <utility>
 
 
 #include "Mod/Fem/App/FemMesh.h"
@@ -123,6 +124,7 @@ PyObject* FemMeshPy::setShape(PyObject* args)
 
     try {
         TopoDS_Shape shape = static_cast<Part::TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
+        getFemMeshPtr()->clearNodeCache();
         getFemMeshPtr()->getSMesh()->ShapeToMesh(shape);
     }
     catch (const std::exception& e) {
@@ -204,6 +206,7 @@ PyObject* FemMeshPy::addNode(PyObject* args)
     int i = -1;
     if (PyArg_ParseTuple(args, "ddd", &x, &y, &z)) {
         try {
+            getFemMeshPtr()->clearNodeCache();
             SMESH_Mesh* mesh = getFemMeshPtr()->getSMesh();
             SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
             SMDS_MeshNode* node = meshDS->AddNode(x, y, z);
@@ -221,6 +224,7 @@ PyObject* FemMeshPy::addNode(PyObject* args)
 
     if (PyArg_ParseTuple(args, "dddi", &x, &y, &z, &i)) {
         try {
+            getFemMeshPtr()->clearNodeCache();
             SMESH_Mesh* mesh = getFemMeshPtr()->getSMesh();
             SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
             SMDS_MeshNode* node = meshDS->AddNodeWithID(x, y, z, i);
@@ -245,6 +249,7 @@ PyObject* FemMeshPy::addNode(PyObject* args)
 
 PyObject* FemMeshPy::addEdge(PyObject* args)
 {
+    getFemMeshPtr()->clearNodeCache();
     SMESH_Mesh* mesh = getFemMeshPtr()->getSMesh();
     SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
 
@@ -335,6 +340,7 @@ PyObject* FemMeshPy::addEdge(PyObject* args)
 
 PyObject* FemMeshPy::addFace(PyObject* args)
 {
+    getFemMeshPtr()->clearNodeCache();
     SMESH_Mesh* mesh = getFemMeshPtr()->getSMesh();
     SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
 
@@ -487,6 +493,7 @@ PyObject* FemMeshPy::addQuad(PyObject* args)
     }
 
     try {
+        getFemMeshPtr()->clearNodeCache();
         SMESH_Mesh* mesh = getFemMeshPtr()->getSMesh();
         SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
         const SMDS_MeshNode* node1 = meshDS->FindNode(n1);
@@ -510,6 +517,7 @@ PyObject* FemMeshPy::addQuad(PyObject* args)
 
 PyObject* FemMeshPy::addVolume(PyObject* args)
 {
+    getFemMeshPtr()->clearNodeCache();
     SMESH_Mesh* mesh = getFemMeshPtr()->getSMesh();
     SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
 
@@ -843,6 +851,7 @@ PyObject* FemMeshPy::addEdgeList(PyObject* args)
 
     Py::List nodesList(nodesObj);
     Py::List npList(npObj);
+    getFemMeshPtr()->clearNodeCache();
     SMESHDS_Mesh* meshDS = getFemMeshPtr()->getSMesh()->GetMeshDS();
 
     std::vector<const SMDS_MeshNode*> nodes;
@@ -897,6 +906,7 @@ PyObject* FemMeshPy::addFaceList(PyObject* args)
 
     Py::List nodesList(nodesObj);
     Py::List npList(npObj);
+    getFemMeshPtr()->clearNodeCache();
     SMESHDS_Mesh* meshDS = getFemMeshPtr()->getSMesh()->GetMeshDS();
 
     std::vector<const SMDS_MeshNode*> nodes;
@@ -973,6 +983,7 @@ PyObject* FemMeshPy::addVolumeList(PyObject* args)
 
     Py::List nodesList(nodesObj);
     Py::List npList(npObj);
+    getFemMeshPtr()->clearNodeCache();
     SMESHDS_Mesh* meshDS = getFemMeshPtr()->getSMesh()->GetMeshDS();
 
     std::vector<const SMDS_MeshNode*> nodes;
@@ -1274,21 +1285,23 @@ PyObject* FemMeshPy::writeABAQUS(PyObject* args, PyObject* kwd) const
     const char* volVariant = "standard";
     const char* faceVariant = "shell";
     const char* edgeVariant = "beam";
+    PyObject* splitFiles = Py_False;
 
-    const std::array<const char*, 7> kwlist {
+    const std::array<const char*, 8> kwlist {
         "fileName",
         "elemParam",
         "groupParam",
         "volVariant",
         "faceVariant",
         "edgeVariant",
+        "splitFiles",
         nullptr
     };
 
     if (!Base::Wrapped_ParseTupleAndKeywords(
             args,
             kwd,
-            "etiO!|sss",
+            "etiO!|sssO!",
             kwlist,
             "utf-8",
             &Name,
@@ -1297,7 +1310,9 @@ PyObject* FemMeshPy::writeABAQUS(PyObject* args, PyObject* kwd) const
             &groupParam,
             &volVariant,
             &faceVariant,
-            &edgeVariant
+            &edgeVariant,
+            &PyBool_Type,
+            &splitFiles
         )) {
         return nullptr;
     }
@@ -1322,7 +1337,8 @@ PyObject* FemMeshPy::writeABAQUS(PyObject* args, PyObject* kwd) const
             grpParam,
             itVol->second,
             itFace->second,
-            itEdge->second
+            itEdge->second,
+            Base::asBoolean(splitFiles)
         );
     }
     catch (const std::exception& e) {
@@ -1483,7 +1499,8 @@ PyObject* FemMeshPy::getNodeById(PyObject* args) const
     }
 
     Base::Matrix4D Mtrx = getFemMeshPtr()->getTransform();
-    const SMDS_MeshNode* aNode = getFemMeshPtr()->getSMesh()->GetMeshDS()->FindNode(id);
+    const SMESHDS_Mesh* meshDS = std::as_const(*getFemMeshPtr()).getSMesh()->GetMeshDS();
+    const SMDS_MeshNode* aNode = meshDS->FindNode(id);
 
     if (aNode) {
         Base::Vector3d vec(aNode->X(), aNode->Y(), aNode->Z());
@@ -1512,7 +1529,7 @@ PyObject* FemMeshPy::getNodesBySolid(PyObject* args) const
             return nullptr;
         }
         Py::List ret;
-        std::set<int> resultSet = getFemMeshPtr()->getNodesBySolid(fc);
+        std::vector<int> resultSet = getFemMeshPtr()->getNodesBySolid(fc);
         for (int it : resultSet) {
             ret.append(Py::Long(it));
         }
@@ -1540,7 +1557,7 @@ PyObject* FemMeshPy::getNodesByFace(PyObject* args) const
             return nullptr;
         }
         Py::List ret;
-        std::set<int> resultSet = getFemMeshPtr()->getNodesByFace(fc);
+        std::vector<int> resultSet = getFemMeshPtr()->getNodesByFace(fc);
         for (int it : resultSet) {
             ret.append(Py::Long(it));
         }
@@ -1568,7 +1585,7 @@ PyObject* FemMeshPy::getNodesByEdge(PyObject* args) const
             return nullptr;
         }
         Py::List ret;
-        std::set<int> resultSet = getFemMeshPtr()->getNodesByEdge(fc);
+        std::vector<int> resultSet = getFemMeshPtr()->getNodesByEdge(fc);
         for (int it : resultSet) {
             ret.append(Py::Long(it));
         }
@@ -1597,7 +1614,7 @@ PyObject* FemMeshPy::getNodesByVertex(PyObject* args) const
             return nullptr;
         }
         Py::List ret;
-        std::set<int> resultSet = getFemMeshPtr()->getNodesByVertex(fc);
+        std::vector<int> resultSet = getFemMeshPtr()->getNodesByVertex(fc);
         for (int it : resultSet) {
             ret.append(Py::Long(it));
         }
@@ -1887,9 +1904,8 @@ PyObject* FemMeshPy::getIdByElementType(PyObject* args) const
 
     SMDSAbs_ElementType elemType = it->second;
     std::set<int> ids;
-    SMDS_ElemIteratorPtr aElemIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->elementsIterator(
-        elemType
-    );
+    const SMESHDS_Mesh* meshDS = std::as_const(*getFemMeshPtr()).getSMesh()->GetMeshDS();
+    SMDS_ElemIteratorPtr aElemIter = meshDS->elementsIterator(elemType);
     while (aElemIter->more()) {
         const SMDS_MeshElement* aElem = aElemIter->next();
         ids.insert(aElem->GetID());
@@ -1915,7 +1931,8 @@ Py::Dict FemMeshPy::getNodes() const
     // get the actual transform of the FemMesh
     Base::Matrix4D Mtrx = getFemMeshPtr()->getTransform();
 
-    SMDS_NodeIteratorPtr aNodeIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->nodesIterator();
+    const SMESHDS_Mesh* meshDS = std::as_const(*getFemMeshPtr()).getSMesh()->GetMeshDS();
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         Base::Vector3d vec(aNode->X(), aNode->Y(), aNode->Z());
@@ -1931,13 +1948,14 @@ Py::Dict FemMeshPy::getNodes() const
 
 Py::Long FemMeshPy::getNodeCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbNodes());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbNodes());
 }
 
 Py::Tuple FemMeshPy::getEdges() const
 {
     std::set<int> ids;
-    SMDS_EdgeIteratorPtr aEdgeIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->edgesIterator();
+    const SMESHDS_Mesh* meshDS = std::as_const(*getFemMeshPtr()).getSMesh()->GetMeshDS();
+    SMDS_EdgeIteratorPtr aEdgeIter = meshDS->edgesIterator();
     while (aEdgeIter->more()) {
         const SMDS_MeshEdge* aEdge = aEdgeIter->next();
         ids.insert(aEdge->GetID());
@@ -1966,13 +1984,14 @@ Py::Tuple FemMeshPy::getEdgesOnly() const
 
 Py::Long FemMeshPy::getEdgeCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbEdges());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbEdges());
 }
 
 Py::Tuple FemMeshPy::getFaces() const
 {
     std::set<int> ids;
-    SMDS_FaceIteratorPtr aFaceIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->facesIterator();
+    const SMESHDS_Mesh* meshDS = std::as_const(*getFemMeshPtr()).getSMesh()->GetMeshDS();
+    SMDS_FaceIteratorPtr aFaceIter = meshDS->facesIterator();
     while (aFaceIter->more()) {
         const SMDS_MeshFace* aFace = aFaceIter->next();
         ids.insert(aFace->GetID());
@@ -2001,28 +2020,29 @@ Py::Tuple FemMeshPy::getFacesOnly() const
 
 Py::Long FemMeshPy::getFaceCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbFaces());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbFaces());
 }
 
 Py::Long FemMeshPy::getTriangleCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbTriangles());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbTriangles());
 }
 
 Py::Long FemMeshPy::getQuadrangleCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbQuadrangles());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbQuadrangles());
 }
 
 Py::Long FemMeshPy::getPolygonCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbPolygons());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbPolygons());
 }
 
 Py::Tuple FemMeshPy::getVolumes() const
 {
     std::set<int> ids;
-    SMDS_VolumeIteratorPtr aVolIter = getFemMeshPtr()->getSMesh()->GetMeshDS()->volumesIterator();
+    const SMESHDS_Mesh* meshDS = std::as_const(*getFemMeshPtr()).getSMesh()->GetMeshDS();
+    SMDS_VolumeIteratorPtr aVolIter = meshDS->volumesIterator();
     while (aVolIter->more()) {
         const SMDS_MeshVolume* aVol = aVolIter->next();
         ids.insert(aVol->GetID());
@@ -2039,47 +2059,47 @@ Py::Tuple FemMeshPy::getVolumes() const
 
 Py::Long FemMeshPy::getVolumeCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbVolumes());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbVolumes());
 }
 
 Py::Long FemMeshPy::getTetraCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbTetras());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbTetras());
 }
 
 Py::Long FemMeshPy::getHexaCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbHexas());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbHexas());
 }
 
 Py::Long FemMeshPy::getPyramidCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbPyramids());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbPyramids());
 }
 
 Py::Long FemMeshPy::getPrismCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbPrisms());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbPrisms());
 }
 
 Py::Long FemMeshPy::getPolyhedronCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbPolyhedrons());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbPolyhedrons());
 }
 
 Py::Long FemMeshPy::getSubMeshCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbSubMesh());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbSubMesh());
 }
 
 Py::Long FemMeshPy::getGroupCount() const
 {
-    return Py::Long(getFemMeshPtr()->getSMesh()->NbGroup());
+    return Py::Long(std::as_const(*getFemMeshPtr()).getSMesh()->NbGroup());
 }
 
 Py::Tuple FemMeshPy::getGroups() const
 {
-    std::list<int> groupIDs = getFemMeshPtr()->getSMesh()->GetGroupIds();
+    std::list<int> groupIDs = std::as_const(*getFemMeshPtr()).getSMesh()->GetGroupIds();
 
     Py::Tuple tuple(groupIDs.size());
     int index = 0;
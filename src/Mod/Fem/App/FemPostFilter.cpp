@@ -21,16 +21,22 @@
  ***************************************************************************/
 
 #include <Python.h>
+#include <algorithm>
+#include <vtkCallbackCommand.h>
+#include <vtkCommand.h>
 #include <vtkDoubleArray.h>
 #include <vtkPointData.h>
 #include <vtkAlgorithm.h>
 #include <vtkAlgorithmOutput.h>
 #include <vtkUnstructuredGrid.h>
 #include <vtkInformation.h>
+#include <vtkNew.h>
 
+#include <App/Application.h>
 #include <App/FeaturePythonPyImp.h>
 #include <App/Document.h>
 #include <Base/Console.h>
+#include <Base/Sequencer.h>
 
 #include "FemPostFilter.h"
 #include "FemPostFilterPy.h"
@@ -45,10 +51,91 @@ using namespace App;
 PROPERTY_SOURCE(Fem::FemPostFilter, Fem::FemPostObject)
 
 
+namespace
+{
+
+// Shows the progress of the VTK algorithms of a filter and aborts them if the user cancels
+class FilterProgress
+{
+public:
+    explicit FilterProgress(std::vector<vtkAlgorithm*> algorithms)
+        : seq("Applying filter...", 100)
+        , algorithms(std::move(algorithms))
+    {
+        command->SetClientData(this);
+        command->SetCallback(&FilterProgress::onProgress);
+        for (auto algorithm : this->algorithms) {
+            tags.push_back(algorithm->AddObserver(vtkCommand::ProgressEvent, command));
+        }
+    }
+    ~FilterProgress()
+    {
+        for (std::size_t i = 0; i < algorithms.size(); ++i) {
+            algorithms[i]->RemoveObserver(tags[i]);
+            if (canceled) {
+                // the output is incomplete, it must be computed again the next time
+                algorithms[i]->SetAbortExecute(0);
+                algorithms[i]->Modified();
+            }
+        }
+    }
+    FilterProgress(const FilterProgress&) = delete;
+    FilterProgress& operator=(const FilterProgress&) = delete;
+
+    bool wasCanceled() const
+    {
+        return canceled;
+    }
+
+private:
+    static void onProgress(vtkObject*, unsigned long, void* clientData, void* callData)
+    {
+        auto self = static_cast<FilterProgress*>(clientData);
+        auto steps = static_cast<std::size_t>(*static_cast<double*>(callData) * 100.0);
+        try {
+            for (; self->steps < steps; ++self->steps) {
+                self->seq.next(true);
+            }
+        }
+        catch (const Base::AbortException&) {
+            self->cancel();
+        }
+        // when the filter runs inside a recompute the progress is shown for the document
+        if (self->seq.wasCanceled()) {
+            self->cancel();
+        }
+    }
+    void cancel()
+    {
+        canceled = true;
+        for (auto algorithm : algorithms) {
+            algorithm->SetAbortExecute(1);
+        }
+    }
+
+    Base::SequencerLauncher seq;
+    std::vector<vtkAlgorithm*> algorithms;
+    std::vector<unsigned long> tags;
+    vtkNew<vtkCallbackCommand> command;
+    std::size_t steps {0};
+    bool canceled {false};
+};
+
+}  // namespace
+
 FemPostFilter::FemPostFilter()
 {
     ADD_PROPERTY_TYPE(Frame, ((long)0), "Data", App::Prop_ReadOnly, "The step used to calculate the data");
 
+    // the results of the last frames are kept so that switching between them doesn't compute
+    // the whole pipeline again
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Fem/General"
+    );
+    m_frame_cache = vtkSmartPointer<vtkFemFrameCache>::New();
+    long cacheSize = hGrp->GetInt("PostFrameCacheSize", 8);
+    m_frame_cache->setCacheSize(static_cast<std::size_t>(std::max(0L, cacheSize)));
+
     // the default pipeline: just a passthrough
     // this is used to simplify the python filter handling,
     // as those do not have filter pipelines setup till later
@@ -70,6 +157,7 @@ void FemPostFilter::addFilterPipeline(const FemPostFilter::FilterPipeline& p, st
 
     if (m_activePipeline.empty()) {
         m_activePipeline = name;
+        connectFrameCache();
     }
 }
 
@@ -104,6 +192,7 @@ void FemPostFilter::setActiveFilterPipeline(std::string name)
 
         // set the new pipeline active
         m_activePipeline = name;
+        connectFrameCache();
         pipelineChanged();
     }
 }
@@ -119,6 +208,11 @@ vtkSmartPointer<vtkAlgorithm> FemPostFilter::getFilterInput()
 }
 
 vtkSmartPointer<vtkAlgorithm> FemPostFilter::getFilterOutput()
+{
+    return m_frame_cache;
+}
+
+vtkSmartPointer<vtkAlgorithm> FemPostFilter::getPipelineOutput()
 {
     if (m_use_transform && m_transform_location == TransformLocation::output) {
 
@@ -128,6 +222,11 @@ vtkSmartPointer<vtkAlgorithm> FemPostFilter::getFilterOutput()
     return m_pipelines[m_activePipeline].target;
 }
 
+void FemPostFilter::connectFrameCache()
+{
+    m_frame_cache->SetInputConnection(getPipelineOutput()->GetOutputPort(0));
+}
+
 void FemPostFilter::pipelineChanged()
 {
     // inform our parent, that we need to be reconnected
@@ -155,6 +254,7 @@ void FemPostFilter::onChanged(const App::Property* prop)
                 m_pipelines[m_activePipeline].source->RemoveAllInputConnections(0);
             }
             m_use_transform = false;
+            connectFrameCache();
             pipelineChanged();
         }
         if (!Placement.getValue().isIdentity() && !m_use_transform) {
@@ -170,6 +270,7 @@ void FemPostFilter::onChanged(const App::Property* prop)
                 );
             }
             m_use_transform = true;
+            connectFrameCache();
             pipelineChanged();
         }
     }
@@ -195,27 +296,37 @@ DocumentObjectExecReturn* FemPostFilter::execute()
             return nullptr;
         }
 
-        auto output = getFilterOutput();
-
-        if (output->GetNumberOfInputConnections(0) == 0) {
+        if (getPipelineOutput()->GetNumberOfInputConnections(0) == 0) {
             return StdReturn;
         }
 
+        std::vector<vtkAlgorithm*> algorithms {active.source, active.target};
+        for (const auto& algorithm : active.algorithmStorage) {
+            algorithms.push_back(algorithm);
+        }
+        std::sort(algorithms.begin(), algorithms.end());
+        algorithms.erase(std::unique(algorithms.begin(), algorithms.end()), algorithms.end());
+        FilterProgress progress(algorithms);
+
         if (Frame.getValue() > 0) {
-            output->UpdateTimeStep(Frame.getValue());
+            m_frame_cache->UpdateTimeStep(Frame.getValue());
         }
         else {
-            output->Update();
+            m_frame_cache->Update();
+        }
+
+        if (progress.wasCanceled()) {
+            return new App::DocumentObjectExecReturn("Filter canceled, recompute to run it again");
         }
 
-        Data.setValue(output->GetOutputDataObject(0));
+        Data.setValue(m_frame_cache->GetOutputDataObject(0));
     }
     return StdReturn;
 }
 
 bool FemPostFilter::dataIsAvailable()
 {
-    auto algo = getFilterOutput();
+    auto algo = getPipelineOutput();
     if (!algo) {
         return false;
     }
@@ -505,7 +616,8 @@ void FemPostDataAlongLineFilter::GetAxisData()
         return;
     }
 
-    vtkSmartPointer<vtkDataObject> data = m_probe->GetOutputDataObject(0);
+    // the probe itself is not executed again for a cached frame
+    vtkSmartPointer<vtkDataObject> data = getFilterOutput()->GetOutputDataObject(0);
     vtkDataSet* dset = vtkDataSet::SafeDownCast(data);
     if (!dset) {
         return;
@@ -638,7 +750,8 @@ void FemPostDataAtPointFilter::GetPointData()
 
     std::vector<double> values;
 
-    vtkSmartPointer<vtkDataObject> data = m_probe->GetOutputDataObject(0);
+    // the probe itself is not executed again for a cached frame
+    vtkSmartPointer<vtkDataObject> data = getFilterOutput()->GetOutputDataObject(0);
     vtkDataSet* dset = vtkDataSet::SafeDownCast(data);
     if (!dset) {
         return;
@@ -43,6 +43,7 @@
 #include <App/FeaturePython.h>
 
 #include "FemPostObject.h"
+#include "VTKExtensions/vtkFemFrameCache.h"
 
 
 namespace Fem
@@ -94,6 +95,7 @@ public:
     App::DocumentObjectExecReturn* execute() override;
 
     vtkSmartPointer<vtkAlgorithm> getFilterInput();
+    // the output keeps the results of the last frames, see vtkFemFrameCache
     vtkSmartPointer<vtkAlgorithm> getFilterOutput();
 
     PyObject* getPyObject() override;
@@ -105,8 +107,11 @@ private:
     bool m_use_transform = false;
     bool m_running_setup = false;
     TransformLocation m_transform_location = TransformLocation::output;
+    vtkSmartPointer<vtkFemFrameCache> m_frame_cache;
 
     void pipelineChanged();  // inform parents that the pipeline changed
+    vtkSmartPointer<vtkAlgorithm> getPipelineOutput();
+    void connectFrameCache();
 };
 
 using PostFilterPython = App::FeaturePythonT<FemPostFilter>;
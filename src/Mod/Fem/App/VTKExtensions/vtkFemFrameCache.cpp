@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <vtkDataObject.h>
+# include <vtkDemandDrivenPipeline.h>
+# include <vtkInformation.h>
+# include <vtkInformationVector.h>
+# include <vtkStreamingDemandDrivenPipeline.h>
+#endif
+
+#include "vtkFemFrameCache.h"
+
+using namespace Fem;
+
+
+vtkStandardNewMacro(vtkFemFrameCache);
+
+vtkFemFrameCache::vtkFemFrameCache() = default;
+
+vtkFemFrameCache::~vtkFemFrameCache() = default;
+
+void vtkFemFrameCache::setCacheSize(std::size_t size)
+{
+    m_cacheSize = size;
+    trim();
+}
+
+void vtkFemFrameCache::clear()
+{
+    m_frames.clear();
+    m_usage.clear();
+}
+
+vtkMTimeType vtkFemFrameCache::getPipelineTime()
+{
+    auto executive = vtkDemandDrivenPipeline::SafeDownCast(GetExecutive());
+    return executive ? executive->GetPipelineMTime() : 0;
+}
+
+bool vtkFemFrameCache::isCached(double time)
+{
+    // drop the frames that were computed before anything upstream was modified
+    vtkMTimeType pipelineTime = getPipelineTime();
+    for (auto it = m_frames.begin(); it != m_frames.end();) {
+        if (it->second.pipelineTime < pipelineTime) {
+            m_usage.remove(it->first);
+            it = m_frames.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    return m_frames.contains(time);
+}
+
+void vtkFemFrameCache::touch(double time)
+{
+    m_usage.remove(time);
+    m_usage.push_back(time);
+}
+
+void vtkFemFrameCache::trim()
+{
+    while (m_frames.size() > m_cacheSize) {
+        m_frames.erase(m_usage.front());
+        m_usage.pop_front();
+    }
+}
+
+int vtkFemFrameCache::RequestUpdateExtent(
+    vtkInformation*,
+    vtkInformationVector** inVector,
+    vtkInformationVector* outVector
+)
+{
+    vtkInformation* outInfo = outVector->GetInformationObject(0);
+    vtkInformation* inInfo = inVector[0]->GetInformationObject(0);
+    if (!outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())) {
+        return 1;
+    }
+
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    if (m_cacheSize == 0 || !isCached(time)) {
+        return 1;
+    }
+
+    // the frame is cached: ask the input for the time step it already has, then it is not
+    // executed again
+    vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (input && input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP())) {
+        inInfo->Set(
+            vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(),
+            input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP())
+        );
+    }
+    else {
+        inInfo->Remove(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    }
+
+    return 1;
+}
+
+int vtkFemFrameCache::RequestData(
+    vtkInformation*,
+    vtkInformationVector** inVector,
+    vtkInformationVector* outVector
+)
+{
+    vtkInformation* outInfo = outVector->GetInformationObject(0);
+    vtkDataObject* input = vtkDataObject::GetData(inVector[0], 0);
+    vtkDataObject* output = vtkDataObject::GetData(outVector, 0);
+    if (!input || !output) {
+        return 0;
+    }
+
+    if (m_cacheSize == 0 || !outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())) {
+        output->ShallowCopy(input);
+        return 1;
+    }
+
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    auto it = m_frames.find(time);
+    if (it != m_frames.end()) {
+        output->ShallowCopy(it->second.data);
+    }
+    else {
+        // the upstream filters create new arrays when they are executed again, so a shallow
+        // copy of the input is sufficient
+        output->ShallowCopy(input);
+        vtkSmartPointer<vtkDataObject> frame = vtkSmartPointer<vtkDataObject>::Take(
+            input->NewInstance()
+        );
+        frame->ShallowCopy(input);
+        m_frames[time] = {getPipelineTime(), frame};
+    }
+    touch(time);
+    trim();
+
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+
+#include <vtkPassInputTypeAlgorithm.h>
+#include <vtkSmartPointer.h>
+
+class vtkInformation;
+class vtkInformationVector;
+
+
+namespace Fem
+{
+
+// algorithm that keeps the output of the upstream pipeline for the last requested time steps.
+// Switching back to a cached frame does not re-execute the upstream filters. The frames are
+// dropped as soon as anything upstream is modified.
+class vtkFemFrameCache: public vtkPassInputTypeAlgorithm
+{
+public:
+    static vtkFemFrameCache* New();
+    vtkTypeMacro(vtkFemFrameCache, vtkPassInputTypeAlgorithm);
+
+    // the maximum number of frames to keep, 0 disables the cache
+    void setCacheSize(std::size_t size);
+    std::size_t getCacheSize() const
+    {
+        return m_cacheSize;
+    }
+    void clear();
+
+protected:
+    vtkFemFrameCache();
+    ~vtkFemFrameCache() override;
+
+    int RequestUpdateExtent(
+        vtkInformation* reqInfo,
+        vtkInformationVector** inVector,
+        vtkInformationVector* outVector
+    ) override;
+    int RequestData(
+        vtkInformation* reqInfo,
+        vtkInformationVector** inVector,
+        vtkInformationVector* outVector
+    ) override;
+
+private:
+    struct Frame
+    {
+        vtkMTimeType pipelineTime;
+        vtkSmartPointer<vtkDataObject> data;
+    };
+    // by time step
+    std::map<double, Frame> m_frames;
+    // the time steps from the least to the most recently used
+    std::list<double> m_usage;
+    std::size_t m_cacheSize {8};
+
+    vtkMTimeType getPipelineTime();
+    bool isCached(double time);
+    void touch(double time);
+    void trim();
+};
+
+}  // namespace Fem
@@ -80,6 +80,7 @@ def write_mesh(ccxwriter):
             volVariant=vol_variant,
             faceVariant=face_variant,
             edgeVariant=edge_variant,
+            splitFiles=True,
         )
 
         inpfile = codecs.open(ccxwriter.file_name, "w", encoding="utf-8")
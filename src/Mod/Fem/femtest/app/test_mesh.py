@@ -192,6 +192,37 @@ class TestMeshCommon(unittest.TestCase):
             f"Problem in test_writeAbaqus_precision, \n{read_node_line}\n{expected}",
         )
 
+    # ********************************************************************************************
+    def test_nodes_by_shape(self):
+        import Part
+
+        box = Part.makeBox(10, 10, 10)
+        mesh = Fem.FemMesh()
+        mesh.setShape(box)
+        mesh.setStandardHypotheses()
+        mesh.compute()
+        # the copy doesn't know the shape and searches the nodes by their distance
+        copy = mesh.copy()
+
+        for face in box.Faces:
+            nodes = mesh.getNodesByFace(face)
+            self.assertTrue(nodes)
+            self.assertEqual(nodes, sorted(nodes))
+            self.assertEqual(nodes, copy.getNodesByFace(face))
+        for edge in box.Edges:
+            nodes = mesh.getNodesByEdge(edge)
+            self.assertTrue(nodes)
+            self.assertEqual(nodes, sorted(nodes))
+            self.assertEqual(nodes, copy.getNodesByEdge(edge))
+        for vertex in box.Vertexes:
+            self.assertEqual(len(mesh.getNodesByVertex(vertex)), 1)
+            self.assertEqual(mesh.getNodesByVertex(vertex), copy.getNodesByVertex(vertex))
+
+        # the cached nodes must not be used after the mesh has changed
+        vertex = box.Vertexes[0]
+        copy.addNode(vertex.X, vertex.Y, vertex.Z)
+        self.assertEqual(len(copy.getNodesByVertex(vertex)), 2)
+
 
 # ************************************************************************************************
 # ************************************************************************************************
@@ -605,6 +636,110 @@ class TestMeshGroups(unittest.TestCase):
             ),
         )
 
+    def test_write_abaqus_split_files(self):
+        """
+        Write a mesh with groups into one inp file and split into include files. With the
+        includes expanded both must be the same.
+        """
+        from femexamples.meshes.mesh_canticcx_tetra10 import create_elements
+        from femexamples.meshes.mesh_canticcx_tetra10 import create_nodes
+
+        fm = Fem.FemMesh()
+        create_nodes(fm)
+        create_elements(fm)
+        node_group = fm.addGroup("mynodegroup", "Node")
+        fm.addGroupElements(node_group, [4, 2, 3, 1])
+        volume_group = fm.addGroup("myvolumegroup", "Volume")
+        fm.addGroupElements(volume_group, [190, 189])
+
+        tmp_dir = testtools.get_fem_test_tmp_dir("mesh_groups_inp_split")
+        single_file = join(tmp_dir, "single.inp")
+        split_file = join(tmp_dir, "split.inp")
+        fm.writeABAQUS(single_file, 0, True)
+        fm.writeABAQUS(split_file, 0, True, splitFiles=True)
+
+        def read_expanded(file_name):
+            lines = []
+            with open(file_name) as f:
+                for line in f:
+                    if line.startswith("*INCLUDE,INPUT="):
+                        lines += read_expanded(join(tmp_dir, line.strip()[15:]))
+                    else:
+                        lines.append(line)
+            return lines
+
+        with open(single_file) as f:
+            single_lines = f.readlines()
+        with open(split_file) as f:
+            includes = [line.strip() for line in f if line.startswith("*INCLUDE")]
+        self.assertEqual(
+            includes,
+            [
+                "*INCLUDE,INPUT=split_Nodes.inp",
+                "*INCLUDE,INPUT=split_Elements.inp",
+                "*INCLUDE,INPUT=split_Sets.inp",
+            ],
+        )
+        self.assertEqual(single_lines, read_expanded(split_file))
+        self.assertIn("*NSET, NSET=mynodegroup\n1\n2\n3\n4\n", "".join(single_lines))
+
+    def test_save_restore_document(self):
+        """
+        Save a mesh with groups in a project file in the binary format and load it again.
+        """
+        self.save_restore_document(True)
+
+    def test_save_restore_document_unv(self):
+        """
+        Save a mesh in a project file in the UNV format older versions can read and load it again.
+        """
+        self.save_restore_document(False)
+
+    def save_restore_document(self, binary):
+        import zipfile
+
+        from femexamples.meshes.mesh_canticcx_tetra10 import create_elements
+        from femexamples.meshes.mesh_canticcx_tetra10 import create_nodes
+
+        fm = Fem.FemMesh()
+        create_nodes(fm)
+        create_elements(fm)
+        node_group = fm.addGroup("mynodegroup", "Node")
+        fm.addGroupElements(node_group, [4, 2, 3, 1])
+        volume_group = fm.addGroup("myvolumegroup", "Volume")
+        fm.addGroupElements(volume_group, [190, 189])
+        mesh_obj = self.document.addObject("Fem::FemMeshObject", "Mesh")
+        mesh_obj.FemMesh = fm
+
+        fcstd_file = join(testtools.get_fem_test_tmp_dir("mesh_groups_fcstd"), "mesh.FCStd")
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Fem/General")
+        old_binary = param.GetBool("BinaryMeshFormat", False)
+        param.SetBool("BinaryMeshFormat", binary)
+        try:
+            self.document.saveAs(fcstd_file)
+        finally:
+            param.SetBool("BinaryMeshFormat", old_binary)
+        with zipfile.ZipFile(fcstd_file) as archive:
+            self.assertIn("FemMesh.bin" if binary else "FemMesh.unv", archive.namelist())
+
+        FreeCAD.closeDocument(self.document.Name)
+        self.document = FreeCAD.openDocument(fcstd_file)
+        restored = self.document.getObject("Mesh").FemMesh
+
+        self.assertEqual(restored.NodeCount, fm.NodeCount)
+        self.assertEqual(restored.Nodes, fm.Nodes)
+        self.assertEqual(restored.Volumes, fm.Volumes)
+        self.assertEqual(
+            [restored.getElementNodes(e) for e in restored.Volumes],
+            [fm.getElementNodes(e) for e in fm.Volumes],
+        )
+        if not binary:
+            return
+        self.assertEqual(
+            [(restored.getGroupName(g), restored.getGroupElements(g)) for g in restored.Groups],
+            [(fm.getGroupName(g), fm.getGroupElements(g)) for g in fm.Groups],
+        )
+
     def test_group_vtk_handling(self):
         """
         See if groups can be exported and imported correctly to and from vtk files
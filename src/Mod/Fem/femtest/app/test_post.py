@@ -0,0 +1,117 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+# SPDX-FileNotice: Part of the FreeCAD project.
+
+################################################################################
+#                                                                              #
+#   FreeCAD is free software: you can redistribute it and/or modify            #
+#   it under the terms of the GNU Lesser General Public License as             #
+#   published by the Free Software Foundation, either version 2.1              #
+#   of the License, or (at your option) any later version.                     #
+#                                                                              #
+#   FreeCAD is distributed in the hope that it will be useful,                 #
+#   but WITHOUT ANY WARRANTY; without even the implied warranty                #
+#   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                    #
+#   See the GNU Lesser General Public License for more details.                #
+#                                                                              #
+#   You should have received a copy of the GNU Lesser General Public           #
+#   License along with FreeCAD. If not, see https://www.gnu.org/licenses       #
+#                                                                              #
+################################################################################
+
+__title__ = "Post processing FEM unit tests"
+__url__ = "https://www.freecad.org"
+
+import unittest
+
+import FreeCAD
+
+from .support_utils import fcc_print
+
+
+@unittest.skipIf(
+    "BUILD_FEM_VTK_PYTHON" not in FreeCAD.__cmake__, "VTK python wrapper not available"
+)
+class TestPostFrameCache(unittest.TestCase):
+    fcc_print("import TestPostFrameCache")
+
+    # ********************************************************************************************
+    def setUp(self):
+        # setUp is executed before every test
+        self.document = FreeCAD.newDocument(self.__class__.__name__)
+
+    # ********************************************************************************************
+    def tearDown(self):
+        # tearDown is executed after every test
+        FreeCAD.closeDocument(self.document.Name)
+
+    # ********************************************************************************************
+    def test_00print(self):
+        # since method name starts with 00 this will be run first
+        # this test just prints a line with stars
+        fcc_print(
+            "\n{0}\n{1} run FEM TestPostFrameCache tests {2}\n{0}".format(
+                100 * "*", 10 * "*", 56 * "*"
+            )
+        )
+
+    # ********************************************************************************************
+    def create_frames(self, times):
+        from vtkmodules.vtkCommonCore import vtkFloatArray, vtkPoints, vtkStringArray
+        from vtkmodules.vtkCommonDataModel import vtkMultiBlockDataSet, vtkUnstructuredGrid
+
+        time_info = vtkStringArray()
+        time_info.SetName("TimeInfo")
+        time_info.InsertNextValue("Time")
+        time_info.InsertNextValue("")
+
+        multiblock = vtkMultiBlockDataSet()
+        multiblock.GetFieldData().AddArray(time_info)
+        for i, time in enumerate(times):
+            points = vtkPoints()
+            points.InsertNextPoint(time, 0.0, 0.0)
+            grid = vtkUnstructuredGrid()
+            grid.SetPoints(points)
+            time_value = vtkFloatArray()
+            time_value.SetName("TimeValue")
+            time_value.InsertNextValue(time)
+            grid.GetFieldData().AddArray(time_value)
+            grid.GetFieldData().AddArray(time_info)
+            multiblock.SetBlock(i, grid)
+        return multiblock
+
+    # ********************************************************************************************
+    def test_frame_cache(self):
+        from vtkmodules.vtkFiltersProgrammable import vtkProgrammableFilter
+
+        pipeline = self.document.addObject("Fem::FemPostPipeline", "Pipeline")
+        pipeline.Data = self.create_frames([1.0, 2.0])
+
+        # a filter that counts how often it is executed
+        executions = []
+        counting = vtkProgrammableFilter()
+
+        def execute():
+            executions.append(counting.GetInput().GetPoint(0)[0])
+            counting.GetOutput().ShallowCopy(counting.GetInput())
+
+        counting.SetExecuteMethod(execute)
+        post_filter = self.document.addObject("Fem::PostFilterPython", "Counting")
+        post_filter.addFilterPipeline("Counting", counting, counting)
+        post_filter.setActiveFilterPipeline("Counting")
+        pipeline.addObject(post_filter)
+
+        # switching from frame A to B and back to A only executes the filter for A and B
+        for frame in (0, 1, 0):
+            pipeline.Frame = frame
+            self.document.recompute()
+        self.assertEqual(executions, [1.0, 2.0])
+        self.assertEqual(post_filter.Data.GetPoint(0)[0], 1.0)
+
+        # a modified pipeline drops the cached frames
+        pipeline.Placement = FreeCAD.Placement(FreeCAD.Vector(0, 0, 1), FreeCAD.Rotation())
+        self.document.recompute()
+        self.assertEqual(executions, [1.0, 2.0, 1.0])
+
+        pipeline.Frame = 1
+        self.document.recompute()
+        self.assertEqual(executions, [1.0, 2.0, 1.0, 2.0])
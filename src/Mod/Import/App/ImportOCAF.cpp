@@ -48,6 +48,7 @@
 
 #include <App/Application.h>
 #include <App/Document.h>
+#include <App/Link.h>
 #include <Base/Console.h>
 #include <Base/Parameter.h>
 #include <Mod/Part/App/FeatureCompound.h>
@@ -109,8 +110,10 @@ void ImportOCAF::loadShapes()
 {
     std::vector<App::DocumentObject*> lValue;
     myRefShapes.clear();
+    myPrototypes.clear();
     loadShapes(pDoc->Main(), TopLoc_Location(), default_name, "", false, lValue);
     lValue.clear();
+    myPrototypes.clear();
 }
 
 void ImportOCAF::setMerge(bool merge)
@@ -118,6 +121,11 @@ void ImportOCAF::setMerge(bool merge)
     this->merge = merge;
 }
 
+void ImportOCAF::setLinkDuplicates(bool link)
+{
+    this->linkDuplicates = link;
+}
+
 void ImportOCAF::loadShapes(
     const TDF_Label& label,
     const TopLoc_Location& loc,
@@ -331,20 +339,10 @@ void ImportOCAF::createShape(
             // Ok we got a Compound which is computed
             // Just need to add it to a Part::Feature and push it to lValue
             if (!comp.IsNull() && (ctSolids || ctShells || ctEdges || ctVertices)) {
-                Part::Feature* part = doc->addObject<Part::Feature>();
-                // Let's allocate the relative placement of the Compound from the STEP file
-                tryPlacementFromLoc(part, loc);
-                if (!loc.IsIdentity()) {
-                    part->Shape.setValue(comp.Moved(loc));
-                }
-                else {
-                    part->Shape.setValue(comp);
-                }
-
-                part->Label.setValue(name);
-                lValue.push_back(part);
-
-                loadColors(part, aShape);
+                // The relative placement of the Compound from the STEP file becomes the
+                // placement of the part
+                TopoDS_Shape shape = loc.IsIdentity() ? comp : comp.Moved(loc);
+                lValue.push_back(createPart(shape, aShape, name));
             }
         }
         else {
@@ -383,32 +381,66 @@ void ImportOCAF::createShape(
     std::vector<App::DocumentObject*>& lvalue
 )
 {
-    Part::Feature* part = doc->addObject<Part::Feature>();
+    lvalue.push_back(createPart(loc.IsIdentity() ? aShape : aShape.Moved(loc), aShape, name));
+}
 
-    if (!loc.IsIdentity()) {
-        part->Shape.setValue(aShape.Moved(loc));
-    }
-    else {
-        part->Shape.setValue(aShape);
+App::DocumentObject* ImportOCAF::createPart(
+    const TopoDS_Shape& shape,
+    const TopoDS_Shape& colorShape,
+    const std::string& name
+)
+{
+    // If enabled, parts with the same geometry and colors as an earlier part, e.g. the many
+    // occurrences of a screw, link to the earlier part instead of keeping a copy of the shape
+    PartColors colors = getColors(colorShape);
+    std::optional<ShapeSignature> signature;
+    if (linkDuplicates) {
+        signature.emplace(shape);
+        auto range = myPrototypes.equal_range(signature->hash());
+        for (auto it = range.first; it != range.second; ++it) {
+            const Prototype& prototype = it->second;
+            if (prototype.colors == colors && prototype.signature.isSame(*signature)) {
+                auto link = doc->addObject<App::Link>("Link");
+                link->setLink(-1, prototype.feature);
+                link->Placement.setValue(
+                    Base::Placement(Part::TopoShape::convert(shape.Location().Transformation()))
+                );
+                link->Label.setValue(name);
+                return link;
+            }
+        }
     }
 
+    Part::Feature* part = doc->addObject<Part::Feature>();
+    part->Shape.setValue(shape);
     part->Label.setValue(name);
-    lvalue.push_back(part);
+    applyPartColors(part, colors);
+    if (signature) {
+        myPrototypes.emplace(signature->hash(), Prototype {*signature, colors, part});
+    }
+    return part;
+}
 
-    loadColors(part, aShape);
+void ImportOCAF::applyPartColors(Part::Feature* part, const PartColors& colors)
+{
+    if (colors.color) {
+        applyColors(part, {*colors.color});
+    }
+    if (!colors.faceColors.empty()) {
+        applyColors(part, colors.faceColors);
+    }
 }
 
-void ImportOCAF::loadColors(Part::Feature* part, const TopoDS_Shape& aShape)
+ImportOCAF::PartColors ImportOCAF::getColors(const TopoDS_Shape& aShape) const
 {
+    PartColors colors;
     Quantity_ColorRGBA aColor;
     Base::Color color(0.8f, 0.8f, 0.8f);
     if (aColorTool->GetColor(aShape, XCAFDoc_ColorGen, aColor)
         || aColorTool->GetColor(aShape, XCAFDoc_ColorSurf, aColor)
         || aColorTool->GetColor(aShape, XCAFDoc_ColorCurv, aColor)) {
         color = Tools::convertColor(aColor);
-        std::vector<Base::Color> colors;
-        colors.push_back(color);
-        applyColors(part, colors);
+        colors.color = color;
     }
 
     TopTools_IndexedMapOfShape faces;
@@ -435,8 +467,9 @@ void ImportOCAF::loadColors(Part::Feature* part, const TopoDS_Shape& aShape)
     }
 
     if (found_face_color) {
-        applyColors(part, faceColors);
+        colors.faceColors = std::move(faceColors);
     }
+    return colors;
 }
 
 // ----------------------------------------------------------------------------
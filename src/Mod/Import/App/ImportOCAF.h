@@ -25,6 +25,7 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -39,6 +40,8 @@
 #include <App/Part.h>
 #include <Mod/Import/ImportGlobal.h>
 
+#include "Tools.h"
+
 
 class TDF_Label;
 class TopLoc_Location;
@@ -63,6 +66,8 @@ public:
     virtual ~ImportOCAF();
     void loadShapes();
     void setMerge(bool);
+    /// Lets later parts with the same geometry and colors link to the first one
+    void setLinkDuplicates(bool);
 
 private:
     void loadShapes(
@@ -86,7 +91,27 @@ private:
         const std::string&,
         std::vector<App::DocumentObject*>&
     );
-    void loadColors(Part::Feature* part, const TopoDS_Shape& aShape);
+    /// The colors of a part in the XCAF document
+    struct PartColors
+    {
+        std::optional<Base::Color> color;
+        std::vector<Base::Color> faceColors;
+        bool operator==(const PartColors&) const = default;
+    };
+    /// The first part of a geometry that the later parts with the same colors link to
+    struct Prototype
+    {
+        ShapeSignature signature;
+        PartColors colors;
+        Part::Feature* feature;
+    };
+    App::DocumentObject* createPart(
+        const TopoDS_Shape& shape,
+        const TopoDS_Shape& colorShape,
+        const std::string& name
+    );
+    PartColors getColors(const TopoDS_Shape& aShape) const;
+    void applyPartColors(Part::Feature* part, const PartColors& colors);
     virtual void applyColors(Part::Feature*, const std::vector<Base::Color>&)
     {}
     static void tryPlacementFromLoc(App::GeoFeature*, const TopLoc_Location&);
@@ -98,8 +123,10 @@ private:
     Handle(XCAFDoc_ShapeTool) aShapeTool;
     Handle(XCAFDoc_ColorTool) aColorTool;
     bool merge {true};
+    bool linkDuplicates {false};
     std::string default_name;
     std::set<int> myRefShapes;
+    std::unordered_multimap<std::size_t, Prototype> myPrototypes;
 };
 
 class ImportExport ImportOCAFCmd: public ImportOCAF
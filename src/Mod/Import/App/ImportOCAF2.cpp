@@ -25,10 +25,19 @@
 #if defined(__MINGW32__)
 # define WNT  // avoid conflict with GUID
 #endif
+#include <algorithm>
+#include <unordered_set>
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <IMeshTools_Parameters.hxx>
 #include <Interface_Static.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
 #include <Quantity_ColorRGBA.hxx>
 #include <Standard_Failure.hxx>
 #include <Standard_Version.hxx>
+#include <gp.hxx>
 #include <TDF_AttributeSequence.hxx>
 #include <TDF_Label.hxx>
 #include <TDF_LabelSequence.hxx>
@@ -52,9 +61,12 @@
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
 #include <Base/Parameter.h>
+#include <Base/Tools.h>
 #include <Mod/Part/App/FeatureCompound.h>
 #include <Mod/Part/App/Interface.h>
 #include <Mod/Part/App/OCAF/ImportExportSettings.h>
+#include <Mod/Part/App/TessellationCache.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "ImportOCAF2.h"
 
@@ -105,6 +117,7 @@ ImportOCAFOptions ImportOCAF2::customImportOptions()
     defaultOptions.reduceObjects = settings.getReduceObjects();
     defaultOptions.showProgress = settings.getShowProgress();
     defaultOptions.expandCompound = settings.getExpandCompound();
+    defaultOptions.linkDuplicates = settings.getLinkDuplicates();
     defaultOptions.mode = static_cast<int>(settings.getImportMode());
 
     auto hGrp = App::GetApplication().GetParameterGroupByPath(
@@ -120,6 +133,17 @@ ImportOCAFOptions ImportOCAF2::customImportOptions()
     );
     defaultOptions.defaultEdgeColor.a = 1.0F;
 
+    // the display parameters of Part::ViewProviderPartExt
+    auto hPart = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part"
+    );
+    defaultOptions.meshDeviation = static_cast<float>(
+        hPart->GetFloat("MeshDeviation", defaultOptions.meshDeviation)
+    );
+    defaultOptions.meshAngularDeflection = static_cast<float>(
+        hPart->GetFloat("MeshAngularDeflection", defaultOptions.meshAngularDeflection)
+    );
+
     return defaultOptions;
 }
 
@@ -293,81 +317,24 @@ bool ImportOCAF2::createObject(
     }
 
     getColor(shape, info);
-    bool hasFaceColors = false;
-    bool hasEdgeColors = false;
 
     Part::TopoShape tshape(shape);
-    std::vector<Base::Color> faceColors;
-    std::vector<Base::Color> edgeColors;
-
-    TDF_LabelSequence seq;
-    if (!label.IsNull() && aShapeTool->GetSubShapes(label, seq)) {
-
-        TopTools_IndexedMapOfShape faceMap, edgeMap;
-        TopExp::MapShapes(tshape.getShape(), TopAbs_FACE, faceMap);
-        TopExp::MapShapes(tshape.getShape(), TopAbs_EDGE, edgeMap);
-
-        faceColors.assign(faceMap.Extent(), info.faceColor);
-        edgeColors.assign(edgeMap.Extent(), info.edgeColor);
-        // Two passes to get sub shape colors. First pass, look for solid, and
-        // second pass look for face and edges. This allows lower level
-        // subshape to override color of higher level ones.
-        for (int j = 0; j < 2; ++j) {
-            for (int i = 1; i <= seq.Length(); ++i) {
-                TDF_Label l = seq.Value(i);
-                TopoDS_Shape subShape = aShapeTool->GetShape(l);
-                if (subShape.IsNull()) {
-                    continue;
-                }
-                if (subShape.ShapeType() == TopAbs_FACE || subShape.ShapeType() == TopAbs_EDGE) {
-                    if (j == 0) {
-                        continue;
-                    }
-                }
-                else if (j != 0) {
-                    continue;
-                }
-
-                bool foundFaceColor = false, foundEdgeColor = false;
-                Base::Color faceColor, edgeColor;
-                Quantity_ColorRGBA aColor;
-                if (aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor)
-                    || aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor)) {
-                    faceColor = Tools::convertColor(aColor);
-                    foundFaceColor = true;
-                }
-                if (aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
-                    edgeColor = Tools::convertColor(aColor);
-                    foundEdgeColor = true;
-                    if (j == 0 && foundFaceColor && !faceColors.empty() && edgeColor == faceColor) {
-                        // Do not set edge the same color as face
-                        foundEdgeColor = false;
-                    }
-                }
-
-                if (foundFaceColor) {
-                    for (TopExp_Explorer exp(subShape, TopAbs_FACE); exp.More(); exp.Next()) {
-                        int idx = faceMap.FindIndex(exp.Current()) - 1;
-                        if (idx >= 0 && idx < (int)faceColors.size()) {
-                            faceColors[idx] = faceColor;
-                            hasFaceColors = true;
-                            info.hasFaceColor = true;
-                        }
-                    }
-                }
-                if (foundEdgeColor) {
-                    for (TopExp_Explorer exp(subShape, TopAbs_EDGE); exp.More(); exp.Next()) {
-                        int idx = edgeMap.FindIndex(exp.Current()) - 1;
-                        if (idx >= 0 && idx < (int)edgeColors.size()) {
-                            edgeColors[idx] = edgeColor;
-                            hasEdgeColors = true;
-                            info.hasEdgeColor = true;
-                        }
-                    }
-                }
-            }
-        }
+    ElementColors colors;
+    auto prepared = myPreparedShapes.find(shape);
+    if (prepared != myPreparedShapes.end()) {
+        colors = std::move(prepared->second);
+        myPreparedShapes.erase(prepared);
+    }
+    else if (!label.IsNull()) {
+        colors = getElementColors(shape, info, getSubShapeColors(label));
     }
+    if (colors.hasFaceColors) {
+        info.hasFaceColor = true;
+    }
+    if (colors.hasEdgeColors) {
+        info.hasEdgeColor = true;
+    }
+    info.hasElementColors = colors.hasFaceColors || colors.hasEdgeColors;
 
     Part::Feature* feature;
 
@@ -387,11 +354,11 @@ bool ImportOCAF2::createObject(
     }
     applyFaceColors(feature, {info.faceColor});
     applyEdgeColors(feature, {info.edgeColor});
-    if (hasFaceColors) {
-        applyFaceColors(feature, faceColors);
+    if (colors.hasFaceColors) {
+        applyFaceColors(feature, colors.faceColors);
     }
-    if (hasEdgeColors) {
-        applyEdgeColors(feature, edgeColors);
+    if (colors.hasEdgeColors) {
+        applyEdgeColors(feature, colors.edgeColors);
     }
 
     info.propPlacement = &feature->Placement;
@@ -504,11 +471,264 @@ bool ImportOCAF2::createGroup(
     return true;
 }
 
+std::vector<ImportOCAF2::SubShapeColor> ImportOCAF2::getSubShapeColors(TDF_Label label) const
+{
+    std::vector<SubShapeColor> subShapeColors;
+    TDF_LabelSequence seq;
+    if (label.IsNull() || !aShapeTool->GetSubShapes(label, seq)) {
+        return subShapeColors;
+    }
+
+    for (int i = 1; i <= seq.Length(); ++i) {
+        TDF_Label l = seq.Value(i);
+        SubShapeColor subShapeColor;
+        subShapeColor.shape = aShapeTool->GetShape(l);
+        if (subShapeColor.shape.IsNull()) {
+            continue;
+        }
+        Quantity_ColorRGBA aColor;
+        if (aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor)
+            || aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor)) {
+            subShapeColor.faceColor = Tools::convertColor(aColor);
+        }
+        if (aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
+            subShapeColor.edgeColor = Tools::convertColor(aColor);
+        }
+        subShapeColors.push_back(subShapeColor);
+    }
+    return subShapeColors;
+}
+
+ImportOCAF2::ElementColors ImportOCAF2::getElementColors(
+    const TopoDS_Shape& shape,
+    const Info& info,
+    const std::vector<SubShapeColor>& subShapeColors
+)
+{
+    ElementColors colors;
+    if (subShapeColors.empty()) {
+        return colors;
+    }
+
+    TopTools_IndexedMapOfShape faceMap, edgeMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+
+    colors.faceColors.assign(faceMap.Extent(), info.faceColor);
+    colors.edgeColors.assign(edgeMap.Extent(), info.edgeColor);
+    // Two passes to get sub shape colors. First pass, look for solid, and
+    // second pass look for face and edges. This allows lower level
+    // subshape to override color of higher level ones.
+    for (int j = 0; j < 2; ++j) {
+        for (const auto& subShapeColor : subShapeColors) {
+            const TopoDS_Shape& subShape = subShapeColor.shape;
+            if (subShape.ShapeType() == TopAbs_FACE || subShape.ShapeType() == TopAbs_EDGE) {
+                if (j == 0) {
+                    continue;
+                }
+            }
+            else if (j != 0) {
+                continue;
+            }
+
+            const auto& faceColor = subShapeColor.faceColor;
+            bool foundEdgeColor = subShapeColor.edgeColor.has_value();
+            if (j == 0 && faceColor && !colors.faceColors.empty()
+                && subShapeColor.edgeColor == faceColor) {
+                // Do not set edge the same color as face
+                foundEdgeColor = false;
+            }
+
+            if (faceColor) {
+                for (TopExp_Explorer exp(subShape, TopAbs_FACE); exp.More(); exp.Next()) {
+                    int idx = faceMap.FindIndex(exp.Current()) - 1;
+                    if (idx >= 0 && idx < (int)colors.faceColors.size()) {
+                        colors.faceColors[idx] = *faceColor;
+                        colors.hasFaceColors = true;
+                    }
+                }
+            }
+            if (foundEdgeColor) {
+                for (TopExp_Explorer exp(subShape, TopAbs_EDGE); exp.More(); exp.Next()) {
+                    int idx = edgeMap.FindIndex(exp.Current()) - 1;
+                    if (idx >= 0 && idx < (int)colors.edgeColors.size()) {
+                        colors.edgeColors[idx] = *subShapeColor.edgeColor;
+                        colors.hasEdgeColors = true;
+                    }
+                }
+            }
+        }
+    }
+    return colors;
+}
+
+void ImportOCAF2::prepareShapes()
+{
+    myPreparedShapes.clear();
+    // otherwise createObject() gets the colors of each part one by one
+    if (!options.prepareInParallel) {
+        return;
+    }
+
+    struct PreparedShape
+    {
+        TopoDS_Shape shape;
+        Info info;
+        std::vector<SubShapeColor> subShapeColors;
+        ElementColors colors;
+        std::vector<const TopoDS_TShape*> faces;
+        bool failed = false;
+    };
+
+    // Reading the XCAF document is not thread-safe, so the colors of the labels are collected
+    // first. Only parts are prepared, the objects of assemblies are cheap to create.
+    std::vector<PreparedShape> shapes;
+    std::unordered_set<TopoDS_Shape, ShapeHasher> baseShapes;
+    TDF_LabelSequence labels;
+    aShapeTool->GetShapes(labels);
+    for (Standard_Integer i = 1; i <= labels.Length(); i++) {
+        auto shape = aShapeTool->GetShape(labels.Value(i));
+        if (shape.IsNull() || !TopExp_Explorer(shape, TopAbs_VERTEX).More()) {
+            continue;
+        }
+        // the same label is used as in loadShape()
+        auto baseShape = shape.Located(TopLoc_Location());
+        auto baseLabel = aShapeTool->FindShape(baseShape);
+        if (baseLabel.IsNull() || aShapeTool->IsAssembly(baseLabel)
+            || !baseShapes.insert(baseShape).second) {
+            continue;
+        }
+        PreparedShape prepared;
+        prepared.shape = baseShape;
+        getColor(baseShape, prepared.info);
+        prepared.subShapeColors = getSubShapeColors(baseLabel);
+        shapes.push_back(std::move(prepared));
+    }
+    if (shapes.empty()) {
+        return;
+    }
+
+    // The expanded or merged shapes are displayed with other mesh parameters
+    bool tessellate = options.tessellate && !options.expandCompound && !options.merge;
+
+    OSD_Parallel::For(0, static_cast<int>(shapes.size()), [&](int i) {
+        auto& prepared = shapes[i];
+        try {
+            prepared.colors
+                = getElementColors(prepared.shape, prepared.info, prepared.subShapeColors);
+            if (tessellate) {
+                TopTools_IndexedMapOfShape faceMap;
+                TopExp::MapShapes(prepared.shape, TopAbs_FACE, faceMap);
+                for (int j = 1; j <= faceMap.Extent(); ++j) {
+                    prepared.faces.push_back(faceMap(j).TShape().get());
+                }
+            }
+        }
+        catch (const Standard_Failure&) {
+            prepared.failed = true;
+        }
+    });
+
+    for (auto& prepared : shapes) {
+        if (!prepared.failed) {
+            myPreparedShapes.emplace(prepared.shape, std::move(prepared.colors));
+        }
+    }
+    if (!tessellate) {
+        return;
+    }
+
+    // Meshing stores the triangulation in the faces, so parts that share faces with other parts
+    // are left to the view providers
+    std::unordered_map<const TopoDS_TShape*, int> faceCount;
+    for (const auto& prepared : shapes) {
+        for (auto face : prepared.faces) {
+            ++faceCount[face];
+        }
+    }
+    std::vector<TopoDS_Shape> meshShapes;
+    for (const auto& prepared : shapes) {
+        bool shared = std::any_of(prepared.faces.begin(), prepared.faces.end(), [&](auto face) {
+            return faceCount[face] > 1;
+        });
+        if (!prepared.failed && !prepared.faces.empty() && !shared) {
+            meshShapes.push_back(prepared.shape);
+        }
+    }
+
+    // Use the same parameters as Part::ViewProviderPartExt so that it can reuse the triangulation
+    double angularDeflection = Base::toRadians(options.meshAngularDeflection);
+    OSD_Parallel::For(0, static_cast<int>(meshShapes.size()), [&](int i) {
+        const TopoDS_Shape& shape = meshShapes[i];
+        try {
+            Standard_Real deflection = Part::Tools::getDeflection(shape, options.meshDeviation);
+            if (deflection < gp::Resolution()) {
+                deflection = Precision::Confusion();
+            }
+            IMeshTools_Parameters meshParams;
+            meshParams.Deflection = deflection;
+            meshParams.Relative = Standard_False;
+            meshParams.Angle = angularDeflection;
+#if OCC_VERSION_HEX < 0x070600
+            BRepTools::Clean(shape);
+#else
+            BRepTools::Clean(shape, Standard_True);
+#endif
+            BRepMesh_IncrementalMesh(shape, meshParams);
+            Part::TessellationCache::instance().add(shape, {deflection, angularDeflection});
+        }
+        catch (const Standard_Failure&) {
+            // the view provider meshes it again
+        }
+    });
+}
+
+const ImportOCAF2::Info* ImportOCAF2::findPrototype(
+    TDF_Label label,
+    const TopoDS_Shape& shape,
+    const ShapeSignature& signature
+)
+{
+    auto range = myPrototypes.equal_range(signature.hash());
+    if (range.first == range.second) {
+        return nullptr;
+    }
+
+    Info info;
+    getColor(shape, info);
+    auto prepared = myPreparedShapes.find(shape);
+    if (prepared != myPreparedShapes.end()) {
+        if (prepared->second.hasFaceColors || prepared->second.hasEdgeColors) {
+            return nullptr;
+        }
+    }
+    else if (!label.IsNull()) {
+        auto colors = getElementColors(shape, info, getSubShapeColors(label));
+        if (colors.hasFaceColors || colors.hasEdgeColors) {
+            return nullptr;
+        }
+    }
+
+    for (auto it = range.first; it != range.second; ++it) {
+        auto found = myShapes.find(it->second.shape);
+        if (found == myShapes.end()) {
+            continue;
+        }
+        const Info& prototype = found->second;
+        if (prototype.faceColor == info.faceColor && prototype.edgeColor == info.edgeColor
+            && it->second.signature.isSame(signature)) {
+            return &prototype;
+        }
+    }
+    return nullptr;
+}
+
 App::DocumentObject* ImportOCAF2::loadShapes()
 {
     if (!options.useLinkGroup) {
         ImportLegacy legacy(*this);
         legacy.setMerge(options.merge);
+        legacy.setLinkDuplicates(options.linkDuplicates);
         legacy.loadShapes();
         return nullptr;
     }
@@ -527,6 +747,8 @@ App::DocumentObject* ImportOCAF2::loadShapes()
     myShapes.clear();
     myNames.clear();
     myCollapsedObjects.clear();
+    myPrototypes.clear();
+    prepareShapes();
 
     std::vector<App::DocumentObject*> objs;
     aShapeTool->GetFreeShapes(labels);
@@ -587,6 +809,8 @@ App::DocumentObject* ImportOCAF2::loadShapes()
 
     seq.stop();
     sequencer = nullptr;
+    myPreparedShapes.clear();
+    myPrototypes.clear();
     return ret;
 }
 
@@ -674,17 +898,35 @@ App::DocumentObject* ImportOCAF2::loadShape(
         if (sequencer && !baseLabel.IsNull() && aShapeTool->IsTopLevel(baseLabel)) {
             sequencer->next(true);
         }
-        bool res;
-        if (baseLabel.IsNull() || !aShapeTool->IsAssembly(baseLabel)) {
-            res = createObject(doc, baseLabel, baseShape, info, newDoc);
+        bool isAssembly = !baseLabel.IsNull() && aShapeTool->IsAssembly(baseLabel);
+        // If enabled, parts that are defined more than once in the file with the same geometry
+        // and colors share one object, like the occurrences of the same part
+        std::optional<ShapeSignature> signature;
+        const Info* prototype = nullptr;
+        if (options.linkDuplicates && !isAssembly) {
+            signature.emplace(baseShape);
+            prototype = findPrototype(baseLabel, baseShape, *signature);
         }
-        else {
-            res = createAssembly(doc, baseLabel, baseShape, info, newDoc);
+        if (prototype) {
+            info = *prototype;
+            info.free = false;
         }
-        if (!res) {
-            return nullptr;
+        else {
+            bool res;
+            if (isAssembly) {
+                res = createAssembly(doc, baseLabel, baseShape, info, newDoc);
+            }
+            else {
+                res = createObject(doc, baseLabel, baseShape, info, newDoc);
+            }
+            if (!res) {
+                return nullptr;
+            }
+            setObjectName(info, baseLabel);
+            if (signature && !info.hasElementColors) {
+                myPrototypes.emplace(signature->hash(), Prototype {*signature, baseShape});
+            }
         }
-        setObjectName(info, baseLabel);
         it = myShapes.emplace(baseShape, info).first;
     }
     if (baseOnly) {
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -72,6 +73,14 @@ struct ImportExport ImportOCAFOptions
     bool reduceObjects = false;
     bool showProgress = false;
     bool expandCompound = false;
+    /// Let the legacy importer link parts with the same geometry to the first one
+    bool linkDuplicates = false;
+    /// Prepare the colors of the parts in parallel before any object is created
+    bool prepareInParallel = true;
+    /// Mesh the parts for the display while they are prepared in parallel
+    bool tessellate = false;
+    double meshDeviation = 0.2;
+    double meshAngularDeflection = 28.65;
     int mode = 0;
 };
 
@@ -113,6 +122,18 @@ public:
     {
         options.expandCompound = enable;
     }
+    void setLinkDuplicates(bool enable)
+    {
+        options.linkDuplicates = enable;
+    }
+    void setPrepareInParallel(bool enable)
+    {
+        options.prepareInParallel = enable;
+    }
+    void setTessellate(bool enable)
+    {
+        options.tessellate = enable;
+    }
 
     enum ImportMode
     {
@@ -139,9 +160,35 @@ private:
         Base::Color edgeColor;
         bool hasFaceColor = false;
         bool hasEdgeColor = false;
+        bool hasElementColors = false;
         int free = true;
     };
 
+    /// A part that later parts with the same geometry and colors link to
+    struct Prototype
+    {
+        ShapeSignature signature;
+        /// The key of the part in myShapes
+        TopoDS_Shape shape;
+    };
+
+    /// The colors of a labeled sub-shape of a part
+    struct SubShapeColor
+    {
+        TopoDS_Shape shape;
+        std::optional<Base::Color> faceColor;
+        std::optional<Base::Color> edgeColor;
+    };
+
+    /// The colors of the faces and edges of a part
+    struct ElementColors
+    {
+        std::vector<Base::Color> faceColors;
+        std::vector<Base::Color> edgeColors;
+        bool hasFaceColors = false;
+        bool hasEdgeColors = false;
+    };
+
     App::DocumentObject* loadShape(
         App::Document* doc,
         TDF_Label label,
@@ -177,6 +224,18 @@ private:
     void setObjectName(Info& info, TDF_Label label);
     std::string getLabelName(TDF_Label label);
     App::DocumentObject* expandShape(App::Document* doc, TDF_Label label, const TopoDS_Shape& shape);
+    std::vector<SubShapeColor> getSubShapeColors(TDF_Label label) const;
+    static ElementColors getElementColors(
+        const TopoDS_Shape& shape,
+        const Info& info,
+        const std::vector<SubShapeColor>& subShapeColors
+    );
+    void prepareShapes();
+    const Info* findPrototype(
+        TDF_Label label,
+        const TopoDS_Shape& shape,
+        const ShapeSignature& signature
+    );
 
     virtual void applyEdgeColors(Part::Feature*, const std::vector<Base::Color>&)
     {}
@@ -218,6 +277,9 @@ private:
     std::unordered_map<TopoDS_Shape, Info, ShapeHasher> myShapes;
     std::unordered_map<TDF_Label, std::string, LabelHasher> myNames;
     std::unordered_map<App::DocumentObject*, App::PropertyPlacement*> myCollapsedObjects;
+    /// The element colors of the parts that have been prepared in parallel
+    std::unordered_map<TopoDS_Shape, ElementColors, ShapeHasher> myPreparedShapes;
+    std::unordered_multimap<std::size_t, Prototype> myPrototypes;
 
     Base::SequencerLauncher* sequencer {nullptr};
 };
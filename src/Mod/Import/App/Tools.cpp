@@ -23,13 +23,25 @@
  ****************************************************************************/
 
 
+#include <algorithm>
+#include <cmath>
+
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepGProp.hxx>
+#include <BRep_Tool.hxx>
+#include <GProp_GProps.hxx>
+#include <Precision.hxx>
 #include <TDataStd_Name.hxx>
 #include <TDF_ChildIterator.hxx>
 #include <TDF_Tool.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
 
 
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
 
 #include "Tools.h"
 #include <Base/Console.h>
@@ -42,6 +54,118 @@ FC_LOG_LEVEL_INIT("Import", true, true)
 
 using namespace Import;
 
+ShapeSignature::ShapeSignature(const TopoDS_Shape& shape)
+    : shape(shape.Located(TopLoc_Location()))
+{
+    // Vertices closer than the grid size may still end up in different cells, then the shapes
+    // are considered different which is safe
+    const double grid = 10 * Precision::Confusion();
+    for (auto type : {TopAbs_SOLID, TopAbs_SHELL, TopAbs_FACE, TopAbs_WIRE, TopAbs_EDGE}) {
+        TopTools_IndexedMapOfShape map;
+        TopExp::MapShapes(this->shape, type, map);
+        counts.push_back(map.Extent());
+    }
+    TopTools_IndexedMapOfShape map;
+    TopExp::MapShapes(this->shape, TopAbs_VERTEX, map);
+    vertices.reserve(map.Extent());
+    for (int i = 1; i <= map.Extent(); ++i) {
+        gp_Pnt pnt = BRep_Tool::Pnt(TopoDS::Vertex(map(i)));
+        vertices.push_back({
+            std::llround(pnt.X() / grid),
+            std::llround(pnt.Y() / grid),
+            std::llround(pnt.Z() / grid),
+        });
+    }
+    std::sort(vertices.begin(), vertices.end());
+
+    map.Clear();
+    TopExp::MapShapes(this->shape, TopAbs_FACE, map);
+    surfaceTypes.reserve(map.Extent());
+    for (int i = 1; i <= map.Extent(); ++i) {
+        BRepAdaptor_Surface surface(TopoDS::Face(map(i)), Standard_False);
+        surfaceTypes.push_back(static_cast<int>(surface.GetType()));
+    }
+    std::sort(surfaceTypes.begin(), surfaceTypes.end());
+
+    boost::hash_combine(hashValue, static_cast<int>(this->shape.ShapeType()));
+    boost::hash_range(hashValue, counts.begin(), counts.end());
+    boost::hash_range(hashValue, surfaceTypes.begin(), surfaceTypes.end());
+    for (const auto& vertex : vertices) {
+        boost::hash_range(hashValue, vertex.begin(), vertex.end());
+    }
+}
+
+bool ShapeSignature::isSame(const ShapeSignature& other) const
+{
+    if (hashValue != other.hashValue || shape.ShapeType() != other.shape.ShapeType()
+        || counts != other.counts || vertices != other.vertices
+        || surfaceTypes != other.surfaceTypes) {
+        return false;
+    }
+    if (shape.IsSame(other.shape)) {
+        return true;
+    }
+
+    auto isClose = [](double val1, double val2) {
+        double tol = 1e-6 * std::max({1.0, std::abs(val1), std::abs(val2)});
+        return std::abs(val1 - val2) <= tol;
+    };
+
+    // The vertices and face areas of e.g. a domed and a dished plate are the same, their
+    // volumes and centroids are not
+    const MassProperties& props1 = getProperties();
+    const MassProperties& props2 = other.getProperties();
+    if (!isClose(props1.volume, props2.volume)
+        || props1.centroid.Distance(props2.centroid) > 10 * Precision::Confusion()) {
+        return false;
+    }
+    for (int row = 1; row <= 3; ++row) {
+        for (int col = 1; col <= 3; ++col) {
+            if (!isClose(props1.inertia(row, col), props2.inertia(row, col))) {
+                return false;
+            }
+        }
+    }
+    for (std::size_t i = 0; i < props1.areas.size(); ++i) {
+        if (!isClose(props1.areas[i], props2.areas[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const ShapeSignature::MassProperties& ShapeSignature::getProperties() const
+{
+    if (!properties) {
+        MassProperties props;
+        GProp_GProps volume;
+        BRepGProp::VolumeProperties(shape, volume);
+        props.volume = volume.Mass();
+        if (std::abs(props.volume) > Precision::Confusion()) {
+            props.centroid = volume.CentreOfMass();
+            props.inertia = volume.MatrixOfInertia();
+        }
+        else {
+            GProp_GProps surface;
+            BRepGProp::SurfaceProperties(shape, surface);
+            props.centroid = surface.CentreOfMass();
+            props.inertia = surface.MatrixOfInertia();
+        }
+
+        TopTools_IndexedMapOfShape map;
+        TopExp::MapShapes(shape, TopAbs_FACE, map);
+        props.areas.reserve(map.Extent());
+        for (int i = 1; i <= map.Extent(); ++i) {
+            GProp_GProps face;
+            BRepGProp::SurfaceProperties(map(i), face);
+            props.areas.push_back(face.Mass());
+        }
+        std::sort(props.areas.begin(), props.areas.end());
+        properties = std::move(props);
+    }
+    return *properties;
+}
+
 Base::Color Tools::convertColor(const Quantity_ColorRGBA& rgba)
 {
     Standard_Real red, green, blue;
@@ -24,8 +24,13 @@
 
 #pragma once
 
+#include <array>
 #include <limits>
+#include <optional>
+#include <vector>
 
+#include <gp_Mat.hxx>
+#include <gp_Pnt.hxx>
 #include <Quantity_ColorRGBA.hxx>
 #include <TopoDS_Shape.hxx>
 #include <XCAFDoc_ColorTool.hxx>
@@ -61,6 +66,49 @@ struct LabelHasher
     }
 };
 
+/** The geometry of a shape without its own location.
+ * Parts that are defined more than once in a file with the same geometry get the same signature,
+ * so that their occurrences can share one object.
+ */
+class ShapeSignature
+{
+public:
+    explicit ShapeSignature(const TopoDS_Shape& shape);
+
+    std::size_t hash() const
+    {
+        return hashValue;
+    }
+    /** Returns true if both shapes have the same number of sub-shapes of each type, the same
+     * vertices, the same surface types, the same face areas and the same mass properties.
+     * The face areas and mass properties are only computed when needed.
+     */
+    bool isSame(const ShapeSignature& other) const;
+
+private:
+    struct MassProperties
+    {
+        /// The signed volume, zero if the shape has no solids
+        double volume {0.0};
+        /// The centroid and the inertia of the volume or, without volume, of the surface
+        gp_Pnt centroid;
+        gp_Mat inertia;
+        /// The face areas, sorted
+        std::vector<double> areas;
+    };
+    const MassProperties& getProperties() const;
+
+private:
+    TopoDS_Shape shape;
+    std::vector<int> counts;
+    /// The coordinates of the vertices on a fine grid, sorted
+    std::vector<std::array<long long, 3>> vertices;
+    /// The surface types of the faces, sorted
+    std::vector<int> surfaceTypes;
+    mutable std::optional<MassProperties> properties;
+    std::size_t hashValue {0};
+};
+
 struct Tools
 {
     static Base::Color convertColor(const Quantity_ColorRGBA& rgba);
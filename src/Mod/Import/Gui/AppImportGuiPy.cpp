@@ -240,6 +240,8 @@ private:
             hApp->NewDocument(TCollection_ExtendedString("MDTV-CAF"), hDoc);
             ImportOCAFGui ocaf(hDoc, pcDoc, file.fileNamePure());
             ocaf.setImportOptions(ImportOCAFGui::customImportOptions());
+            // the parts are displayed right after the import
+            ocaf.setTessellate(true);
 
             Base::TimeTracker tracker("Import Step");
 
@@ -292,6 +294,16 @@ private:
                             static_cast<bool>(Py::Boolean(options.getItem("expandCompound")))
                         );
                     }
+                    if (options.hasKey("linkDuplicates")) {
+                        ocaf.setLinkDuplicates(
+                            static_cast<bool>(Py::Boolean(options.getItem("linkDuplicates")))
+                        );
+                    }
+                    if (options.hasKey("prepareInParallel")) {
+                        ocaf.setPrepareInParallel(
+                            static_cast<bool>(Py::Boolean(options.getItem("prepareInParallel")))
+                        );
+                    }
                     if (options.hasKey("mode")) {
                         ocaf.setMode(static_cast<int>(Py::Long(options.getItem("mode"))));
                     }
@@ -26,9 +26,26 @@ import tempfile
 import unittest
 import FreeCAD as App
 import ImportGui
+import Part
 from pivy import coin
 
 
+def makePlate(bulge):
+    """
+    Make a plate whose right side bulges out by bulge. The vertices don't depend on bulge.
+    """
+    V = App.Vector
+    edges = [
+        Part.LineSegment(V(0, 0, 0), V(10, 0, 0)).toShape(),
+        Part.LineSegment(V(10, 0, 0), V(10, 10, 0)).toShape()
+        if bulge == 0
+        else Part.Arc(V(10, 0, 0), V(10 + bulge, 5, 0), V(10, 10, 0)).toShape(),
+        Part.LineSegment(V(10, 10, 0), V(0, 10, 0)).toShape(),
+        Part.LineSegment(V(0, 10, 0), V(0, 0, 0)).toShape(),
+    ]
+    return Part.Face(Part.Wire(edges)).extrude(V(0, 0, 2))
+
+
 class ExportImportTest(unittest.TestCase):
     def setUp(self):
         TempPath = tempfile.gettempdir()
@@ -91,3 +108,90 @@ class ExportImportTest(unittest.TestCase):
 
         mat = paths.get(1).getTail()
         self.assertEqual(mat.diffuseColor.getNum(), 6)
+
+    def exportPlates(self):
+        """
+        Export two plates with the same geometry and two with the same vertices but different
+        geometry as separate products
+        """
+        part = self.doc.addObject("App::Part", "Part")
+        for i, (name, bulge) in enumerate(
+            [("PlateA", 2), ("PlateB", 2), ("PlateC", -2), ("PlateD", 0)]
+        ):
+            plate = part.newObject("Part::Feature", name)
+            plate.Label = name
+            plate.Shape = makePlate(bulge)
+            plate.Placement.Base = App.Vector(20 * i, 0, 0)
+        self.doc.recompute()
+
+        ImportGui.export([part], self.fileName)
+        self.doc.clearDocument()
+
+    def importPlates(self, linkDuplicates):
+        options = {"merge": False, "useLinkGroup": True, "linkDuplicates": linkDuplicates}
+        ImportGui.insert(name=self.fileName, docName=self.doc.Name, options=options)
+        return list(filter(lambda x: x.isDerivedFrom("Part::Feature"), self.doc.Objects))
+
+    def testImportDuplicatesSeparately(self):
+        """
+        By default each product gets an object of its own with its name
+        """
+        self.exportPlates()
+        features = self.importPlates(False)
+
+        self.assertEqual(len(features), 4)
+        labels = [feature.Label for feature in features]
+        for name in ["PlateA", "PlateB", "PlateC", "PlateD"]:
+            self.assertIn(name, labels)
+
+    def testLinkDuplicates(self):
+        """
+        Only the products with the same geometry share an object
+        """
+        self.exportPlates()
+        features = self.importPlates(True)
+
+        self.assertEqual(len(features), 3)
+        volumes = sorted(feature.Shape.Volume for feature in features)
+        expected = sorted(makePlate(bulge).Volume for bulge in [2, -2, 0])
+        for volume, other in zip(volumes, expected):
+            self.assertAlmostEqual(volume, other, places=6)
+
+        # the second of the equal plates links to the object of the first one
+        links = list(filter(lambda x: x.isDerivedFrom("App::Link"), self.doc.Objects))
+        self.assertTrue(any(link.LinkedObject in features for link in links))
+
+    def importColors(self, prepareInParallel):
+        options = {"merge": False, "useLinkGroup": True, "prepareInParallel": prepareInParallel}
+        ImportGui.insert(name=self.fileName, docName=self.doc.Name, options=options)
+        features = filter(lambda x: x.isDerivedFrom("Part::Feature"), self.doc.Objects)
+        colors = {
+            feature.Label: (feature.ViewObject.DiffuseColor, feature.ViewObject.LineColorArray)
+            for feature in features
+        }
+        self.doc.clearDocument()
+        return colors
+
+    def testParallelImportColors(self):
+        """
+        The element colors of parts prepared in parallel match the ones of the serial import
+        """
+        part = self.doc.addObject("App::Part", "Part")
+        for i in range(4):
+            box = part.newObject("Part::Box", "Box{}".format(i))
+            box.Label = "Box{}".format(i)
+            box.Placement.Base = App.Vector(20 * i, 0, 0)
+            self.doc.recompute()
+            box.ViewObject.DiffuseColor = [
+                (1.0, 0.1 * (i + face), 0.0, 1.0) for face in range(len(box.Shape.Faces))
+            ]
+        ImportGui.export([part], self.fileName)
+        self.doc.clearDocument()
+
+        serial = self.importColors(False)
+        parallel = self.importColors(True)
+
+        self.assertEqual(len(parallel), 4)
+        self.assertEqual(parallel, serial)
+        self.assertEqual(len(parallel["Box2"][0]), 6)
+        self.assertNotEqual(parallel["Box2"][0][0], parallel["Box2"][0][5])
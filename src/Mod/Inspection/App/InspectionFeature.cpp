@@ -23,15 +23,23 @@
  ***************************************************************************/
 
 #include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <numeric>
 #include <limits>
 
+#include <BRep_Builder.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <Poly_Triangle.hxx>
 #include <TopExp.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <gp_Pnt.hxx>
 
@@ -40,9 +48,12 @@
 #include <QFutureWatcher>
 #include <QtConcurrentMap>
 
+#include <App/Application.h>
+#include <App/Document.h>
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/TimeInfo.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
 #include <Mod/Mesh/App/Core/Grid.h>
@@ -50,6 +61,7 @@
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Tools.h>
 #include <Mod/Points/App/PointsFeature.h>
 #include <Mod/Points/App/PointsGrid.h>
 
@@ -474,39 +486,175 @@ float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float offset)
     : _rShape(shape)
+    , _offset(offset)
+    , _mesh(new MeshCore::MeshKernel)
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
-
-    // When having a solid then use its shell because otherwise the distance
-    // for inner points will always be zero
-    if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
-        TopExp_Explorer xp;
-        xp.Init(_rShape, TopAbs_SHELL);
-        if (xp.More()) {
-            distss->LoadS1(xp.Current());
-            isSolid = true;
-        }
+    if (_rShape.IsNull()) {
+        return;
     }
-    // distss->SetDeflection(radius);
+
+    isSolid = _rShape.ShapeType() == TopAbs_SOLID;
+    tessellate(offset);
 }
 
 InspectNominalShape::~InspectNominalShape()
 {
-    delete distss;
+    delete _pGrid;
+    delete _mesh;
+}
+
+void InspectNominalShape::tessellate(float offset)
+{
+    // Tessellate a copy to not replace the triangulation the shape is displayed with
+    TopoDS_Shape copy = BRepBuilderAPI_Copy(_rShape).Shape();
+    float accuracy = static_cast<float>(Part::TopoShape(copy).getAccuracy());
+    _deflection = std::clamp(0.1f * offset, 0.1f * accuracy, accuracy);
+    BRepMesh_IncrementalMesh(copy, _deflection, Standard_False, 0.5, Standard_True);
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (TopExp_Explorer xp(copy, TopAbs_FACE); xp.More(); xp.Next()) {
+        std::vector<gp_Pnt> nodes;
+        std::vector<Poly_Triangle> triangles;
+        if (!Part::Tools::getTriangulation(TopoDS::Face(xp.Current()), nodes, triangles)) {
+            continue;
+        }
+
+        auto start = static_cast<MeshCore::PointIndex>(points.size());
+        for (const auto& node : nodes) {
+            points.emplace_back(float(node.X()), float(node.Y()), float(node.Z()));
+        }
+        for (const auto& triangle : triangles) {
+            Standard_Integer n1, n2, n3;
+            triangle.Get(n1, n2, n3);
+            facets.emplace_back(start + n1, start + n2, start + n3);
+            _facetToFace.push_back(static_cast<int>(_faces.size()));
+        }
+        _faces.push_back(xp.Current());
+    }
+
+    if (facets.empty()) {
+        return;
+    }
+    _mesh->Adopt(points, facets);
+
+    // Max. limit of grid elements
+    float fMaxGridElements = 8000000.0f;
+    Base::BoundBox3f box = _mesh->GetBoundBox();
+
+    // estimate the minimum allowed grid length
+    float fMinGridLen
+        = (float)pow((box.LengthX() * box.LengthY() * box.LengthZ() / fMaxGridElements), 0.3333f);
+    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(*_mesh).GetAverageEdgeLength();
+    fGridLen = std::max<float>(fMinGridLen, fGridLen);
+
+    _pGrid = new MeshInspectGrid(*_mesh, fGridLen, Base::Matrix4D());
+    float lenX, lenY, lenZ;
+    _pGrid->GetGridLengths(lenX, lenY, lenZ);
+    _gridLen = std::min({lenX, lenY, lenZ});
+
+    // the exact distance may differ by the deflection from the distance to the triangles
+    float band = offset + 2.0f * _deflection;
+    _box = box;
+    _box.Enlarge(band);
+    unsigned long ctX, ctY, ctZ;
+    _pGrid->GetCtGrids(ctX, ctY, ctZ);
+    _maxLevel = std::min<unsigned long>(
+        static_cast<unsigned long>(band / _gridLen) + 1,
+        std::max({ctX, ctY, ctZ})
+    );
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
     gp_Pnt pnt3d(point.x, point.y, point.z);
+    if (!_pGrid) {
+        // no faces, e.g. a wire
+        return _rShape.IsNull() ? std::numeric_limits<float>::max()
+                                : getExactDistance(_rShape, pnt3d);
+    }
+
+    if (!_box.IsInBox(point)) {
+        return std::numeric_limits<float>::max();  // must be inside bbox
+    }
+
+    // Search the hulls around the grid element of the point until no nearer triangle can
+    // be found. The elements of the hull of a level are at least level - 1 grid lengths away.
+    unsigned long ulX, ulY, ulZ;
+    _pGrid->Position(point, ulX, ulY, ulZ);
+    std::vector<std::pair<float, unsigned long>> candidates;
+    float fMinDist = std::numeric_limits<float>::max();
+    bool positive = true;
+    for (unsigned long level = 0; level <= _maxLevel; level++) {
+        if (level > 0 && fMinDist + 2.0f * _deflection < float(level - 1) * _gridLen) {
+            break;
+        }
+
+        std::set<unsigned long> indices;
+        _pGrid->GetHull(ulX, ulY, ulZ, level, indices);
+        for (unsigned long it : indices) {
+            MeshCore::MeshGeomFacet geomFace = _mesh->GetFacet(it);
+            float fDist = geomFace.DistanceToPoint(point);
+            candidates.emplace_back(fDist, it);
+            if (fDist < fMinDist) {
+                fMinDist = fDist;
+                positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
+            }
+        }
+    }
+
+    if (candidates.empty()) {
+        return std::numeric_limits<float>::max();
+    }
+
+    // outside of the search radius the distance to the triangles is good enough
+    if (fMinDist > _offset + _deflection) {
+        return positive ? fMinDist : -fMinDist;
+    }
+
+    // the nearest point lies on one of the faces of the triangles that are nearly as near
+    std::set<int> faces;
+    for (const auto& it : candidates) {
+        if (it.first <= fMinDist + 2.0f * _deflection) {
+            faces.insert(_facetToFace[it.second]);
+        }
+    }
+
+    if (faces.size() == 1) {
+        return getExactDistance(_faces[*faces.begin()], pnt3d);
+    }
+
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    for (int index : faces) {
+        builder.Add(comp, _faces[index]);
+    }
+    return getExactDistance(comp, pnt3d);
+}
+
+float InspectNominalShape::getExactDistance(const TopoDS_Shape& shape, const gp_Pnt& pnt3d) const
+{
+    // When having a solid then use its shell because otherwise the distance
+    // for inner points will always be zero
+    TopoDS_Shape boundary = shape;
+    if (shape.ShapeType() == TopAbs_SOLID) {
+        TopExp_Explorer xp(shape, TopAbs_SHELL);
+        if (xp.More()) {
+            boundary = xp.Current();
+        }
+    }
+
+    BRepExtrema_DistShapeShape distss;
+    distss.LoadS1(boundary);
     BRepBuilderAPI_MakeVertex mkVert(pnt3d);
-    distss->LoadS2(mkVert.Vertex());
+    distss.LoadS2(mkVert.Vertex());
 
     float fMinDist = std::numeric_limits<float>::max();
-    if (distss->Perform() && distss->NbSolution() > 0) {
-        fMinDist = (float)distss->Value();
+    if (distss.Perform() && distss.NbSolution() > 0) {
+        fMinDist = (float)distss.Value();
         // the shape is a solid, check if the vertex is inside
         if (isSolid) {
             if (isInsideSolid(pnt3d)) {
@@ -515,7 +663,7 @@ float InspectNominalShape::getDistance(const Base::Vector3f& point) const
         }
         else if (fMinDist > 0) {
             // check if the distance was computed from a face
-            if (isBelowFace(pnt3d)) {
+            if (isBelowFace(distss, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
@@ -531,15 +679,18 @@ bool InspectNominalShape::isInsideSolid(const gp_Pnt& pnt3d) const
     return (classifier.State() == TopAbs_IN);
 }
 
-bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
+bool InspectNominalShape::isBelowFace(
+    const BRepExtrema_DistShapeShape& distss,
+    const gp_Pnt& pnt3d
+)
 {
     // check if the distance was computed from a face
-    for (Standard_Integer index = 1; index <= distss->NbSolution(); index++) {
-        if (distss->SupportTypeShape1(index) == BRepExtrema_IsInFace) {
-            TopoDS_Shape face = distss->SupportOnShape1(index);
+    for (Standard_Integer index = 1; index <= distss.NbSolution(); index++) {
+        if (distss.SupportTypeShape1(index) == BRepExtrema_IsInFace) {
+            TopoDS_Shape face = distss.SupportOnShape1(index);
             Standard_Real u, v;
-            distss->ParOnFaceS1(index, u, v);
-            // gp_Pnt pnt = distss->PointOnShape1(index);
+            distss.ParOnFaceS1(index, u, v);
+            // gp_Pnt pnt = distss.PointOnShape1(index);
             BRepGProp_Face props(TopoDS::Face(face));
             gp_Vec normal;
             gp_Pnt center;
@@ -761,6 +912,115 @@ public:
 };
 }  // namespace Inspection
 
+namespace
+{
+
+/// Checks if the geometry of a nominal or actual object has changed
+bool isGeometryChange(const App::DocumentObject& obj, const App::Property& prop)
+{
+    auto geo = freecad_cast<const App::GeoFeature*>(&obj);
+    return geo && (&prop == geo->getPropertyOfGeometry() || &prop == &geo->Placement);
+}
+
+InspectNominalGeometry* makeNominal(App::DocumentObject* obj, float radius)
+{
+    if (obj->isDerivedFrom<Mesh::Feature>()) {
+        Mesh::Feature* mesh = static_cast<Mesh::Feature*>(obj);
+        return new InspectNominalMesh(mesh->Mesh.getValue(), radius);
+    }
+    if (obj->isDerivedFrom<Points::Feature>()) {
+        Points::Feature* pts = static_cast<Points::Feature*>(obj);
+        return new InspectNominalPoints(pts->Points.getValue(), radius);
+    }
+    if (obj->isDerivedFrom<Part::Feature>()) {
+        Part::Feature* part = static_cast<Part::Feature*>(obj);
+        return new InspectNominalShape(part->Shape.getValue(), radius);
+    }
+    return nullptr;
+}
+
+/** The nominals built while a document is recomputed.
+ * All inspection features that check against the same nominal with the same search radius share
+ * its grid. The nominals are released when the recompute has finished or the nominal object has
+ * changed.
+ */
+class NominalCache
+{
+public:
+    static NominalCache& instance()
+    {
+        static NominalCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<InspectNominalGeometry> get(App::DocumentObject* obj, float radius)
+    {
+        // outside of a document recompute nobody would release the nominal
+        if (!obj->getDocument()->testStatus(App::Document::Recomputing)) {
+            return std::shared_ptr<InspectNominalGeometry>(makeNominal(obj, radius));
+        }
+
+        auto& nominal = nominals[{obj, radius}];
+        if (!nominal) {
+            nominal.reset(makeNominal(obj, radius));
+        }
+        return nominal;
+    }
+
+private:
+    NominalCache()
+    {
+        // the connections live as long as the application
+        auto& app = App::GetApplication();
+        app.signalRecomputed.connect([this](const App::Document& doc) {
+            clear(doc);
+        });
+        app.signalDeleteDocument.connect([this](const App::Document& doc) {
+            clear(doc);
+        });
+        app.signalDeletedObject.connect([this](const App::DocumentObject& obj) {
+            erase(obj);
+        });
+        app.signalChangedObject.connect(
+            [this](const App::DocumentObject& obj, const App::Property& prop) {
+                if (isGeometryChange(obj, prop)) {
+                    erase(obj);
+                }
+            }
+        );
+    }
+
+    void clear(const App::Document& doc)
+    {
+        for (auto it = nominals.begin(); it != nominals.end();) {
+            if (it->first.first->getDocument() == &doc) {
+                it = nominals.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    void erase(const App::DocumentObject& obj)
+    {
+        for (auto it = nominals.begin(); it != nominals.end();) {
+            if (it->first.first == &obj) {
+                it = nominals.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+private:
+    std::map<std::pair<const App::DocumentObject*, float>, std::shared_ptr<InspectNominalGeometry>>
+        nominals;
+};
+
+}  // namespace
+
 PROPERTY_SOURCE(Inspection::Feature, App::DocumentObject)
 
 Feature::Feature()
@@ -774,6 +1034,53 @@ Feature::Feature()
 
 Feature::~Feature() = default;
 
+void Feature::onChanged(const App::Property* prop)
+{
+    // the distances are only set by the user if the feature isn't recomputing
+    if (prop == &SearchRadius || prop == &Thickness || prop == &Actual || prop == &Nominals
+        || (prop == &Distances && !isRecomputing())) {
+        resetResume();
+    }
+    App::DocumentObject::onChanged(prop);
+}
+
+void Feature::onSettingDocument()
+{
+    App::Document* doc = getDocument();
+    if (doc) {
+        connDocChangedObject = doc->signalChangedObject.connect(
+            std::bind(&Feature::slotChangedObject, this, sp::_1, sp::_2)
+        );
+    }
+
+    App::DocumentObject::onSettingDocument();
+}
+
+void Feature::unsetupObject()
+{
+    connDocChangedObject.disconnect();
+    App::DocumentObject::unsetupObject();
+}
+
+void Feature::slotChangedObject(const App::DocumentObject& obj, const App::Property& prop)
+{
+    if (resumeIndex == 0 || !isGeometryChange(obj, prop)) {
+        return;
+    }
+
+    const auto& nominals = Nominals.getValues();
+    if (&obj == Actual.getValue() || std::ranges::find(nominals, &obj) != nominals.end()) {
+        resetResume();
+    }
+}
+
+void Feature::resetResume()
+{
+    resumeIndex = 0;
+    resumeSumSq = 0.0;
+    resumeCount = 0;
+}
+
 short Feature::mustExecute() const
 {
     if (SearchRadius.isTouched()) {
@@ -818,31 +1125,15 @@ App::DocumentObjectExecReturn* Feature::execute()
         throw Base::TypeError("Unknown geometric type");
     }
 
-    // clang-format off
     // get a list of nominals
-    std::vector<InspectNominalGeometry*> inspectNominal;
+    std::vector<std::shared_ptr<InspectNominalGeometry>> inspectNominal;
     const std::vector<App::DocumentObject*>& nominals = Nominals.getValues();
     for (auto it : nominals) {
-        InspectNominalGeometry* nominal = nullptr;
-        if (it->isDerivedFrom<Mesh::Feature>()) {
-            Mesh::Feature* mesh = static_cast<Mesh::Feature*>(it);
-            nominal = new InspectNominalMesh(mesh->Mesh.getValue(), this->SearchRadius.getValue());
-        }
-        else if (it->isDerivedFrom<Points::Feature>()) {
-            Points::Feature* pts = static_cast<Points::Feature*>(it);
-            nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
-        }
-        else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
-            Part::Feature* part = static_cast<Part::Feature*>(it);
-            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
-        }
-
+        auto nominal = NominalCache::instance().get(it, this->SearchRadius.getValue());
         if (nominal) {
             inspectNominal.push_back(nominal);
         }
     }
-    // clang-format on
 
 #if 0
 # if 1  // test with some huge data sets
@@ -900,13 +1191,13 @@ App::DocumentObjectExecReturn* Feature::execute()
         this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), fRMS);
 #else
     unsigned long count = actual->countPoints();
-    std::vector<float> vals(count);
+    std::vector<float> vals(count, std::numeric_limits<float>::max());
     std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index) {
         DistanceInspectionRMS res;
         Base::Vector3f pnt = actual->getPoint(index);
 
         float fMinDist = std::numeric_limits<float>::max();
-        for (auto it : inspectNominal) {
+        for (const auto& it : inspectNominal) {
             float fDist = it->getDistance(pnt);
             if (fabs(fDist) < fabs(fMinDist)) {
                 fMinDist = fDist;
@@ -928,58 +1219,129 @@ App::DocumentObjectExecReturn* Feature::execute()
         return res;
     };
 
+    // Continue a cancelled inspection of the same data
     DistanceInspectionRMS res;
+    unsigned long begin = 0;
+    if (resumeIndex > 0 && resumeIndex < count && Distances.getSize() == static_cast<int>(count)) {
+        vals = Distances.getValues();
+        begin = resumeIndex;
+        res.m_sumsq = resumeSumSq;
+        res.m_numv = resumeCount;
+    }
+    resetResume();
 
-    if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS
-        // computation
-        QFuture<DistanceInspectionRMS> future
-            = QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
-        // Setup progress bar
-        Base::SequencerLauncher seq("Inspecting...", 100);
-        unsigned int currentStep = 0;
-        const unsigned int steps = static_cast<unsigned int>(actual->countPoints());
-        QFutureWatcher<DistanceInspectionRMS> watcher;
-        QObject::connect(
-            &watcher,
-            &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
-            [&](int value) {
-                if (steps == 0) {
-                    return;
-                }
-                const unsigned int step = (100U * static_cast<unsigned int>(value)) / steps;
-                if (step > currentStep) {
-                    currentStep = step;
-                    seq.next();
+    Base::TimeElapsed start;
+    auto pointsPerSecond = [&start](unsigned long points) {
+        float seconds = Base::TimeElapsed::diffTimeF(start);
+        return seconds > 0.0f ? static_cast<unsigned long>(float(points) / seconds) : 0UL;
+    };
+
+    // Setup progress bar
+    Base::SequencerLauncher seq("Inspecting...", 100);
+    unsigned int currentStep = 0;
+    const unsigned long steps = count - begin;
+    // Returns false if the user has cancelled
+    auto advance = [&](unsigned long inspected) {
+        if (steps == 0) {
+            return true;
+        }
+        const auto step = static_cast<unsigned int>((100U * (inspected - begin)) / steps);
+        if (step > currentStep) {
+            currentStep = step;
+            std::stringstream str;
+            str << "Inspecting... (" << pointsPerSecond(inspected - begin) << " points/s)";
+            seq.setText(str.str().c_str());
+            try {
+                seq.next(true);
+            }
+            catch (const Base::AbortException&) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // The points are inspected in chunks. The distances are published while the inspection is
+    // running, and the finished chunks are kept if it is cancelled.
+    const unsigned long chunkSize = std::max<unsigned long>(20000, count / 50);
+    Base::TimeElapsed published;
+    bool first = true;
+    bool canceled = false;
+    unsigned long done = begin;
+    while (done < count && !canceled) {
+        const unsigned long end = std::min(count, done + chunkSize);
+        DistanceInspectionRMS chunk;
+        if (useMultithreading) {
+            // Build vector of increasing indices
+            std::vector<unsigned long> index(end - done);
+            std::iota(index.begin(), index.end(), done);
+            // Perform map-reduce operation : compute distances and update sum of squares for RMS
+            // computation
+            QFuture<DistanceInspectionRMS> future
+                = QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
+            QFutureWatcher<DistanceInspectionRMS> watcher;
+            QObject::connect(
+                &watcher,
+                &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
+                [&](int value) {
+                    if (!canceled && !advance(done + static_cast<unsigned long>(value))) {
+                        canceled = true;
+                        future.cancel();
+                    }
                 }
+            );
+            // Keep UI responsive during computation
+            QEventLoop loop;
+            QObject::connect(
+                &watcher,
+                &QFutureWatcher<DistanceInspectionRMS>::finished,
+                &loop,
+                &QEventLoop::quit
+            );
+            watcher.setFuture(future);
+            loop.exec();
+            if (!canceled) {
+                chunk = future.result();
             }
-        );
-        // Keep UI responsive during computation
-        QEventLoop loop;
-        QObject::connect(
-            &watcher,
-            &QFutureWatcher<DistanceInspectionRMS>::finished,
-            &loop,
-            &QEventLoop::quit
-        );
-        watcher.setFuture(future);
-        loop.exec();
-        res = future.result();
-    }
-    else {
-        // Single-threaded operation
-        std::stringstream str;
-        str << "Inspecting " << this->Label.getValue() << "…";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
+        }
+        else {
+            // Single-threaded operation
+            for (unsigned long i = done; i < end && !canceled; i++) {
+                chunk += fMap(i);
+                canceled = !advance(i + 1);
+            }
+        }
 
-        for (unsigned int i = 0; i < count; i++) {
-            res += fMap(i);
+        if (canceled) {
+            break;
+        }
+        res += chunk;
+        done = end;
+
+        // The first values are published with the geometry of the actual, after that only the
+        // colors need an update. Publishing more than once a second slows down the inspection.
+        if (done < count && Base::TimeElapsed::diffTimeF(published) >= 1.0f) {
+            Distances.setStatus(App::Property::User1, !first);
+            Distances.setValues(vals);
+            Distances.setStatus(App::Property::User1, false);
+            published.setCurrent();
+            first = false;
         }
     }
 
+    Distances.setValues(vals);
+
+    if (canceled) {
+        resumeIndex = done;
+        resumeSumSq = res.m_sumsq;
+        resumeCount = res.m_numv;
+        delete actual;
+        std::stringstream str;
+        str << "Inspection cancelled after " << done << " of " << count
+            << " points, recompute to resume";
+        return new App::DocumentObjectExecReturn(str.str());
+    }
+
     Base::Console().message(
         "RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
         this->Label.getValue(),
@@ -987,13 +1349,16 @@ App::DocumentObjectExecReturn* Feature::execute()
         this->SearchRadius.getValue(),
         res.getRMS()
     );
-    Distances.setValues(vals);
+    Base::Console().message(
+        "Inspected %lu points of '%s' in %.2f s (%lu points/s)\n",
+        count - begin,
+        this->Label.getValue(),
+        Base::TimeElapsed::diffTimeF(start),
+        pointsPerSecond(count - begin)
+    );
 #endif
 
     delete actual;
-    for (auto it : inspectNominal) {
-        delete it;
-    }
 
     return nullptr;
 }
@@ -160,6 +160,11 @@ private:
     Points::PointsGrid* _pGrid;
 };
 
+/** Computes the distance to a shape.
+ * A fine tessellation of the faces is searched with a grid for the nearest triangles. Only if
+ * the point is within the search radius the distance is refined against the faces the nearest
+ * triangles belong to.
+ */
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
 {
 public:
@@ -168,13 +173,25 @@ public:
     float getDistance(const Base::Vector3f&) const override;
 
 private:
+    void tessellate(float offset);
+    float getExactDistance(const TopoDS_Shape&, const gp_Pnt&) const;
     bool isInsideSolid(const gp_Pnt&) const;
-    bool isBelowFace(const gp_Pnt&) const;
+    static bool isBelowFace(const BRepExtrema_DistShapeShape&, const gp_Pnt&);
 
 private:
-    BRepExtrema_DistShapeShape* distss;
     const TopoDS_Shape& _rShape;
     bool isSolid {false};
+    float _offset;
+    /// The maximum distance of the tessellation to the faces
+    float _deflection {0.0f};
+    MeshCore::MeshKernel* _mesh;
+    MeshCore::MeshGrid* _pGrid {nullptr};
+    float _gridLen {0.0f};
+    unsigned long _maxLevel {0};
+    Base::BoundBox3f _box;
+    /// The index into _faces of each triangle of _mesh
+    std::vector<int> _facetToFace;
+    std::vector<TopoDS_Shape> _faces;
 };
 
 class InspectionExport PropertyDistanceList: public App::PropertyLists
@@ -255,6 +272,7 @@ public:
     App::PropertyFloat Thickness;
     App::PropertyLink Actual;
     App::PropertyLinkList Nominals;
+    /// While an inspection is running, its status User1 is set if only more distances are known
     PropertyDistanceList Distances;
     //@}
 
@@ -274,6 +292,28 @@ public:
     {
         return "InspectionGui::ViewProviderInspection";
     }
+
+protected:
+    void onChanged(const App::Property* prop) override;
+    void onSettingDocument() override;
+    void unsetupObject() override;
+
+private:
+    void slotChangedObject(const App::DocumentObject& obj, const App::Property& prop);
+    void resetResume();
+
+private:
+    /** @name Resume
+     * The state of an inspection that was cancelled. The distances of the points before
+     * resumeIndex are kept in Distances and the next recompute continues with the remaining
+     * points, unless the inputs have changed in the meantime.
+     */
+    //@{
+    unsigned long resumeIndex {0};
+    double resumeSumSq {0.0};
+    int resumeCount {0};
+    //@}
+    fastsignals::connection connDocChangedObject;
 };
 
 class InspectionExport Group: public App::DocumentObjectGroup
@@ -370,10 +370,11 @@ void ViewProviderInspection::updateData(const App::Property* prop)
         }
     }
     else if (prop->is<Inspection::PropertyDistanceList>()) {
-        // force an update of the Inventor data nodes
         if (this->pcObject) {
+            // force an update of the Inventor data nodes unless the feature publishes more
+            // distances of a running inspection
             App::Property* link = this->pcObject->getPropertyByName("Actual");
-            if (link) {
+            if (link && !prop->testStatus(App::Property::User1)) {
                 updateData(link);
             }
             setDistances();
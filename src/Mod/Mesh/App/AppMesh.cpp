@@ -107,6 +107,7 @@ PyMOD_INIT_FUNC(Mesh)
     Mesh::FixDuplicatedFaces    ::init();
     Mesh::FixDuplicatedPoints   ::init();
     Mesh::FixDegenerations      ::init();
+    Mesh::RepairDefects         ::init();
     Mesh::FixDeformations       ::init();
     Mesh::FixIndices            ::init();
     Mesh::FillHoles             ::init();
@@ -0,0 +1,1986 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+#include "Boolean.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// Exact predicates
+//
+// The predicates first evaluate the determinant in floating point arithmetic and only if the
+// result is within the error bound it is recomputed exactly with expansion arithmetic as
+// described by J. R. Shewchuk: "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+// Geometric Predicates".
+
+inline void twoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+inline void twoProduct(double a, double b, double& x, double& y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+/**
+ * A sum of non-overlapping doubles ordered by increasing magnitude that represents a number
+ * exactly. The capacity is sufficient for the 3x3 determinant of orient3d.
+ */
+class Expansion
+{
+public:
+    Expansion() = default;
+    // only the first 'size' components need to be copied
+    Expansion(const Expansion& e)
+        : size(e.size)
+    {
+        std::copy_n(e.comp.begin(), size, comp.begin());
+    }
+    Expansion& operator=(const Expansion& e)
+    {
+        if (this != &e) {
+            size = e.size;
+            std::copy_n(e.comp.begin(), size, comp.begin());
+        }
+        return *this;
+    }
+
+    static Expansion difference(double a, double b)
+    {
+        Expansion e;
+        double x {};
+        double y {};
+        twoSum(a, -b, x, y);
+        if (y != 0.0) {
+            e.comp[e.size++] = y;
+        }
+        e.comp[e.size++] = x;
+        return e;
+    }
+
+    Expansion operator+(const Expansion& f) const
+    {
+        Expansion h = *this;
+        for (int i = 0; i < f.size; i++) {
+            h.grow(f.comp[i]);
+        }
+        return h;
+    }
+
+    Expansion operator-(const Expansion& f) const
+    {
+        Expansion h = *this;
+        for (int i = 0; i < f.size; i++) {
+            h.grow(-f.comp[i]);
+        }
+        return h;
+    }
+
+    Expansion operator*(const Expansion& f) const
+    {
+        Expansion h;
+        for (int i = 0; i < f.size; i++) {
+            Expansion product = scaled(f.comp[i]);
+            for (int j = 0; j < product.size; j++) {
+                h.grow(product.comp[j]);
+            }
+        }
+        return h;
+    }
+
+    int sign() const
+    {
+        for (int i = size - 1; i >= 0; i--) {
+            if (comp[i] > 0.0) {
+                return 1;
+            }
+            if (comp[i] < 0.0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+private:
+    void grow(double b)
+    {
+        int count = 0;
+        double q = b;
+        for (int i = 0; i < size; i++) {
+            double x {};
+            double y {};
+            twoSum(q, comp[i], x, y);
+            if (y != 0.0) {
+                comp[count++] = y;
+            }
+            q = x;
+        }
+        if (q != 0.0 || count == 0) {
+            comp[count++] = q;
+        }
+        size = count;
+    }
+
+    Expansion scaled(double b) const
+    {
+        Expansion h;
+        if (size == 0) {
+            return h;
+        }
+        double q {};
+        double hh {};
+        twoProduct(comp[0], b, q, hh);
+        if (hh != 0.0) {
+            h.comp[h.size++] = hh;
+        }
+        for (int i = 1; i < size; i++) {
+            double p1 {};
+            double p0 {};
+            double s {};
+            twoProduct(comp[i], b, p1, p0);
+            twoSum(q, p0, s, hh);
+            if (hh != 0.0) {
+                h.comp[h.size++] = hh;
+            }
+            q = p1 + s;
+            hh = s - (q - p1);
+            if (hh != 0.0) {
+                h.comp[h.size++] = hh;
+            }
+        }
+        if (q != 0.0 || h.size == 0) {
+            h.comp[h.size++] = q;
+        }
+        return h;
+    }
+
+    std::array<double, 256> comp;  // NOLINT
+    int size {0};
+};
+
+struct Point2
+{
+    double x {0.0};
+    double y {0.0};
+};
+
+int orient2dExact(const Point2& a, const Point2& b, const Point2& c)
+{
+    Expansion acx = Expansion::difference(a.x, c.x);
+    Expansion acy = Expansion::difference(a.y, c.y);
+    Expansion bcx = Expansion::difference(b.x, c.x);
+    Expansion bcy = Expansion::difference(b.y, c.y);
+    return (acx * bcy - acy * bcx).sign();
+}
+
+/**
+ * Returns 1 if \a a, \a b, \a c are in counterclockwise order, -1 if they are in clockwise
+ * order and 0 if they are collinear.
+ */
+int orient2d(const Point2& a, const Point2& b, const Point2& c)
+{
+    double detLeft = (a.x - c.x) * (b.y - c.y);
+    double detRight = (a.y - c.y) * (b.x - c.x);
+    double det = detLeft - detRight;
+    double detSum = std::fabs(detLeft) + std::fabs(detRight);
+    if (detSum == 0.0) {
+        // at least one factor of each product is exactly zero
+        return 0;
+    }
+    double errBound = 3.3306690738754716e-16 * detSum;
+    if (det > errBound) {
+        return 1;
+    }
+    if (-det > errBound) {
+        return -1;
+    }
+    return orient2dExact(a, b, c);
+}
+
+int orient3dExact(
+    const Base::Vector3d& a,
+    const Base::Vector3d& b,
+    const Base::Vector3d& c,
+    const Base::Vector3d& d
+)
+{
+    Expansion adx = Expansion::difference(a.x, d.x);
+    Expansion ady = Expansion::difference(a.y, d.y);
+    Expansion adz = Expansion::difference(a.z, d.z);
+    Expansion bdx = Expansion::difference(b.x, d.x);
+    Expansion bdy = Expansion::difference(b.y, d.y);
+    Expansion bdz = Expansion::difference(b.z, d.z);
+    Expansion cdx = Expansion::difference(c.x, d.x);
+    Expansion cdy = Expansion::difference(c.y, d.y);
+    Expansion cdz = Expansion::difference(c.z, d.z);
+
+    Expansion det = adz * (bdx * cdy - cdx * bdy) + bdz * (cdx * ady - adx * cdy)
+        + cdz * (adx * bdy - bdx * ady);
+    return det.sign();
+}
+
+/**
+ * Returns the sign of the volume of the tetrahedron (a, b, c, d), i.e. 0 if the four points
+ * are coplanar and otherwise 1 or -1 depending on which side of the plane through \a a,
+ * \a b and \a c the point \a d lies.
+ */
+int orient3d(
+    const Base::Vector3d& a,
+    const Base::Vector3d& b,
+    const Base::Vector3d& c,
+    const Base::Vector3d& d
+)
+{
+    double adx = a.x - d.x;
+    double ady = a.y - d.y;
+    double adz = a.z - d.z;
+    double bdx = b.x - d.x;
+    double bdy = b.y - d.y;
+    double bdz = b.z - d.z;
+    double cdx = c.x - d.x;
+    double cdy = c.y - d.y;
+    double cdz = c.z - d.z;
+
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+
+    double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+        + (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+        + (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+    if (permanent == 0.0) {
+        // at least one factor of each product is exactly zero
+        return 0;
+    }
+    double errBound = 7.7715611723761027e-16 * permanent;
+    if (det > errBound) {
+        return 1;
+    }
+    if (-det > errBound) {
+        return -1;
+    }
+    return orient3dExact(a, b, c, d);
+}
+
+/**
+ * Projects points onto the coordinate plane that is most parallel to a given plane. The two
+ * remaining axes are ordered so that a triangle which is counterclockwise with respect to the
+ * plane normal stays counterclockwise in 2D.
+ */
+struct Projection
+{
+    unsigned short ax {0};
+    unsigned short ay {1};
+
+    Projection() = default;
+    explicit Projection(const Base::Vector3d& normal)
+    {
+        double nx = std::fabs(normal.x);
+        double ny = std::fabs(normal.y);
+        double nz = std::fabs(normal.z);
+        unsigned short axis = 2;
+        if (nx >= ny && nx >= nz) {
+            axis = 0;
+        }
+        else if (ny >= nz) {
+            axis = 1;
+        }
+        ax = (axis + 1) % 3;
+        ay = (axis + 2) % 3;
+        if (normal[axis] < 0.0) {
+            std::swap(ax, ay);
+        }
+    }
+
+    Point2 operator()(const Base::Vector3d& pnt) const
+    {
+        return {pnt[ax], pnt[ay]};
+    }
+};
+
+// ----------------------------------------------------------------------------
+
+using Triangle = std::array<PointIndex, 3>;
+
+/**
+ * Identifies a point of the intersection curve by the mesh elements it is created from.
+ * Points created from the same elements get the same key and thus the same index.
+ */
+struct PointKey
+{
+    enum Type
+    {
+        /** An existing vertex: ids[0] */
+        Vertex,
+        /** An edge (ids[0], ids[1]) of side ids[3] crossing facet ids[2] of the other side */
+        EdgeFacet,
+        /** Edge (ids[0], ids[1]) of the first mesh crossing edge (ids[2], ids[3]) of the second
+           mesh */
+        EdgeEdge
+    };
+
+    int type {Vertex};
+    std::array<unsigned long, 4> ids {};
+
+    bool operator<(const PointKey& key) const
+    {
+        return std::tie(type, ids) < std::tie(key.type, key.ids);
+    }
+    bool operator==(const PointKey& key) const
+    {
+        return type == key.type && ids == key.ids;
+    }
+};
+
+struct KeyedPoint
+{
+    PointKey key;
+    Base::Vector3d pnt;
+};
+
+/** A part of the intersection curve that must become an edge of the retriangulated facet. */
+struct Constraint
+{
+    FacetIndex facet {FACET_INDEX_MAX};
+    std::array<PointKey, 2> key;
+    std::array<Base::Vector3d, 2> pnt;
+    std::array<PointIndex, 2> index {POINT_INDEX_MAX, POINT_INDEX_MAX};
+};
+
+struct Constraint_Less
+{
+    bool operator()(const Constraint& c1, const Constraint& c2) const
+    {
+        return std::tie(c1.facet, c1.key[0], c1.key[1]) < std::tie(c2.facet, c2.key[0], c2.key[1]);
+    }
+};
+
+using Edge = std::pair<PointIndex, PointIndex>;
+
+inline Edge makeEdge(PointIndex p1, PointIndex p2)
+{
+    return p1 < p2 ? Edge(p1, p2) : Edge(p2, p1);
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Bounding volume hierarchy of the facets of a mesh.
+ */
+class FacetTree
+{
+public:
+    FacetTree(const std::vector<Base::Vector3d>& points, const std::vector<Triangle>& facets)
+        : points(points)
+        , facets(facets)
+    {
+        std::vector<Base::Vector3d> centers;
+        centers.reserve(facets.size());
+        for (FacetIndex index = 0; index < facets.size(); index++) {
+            const Triangle& tria = facets[index];
+            if (tria[0] == tria[1] || tria[1] == tria[2] || tria[2] == tria[0]) {
+                centers.emplace_back();
+                continue;
+            }
+            items.push_back(index);
+            centers.push_back((points[tria[0]] + points[tria[1]] + points[tria[2]]) / 3.0);
+        }
+
+        if (!items.empty()) {
+            nodes.reserve(2 * items.size() / LeafSize + 1);
+            build(0, items.size(), centers);
+        }
+    }
+
+    /** Calls \a func for each facet whose bounding box intersects \a box. */
+    template<class Func>
+    void search(const Base::BoundBox3d& box, Func func) const
+    {
+        if (nodes.empty()) {
+            return;
+        }
+        std::vector<std::size_t> stack {0};
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            std::size_t index = stack.back();
+            stack.pop_back();
+            if (!node.box.Intersect(box)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (std::size_t i = node.first; i < node.first + node.count; i++) {
+                    func(items[i]);
+                }
+            }
+            else {
+                stack.push_back(node.right);
+                stack.push_back(index + 1);
+            }
+        }
+    }
+
+    /** Calls \a func for each facet whose bounding box intersects the segment [p, q]. */
+    template<class Func>
+    void search(const Base::Vector3d& p, const Base::Vector3d& q, Func func) const
+    {
+        if (nodes.empty()) {
+            return;
+        }
+        // enlarge the boxes slightly to be on the safe side
+        double tolerance = 1.0e-9 * nodes.front().box.CalcDiagonalLength();
+        std::vector<std::size_t> stack {0};
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            std::size_t index = stack.back();
+            stack.pop_back();
+            if (!cutsBox(node.box, p, q - p, tolerance)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (std::size_t i = node.first; i < node.first + node.count; i++) {
+                    func(items[i]);
+                }
+            }
+            else {
+                stack.push_back(node.right);
+                stack.push_back(index + 1);
+            }
+        }
+    }
+
+    Base::BoundBox3d boundBox(FacetIndex index) const
+    {
+        const Triangle& tria = facets[index];
+        Base::BoundBox3d box;
+        box.Add(points[tria[0]]);
+        box.Add(points[tria[1]]);
+        box.Add(points[tria[2]]);
+        return box;
+    }
+
+private:
+    static constexpr std::size_t LeafSize = 4;
+
+    struct Node
+    {
+        Base::BoundBox3d box;
+        std::size_t first {0};
+        std::size_t count {0};
+        std::size_t right {0};
+    };
+
+    std::size_t build(
+        std::size_t first,
+        std::size_t last,
+        const std::vector<Base::Vector3d>& centers
+    )
+    {
+        std::size_t index = nodes.size();
+        nodes.emplace_back();
+
+        Base::BoundBox3d box;
+        Base::BoundBox3d centerBox;
+        for (std::size_t i = first; i < last; i++) {
+            box.Add(boundBox(items[i]));
+            centerBox.Add(centers[items[i]]);
+        }
+        nodes[index].box = box;
+
+        if (last - first <= LeafSize) {
+            nodes[index].first = first;
+            nodes[index].count = last - first;
+            return index;
+        }
+
+        int axis = 0;
+        double lenX = centerBox.LengthX();
+        double lenY = centerBox.LengthY();
+        double lenZ = centerBox.LengthZ();
+        if (lenY > lenX && lenY >= lenZ) {
+            axis = 1;
+        }
+        else if (lenZ > lenX && lenZ > lenY) {
+            axis = 2;
+        }
+
+        std::size_t mid = (first + last) / 2;
+        auto begin = items.begin();
+        std::nth_element(
+            begin + std::ptrdiff_t(first),
+            begin + std::ptrdiff_t(mid),
+            begin + std::ptrdiff_t(last),
+            [&centers, axis](FacetIndex f1, FacetIndex f2) {
+                return centers[f1][axis] < centers[f2][axis];
+            }
+        );
+
+        build(first, mid, centers);
+        std::size_t right = build(mid, last, centers);
+        nodes[index].right = right;
+        return index;
+    }
+
+    static bool cutsBox(
+        const Base::BoundBox3d& box,
+        const Base::Vector3d& p,
+        const Base::Vector3d& dir,
+        double tolerance
+    )
+    {
+        double tmin = 0.0;
+        double tmax = 1.0;
+        const std::array<double, 3> lower {
+            box.MinX - tolerance,
+            box.MinY - tolerance,
+            box.MinZ - tolerance
+        };
+        const std::array<double, 3> upper {
+            box.MaxX + tolerance,
+            box.MaxY + tolerance,
+            box.MaxZ + tolerance
+        };
+        for (unsigned short axis = 0; axis < 3; axis++) {
+            if (dir[axis] == 0.0) {
+                if (p[axis] < lower[axis] || p[axis] > upper[axis]) {
+                    return false;
+                }
+                continue;
+            }
+            double t1 = (lower[axis] - p[axis]) / dir[axis];
+            double t2 = (upper[axis] - p[axis]) / dir[axis];
+            if (t1 > t2) {
+                std::swap(t1, t2);
+            }
+            tmin = std::max(tmin, t1);
+            tmax = std::min(tmax, t2);
+            if (tmin > tmax) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const std::vector<Base::Vector3d>& points;
+    const std::vector<Triangle>& facets;
+    std::vector<FacetIndex> items;
+    std::vector<Node> nodes;
+};
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Triangulation of a single facet in its 2D projection. Points are inserted by splitting the
+ * triangles and the constraint edges are recovered by edge flips (Sloan's algorithm) so that no
+ * additional points are created on the intersection curve.
+ */
+class FacetSplitter
+{
+public:
+    explicit FacetSplitter(const std::array<Point2, 3>& corners)
+        : uv(corners.begin(), corners.end())
+    {
+        tris.push_back({0, 1, 2});
+    }
+
+    int addVertex(const Point2& pnt)
+    {
+        uv.push_back(pnt);
+        return int(uv.size()) - 1;
+    }
+
+    /** Inserts vertex \a p on the boundary edge (a, b). */
+    void splitBoundary(int a, int b, int p)
+    {
+        std::size_t tri {};
+        int pos {};
+        if (!findEdge(a, b, tri, pos)) {
+            return;
+        }
+        int c = tris[tri][(pos + 2) % 3];
+        tris[tri] = {a, p, c};
+        tris.push_back({p, b, c});
+    }
+
+    /** Inserts an inner vertex. If it coincides with an existing vertex the index of this
+     * vertex is returned. */
+    int insert(int p)
+    {
+        std::size_t best = 0;
+        double bestValue = -std::numeric_limits<double>::max();
+        for (std::size_t tri = 0; tri < tris.size(); tri++) {
+            std::array<int, 3> sign {};
+            for (int i = 0; i < 3; i++) {
+                sign[i] = orient(tris[tri][i], tris[tri][(i + 1) % 3], p);
+            }
+            if (sign[0] < 0 || sign[1] < 0 || sign[2] < 0) {
+                double value = std::numeric_limits<double>::max();
+                for (int i = 0; i < 3; i++) {
+                    value = std::min(value, area(tris[tri][i], tris[tri][(i + 1) % 3], p));
+                }
+                if (value > bestValue) {
+                    bestValue = value;
+                    best = tri;
+                }
+                continue;
+            }
+
+            int zeros = int(std::count(sign.begin(), sign.end(), 0));
+            if (zeros == 0) {
+                splitTriangle(tri, p);
+                return p;
+            }
+            if (zeros == 1) {
+                int pos = int(std::find(sign.begin(), sign.end(), 0) - sign.begin());
+                if (!splitEdge(tri, pos, p)) {
+                    splitTriangle(tri, p);
+                }
+                return p;
+            }
+            if (zeros == 2) {
+                for (int i = 0; i < 3; i++) {
+                    if (sign[i] != 0) {
+                        return tris[tri][(i + 2) % 3];
+                    }
+                }
+            }
+        }
+
+        // due to round-off the point lies marginally outside of the facet
+        if (!tris.empty()) {
+            splitTriangle(best, p);
+        }
+        return p;
+    }
+
+    /** Makes (u, v) an edge of the triangulation. Returns false if this fails because the
+     * segment crosses another constraint. */
+    bool constrain(int u, int v)
+    {
+        if (u == v) {
+            return true;
+        }
+        if (hasEdge(u, v)) {
+            fixed.push_back(makeLocalEdge(u, v));
+            return true;
+        }
+
+        // a vertex that lies exactly on the segment splits it
+        for (int w = 0; w < int(uv.size()); w++) {
+            if (w != u && w != v && orient(u, v, w) == 0 && isBetween(u, v, w) && isUsed(w)) {
+                return constrain(u, w) && constrain(w, v);
+            }
+        }
+
+        std::vector<std::pair<int, int>> queue;
+        for (const auto& tri : tris) {
+            for (int i = 0; i < 3; i++) {
+                int a = tri[i];
+                int b = tri[(i + 1) % 3];
+                if (a < b && crosses(a, b, u, v)) {
+                    if (isFixed(a, b)) {
+                        return false;
+                    }
+                    queue.emplace_back(a, b);
+                }
+            }
+        }
+
+        std::size_t limit = 16 * (queue.size() + 1) * (queue.size() + 1);
+        std::size_t front = 0;
+        while (front < queue.size()) {
+            if (front > limit) {
+                return false;
+            }
+            auto [a, b] = queue[front++];
+            std::size_t tri1 {};
+            std::size_t tri2 {};
+            int pos1 {};
+            int pos2 {};
+            if (!findEdge(a, b, tri1, pos1) || !findEdge(b, a, tri2, pos2)) {
+                return false;
+            }
+            int c = tris[tri1][(pos1 + 2) % 3];
+            int d = tris[tri2][(pos2 + 2) % 3];
+            if (orient(c, d, a) * orient(c, d, b) >= 0) {
+                // the quadrilateral is not convex, try again later
+                queue.emplace_back(a, b);
+                continue;
+            }
+
+            tris[tri1] = {a, d, c};
+            tris[tri2] = {d, b, c};
+            if (crosses(c, d, u, v)) {
+                queue.emplace_back(c, d);
+            }
+        }
+
+        fixed.push_back(makeLocalEdge(u, v));
+        return hasEdge(u, v);
+    }
+
+    const std::vector<std::array<int, 3>>& triangles() const
+    {
+        return tris;
+    }
+
+    const std::vector<std::pair<int, int>>& constraints() const
+    {
+        return fixed;
+    }
+
+    const Point2& vertex(int index) const
+    {
+        return uv[index];
+    }
+
+private:
+    int orient(int a, int b, int c) const
+    {
+        return orient2d(uv[a], uv[b], uv[c]);
+    }
+
+    double area(int a, int b, int c) const
+    {
+        return (uv[b].x - uv[a].x) * (uv[c].y - uv[a].y)
+            - (uv[b].y - uv[a].y) * (uv[c].x - uv[a].x);
+    }
+
+    static std::pair<int, int> makeLocalEdge(int a, int b)
+    {
+        return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+    }
+
+    bool findEdge(int a, int b, std::size_t& tri, int& pos) const
+    {
+        for (std::size_t i = 0; i < tris.size(); i++) {
+            for (int j = 0; j < 3; j++) {
+                if (tris[i][j] == a && tris[i][(j + 1) % 3] == b) {
+                    tri = i;
+                    pos = j;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool hasEdge(int a, int b) const
+    {
+        std::size_t tri {};
+        int pos {};
+        return findEdge(a, b, tri, pos) || findEdge(b, a, tri, pos);
+    }
+
+    bool isFixed(int a, int b) const
+    {
+        return std::find(fixed.begin(), fixed.end(), makeLocalEdge(a, b)) != fixed.end();
+    }
+
+    bool isUsed(int w) const
+    {
+        for (const auto& tri : tris) {
+            if (tri[0] == w || tri[1] == w || tri[2] == w) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isBetween(int u, int v, int w) const
+    {
+        // w is collinear with u and v
+        if (std::fabs(uv[u].x - uv[v].x) >= std::fabs(uv[u].y - uv[v].y)) {
+            return std::min(uv[u].x, uv[v].x) < uv[w].x && uv[w].x < std::max(uv[u].x, uv[v].x);
+        }
+        return std::min(uv[u].y, uv[v].y) < uv[w].y && uv[w].y < std::max(uv[u].y, uv[v].y);
+    }
+
+    bool crosses(int a, int b, int u, int v) const
+    {
+        return orient(u, v, a) * orient(u, v, b) < 0 && orient(a, b, u) * orient(a, b, v) < 0;
+    }
+
+    void splitTriangle(std::size_t tri, int p)
+    {
+        auto [a, b, c] = tris[tri];
+        tris[tri] = {a, b, p};
+        tris.push_back({b, c, p});
+        tris.push_back({c, a, p});
+    }
+
+    bool splitEdge(std::size_t tri1, int pos1, int p)
+    {
+        int a = tris[tri1][pos1];
+        int b = tris[tri1][(pos1 + 1) % 3];
+        int c = tris[tri1][(pos1 + 2) % 3];
+        std::size_t tri2 {};
+        int pos2 {};
+        if (!findEdge(b, a, tri2, pos2)) {
+            return false;
+        }
+        int d = tris[tri2][(pos2 + 2) % 3];
+        tris[tri1] = {a, p, c};
+        tris.push_back({p, b, c});
+        tris[tri2] = {b, p, d};
+        tris.push_back({p, a, d});
+        return true;
+    }
+
+    std::vector<Point2> uv;
+    std::vector<std::array<int, 3>> tris;
+    std::vector<std::pair<int, int>> fixed;
+};
+
+// ----------------------------------------------------------------------------
+
+class BooleanAlgorithm
+{
+public:
+    enum State : char
+    {
+        Unknown,
+        Degenerated,
+        Inside,
+        Outside,
+        OnSame,
+        OnOpposite
+    };
+
+    struct Piece
+    {
+        Triangle tria;
+        char state {Unknown};
+    };
+
+    BooleanAlgorithm(const MeshKernel& kernel1, const MeshKernel& kernel2, int threads)
+        : threads(std::max(threads, 1))
+    {
+        const MeshKernel* kernels[2] = {&kernel1, &kernel2};
+        for (const MeshKernel* kernel : kernels) {
+            for (const auto& pnt : kernel->GetPoints()) {
+                points.emplace_back(pnt.x, pnt.y, pnt.z);
+            }
+        }
+
+        PointIndex offset = 0;
+        for (int side = 0; side < 2; side++) {
+            const MeshFacetArray& rFacets = kernels[side]->GetFacets();
+            facets[side].reserve(rFacets.size());
+            neighbours[side].reserve(rFacets.size());
+            for (const auto& face : rFacets) {
+                facets[side].push_back(
+                    {face._aulPoints[0] + offset,
+                     face._aulPoints[1] + offset,
+                     face._aulPoints[2] + offset}
+                );
+                neighbours[side].push_back(
+                    {face._aulNeighbours[0], face._aulNeighbours[1], face._aulNeighbours[2]}
+                );
+            }
+            offset += kernels[side]->CountPoints();
+        }
+
+        for (const auto& pnt : points) {
+            bbox.Add(pnt);
+        }
+
+        weldPoints();
+    }
+
+    std::size_t run(SetOperations::OperationType type)
+    {
+        // build both trees concurrently
+        auto future = std::async(std::launch::async, [this]() {
+            return std::make_unique<FacetTree>(points, facets[0]);
+        });
+        tree[1] = std::make_unique<FacetTree>(points, facets[1]);
+        tree[0] = future.get();
+
+        std::size_t intersections = intersect();
+        assignIndices();
+        for (int side = 0; side < 2; side++) {
+            split(side);
+        }
+        std::sort(cutEdges.begin(), cutEdges.end());
+        cutEdges.erase(std::unique(cutEdges.begin(), cutEdges.end()), cutEdges.end());
+        for (int side = 0; side < 2; side++) {
+            classify(side);
+        }
+
+        select(type);
+        return intersections;
+    }
+
+    void store(MeshKernel& kernel) const
+    {
+        std::vector<PointIndex> pointMap(points.size(), POINT_INDEX_MAX);
+        MeshPointArray newPoints;
+        MeshFacetArray newFacets;
+        newFacets.reserve(result.size());
+        for (const auto& tria : result) {
+            MeshFacet face;
+            for (int i = 0; i < 3; i++) {
+                PointIndex pnt = tria[i];
+                if (pointMap[pnt] == POINT_INDEX_MAX) {
+                    pointMap[pnt] = PointIndex(newPoints.size());
+                    const Base::Vector3d& pos = points[pnt];
+                    newPoints.emplace_back(
+                        Base::Vector3f(float(pos.x), float(pos.y), float(pos.z))
+                    );
+                }
+                face._aulPoints[i] = pointMap[pnt];
+            }
+            newFacets.push_back(face);
+        }
+
+        kernel.Adopt(newPoints, newFacets, true);
+    }
+
+private:
+    /**
+     * Calls \a func(worker, index) for all indices in [0, count). The indices are distributed
+     * in small interleaved chunks over the threads to balance the load, because the facets that
+     * need work usually are clustered.
+     */
+    template<class Func>
+    void forEach(std::size_t count, Func func) const
+    {
+        const std::size_t chunk = 256;
+        std::size_t numChunks = (count + chunk - 1) / chunk;
+        std::size_t workers = countWorkers(count);
+        auto work = [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t worker = begin; worker < end; worker++) {
+                for (std::size_t index = worker; index < numChunks; index += workers) {
+                    std::size_t last = std::min(count, (index + 1) * chunk);
+                    for (std::size_t i = index * chunk; i < last; i++) {
+                        func(worker, i);
+                    }
+                }
+            }
+        };
+        parallel_for_blocks(workers, int(workers), work);
+    }
+
+    std::size_t countWorkers(std::size_t count) const
+    {
+        std::size_t numChunks = (count + 255) / 256;
+        return std::min<std::size_t>(std::size_t(threads), std::max<std::size_t>(numChunks, 1));
+    }
+
+    static bool isDegenerated(const Triangle& tria)
+    {
+        return tria[0] == tria[1] || tria[1] == tria[2] || tria[2] == tria[0];
+    }
+
+    Base::Vector3d normal(const Triangle& tria) const
+    {
+        const Base::Vector3d& p0 = points[tria[0]];
+        return (points[tria[1]] - p0) % (points[tria[2]] - p0);
+    }
+
+    static bool isEqual(const Base::Vector3d& v1, const Base::Vector3d& v2)
+    {
+        return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z;
+    }
+
+    /**
+     * Points with identical coordinates get the same index so that both meshes share the
+     * vertices they have in common.
+     */
+    void weldPoints()
+    {
+        std::vector<PointIndex> order(points.size());
+        std::iota(order.begin(), order.end(), 0);
+        parallel_sort(
+            order.begin(),
+            order.end(),
+            [this](PointIndex p1, PointIndex p2) {
+                const Base::Vector3d& v1 = points[p1];
+                const Base::Vector3d& v2 = points[p2];
+                return std::tie(v1.x, v1.y, v1.z, p1) < std::tie(v2.x, v2.y, v2.z, p2);
+            },
+            threads
+        );
+
+        std::vector<PointIndex> canonical(points.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            if (i > 0 && isEqual(points[order[i]], points[order[i - 1]])) {
+                canonical[order[i]] = canonical[order[i - 1]];
+            }
+            else {
+                canonical[order[i]] = order[i];
+            }
+        }
+
+        for (auto& side : facets) {
+            for (auto& tria : side) {
+                for (auto& pnt : tria) {
+                    pnt = canonical[pnt];
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Intersection of the facet pairs
+
+    struct WorkerResult
+    {
+        std::vector<Constraint> constraints[2];
+        std::vector<std::pair<FacetIndex, FacetIndex>> coplanar;
+        std::size_t intersections {0};
+    };
+
+    std::size_t intersect()
+    {
+        std::vector<WorkerResult> work(countWorkers(facets[0].size()));
+        forEach(facets[0].size(), [&](std::size_t worker, std::size_t index) {
+            const Triangle& tria = facets[0][index];
+            if (isDegenerated(tria)) {
+                return;
+            }
+            tree[1]->search(tree[0]->boundBox(index), [&](FacetIndex other) {
+                intersectPair(index, other, work[worker]);
+            });
+        });
+
+        std::size_t intersections = 0;
+        for (auto& result : work) {
+            intersections += result.intersections;
+            for (int side = 0; side < 2; side++) {
+                constraints[side].insert(
+                    constraints[side].end(),
+                    result.constraints[side].begin(),
+                    result.constraints[side].end()
+                );
+            }
+            coplanar.insert(coplanar.end(), result.coplanar.begin(), result.coplanar.end());
+        }
+
+        for (auto& side : constraints) {
+            parallel_sort(side.begin(), side.end(), Constraint_Less(), threads);
+        }
+        std::sort(coplanar.begin(), coplanar.end());
+        return intersections;
+    }
+
+    void intersectPair(FacetIndex index1, FacetIndex index2, WorkerResult& work) const
+    {
+        const Triangle& tria1 = facets[0][index1];
+        const Triangle& tria2 = facets[1][index2];
+
+        std::array<int, 3> side1 {};
+        for (int i = 0; i < 3; i++) {
+            side1[i] = orientToPlane(tria2, points[tria1[i]]);
+        }
+        if (sameSign(side1)) {
+            return;
+        }
+        if (side1[0] == 0 && side1[1] == 0 && side1[2] == 0) {
+            intersectCoplanar(index1, index2, work);
+            return;
+        }
+
+        std::array<int, 3> side2 {};
+        for (int i = 0; i < 3; i++) {
+            side2[i] = orientToPlane(tria1, points[tria2[i]]);
+        }
+        if (sameSign(side2)) {
+            return;
+        }
+        if (side2[0] == 0 && side2[1] == 0 && side2[2] == 0) {
+            return;
+        }
+
+        std::vector<KeyedPoint> cut;
+        for (int i = 0; i < 3; i++) {
+            int j = (i + 1) % 3;
+            if (side1[i] * side1[j] < 0) {
+                crossFacet(0, tria1[i], tria1[j], 1, index2, cut);
+            }
+            if (side2[i] * side2[j] < 0) {
+                crossFacet(1, tria2[i], tria2[j], 0, index1, cut);
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            if (side1[i] == 0 && isInside(points[tria1[i]], tria2)) {
+                cut.push_back({vertexKey(tria1[i]), points[tria1[i]]});
+            }
+            if (side2[i] == 0 && isInside(points[tria2[i]], tria1)) {
+                cut.push_back({vertexKey(tria2[i]), points[tria2[i]]});
+            }
+        }
+
+        // all points lie on the intersection line of both planes
+        Base::Vector3d dir = normal(tria1) % normal(tria2);
+        if (addConstraints(cut, dir, {index1, index2}, work)) {
+            work.intersections++;
+        }
+    }
+
+    void intersectCoplanar(FacetIndex index1, FacetIndex index2, WorkerResult& work) const
+    {
+        const Triangle& tria1 = facets[0][index1];
+        const Triangle& tria2 = facets[1][index2];
+        Base::Vector3d norm = normal(tria1);
+        Projection proj(norm);
+        work.coplanar.emplace_back(index1, index2);
+
+        bool cuts = false;
+        for (int i = 0; i < 3; i++) {
+            int j = (i + 1) % 3;
+            std::vector<KeyedPoint> cut;
+            clipEdge(1, tria2[i], tria2[j], 0, index1, proj, cut);
+            Base::Vector3d dir = points[tria2[j]] - points[tria2[i]];
+            cuts |= addConstraints(cut, dir, {index1, FACET_INDEX_MAX}, work);
+
+            cut.clear();
+            clipEdge(0, tria1[i], tria1[j], 1, index2, proj, cut);
+            dir = points[tria1[j]] - points[tria1[i]];
+            cuts |= addConstraints(cut, dir, {FACET_INDEX_MAX, index2}, work);
+        }
+
+        if (cuts) {
+            work.intersections++;
+        }
+    }
+
+    /**
+     * Sorts the points along \a dir and adds the segments between consecutive points as
+     * constraints to the given facets.
+     */
+    static bool addConstraints(
+        std::vector<KeyedPoint>& cut,
+        const Base::Vector3d& dir,
+        const std::array<FacetIndex, 2>& facet,
+        WorkerResult& work
+    )
+    {
+        std::sort(cut.begin(), cut.end(), [](const KeyedPoint& p1, const KeyedPoint& p2) {
+            return p1.key < p2.key;
+        });
+        cut.erase(
+            std::unique(
+                cut.begin(),
+                cut.end(),
+                [](const KeyedPoint& p1, const KeyedPoint& p2) { return p1.key == p2.key; }
+            ),
+            cut.end()
+        );
+        if (cut.size() < 2) {
+            return false;
+        }
+
+        std::sort(cut.begin(), cut.end(), [&dir](const KeyedPoint& p1, const KeyedPoint& p2) {
+            return p1.pnt * dir < p2.pnt * dir;
+        });
+        for (std::size_t i = 1; i < cut.size(); i++) {
+            for (int side = 0; side < 2; side++) {
+                if (facet[side] == FACET_INDEX_MAX) {
+                    continue;
+                }
+                Constraint constraint;
+                constraint.facet = facet[side];
+                constraint.key = {cut[i - 1].key, cut[i].key};
+                constraint.pnt = {cut[i - 1].pnt, cut[i].pnt};
+                work.constraints[side].push_back(constraint);
+            }
+        }
+        return true;
+    }
+
+    static bool sameSign(const std::array<int, 3>& sign)
+    {
+        return (sign[0] > 0 && sign[1] > 0 && sign[2] > 0)
+            || (sign[0] < 0 && sign[1] < 0 && sign[2] < 0);
+    }
+
+    static bool mixedSigns(const std::array<int, 3>& sign)
+    {
+        int lowest = std::min({sign[0], sign[1], sign[2]});
+        int highest = std::max({sign[0], sign[1], sign[2]});
+        return lowest < 0 && highest > 0;
+    }
+
+    int orientToPlane(const Triangle& tria, const Base::Vector3d& pnt) const
+    {
+        return orient3d(points[tria[0]], points[tria[1]], points[tria[2]], pnt);
+    }
+
+    std::array<Point2, 3> project(const Projection& proj, const Triangle& tria) const
+    {
+        return {proj(points[tria[0]]), proj(points[tria[1]]), proj(points[tria[2]])};
+    }
+
+    static PointKey vertexKey(PointIndex pnt)
+    {
+        PointKey key;
+        key.type = PointKey::Vertex;
+        key.ids = {pnt, 0, 0, 0};
+        return key;
+    }
+
+    static PointKey edgeEdgeKey(int side, Edge edge, Edge other)
+    {
+        if (side == 1) {
+            std::swap(edge, other);
+        }
+        PointKey key;
+        key.type = PointKey::EdgeEdge;
+        key.ids = {edge.first, edge.second, other.first, other.second};
+        return key;
+    }
+
+    /**
+     * Checks where the edge (p, q) of \a side that crosses the plane of the facet \a index of
+     * \a other pierces the facet.
+     */
+    void crossFacet(
+        int side,
+        PointIndex p,
+        PointIndex q,
+        int other,
+        FacetIndex index,
+        std::vector<KeyedPoint>& cut
+    ) const
+    {
+        const Triangle& tria = facets[other][index];
+        std::array<int, 3> sign {};
+        for (int i = 0; i < 3; i++) {
+            sign[i] = orient3d(points[p], points[q], points[tria[i]], points[tria[(i + 1) % 3]]);
+        }
+        if (mixedSigns(sign)) {
+            return;
+        }
+
+        int zeros = int(std::count(sign.begin(), sign.end(), 0));
+        Edge edge = makeEdge(p, q);
+        if (zeros == 0) {
+            PointKey key;
+            key.type = PointKey::EdgeFacet;
+            key.ids = {edge.first, edge.second, index, (unsigned long)side};
+            cut.push_back({key, edgeFacetPoint(edge, tria)});
+        }
+        else if (zeros == 1) {
+            int pos = int(std::find(sign.begin(), sign.end(), 0) - sign.begin());
+            PointKey key = edgeEdgeKey(side, edge, makeEdge(tria[pos], tria[(pos + 1) % 3]));
+            cut.push_back({key, edgeEdgePoint(key)});
+        }
+        else if (zeros == 2) {
+            for (int i = 0; i < 3; i++) {
+                if (sign[i] != 0) {
+                    PointIndex pnt = tria[(i + 2) % 3];
+                    cut.push_back({vertexKey(pnt), points[pnt]});
+                }
+            }
+        }
+    }
+
+    /**
+     * Clips the edge (p, q) of \a side against the coplanar facet \a index of \a other.
+     */
+    void clipEdge(
+        int side,
+        PointIndex p,
+        PointIndex q,
+        int other,
+        FacetIndex index,
+        const Projection& proj,
+        std::vector<KeyedPoint>& cut
+    ) const
+    {
+        const Triangle& tria = facets[other][index];
+        std::array<Point2, 3> corner = project(proj, tria);
+        int orientation = orient2d(corner[0], corner[1], corner[2]);
+        if (orientation == 0) {
+            return;
+        }
+
+        Point2 p2 = proj(points[p]);
+        Point2 q2 = proj(points[q]);
+        for (PointIndex pnt : {p, q}) {
+            if (isInside(proj(points[pnt]), corner, orientation)) {
+                cut.push_back({vertexKey(pnt), points[pnt]});
+            }
+        }
+
+        Edge edge = makeEdge(p, q);
+        for (int i = 0; i < 3; i++) {
+            const Point2& c1 = corner[i];
+            const Point2& c2 = corner[(i + 1) % 3];
+            int s1 = orient2d(p2, q2, c1);
+            if (s1 == 0 && isBetween(p2, q2, c1)) {
+                cut.push_back({vertexKey(tria[i]), points[tria[i]]});
+            }
+            int s2 = orient2d(p2, q2, c2);
+            if (s1 * s2 < 0 && orient2d(c1, c2, p2) * orient2d(c1, c2, q2) < 0) {
+                PointKey key = edgeEdgeKey(side, edge, makeEdge(tria[i], tria[(i + 1) % 3]));
+                cut.push_back({key, edgeEdgePoint(key)});
+            }
+        }
+    }
+
+    static bool isBetween(const Point2& p, const Point2& q, const Point2& pnt)
+    {
+        // pnt is collinear with p and q
+        if (std::fabs(p.x - q.x) >= std::fabs(p.y - q.y)) {
+            return std::min(p.x, q.x) < pnt.x && pnt.x < std::max(p.x, q.x);
+        }
+        return std::min(p.y, q.y) < pnt.y && pnt.y < std::max(p.y, q.y);
+    }
+
+    static bool isInside(const Point2& pnt, const std::array<Point2, 3>& corner, int orientation)
+    {
+        for (int i = 0; i < 3; i++) {
+            if (orient2d(corner[i], corner[(i + 1) % 3], pnt) * orientation < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Checks if the point that lies in the plane of the facet is inside the closed facet. */
+    bool isInside(const Base::Vector3d& pnt, const Triangle& tria) const
+    {
+        Projection proj(normal(tria));
+        std::array<Point2, 3> corner = project(proj, tria);
+        int orientation = orient2d(corner[0], corner[1], corner[2]);
+        return orientation != 0 && isInside(proj(pnt), corner, orientation);
+    }
+
+    /** The intersection point only depends on the edge and the facet, so it is identical for
+     * all facet pairs it is computed for. */
+    Base::Vector3d edgeFacetPoint(const Edge& edge, const Triangle& tria) const
+    {
+        const Base::Vector3d& p = points[edge.first];
+        const Base::Vector3d& q = points[edge.second];
+        Base::Vector3d norm = normal(tria);
+        double dp = norm * (p - points[tria[0]]);
+        double dq = norm * (q - points[tria[0]]);
+        double t = dp != dq ? dp / (dp - dq) : 0.5;
+        t = std::clamp(t, 0.0, 1.0);
+        return p + (q - p) * t;
+    }
+
+    Base::Vector3d edgeEdgePoint(const PointKey& key) const
+    {
+        const Base::Vector3d& p = points[key.ids[0]];
+        Base::Vector3d u = points[key.ids[1]] - p;
+        Base::Vector3d v = points[key.ids[3]] - points[key.ids[2]];
+        Base::Vector3d w = u % v;
+        double den = w.Sqr();
+        double t = den > 0.0 ? (((points[key.ids[2]] - p) % v) * w) / den : 0.5;
+        t = std::clamp(t, 0.0, 1.0);
+        return p + u * t;
+    }
+
+    /** Gives all new points of the intersection curves an index. */
+    void assignIndices()
+    {
+        std::vector<KeyedPoint> created;
+        for (const auto& side : constraints) {
+            for (const auto& constraint : side) {
+                for (int i = 0; i < 2; i++) {
+                    if (constraint.key[i].type != PointKey::Vertex) {
+                        created.push_back({constraint.key[i], constraint.pnt[i]});
+                    }
+                }
+            }
+        }
+
+        auto keyLess = [](const KeyedPoint& p1, const KeyedPoint& p2) {
+            return p1.key < p2.key;
+        };
+        parallel_sort(created.begin(), created.end(), keyLess, threads);
+        created.erase(
+            std::unique(
+                created.begin(),
+                created.end(),
+                [](const KeyedPoint& p1, const KeyedPoint& p2) { return p1.key == p2.key; }
+            ),
+            created.end()
+        );
+
+        PointIndex offset = points.size();
+        for (const auto& pnt : created) {
+            points.push_back(pnt.pnt);
+        }
+
+        for (auto& side : constraints) {
+            forEach(side.size(), [&](std::size_t, std::size_t index) {
+                Constraint& constraint = side[index];
+                for (int i = 0; i < 2; i++) {
+                    const PointKey& key = constraint.key[i];
+                    if (key.type == PointKey::Vertex) {
+                        constraint.index[i] = key.ids[0];
+                    }
+                    else {
+                        KeyedPoint pnt {key, Base::Vector3d()};
+                        auto it = std::lower_bound(created.begin(), created.end(), pnt, keyLess);
+                        constraint.index[i] = offset + PointIndex(it - created.begin());
+                        constraint.pnt[i] = it->pnt;
+                    }
+                }
+            });
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Retriangulation of the cut facets
+
+    /** Returns the edge of the facet the point lies on or -1 if it's an inner point. */
+    int boundaryEdge(
+        int side,
+        const Triangle& tria,
+        const PointKey& key,
+        const std::array<Point2, 3>& corner,
+        const Point2& pnt
+    ) const
+    {
+        if (key.type == PointKey::Vertex) {
+            for (int i = 0; i < 3; i++) {
+                if (orient2d(corner[i], corner[(i + 1) % 3], pnt) == 0) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        Edge own;
+        if (key.type == PointKey::EdgeFacet) {
+            if (key.ids[3] != (unsigned long)side) {
+                return -1;
+            }
+            own = Edge(key.ids[0], key.ids[1]);
+        }
+        else {
+            own = side == 0 ? Edge(key.ids[0], key.ids[1]) : Edge(key.ids[2], key.ids[3]);
+        }
+
+        for (int i = 0; i < 3; i++) {
+            if (makeEdge(tria[i], tria[(i + 1) % 3]) == own) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    struct SplitResult
+    {
+        std::vector<Piece> pieces;
+    };
+
+    /** Splits the facet \a index into pieces along its constraints. */
+    void splitFacet(
+        int side,
+        FacetIndex index,
+        const Constraint* begin,
+        const Constraint* end,
+        const std::pair<FacetIndex, FacetIndex>* partnerBegin,
+        const std::pair<FacetIndex, FacetIndex>* partnerEnd,
+        std::vector<Piece>& pieces,
+        std::vector<Edge>& fixed
+    ) const
+    {
+        const Triangle& tria = facets[side][index];
+        Projection proj(normal(tria));
+        std::array<Point2, 3> corner = project(proj, tria);
+        if (orient2d(corner[0], corner[1], corner[2]) <= 0) {
+            pieces.push_back({tria, Degenerated});
+            return;
+        }
+
+        FacetSplitter splitter(corner);
+        std::vector<PointIndex> globalIndex(tria.begin(), tria.end());
+        std::vector<std::pair<PointIndex, int>> localIndex;
+        for (int i = 0; i < 3; i++) {
+            localIndex.emplace_back(tria[i], i);
+        }
+        auto findLocal = [&localIndex](PointIndex pnt) {
+            for (const auto& it : localIndex) {
+                if (it.first == pnt) {
+                    return it.second;
+                }
+            }
+            return -1;
+        };
+
+        // boundary points sorted along the edges, then the inner points
+        std::array<std::vector<std::pair<double, int>>, 3> boundary;
+        std::vector<int> inner;
+        for (const Constraint* it = begin; it != end; ++it) {
+            for (int i = 0; i < 2; i++) {
+                if (findLocal(it->index[i]) >= 0) {
+                    continue;
+                }
+                Point2 pnt = proj(it->pnt[i]);
+                int local = splitter.addVertex(pnt);
+                localIndex.emplace_back(it->index[i], local);
+                globalIndex.push_back(it->index[i]);
+
+                int edge = boundaryEdge(side, tria, it->key[i], corner, pnt);
+                if (edge >= 0) {
+                    const Base::Vector3d& p = points[tria[edge]];
+                    double param = (it->pnt[i] - p) * (points[tria[(edge + 1) % 3]] - p);
+                    boundary[edge].emplace_back(param, local);
+                }
+                else {
+                    inner.push_back(local);
+                }
+            }
+        }
+
+        for (int edge = 0; edge < 3; edge++) {
+            std::sort(boundary[edge].begin(), boundary[edge].end());
+            int prev = edge;
+            for (const auto& it : boundary[edge]) {
+                splitter.splitBoundary(prev, (edge + 1) % 3, it.second);
+                prev = it.second;
+            }
+        }
+
+        std::vector<int> alias(globalIndex.size());
+        std::iota(alias.begin(), alias.end(), 0);
+        for (int local : inner) {
+            alias[local] = splitter.insert(local);
+        }
+
+        for (const Constraint* it = begin; it != end; ++it) {
+            int u = alias[findLocal(it->index[0])];
+            int v = alias[findLocal(it->index[1])];
+            splitter.constrain(u, v);
+        }
+
+        for (const auto& edge : splitter.constraints()) {
+            fixed.push_back(makeEdge(globalIndex[edge.first], globalIndex[edge.second]));
+        }
+
+        // the pieces inside a coplanar facet of the other mesh
+        std::vector<std::array<Point2, 3>> partner;
+        std::vector<int> orientation;
+        for (auto it = partnerBegin; it != partnerEnd; ++it) {
+            const Triangle& other = facets[1 - side][it->second];
+            std::array<Point2, 3> corner = project(proj, other);
+            int orient = orient2d(corner[0], corner[1], corner[2]);
+            if (orient != 0) {
+                partner.push_back(corner);
+                orientation.push_back(orient);
+            }
+        }
+
+        for (const auto& local : splitter.triangles()) {
+            Piece piece;
+            piece.tria = {globalIndex[local[0]], globalIndex[local[1]], globalIndex[local[2]]};
+            if (isDegenerated(piece.tria)) {
+                continue;
+            }
+
+            const Point2& p0 = splitter.vertex(local[0]);
+            const Point2& p1 = splitter.vertex(local[1]);
+            const Point2& p2 = splitter.vertex(local[2]);
+            Point2 center {(p0.x + p1.x + p2.x) / 3.0, (p0.y + p1.y + p2.y) / 3.0};
+            for (std::size_t i = 0; i < partner.size(); i++) {
+                if (isInside(center, partner[i], orientation[i])) {
+                    piece.state = orientation[i] > 0 ? OnSame : OnOpposite;
+                    break;
+                }
+            }
+            pieces.push_back(piece);
+        }
+    }
+
+    void split(int side)
+    {
+        const std::vector<Constraint>& cons = constraints[side];
+
+        // the facets with constraints or with a coplanar facet of the other mesh
+        std::vector<std::pair<FacetIndex, FacetIndex>> partners = coplanar;
+        if (side == 1) {
+            for (auto& it : partners) {
+                std::swap(it.first, it.second);
+            }
+            std::sort(partners.begin(), partners.end());
+        }
+
+        std::vector<FacetIndex> touched;
+        touched.reserve(cons.size() + partners.size());
+        for (const auto& it : cons) {
+            touched.push_back(it.facet);
+        }
+        for (const auto& it : partners) {
+            touched.push_back(it.first);
+        }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+        std::vector<std::vector<Piece>> splitPieces(touched.size());
+        std::vector<std::vector<Edge>> fixed(countWorkers(touched.size()));
+        forEach(touched.size(), [&](std::size_t worker, std::size_t index) {
+            FacetIndex facet = touched[index];
+            auto lower = std::lower_bound(
+                cons.begin(),
+                cons.end(),
+                facet,
+                [](const Constraint& con, FacetIndex index) { return con.facet < index; }
+            );
+            auto upper = std::upper_bound(
+                lower,
+                cons.end(),
+                facet,
+                [](FacetIndex index, const Constraint& con) { return index < con.facet; }
+            );
+            auto partnerRange = std::equal_range(
+                partners.begin(),
+                partners.end(),
+                std::make_pair(facet, FacetIndex(0)),
+                [](const auto& p1, const auto& p2) { return p1.first < p2.first; }
+            );
+            splitFacet(
+                side,
+                facet,
+                cons.data() + (lower - cons.begin()),
+                cons.data() + (upper - cons.begin()),
+                partners.data() + (partnerRange.first - partners.begin()),
+                partners.data() + (partnerRange.second - partners.begin()),
+                splitPieces[index],
+                fixed[worker]
+            );
+        });
+
+        for (const auto& it : fixed) {
+            cutEdges.insert(cutEdges.end(), it.begin(), it.end());
+        }
+
+        // collect the pieces in the order of the facets
+        std::vector<Piece>& all = pieces[side];
+        std::vector<std::size_t>& first = firstPiece[side];
+        first.resize(facets[side].size() + 1);
+        all.reserve(facets[side].size() + touched.size());
+        std::size_t pos = 0;
+        for (FacetIndex index = 0; index < facets[side].size(); index++) {
+            first[index] = all.size();
+            if (pos < touched.size() && touched[pos] == index) {
+                all.insert(all.end(), splitPieces[pos].begin(), splitPieces[pos].end());
+                pos++;
+            }
+            else {
+                const Triangle& tria = facets[side][index];
+                all.push_back({tria, isDegenerated(tria) ? Degenerated : Unknown});
+            }
+        }
+        first.back() = all.size();
+        isTouched[side].assign(facets[side].size(), false);
+        for (FacetIndex index : touched) {
+            isTouched[side][index] = true;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Classification of the pieces
+
+    static std::size_t findRoot(std::vector<std::size_t>& parent, std::size_t index)
+    {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    }
+
+    static void unite(std::vector<std::size_t>& parent, std::size_t index1, std::size_t index2)
+    {
+        std::size_t root1 = findRoot(parent, index1);
+        std::size_t root2 = findRoot(parent, index2);
+        if (root1 != root2) {
+            parent[std::max(root1, root2)] = std::min(root1, root2);
+        }
+    }
+
+    bool isCutEdge(const Edge& edge) const
+    {
+        return std::binary_search(cutEdges.begin(), cutEdges.end(), edge);
+    }
+
+    /**
+     * Groups the pieces into regions that are bounded by the intersection curves and
+     * classifies each region by a single ray test.
+     */
+    void classify(int side)
+    {
+        std::vector<Piece>& all = pieces[side];
+        const std::vector<std::size_t>& first = firstPiece[side];
+        const std::vector<bool>& touched = isTouched[side];
+        std::vector<std::size_t> parent(all.size());
+        std::iota(parent.begin(), parent.end(), 0);
+
+        // untouched facets are connected by their original neighbourhood
+        std::vector<std::tuple<PointIndex, PointIndex, std::size_t>> edges;
+        for (FacetIndex index = 0; index < facets[side].size(); index++) {
+            bool nearCut = touched[index];
+            if (!nearCut && all[first[index]].state == Degenerated) {
+                continue;
+            }
+            for (FacetIndex neighbour : neighbours[side][index]) {
+                if (neighbour == FACET_INDEX_MAX || neighbour >= facets[side].size()) {
+                    continue;
+                }
+                if (touched[neighbour]) {
+                    nearCut = true;
+                }
+                else if (!touched[index] && all[first[neighbour]].state != Degenerated) {
+                    unite(parent, first[index], first[neighbour]);
+                }
+            }
+
+            // the pieces of cut facets and their neighbours are connected by common edges
+            if (nearCut) {
+                for (std::size_t piece = first[index]; piece < first[index + 1]; piece++) {
+                    const Triangle& tria = all[piece].tria;
+                    for (int i = 0; i < 3; i++) {
+                        Edge edge = makeEdge(tria[i], tria[(i + 1) % 3]);
+                        edges.emplace_back(edge.first, edge.second, piece);
+                    }
+                }
+            }
+        }
+
+        parallel_sort(edges.begin(), edges.end(), std::less<>(), threads);
+        for (std::size_t i = 0; i < edges.size();) {
+            std::size_t j = i + 1;
+            while (j < edges.size() && std::get<0>(edges[j]) == std::get<0>(edges[i])
+                   && std::get<1>(edges[j]) == std::get<1>(edges[i])) {
+                j++;
+            }
+            Edge edge(std::get<0>(edges[i]), std::get<1>(edges[i]));
+            if (j - i > 1 && !isCutEdge(edge)) {
+                std::size_t root = std::numeric_limits<std::size_t>::max();
+                for (std::size_t k = i; k < j; k++) {
+                    std::size_t piece = std::get<2>(edges[k]);
+                    if (all[piece].state != Unknown) {
+                        continue;
+                    }
+                    if (root == std::numeric_limits<std::size_t>::max()) {
+                        root = piece;
+                    }
+                    else {
+                        unite(parent, root, piece);
+                    }
+                }
+            }
+            i = j;
+        }
+
+        // the largest piece of each region is tested
+        std::vector<std::size_t> regions;
+        std::vector<std::size_t> best(all.size(), std::numeric_limits<std::size_t>::max());
+        std::vector<double> bestArea(all.size(), -1.0);
+        for (std::size_t piece = 0; piece < all.size(); piece++) {
+            if (all[piece].state != Unknown) {
+                continue;
+            }
+            std::size_t root = findRoot(parent, piece);
+            if (root == piece) {
+                regions.push_back(root);
+            }
+            double area = normal(all[piece].tria).Length();
+            if (area > bestArea[root]) {
+                bestArea[root] = area;
+                best[root] = piece;
+            }
+        }
+
+        std::vector<char> inside(regions.size());
+        forEach(regions.size(), [&](std::size_t, std::size_t index) {
+            const Triangle& tria = all[best[regions[index]]].tria;
+            Base::Vector3d center = (points[tria[0]] + points[tria[1]] + points[tria[2]]) / 3.0;
+            inside[index] = isInsideMesh(1 - side, center);
+        });
+
+        std::vector<char> state(all.size(), Unknown);
+        for (std::size_t index = 0; index < regions.size(); index++) {
+            state[regions[index]] = inside[index] ? Inside : Outside;
+        }
+        for (std::size_t piece = 0; piece < all.size(); piece++) {
+            if (all[piece].state == Unknown) {
+                all[piece].state = state[findRoot(parent, piece)];
+            }
+        }
+    }
+
+    /** Checks with a ray test if the point is inside the closed mesh of \a side. */
+    bool isInsideMesh(int side, const Base::Vector3d& pnt) const
+    {
+        static const std::array<Base::Vector3d, 6> directions {
+            Base::Vector3d(0.2381, 0.8127, 0.5319),
+            Base::Vector3d(-0.7012, 0.1187, 0.7031),
+            Base::Vector3d(0.4573, -0.6124, 0.6449),
+            Base::Vector3d(-0.3344, -0.4187, -0.8445),
+            Base::Vector3d(0.9131, 0.3079, -0.2672),
+            Base::Vector3d(-0.1563, 0.9713, -0.1792)
+        };
+
+        double length = 2.0 * bbox.CalcDiagonalLength() + 1.0;
+        bool inside = false;
+        for (const auto& dir : directions) {
+            Base::Vector3d end = pnt + dir * length;
+            bool degenerated = false;
+            int crossings = 0;
+            tree[side]->search(pnt, end, [&](FacetIndex index) {
+                if (degenerated) {
+                    return;
+                }
+                int result = rayCrossing(pnt, end, facets[side][index]);
+                if (result < 0) {
+                    degenerated = true;
+                }
+                else {
+                    crossings += result;
+                }
+            });
+
+            inside = (crossings % 2) == 1;
+            if (!degenerated) {
+                break;
+            }
+        }
+
+        return inside;
+    }
+
+    /** Returns 1 if the segment crosses the facet, 0 if not and -1 if it touches an edge. */
+    int rayCrossing(const Base::Vector3d& p, const Base::Vector3d& q, const Triangle& tria) const
+    {
+        const Base::Vector3d& t0 = points[tria[0]];
+        const Base::Vector3d& t1 = points[tria[1]];
+        const Base::Vector3d& t2 = points[tria[2]];
+        int s1 = orient3d(t0, t1, t2, p);
+        int s2 = orient3d(t0, t1, t2, q);
+        if (s1 == 0) {
+            return 0;
+        }
+        if (s2 == 0) {
+            return -1;
+        }
+        if (s1 == s2) {
+            return 0;
+        }
+
+        std::array<int, 3> sign {};
+        sign[0] = orient3d(p, q, t0, t1);
+        sign[1] = orient3d(p, q, t1, t2);
+        sign[2] = orient3d(p, q, t2, t0);
+        if (sameSign(sign)) {
+            return 1;
+        }
+        if (mixedSigns(sign)) {
+            return 0;
+        }
+        return -1;
+    }
+
+    void select(SetOperations::OperationType type)
+    {
+        auto keep = [type](int side, char state) {
+            switch (type) {
+                case SetOperations::Union:
+                    return state == Outside || (side == 0 && state == OnSame);
+                case SetOperations::Intersect:
+                    return state == Inside || (side == 0 && state == OnSame);
+                case SetOperations::Difference:
+                    return side == 0 ? (state == Outside || state == OnOpposite) : state == Inside;
+                case SetOperations::Inner:
+                    return side == 0 && (state == Inside || state == OnSame || state == OnOpposite);
+                case SetOperations::Outer:
+                    return side == 0 && state == Outside;
+                default:
+                    return false;
+            }
+        };
+
+        for (int side = 0; side < 2; side++) {
+            bool flip = side == 1 && type == SetOperations::Difference;
+            for (const auto& piece : pieces[side]) {
+                if (keep(side, piece.state)) {
+                    Triangle tria = piece.tria;
+                    if (flip) {
+                        std::swap(tria[0], tria[1]);
+                    }
+                    result.push_back(tria);
+                }
+            }
+        }
+    }
+
+private:
+    int threads;
+    std::vector<Base::Vector3d> points;
+    Base::BoundBox3d bbox;
+    std::vector<Triangle> facets[2];
+    std::vector<std::array<FacetIndex, 3>> neighbours[2];
+    std::unique_ptr<FacetTree> tree[2];
+    std::vector<Constraint> constraints[2];
+    std::vector<std::pair<FacetIndex, FacetIndex>> coplanar;
+    std::vector<Edge> cutEdges;
+    std::vector<Piece> pieces[2];
+    std::vector<std::size_t> firstPiece[2];
+    std::vector<bool> isTouched[2];
+    std::vector<Triangle> result;
+};
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+MeshBoolean::MeshBoolean(
+    const MeshKernel& mesh1,
+    const MeshKernel& mesh2,
+    MeshKernel& result,
+    SetOperations::OperationType opType
+)
+    : _mesh1(mesh1)
+    , _mesh2(mesh2)
+    , _result(result)
+    , _operationType(opType)
+    , _threads(int(std::thread::hardware_concurrency()))
+{}
+
+void MeshBoolean::SetThreads(int threads)
+{
+    _threads = threads > 0 ? threads : int(std::thread::hardware_concurrency());
+}
+
+void MeshBoolean::Do()
+{
+    BooleanAlgorithm alg(_mesh1, _mesh2, _threads);
+    _intersections = alg.run(_operationType);
+    alg.store(_result);
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <cstddef>
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+#include "SetOperations.h"
+
+namespace MeshCore
+{
+class MeshKernel;
+
+/**
+ * The MeshBoolean class is an alternative implementation of the set operations of
+ * SetOperations that is meant to be used for large or (partially) coplanar meshes.
+ *
+ * - Candidate facet pairs are found with a bounding volume hierarchy.
+ * - All decisions are made with exact orientation predicates, i.e. a floating point filter
+ *   with an exact fallback. Coplanar facets, vertices on facets and edges crossing edges are
+ *   handled explicitly. The intersection points are identified by the mesh elements they are
+ *   created from so that all facets sharing an element get the very same point.
+ * - Each cut facet is retriangulated on its own by inserting the intersection points and
+ *   recovering the intersection segments by edge flips. This is done concurrently.
+ * - The pieces bounded by the intersection curves are classified with a ray test against the
+ *   other mesh, coplanar pieces by comparing their orientation.
+ *
+ * Both meshes are expected to be closed and free of self-intersections.
+ */
+class MeshExport MeshBoolean
+{
+public:
+    MeshBoolean(
+        const MeshKernel& mesh1,
+        const MeshKernel& mesh2,
+        MeshKernel& result,
+        SetOperations::OperationType opType
+    );
+
+    /** Sets the number of threads. A value of zero uses as many threads as the hardware
+     * supports. */
+    void SetThreads(int);
+    /** Computes the set operation. */
+    void Do();
+    /** Returns the number of facet pairs that intersect each other. */
+    std::size_t CountIntersections() const
+    {
+        return _intersections;
+    }
+
+private:
+    const MeshKernel& _mesh1;
+    const MeshKernel& _mesh2;
+    MeshKernel& _result;
+    SetOperations::OperationType _operationType;
+    int _threads;
+    std::size_t _intersections {0};
+};
+
+}  // namespace MeshCore
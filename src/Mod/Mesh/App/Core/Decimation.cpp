@@ -22,9 +22,14 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <thread>
 
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
@@ -154,3 +159,682 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Symmetric 4x4 matrix of the quadric error metric
+struct Quadric
+{
+    // a2, ab, ac, ad, b2, bc, bd, c2, cd, d2
+    std::array<double, 10> m {};
+
+    static Quadric fromPlane(const Base::Vector3d& n, double d, double weight)
+    {
+        Quadric q;
+        q.m = {n.x * n.x, n.x * n.y, n.x * n.z, n.x * d, n.y * n.y,
+               n.y * n.z, n.y * d,   n.z * n.z, n.z * d, d * d};
+        for (double& v : q.m) {
+            v *= weight;
+        }
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& q)
+    {
+        for (std::size_t i = 0; i < m.size(); i++) {
+            m[i] += q.m[i];
+        }
+        return *this;
+    }
+
+    double error(const Base::Vector3d& v) const
+    {
+        double x = v.x;
+        double y = v.y;
+        double z = v.z;
+        double e = m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x + m[4] * y * y
+            + 2 * m[5] * y * z + 2 * m[6] * y + m[7] * z * z + 2 * m[8] * z + m[9];
+        return std::max(e, 0.0);
+    }
+
+    bool optimum(Base::Vector3d& v) const
+    {
+        // solve the 3x3 system with Cramer's rule
+        double det = m[0] * (m[4] * m[7] - m[5] * m[5]) - m[1] * (m[1] * m[7] - m[5] * m[2])
+            + m[2] * (m[1] * m[5] - m[4] * m[2]);
+        double scale = std::abs(m[0]) + std::abs(m[4]) + std::abs(m[7]);
+        if (std::abs(det) <= 1e-12 * scale * scale * scale) {
+            return false;
+        }
+
+        double bx = -m[3];
+        double by = -m[6];
+        double bz = -m[8];
+        v.x = (bx * (m[4] * m[7] - m[5] * m[5]) - m[1] * (by * m[7] - m[5] * bz)
+               + m[2] * (by * m[5] - m[4] * bz))
+            / det;
+        v.y = (m[0] * (by * m[7] - bz * m[5]) - bx * (m[1] * m[7] - m[5] * m[2])
+               + m[2] * (m[1] * bz - by * m[2]))
+            / det;
+        v.z = (m[0] * (m[4] * bz - m[5] * by) - m[1] * (m[1] * bz - by * m[2])
+               + bx * (m[1] * m[5] - m[4] * m[2]))
+            / det;
+        return true;
+    }
+};
+
+// Weight of the constraint planes along feature edges
+constexpr double featureWeight = 1000.0;
+// Reject collapses that turn a facet by more than ~78 degree
+constexpr double minCosFlip = 0.2;
+// Reject collapses that create facets with a worse ratio of twice the area to the sum of
+// the squared edge lengths (an equilateral triangle has ~0.577)
+constexpr double minQuality = 0.02;
+
+enum VertexFlag : unsigned char
+{
+    Removed = 1,
+    Boundary = 2,
+    OnFeature = 4,
+    Locked = 8
+};
+
+struct Collapse
+{
+    double cost {0.0};
+    PointIndex keep {0};
+    PointIndex remove {0};
+    Base::Vector3d pos;
+    double dist {0.0};
+    int numFacets {0};
+};
+
+struct Collapse_Less
+{
+    bool operator()(const Collapse& x, const Collapse& y) const
+    {
+        if (x.cost != y.cost) {
+            return x.cost < y.cost;
+        }
+        if (x.keep != y.keep) {
+            return x.keep < y.keep;
+        }
+        return x.remove < y.remove;
+    }
+};
+
+struct EdgeInfo
+{
+    PointIndex other;
+    int count;
+    FacetIndex facets[2];
+};
+
+class QuadricDecimation
+{
+public:
+    QuadricDecimation(const MeshKernel& kernel, std::vector<unsigned long>& segments)
+        : segments(segments)
+    {
+        const MeshPointArray& points = kernel.GetPoints();
+        pos.reserve(points.size());
+        for (const auto& pnt : points) {
+            pos.emplace_back(pnt.x, pnt.y, pnt.z);
+        }
+        const MeshFacetArray& facets = kernel.GetFacets();
+        tria.reserve(facets.size());
+        for (const auto& face : facets) {
+            tria.push_back({face._aulPoints[0], face._aulPoints[1], face._aulPoints[2]});
+        }
+        quadrics.resize(pos.size());
+        dist.resize(pos.size(), 0.0);
+        flags.resize(pos.size(), 0);
+        dead.resize(tria.size(), 0);
+        numLive = tria.size();
+        if (segments.size() != tria.size()) {
+            segments.assign(tria.size(), 0);
+        }
+    }
+
+    std::size_t run(const MeshQuadricDecimation::Parameters& param)
+    {
+        threads = param.threads > 0 ? param.threads : int(std::thread::hardware_concurrency());
+        std::size_t start = numLive;
+
+        cosCrease = param.creaseAngle > 0.0 ? std::cos(param.creaseAngle) : -2.0;
+        preserveBoundary = param.preserveBoundary;
+        preserveSegments = param.preserveSegments;
+        maxError = param.maxError;
+        maxDistance = param.maxDistance;
+
+        bool first = true;
+        while (numLive > param.targetSize) {
+            buildAdjacency();
+            classifyVertices(first);
+            first = false;
+
+            std::vector<Collapse> collapses = evaluateCollapses();
+            if (collapses.empty()) {
+                break;
+            }
+
+            parallel_sort(collapses.begin(), collapses.end(), Collapse_Less(), threads);
+            std::vector<Collapse> selection = selectIndependent(collapses, numLive - param.targetSize);
+            if (selection.empty()) {
+                break;
+            }
+
+            applyCollapses(selection);
+        }
+
+        return start - numLive;
+    }
+
+    void store(MeshKernel& kernel)
+    {
+        std::vector<PointIndex> pointMap(pos.size(), POINT_INDEX_MAX);
+        MeshPointArray newPoints;
+        MeshFacetArray newFacets;
+        newFacets.reserve(numLive);
+        std::vector<unsigned long> newSegments;
+        newSegments.reserve(numLive);
+        for (std::size_t index = 0; index < tria.size(); index++) {
+            if (dead[index]) {
+                continue;
+            }
+            MeshFacet face;
+            for (int i = 0; i < 3; i++) {
+                PointIndex pnt = tria[index][i];
+                if (pointMap[pnt] == POINT_INDEX_MAX) {
+                    pointMap[pnt] = PointIndex(newPoints.size());
+                    newPoints.emplace_back(
+                        Base::Vector3f(float(pos[pnt].x), float(pos[pnt].y), float(pos[pnt].z))
+                    );
+                }
+                face._aulPoints[i] = pointMap[pnt];
+            }
+            newFacets.push_back(face);
+            newSegments.push_back(segments[index]);
+        }
+
+        segments.swap(newSegments);
+        kernel.Adopt(newPoints, newFacets, true);
+    }
+
+private:
+    void buildAdjacency()
+    {
+        std::size_t numPoints = pos.size();
+        offsets.assign(numPoints + 1, 0);
+        for (std::size_t index = 0; index < tria.size(); index++) {
+            if (!dead[index]) {
+                for (PointIndex pnt : tria[index]) {
+                    offsets[pnt + 1]++;
+                }
+            }
+        }
+        for (std::size_t index = 0; index < numPoints; index++) {
+            offsets[index + 1] += offsets[index];
+        }
+
+        ring.resize(offsets[numPoints]);
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t index = 0; index < tria.size(); index++) {
+            if (!dead[index]) {
+                for (PointIndex pnt : tria[index]) {
+                    ring[fill[pnt]++] = FacetIndex(index);
+                }
+            }
+        }
+    }
+
+    Base::Vector3d normal(FacetIndex index) const
+    {
+        const auto& t = tria[index];
+        return (pos[t[1]] - pos[t[0]]) % (pos[t[2]] - pos[t[0]]);
+    }
+
+    // Collects the edges around a vertex with the number of facets sharing them
+    void collectEdges(PointIndex vertex, std::vector<EdgeInfo>& edges) const
+    {
+        edges.clear();
+        for (std::size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+            FacetIndex facet = ring[i];
+            for (PointIndex other : tria[facet]) {
+                if (other == vertex) {
+                    continue;
+                }
+                auto it = std::find_if(edges.begin(), edges.end(), [other](const EdgeInfo& e) {
+                    return e.other == other;
+                });
+                if (it == edges.end()) {
+                    edges.push_back({other, 1, {facet, FACET_INDEX_MAX}});
+                }
+                else {
+                    if (it->count < 2) {
+                        it->facets[it->count] = facet;
+                    }
+                    it->count++;
+                }
+            }
+        }
+    }
+
+    bool isFeatureEdge(const EdgeInfo& edge) const
+    {
+        if (edge.count != 2) {
+            return edge.count > 2 || preserveBoundary;
+        }
+        if (preserveSegments && segments[edge.facets[0]] != segments[edge.facets[1]]) {
+            return true;
+        }
+        if (cosCrease > -1.0) {
+            Base::Vector3d n0 = normal(edge.facets[0]);
+            Base::Vector3d n1 = normal(edge.facets[1]);
+            double len = n0.Length() * n1.Length();
+            if (len > 0.0 && (n0 * n1) < cosCrease * len) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void classifyVertices(bool initQuadrics)
+    {
+        parallel_for_blocks(pos.size(), threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::vector<EdgeInfo> edges;
+            for (std::size_t index = begin; index < end; index++) {
+                PointIndex vertex = PointIndex(index);
+                if (flags[vertex] & Removed) {
+                    continue;
+                }
+
+                unsigned char flag = 0;
+                int numFeatures = 0;
+                collectEdges(vertex, edges);
+                for (const auto& edge : edges) {
+                    if (edge.count == 1) {
+                        flag |= Boundary;
+                    }
+                    else if (edge.count > 2) {
+                        flag |= Locked;
+                    }
+                    if (isFeatureEdge(edge)) {
+                        numFeatures++;
+                        if (initQuadrics) {
+                            addConstraint(vertex, edge);
+                        }
+                    }
+                }
+
+                if (numFeatures == 2) {
+                    flag |= OnFeature;
+                }
+                else if (numFeatures > 0) {
+                    flag |= Locked;
+                }
+                flags[vertex] = flag;
+
+                if (initQuadrics) {
+                    for (std::size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+                        Base::Vector3d n = normal(ring[i]);
+                        if (n.Length() > 0.0) {
+                            n.Normalize();
+                            quadrics[vertex] += Quadric::fromPlane(n, -(n * pos[vertex]), 1.0);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    // Adds a plane perpendicular to the facet through the feature edge
+    void addConstraint(PointIndex vertex, const EdgeInfo& edge)
+    {
+        Base::Vector3d dir = pos[edge.other] - pos[vertex];
+        for (int i = 0; i < std::min(edge.count, 2); i++) {
+            Base::Vector3d n = dir % normal(edge.facets[i]);
+            if (n.Length() > 0.0) {
+                n.Normalize();
+                double weight = featureWeight * (dir * dir);
+                quadrics[vertex] += Quadric::fromPlane(n, -(n * pos[vertex]), weight);
+            }
+        }
+    }
+
+    bool isEdgeFeature(PointIndex v0, PointIndex v1, std::vector<EdgeInfo>& edges) const
+    {
+        collectEdges(v0, edges);
+        for (const auto& edge : edges) {
+            if (edge.other == v1) {
+                return isFeatureEdge(edge);
+            }
+        }
+        return false;
+    }
+
+    // Checks that the collapse keeps the mesh manifold and doesn't flip facets
+    bool isValid(
+        PointIndex v0,
+        PointIndex v1,
+        const EdgeInfo& edge,
+        const Base::Vector3d& target,
+        std::vector<PointIndex>& n0,
+        std::vector<PointIndex>& n1
+    ) const
+    {
+        // link condition: the common neighbours must be the opposite vertices of the edge
+        auto neighbours = [this](PointIndex vertex, std::vector<PointIndex>& result) {
+            result.clear();
+            for (std::size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+                for (PointIndex other : tria[ring[i]]) {
+                    if (other != vertex) {
+                        result.push_back(other);
+                    }
+                }
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+        };
+        neighbours(v0, n0);
+        neighbours(v1, n1);
+        std::size_t common = 0;
+        auto it0 = n0.begin();
+        auto it1 = n1.begin();
+        while (it0 != n0.end() && it1 != n1.end()) {
+            if (*it0 < *it1) {
+                ++it0;
+            }
+            else if (*it1 < *it0) {
+                ++it1;
+            }
+            else {
+                common++;
+                ++it0;
+                ++it1;
+            }
+        }
+        if (common != std::size_t(edge.count)) {
+            return false;
+        }
+        // an inner edge connecting two boundary vertices would pinch the mesh
+        if (edge.count == 2 && (flags[v0] & Boundary) && (flags[v1] & Boundary)) {
+            return false;
+        }
+        // a single facet mustn't vanish completely
+        if (offsets[v0 + 1] - offsets[v0] + offsets[v1 + 1] - offsets[v1] <= std::size_t(edge.count)) {
+            return false;
+        }
+
+        for (PointIndex vertex : {v0, v1}) {
+            for (std::size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+                FacetIndex facet = ring[i];
+                const auto& t = tria[facet];
+                if (std::find(t.begin(), t.end(), vertex == v0 ? v1 : v0) != t.end()) {
+                    continue;  // will be removed
+                }
+                std::array<Base::Vector3d, 3> p {pos[t[0]], pos[t[1]], pos[t[2]]};
+                for (int j = 0; j < 3; j++) {
+                    if (t[j] == vertex) {
+                        p[j] = target;
+                    }
+                }
+                Base::Vector3d nold = normal(facet);
+                Base::Vector3d nnew = (p[1] - p[0]) % (p[2] - p[0]);
+                double len = nold.Length() * nnew.Length();
+                if (len <= 0.0 || (nold * nnew) < minCosFlip * len) {
+                    return false;
+                }
+                // avoid creating slivers
+                double quality = nnew.Length() / (Base::DistanceP2(p[0], p[1])
+                    + Base::DistanceP2(p[1], p[2]) + Base::DistanceP2(p[2], p[0]));
+                if (quality < minQuality) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<Collapse> evaluateCollapses() const
+    {
+        std::vector<std::vector<Collapse>> results(std::max(threads, 1));
+        parallel_for_blocks(pos.size(), threads, [&](std::size_t block, std::size_t begin, std::size_t end) {
+            std::vector<Collapse>& result = results[block];
+            std::vector<EdgeInfo> edges;
+            std::vector<PointIndex> n0, n1;
+            for (std::size_t index = begin; index < end; index++) {
+                PointIndex v0 = PointIndex(index);
+                if (flags[v0] & Removed) {
+                    continue;
+                }
+                collectEdges(v0, edges);
+                for (const auto& edge : edges) {
+                    PointIndex v1 = edge.other;
+                    if (v1 < v0 || edge.count > 2) {
+                        continue;
+                    }
+                    Collapse collapse;
+                    if (evaluate(v0, v1, edge, collapse) && isValid(v0, v1, edge, collapse.pos, n0, n1)) {
+                        result.push_back(collapse);
+                    }
+                }
+            }
+        });
+
+        std::vector<Collapse> collapses;
+        for (const auto& result : results) {
+            collapses.insert(collapses.end(), result.begin(), result.end());
+        }
+        return collapses;
+    }
+
+    bool evaluate(PointIndex v0, PointIndex v1, const EdgeInfo& edge, Collapse& collapse) const
+    {
+        unsigned char f0 = flags[v0];
+        unsigned char f1 = flags[v1];
+        if ((f0 & Locked) && (f1 & Locked)) {
+            return false;
+        }
+
+        Quadric q = quadrics[v0];
+        q += quadrics[v1];
+
+        bool edgeFeature = isFeatureEdge(edge);
+        std::vector<Base::Vector3d> targets;
+        if (f0 & Locked) {
+            if ((f1 & OnFeature) && !edgeFeature) {
+                return false;
+            }
+            targets.push_back(pos[v0]);
+        }
+        else if (f1 & Locked) {
+            if ((f0 & OnFeature) && !edgeFeature) {
+                return false;
+            }
+            targets.push_back(pos[v1]);
+        }
+        else if ((f0 & OnFeature) && (f1 & OnFeature)) {
+            if (!edgeFeature) {
+                return false;
+            }
+            targets = {pos[v0], pos[v1], (pos[v0] + pos[v1]) / 2.0};
+        }
+        else if (f0 & OnFeature) {
+            targets.push_back(pos[v0]);
+        }
+        else if (f1 & OnFeature) {
+            targets.push_back(pos[v1]);
+        }
+        else {
+            Base::Vector3d opt;
+            if (q.optimum(opt)) {
+                targets.push_back(opt);
+            }
+            else {
+                targets = {pos[v0], pos[v1], (pos[v0] + pos[v1]) / 2.0};
+            }
+        }
+
+        collapse.cost = std::numeric_limits<double>::max();
+        for (const auto& target : targets) {
+            double cost = q.error(target);
+            if (cost < collapse.cost) {
+                collapse.cost = cost;
+                collapse.pos = target;
+            }
+        }
+        if (collapse.cost > maxError) {
+            return false;
+        }
+
+        collapse.dist = std::max(
+            dist[v0] + Base::Distance(collapse.pos, pos[v0]),
+            dist[v1] + Base::Distance(collapse.pos, pos[v1])
+        );
+        if (collapse.dist > maxDistance) {
+            return false;
+        }
+
+        // keep the vertex that stays in place, if any
+        bool keepFirst = true;
+        if (!(f0 & Locked) && (f1 & (Locked | OnFeature))) {
+            keepFirst = (f0 & OnFeature) && !(f1 & Locked);
+        }
+        collapse.keep = keepFirst ? v0 : v1;
+        collapse.remove = keepFirst ? v1 : v0;
+        collapse.numFacets = edge.count;
+        return true;
+    }
+
+    std::vector<Collapse> selectIndependent(const std::vector<Collapse>& collapses, std::size_t budget)
+    {
+        std::vector<Collapse> selection;
+        std::vector<char> marked(tria.size(), 0);
+        std::size_t removed = 0;
+        auto isFree = [&](PointIndex vertex) {
+            for (std::size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+                if (marked[ring[i]]) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        auto mark = [&](PointIndex vertex) {
+            for (std::size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+                marked[ring[i]] = 1;
+            }
+        };
+
+        for (const auto& collapse : collapses) {
+            if (removed >= budget) {
+                break;
+            }
+            if (isFree(collapse.keep) && isFree(collapse.remove)) {
+                mark(collapse.keep);
+                mark(collapse.remove);
+                selection.push_back(collapse);
+                removed += std::size_t(collapse.numFacets);
+            }
+        }
+
+        return selection;
+    }
+
+    void applyCollapses(const std::vector<Collapse>& selection)
+    {
+        // the one-rings of the selected collapses are disjoint
+        std::vector<std::size_t> removedFacets(std::max(threads, 1), 0);
+        parallel_for_blocks(selection.size(), threads, [&](std::size_t block, std::size_t begin, std::size_t end) {
+            for (std::size_t index = begin; index < end; index++) {
+                const Collapse& collapse = selection[index];
+                PointIndex keep = collapse.keep;
+                PointIndex remove = collapse.remove;
+                pos[keep] = collapse.pos;
+                quadrics[keep] += quadrics[remove];
+                dist[keep] = collapse.dist;
+                flags[remove] |= Removed;
+
+                for (std::size_t i = offsets[remove]; i < offsets[remove + 1]; i++) {
+                    FacetIndex facet = ring[i];
+                    auto& t = tria[facet];
+                    if (std::find(t.begin(), t.end(), keep) != t.end()) {
+                        dead[facet] = 1;
+                        removedFacets[block]++;
+                    }
+                    else {
+                        std::replace(t.begin(), t.end(), remove, keep);
+                    }
+                }
+            }
+        });
+
+        for (std::size_t count : removedFacets) {
+            numLive -= count;
+        }
+    }
+
+private:
+    std::vector<Base::Vector3d> pos;
+    std::vector<std::array<PointIndex, 3>> tria;
+    std::vector<Quadric> quadrics;
+    std::vector<double> dist;
+    std::vector<unsigned char> flags;
+    std::vector<char> dead;
+    std::vector<unsigned long>& segments;
+    std::vector<std::size_t> offsets;
+    std::vector<FacetIndex> ring;
+    std::size_t numLive {0};
+    int threads {1};
+    double cosCrease {-2.0};
+    double maxError {0.0};
+    double maxDistance {0.0};
+    bool preserveBoundary {true};
+    bool preserveSegments {true};
+};
+
+}  // namespace
+
+MeshQuadricDecimation::MeshQuadricDecimation(MeshKernel& mesh)
+    : myKernel(mesh)
+{}
+
+void MeshQuadricDecimation::SetSegments(const std::vector<std::vector<FacetIndex>>& segments)
+{
+    numSegments = static_cast<unsigned long>(segments.size());
+    facetSegments.assign(myKernel.CountFacets(), numSegments);
+    for (std::size_t index = 0; index < segments.size(); index++) {
+        for (FacetIndex facet : segments[index]) {
+            if (facet < facetSegments.size()) {
+                facetSegments[facet] = static_cast<unsigned long>(index);
+            }
+        }
+    }
+}
+
+std::vector<std::vector<FacetIndex>> MeshQuadricDecimation::GetSegments() const
+{
+    std::vector<std::vector<FacetIndex>> segments(numSegments);
+    for (std::size_t index = 0; index < facetSegments.size(); index++) {
+        if (facetSegments[index] < numSegments) {
+            segments[facetSegments[index]].push_back(FacetIndex(index));
+        }
+    }
+    return segments;
+}
+
+std::size_t MeshQuadricDecimation::Decimate(const Parameters& param)
+{
+    if (facetSegments.size() != myKernel.CountFacets()) {
+        facetSegments.assign(myKernel.CountFacets(), numSegments);
+    }
+
+    QuadricDecimation alg(myKernel, facetSegments);
+    std::size_t removed = alg.run(param);
+    alg.store(myKernel);
+    return removed;
+}
@@ -25,8 +25,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <limits>
+#include <vector>
+
 #include <Mod/Mesh/MeshGlobal.h>
 
+#include "Definitions.h"
+
 namespace MeshCore
 {
 class MeshKernel;
@@ -42,4 +48,54 @@ private:
     MeshKernel& myKernel;
 };
 
+/**
+ * The MeshQuadricDecimation class reduces the number of facets by edge collapses ordered by
+ * the quadric error metric of Garland and Heckbert.
+ * Unlike MeshSimplify it works in passes where each pass evaluates all edges concurrently and
+ * selects a set of collapses whose one-rings don't share any facet. Since these collapses are
+ * independent of each other they are applied concurrently, too.
+ * Boundary edges, crease edges and the borders between segments are kept as feature lines:
+ * vertices on a feature line may only move along it and feature corners are never moved.
+ * @note The distance bound is checked conservatively, i.e. each vertex accumulates the
+ * displacements of all vertices collapsed into it, so the real Hausdorff distance of the
+ * original vertices to the decimated mesh never exceeds \a maxDistance.
+ */
+class MeshExport MeshQuadricDecimation
+{
+public:
+    struct Parameters
+    {
+        /** Stop as soon as the number of facets is reduced to this value. */
+        std::size_t targetSize {0};
+        /** Upper bound for the quadric error, i.e. the sum of squared distances to the
+         * planes of the original facets, of a single collapse. */
+        double maxError {std::numeric_limits<double>::max()};
+        /** Hard upper bound for the distance of the original vertices to the decimated mesh. */
+        double maxDistance {std::numeric_limits<double>::max()};
+        /** Keep the boundary edges as feature lines. */
+        bool preserveBoundary {true};
+        /** Keep the borders of the segments set with SetSegments() as feature lines. */
+        bool preserveSegments {true};
+        /** Edges whose adjacent facets enclose an angle above this value (in radian) are kept
+         * as feature lines. A value of zero disables the crease detection. */
+        double creaseAngle {0.0};
+        /** Number of threads, zero uses the number of available cores. */
+        int threads {0};
+    };
+
+    explicit MeshQuadricDecimation(MeshKernel&);
+    /** Sets the segments of the mesh. A facet not part of any segment is regarded as part
+     * of a separate segment. */
+    void SetSegments(const std::vector<std::vector<FacetIndex>>&);
+    /** Returns the segments of the decimated mesh in the order they were set. */
+    std::vector<std::vector<FacetIndex>> GetSegments() const;
+    /** Decimates the mesh and returns the number of removed facets. */
+    std::size_t Decimate(const Parameters&);
+
+private:
+    MeshKernel& myKernel;
+    std::vector<unsigned long> facetSegments;
+    unsigned long numSegments {0};
+};
+
 }  // namespace MeshCore
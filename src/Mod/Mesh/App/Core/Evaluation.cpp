@@ -24,6 +24,9 @@
 
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
 #include <vector>
 
 
@@ -1051,6 +1054,559 @@ void MeshKernel::RebuildNeighbours()
 
 // ----------------------------------------------------------------
 
+bool MeshDefectReport::IsValid() const
+{
+    return wrongOrientedFacets.empty() && nonManifoldEdges.empty() && nonManifoldPoints.empty()
+        && duplicatedPoints.empty() && duplicatedFacets.empty() && degeneratedFacets.empty()
+        && foldsOnSurface.empty() && selfIntersections.empty();
+}
+
+void MeshDefectReport::Clear()
+{
+    wrongOrientedFacets.clear();
+    nonManifoldEdges.clear();
+    nonManifoldFacets.clear();
+    nonManifoldPoints.clear();
+    duplicatedPoints.clear();
+    duplicatedFacets.clear();
+    degeneratedFacets.clear();
+    foldsOnSurface.clear();
+    selfIntersections.clear();
+}
+
+namespace MeshCore
+{
+
+struct Edge_EqualTo
+{
+    bool operator()(const Edge_Index& x, const Edge_Index& y) const
+    {
+        return x.p0 == y.p0 && x.p1 == y.p1;
+    }
+};
+
+struct Point_Index
+{
+    PointIndex index;
+    const MeshPoint* point;
+};
+
+// Sort by coordinates and use the index to get a deterministic order of equal points
+struct Point_Index_Less
+{
+    bool operator()(const Point_Index& x, const Point_Index& y) const
+    {
+        if (*x.point < *y.point) {
+            return true;
+        }
+        if (*y.point < *x.point) {
+            return false;
+        }
+        return x.index < y.index;
+    }
+};
+
+struct Facet_Key
+{
+    PointIndex p[3];
+    FacetIndex f;
+};
+
+struct Facet_Key_Less
+{
+    bool operator()(const Facet_Key& x, const Facet_Key& y) const
+    {
+        for (int i = 0; i < 3; i++) {
+            if (x.p[i] != y.p[i]) {
+                return x.p[i] < y.p[i];
+            }
+        }
+        return x.f < y.f;
+    }
+};
+
+}  // namespace MeshCore
+
+MeshEvalDefects::MeshEvalDefects(const MeshKernel& rclB, float fEps)
+    : MeshEvaluation(rclB)
+    , _fEpsilon(fEps)
+    , _threads(int(std::thread::hardware_concurrency()))
+{}
+
+bool MeshEvalDefects::Evaluate()
+{
+    _report.Clear();
+    if (_rclMesh.CountFacets() == 0) {
+        return true;
+    }
+
+    if (_checks & (Orientation | NonManifoldEdges | NonManifoldPoints)) {
+        CheckEdges();
+    }
+    if (_checks & (DegeneratedFacets | Folds)) {
+        CheckFacets();
+    }
+    if (_checks & DuplicatedPoints) {
+        CheckDuplicatedPoints();
+    }
+    if (_checks & DuplicatedFacets) {
+        CheckDuplicatedFacets();
+    }
+    if (_checks & SelfIntersections) {
+        CheckSelfIntersections();
+    }
+
+    return _report.IsValid();
+}
+
+void MeshEvalDefects::CheckEdges()
+{
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    std::size_t numFacets = rFaces.size();
+    std::size_t numPoints = _rclMesh.CountPoints();
+
+    // the edge array is shared by the orientation, edge and point manifold checks
+    std::vector<Edge_Index> edges(3 * numFacets);
+    std::vector<std::atomic<unsigned int>> facetsPerPoint(numPoints);
+    bool checkPoints = (_checks & NonManifoldPoints) != 0;
+    parallel_for_blocks(numFacets, _threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            const MeshFacet& face = rFaces[index];
+            for (int i = 0; i < 3; i++) {
+                Edge_Index& item = edges[3 * index + i];
+                item.p0 = std::min<PointIndex>(face._aulPoints[i], face._aulPoints[(i + 1) % 3]);
+                item.p1 = std::max<PointIndex>(face._aulPoints[i], face._aulPoints[(i + 1) % 3]);
+                item.f = FacetIndex(index);
+                if (checkPoints) {
+                    facetsPerPoint[face._aulPoints[i]].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+
+    parallel_sort(edges.begin(), edges.end(), Edge_Less(), _threads);
+
+    // Each block must start at the beginning of a group of equal edges
+    Edge_EqualTo equalEdge;
+    auto alignToGroup = [&edges, equalEdge](std::size_t pos) {
+        while (pos > 0 && pos < edges.size() && equalEdge(edges[pos - 1], edges[pos])) {
+            pos++;
+        }
+        return pos;
+    };
+
+    struct EdgeResult
+    {
+        std::vector<std::pair<PointIndex, PointIndex>> nonManifolds;
+        std::list<std::vector<FacetIndex>> facets;
+        bool wrongOrientation {false};
+    };
+
+    std::vector<EdgeResult> results(std::max(_threads, 1));
+    std::vector<std::atomic<unsigned int>> pointsPerPoint(checkPoints ? numPoints : 0);
+    parallel_for_blocks(edges.size(), _threads, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        EdgeResult& result = results[block];
+        std::size_t pos = alignToGroup(begin);
+        std::size_t last = alignToGroup(end);
+        while (pos < last) {
+            std::size_t next = pos + 1;
+            while (next < edges.size() && equalEdge(edges[pos], edges[next])) {
+                next++;
+            }
+
+            std::size_t count = next - pos;
+            if (count == 2) {
+                const MeshFacet& face0 = rFaces[edges[pos].f];
+                const MeshFacet& face1 = rFaces[edges[pos + 1].f];
+                if (!face0.HasSameOrientation(face1)) {
+                    result.wrongOrientation = true;
+                }
+            }
+            else if (count > 2) {
+                // Edge that is shared by more than 2 facets
+                result.nonManifolds.emplace_back(edges[pos].p0, edges[pos].p1);
+                std::vector<FacetIndex> facets;
+                facets.reserve(count);
+                for (std::size_t i = pos; i < next; i++) {
+                    facets.push_back(edges[i].f);
+                }
+                result.facets.push_back(facets);
+            }
+
+            if (checkPoints) {
+                pointsPerPoint[edges[pos].p0].fetch_add(1, std::memory_order_relaxed);
+                pointsPerPoint[edges[pos].p1].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            pos = next;
+        }
+    });
+
+    bool wrongOrientation = false;
+    for (auto& result : results) {
+        wrongOrientation = wrongOrientation || result.wrongOrientation;
+        if (_checks & NonManifoldEdges) {
+            _report.nonManifoldEdges.insert(
+                _report.nonManifoldEdges.end(),
+                result.nonManifolds.begin(),
+                result.nonManifolds.end()
+            );
+            _report.nonManifoldFacets.splice(_report.nonManifoldFacets.end(), result.facets);
+        }
+    }
+
+    // The majority vote per component needs a traversal of the mesh that cannot be
+    // split into blocks, but it's only needed if an inconsistent edge was found
+    if ((_checks & Orientation) && wrongOrientation) {
+        _report.wrongOrientedFacets = MeshEvalOrientation(_rclMesh).GetIndices();
+    }
+
+    // for an inner point the number of adjacent points is equal to the number of shared faces
+    // for a boundary point it's higher by one and for a non-manifold point it's higher by more
+    // than one, see MeshEvalPointManifolds
+    if (checkPoints) {
+        for (std::size_t index = 0; index < numPoints; index++) {
+            unsigned int sp = pointsPerPoint[index].load(std::memory_order_relaxed);
+            unsigned int sf = facetsPerPoint[index].load(std::memory_order_relaxed);
+            if (sp > sf + 1) {
+                _report.nonManifoldPoints.push_back(PointIndex(index));
+            }
+        }
+    }
+}
+
+void MeshEvalDefects::CheckFacets()
+{
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    std::size_t numFacets = rFaces.size();
+
+    std::vector<Base::Vector3f> normals(numFacets);
+    parallel_for_blocks(numFacets, _threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            normals[index] = _rclMesh.GetFacet(rFaces[index]).GetNormal();
+        }
+    });
+
+    struct FacetResult
+    {
+        std::vector<FacetIndex> degenerated;
+        std::vector<FacetIndex> folds;
+    };
+
+    std::vector<FacetResult> results(std::max(_threads, 1));
+    parallel_for_blocks(numFacets, _threads, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        FacetResult& result = results[block];
+        for (std::size_t index = begin; index < end; index++) {
+            const MeshFacet& face = rFaces[index];
+            if ((_checks & DegeneratedFacets)
+                && (face.IsDegenerated() || _rclMesh.GetFacet(face).IsDegenerated(_fEpsilon))) {
+                result.degenerated.push_back(FacetIndex(index));
+            }
+
+            if (_checks & Folds) {
+                const Base::Vector3f& v1 = normals[index];
+                for (int i = 0; i < 3; i++) {
+                    FacetIndex n1 = face._aulNeighbours[i];
+                    FacetIndex n2 = face._aulNeighbours[(i + 1) % 3];
+                    if (n1 < numFacets && n2 < numFacets) {
+                        const Base::Vector3f& v2 = normals[n1];
+                        const Base::Vector3f& v3 = normals[n2];
+                        if (v2 * v3 > 0.0F && v1 * v2 < -0.1F && v1 * v3 < -0.1F) {
+                            result.folds.push_back(n1);
+                            result.folds.push_back(n2);
+                            result.folds.push_back(FacetIndex(index));
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    for (const auto& result : results) {
+        _report.degeneratedFacets.insert(
+            _report.degeneratedFacets.end(),
+            result.degenerated.begin(),
+            result.degenerated.end()
+        );
+        _report.foldsOnSurface.insert(
+            _report.foldsOnSurface.end(),
+            result.folds.begin(),
+            result.folds.end()
+        );
+    }
+
+    // remove duplicates
+    std::vector<FacetIndex>& folds = _report.foldsOnSurface;
+    std::sort(folds.begin(), folds.end());
+    folds.erase(std::unique(folds.begin(), folds.end()), folds.end());
+}
+
+void MeshEvalDefects::CheckDuplicatedPoints()
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    std::vector<Point_Index> points(rPoints.size());
+    for (std::size_t index = 0; index < rPoints.size(); index++) {
+        points[index].index = PointIndex(index);
+        points[index].point = &rPoints[index];
+    }
+
+    parallel_sort(points.begin(), points.end(), Point_Index_Less(), _threads);
+
+    // keep the point with the lowest index of each group of equal points
+    for (std::size_t index = 1; index < points.size(); index++) {
+        const MeshPoint& prev = *points[index - 1].point;
+        const MeshPoint& curr = *points[index].point;
+        if (!(prev < curr) && !(curr < prev)) {
+            _report.duplicatedPoints.push_back(points[index].index);
+        }
+    }
+
+    std::sort(_report.duplicatedPoints.begin(), _report.duplicatedPoints.end());
+}
+
+void MeshEvalDefects::CheckDuplicatedFacets()
+{
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    std::vector<Facet_Key> faces(rFaces.size());
+    parallel_for_blocks(rFaces.size(), _threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            Facet_Key& key = faces[index];
+            std::copy(rFaces[index]._aulPoints, rFaces[index]._aulPoints + 3, key.p);
+            std::sort(key.p, key.p + 3);
+            key.f = FacetIndex(index);
+        }
+    });
+
+    parallel_sort(faces.begin(), faces.end(), Facet_Key_Less(), _threads);
+
+    // keep the facet with the lowest index of each group of equal facets
+    for (std::size_t index = 1; index < faces.size(); index++) {
+        if (std::equal(faces[index - 1].p, faces[index - 1].p + 3, faces[index].p)) {
+            _report.duplicatedFacets.push_back(faces[index].f);
+        }
+    }
+
+    std::sort(_report.duplicatedFacets.begin(), _report.duplicatedFacets.end());
+}
+
+void MeshEvalDefects::CheckSelfIntersections()
+{
+    MeshFacetGrid grid(_rclMesh);
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+
+    using FacetPairs = std::vector<std::pair<FacetIndex, FacetIndex>>;
+    std::vector<FacetPairs> results(std::max(_threads, 1));
+    parallel_for_blocks(rFaces.size(), _threads, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        FacetPairs& result = results[block];
+        std::vector<ElementIndex> elements;
+        Base::Vector3f pt1, pt2;
+        for (std::size_t index = begin; index < end; index++) {
+            const MeshFacet& rface1 = rFaces[index];
+            MeshGeomFacet facet1 = _rclMesh.GetFacet(rface1);
+            Base::BoundBox3f box1 = facet1.GetBoundBox();
+
+            elements.clear();
+            grid.Inside(box1, elements, true);
+            std::sort(elements.begin(), elements.end());
+            for (ElementIndex jt : elements) {
+                // each pair is only checked once
+                if (jt <= index) {
+                    continue;
+                }
+
+                // If the facets share a common vertex we do not check for self-intersections,
+                // see MeshEvalSelfIntersection
+                const MeshFacet& rface2 = rFaces[jt];
+                bool common = false;
+                for (PointIndex p1 : rface1._aulPoints) {
+                    for (PointIndex p2 : rface2._aulPoints) {
+                        common = common || (p1 == p2);
+                    }
+                }
+                if (common) {
+                    continue;
+                }
+
+                MeshGeomFacet facet2 = _rclMesh.GetFacet(rface2);
+                if (box1 && facet2.GetBoundBox()) {
+                    if (facet1.IntersectWithFacet(facet2, pt1, pt2) == 2) {
+                        result.emplace_back(FacetIndex(index), jt);
+                    }
+                }
+            }
+        }
+    });
+
+    for (const auto& result : results) {
+        _report.selfIntersections.insert(_report.selfIntersections.end(), result.begin(), result.end());
+    }
+}
+
+bool MeshFixDefects::Fixup()
+{
+    deletedFaces.clear();
+    MeshFacetArray& rFaces = _rclMesh._aclFacetArray;
+
+    // merge duplicated points with the first point of the same coordinates, the
+    // unreferenced points are removed together with the facets below
+    if (!_report.duplicatedPoints.empty()) {
+        const MeshPointArray& rPoints = _rclMesh.GetPoints();
+        std::vector<Point_Index> points(rPoints.size());
+        for (std::size_t index = 0; index < rPoints.size(); index++) {
+            points[index].index = PointIndex(index);
+            points[index].point = &rPoints[index];
+        }
+
+        int threads = int(std::thread::hardware_concurrency());
+        parallel_sort(points.begin(), points.end(), Point_Index_Less(), threads);
+
+        std::vector<PointIndex> mapPointIndex(rPoints.size());
+        for (std::size_t index = 0; index < points.size(); index++) {
+            PointIndex target = points[index].index;
+            if (index > 0) {
+                const MeshPoint& prev = *points[index - 1].point;
+                const MeshPoint& curr = *points[index].point;
+                if (!(prev < curr) && !(curr < prev)) {
+                    target = mapPointIndex[points[index - 1].index];
+                }
+            }
+            mapPointIndex[points[index].index] = target;
+        }
+
+        parallel_for_blocks(rFaces.size(), threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t index = begin; index < end; index++) {
+                for (PointIndex& point : rFaces[index]._aulPoints) {
+                    point = mapPointIndex[point];
+                }
+            }
+        });
+    }
+
+    // non-manifolds: keep two facets if possible, see MeshFixTopology
+    for (const auto& it : _report.nonManifoldFacets) {
+        std::vector<FacetIndex> non_mf;
+        non_mf.reserve(it.size());
+        for (FacetIndex jt : it) {
+            if (rFaces[jt].CountOpenEdges() == 2 || rFaces[jt].IsDegenerated()) {
+                non_mf.push_back(jt);
+            }
+        }
+
+        if (it.size() - non_mf.size() == 2) {
+            deletedFaces.insert(deletedFaces.end(), non_mf.begin(), non_mf.end());
+        }
+        else {
+            deletedFaces.insert(deletedFaces.end(), it.begin(), it.end());
+        }
+    }
+
+    // self-intersections: prefer to remove border facets, see MeshFixSelfIntersection
+    for (const auto& it : _report.selfIntersections) {
+        unsigned short numOpenEdges1 = rFaces[it.first].CountOpenEdges();
+        unsigned short numOpenEdges2 = rFaces[it.second].CountOpenEdges();
+        if (numOpenEdges1 == 0 && numOpenEdges2 > 0) {
+            deletedFaces.push_back(it.second);
+        }
+        else if (numOpenEdges1 > 0 && numOpenEdges2 == 0) {
+            deletedFaces.push_back(it.first);
+        }
+        else {
+            deletedFaces.push_back(it.first);
+            deletedFaces.push_back(it.second);
+        }
+    }
+
+    deletedFaces.insert(
+        deletedFaces.end(),
+        _report.duplicatedFacets.begin(),
+        _report.duplicatedFacets.end()
+    );
+    deletedFaces.insert(
+        deletedFaces.end(),
+        _report.degeneratedFacets.begin(),
+        _report.degeneratedFacets.end()
+    );
+    deletedFaces.insert(deletedFaces.end(), _report.foldsOnSurface.begin(), _report.foldsOnSurface.end());
+
+    // merging points may have produced further corrupted facets
+    if (!_report.duplicatedPoints.empty()) {
+        for (std::size_t index = 0; index < rFaces.size(); index++) {
+            if (rFaces[index].IsDegenerated()) {
+                deletedFaces.push_back(FacetIndex(index));
+            }
+        }
+
+        // facets that have become equal, the first of them is kept
+        std::vector<bool> deleted(rFaces.size(), false);
+        for (FacetIndex index : deletedFaces) {
+            deleted[index] = true;
+        }
+        using FacetKey = std::pair<std::array<PointIndex, 3>, FacetIndex>;
+        std::vector<FacetKey> keys;
+        keys.reserve(rFaces.size());
+        for (std::size_t index = 0; index < rFaces.size(); index++) {
+            if (!deleted[index]) {
+                const PointIndex* points = rFaces[index]._aulPoints;
+                std::array<PointIndex, 3> key {points[0], points[1], points[2]};
+                std::sort(key.begin(), key.end());
+                keys.emplace_back(key, FacetIndex(index));
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        for (std::size_t index = 1; index < keys.size(); index++) {
+            if (keys[index].first == keys[index - 1].first) {
+                deletedFaces.push_back(keys[index].second);
+            }
+        }
+    }
+
+    std::sort(deletedFaces.begin(), deletedFaces.end());
+    deletedFaces.erase(std::unique(deletedFaces.begin(), deletedFaces.end()), deletedFaces.end());
+
+    std::size_t numFacets = rFaces.size();
+    if (!deletedFaces.empty() || !_report.duplicatedPoints.empty()) {
+        _rclMesh.DeleteFacets(deletedFaces);
+        _rclMesh.RebuildNeighbours();
+    }
+
+    // non-manifold points: remove the facets around them, see MeshObject::removeNonManifoldPoints
+    // As merging points may have produced further ones the points are checked again.
+    if (!_report.nonManifoldPoints.empty() || !_report.duplicatedPoints.empty()) {
+        MeshEvalPointManifolds eval(_rclMesh);
+        if (!eval.Evaluate()) {
+            std::vector<FacetIndex> faces;
+            eval.GetFacetIndices(faces);
+            _rclMesh.DeleteFacets(faces);
+            _rclMesh.RebuildNeighbours();
+
+            // GetDeletedFaces() refers to the facet indices before any facet was deleted
+            std::vector<FacetIndex> remaining;
+            remaining.reserve(numFacets - deletedFaces.size());
+            auto it = deletedFaces.begin();
+            for (FacetIndex index = 0; index < numFacets; index++) {
+                if (it != deletedFaces.end() && *it == index) {
+                    ++it;
+                }
+                else {
+                    remaining.push_back(index);
+                }
+            }
+            for (FacetIndex index : faces) {
+                deletedFaces.push_back(remaining[index]);
+            }
+            std::sort(deletedFaces.begin(), deletedFaces.end());
+        }
+    }
+
+    if (!_report.wrongOrientedFacets.empty()) {
+        MeshTopoAlgorithm(_rclMesh).HarmonizeNormals();
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------
+
 MeshEigensystem::MeshEigensystem(const MeshKernel& rclB)
     : MeshEvaluation(rclB)
     , _cU(1.0F, 0.0F, 0.0F)
@@ -391,6 +391,121 @@ public:
 
 // ----------------------------------------------------
 
+/**
+ * The MeshDefectReport structure collects the results of a MeshEvalDefects run.
+ * All facet and point indices refer to the mesh kernel the evaluation was done on.
+ */
+struct MeshExport MeshDefectReport
+{
+    /** Facets whose orientation differs from the majority of their component. */
+    std::vector<FacetIndex> wrongOrientedFacets;
+    /** Edges shared by more than two facets and the facets attached to each of them. */
+    std::vector<std::pair<PointIndex, PointIndex>> nonManifoldEdges;
+    std::list<std::vector<FacetIndex>> nonManifoldFacets;
+    /** Points shared by facets that are not connected over a common edge. */
+    std::vector<PointIndex> nonManifoldPoints;
+    std::vector<PointIndex> duplicatedPoints;
+    std::vector<FacetIndex> duplicatedFacets;
+    std::vector<FacetIndex> degeneratedFacets;
+    std::vector<FacetIndex> foldsOnSurface;
+    std::vector<std::pair<FacetIndex, FacetIndex>> selfIntersections;
+
+    bool IsValid() const;
+    void Clear();
+};
+
+/**
+ * The MeshEvalDefects class runs the checks of MeshEvalOrientation, MeshEvalTopology,
+ * MeshEvalPointManifolds, MeshEvalDuplicatePoints, MeshEvalDuplicateFacets,
+ * MeshEvalDegeneratedFacets, MeshEvalFoldsOnSurface and MeshEvalSelfIntersection in a single
+ * pass. The edge adjacency is built only once and shared by all edge based checks, and the
+ * per-facet checks are done concurrently over blocks of facets.
+ * @see MeshFixDefects
+ */
+class MeshExport MeshEvalDefects: public MeshEvaluation
+{
+public:
+    enum Defect
+    {
+        Orientation = 1,
+        NonManifoldEdges = 2,
+        NonManifoldPoints = 4,
+        DuplicatedPoints = 8,
+        DuplicatedFacets = 16,
+        DegeneratedFacets = 32,
+        Folds = 64,
+        SelfIntersections = 128,
+        All = 255
+    };
+
+    explicit MeshEvalDefects(const MeshKernel& rclB, float fEps = MeshDefinitions::_fMinPointDistanceP2);
+    /** Restricts the evaluation to the defects set in the bit mask \a checks. */
+    void SetChecks(unsigned int checks)
+    {
+        _checks = checks;
+    }
+    unsigned int GetChecks() const
+    {
+        return _checks;
+    }
+    /** Sets the number of threads, by default the number of available cores is used. */
+    void SetThreads(int threads)
+    {
+        _threads = threads;
+    }
+    /** Returns true if none of the enabled checks found a defect. */
+    bool Evaluate() override;
+    const MeshDefectReport& GetReport() const
+    {
+        return _report;
+    }
+
+private:
+    void CheckEdges();
+    void CheckFacets();
+    void CheckDuplicatedPoints();
+    void CheckDuplicatedFacets();
+    void CheckSelfIntersections();
+
+private:
+    MeshDefectReport _report;
+    float _fEpsilon;
+    unsigned int _checks {All};
+    int _threads;
+};
+
+/**
+ * The MeshFixDefects class repairs the defects of a MeshDefectReport in one batch.
+ * Duplicated points are merged and all facets to be removed are deleted at once, so
+ * that the point array is compacted and the neighbourhood is rebuilt only a single time.
+ * The facets to remove for non-manifolds and self-intersections are chosen the same way
+ * as MeshFixTopology and MeshFixSelfIntersection do. Unlike MeshFixDegeneratedFacets,
+ * degenerated facets are removed rather than collapsed. Facets that become degenerated or
+ * duplicated by merging points are removed, too. Afterwards the facets around non-manifold
+ * points are removed in a second step, because merging points may produce new ones.
+ * @see MeshEvalDefects
+ */
+class MeshExport MeshFixDefects: public MeshValidation
+{
+public:
+    MeshFixDefects(MeshKernel& rclB, const MeshDefectReport& report)
+        : MeshValidation(rclB)
+        , _report(report)
+    {}
+    bool Fixup() override;
+
+    const std::vector<FacetIndex>& GetDeletedFaces() const
+    {
+        return deletedFaces;
+    }
+
+private:
+    std::vector<FacetIndex> deletedFaces;
+    const MeshDefectReport& _report;
+};
+
+// ----------------------------------------------------
+
 /**
  * The MeshEigensystem class actually does not try to check for or fix errors but
  * it provides methods to calculate the mesh's local coordinate system with the center
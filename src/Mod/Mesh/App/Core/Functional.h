@@ -25,7 +25,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <future>
+#include <vector>
 
 
 namespace MeshCore
@@ -61,4 +63,36 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/**
+ * Splits the index range [0, count) into at most \a threads contiguous blocks and calls
+ * \a func(block, begin, end) for each of them concurrently. The block index allows the
+ * caller to collect per-block results that can be merged in a deterministic order afterwards.
+ * Returns the number of blocks used.
+ */
+template<class Func>
+static std::size_t parallel_for_blocks(std::size_t count, int threads, Func func)
+{
+    std::size_t blocks = threads < 2 ? 1 : std::min<std::size_t>(std::size_t(threads), count);
+    if (blocks < 2) {
+        func(std::size_t(0), std::size_t(0), count);
+        return 1;
+    }
+
+    std::size_t size = (count + blocks - 1) / blocks;
+    std::vector<std::future<void>> futures;
+    futures.reserve(blocks - 1);
+    for (std::size_t block = 1; block < blocks; block++) {
+        std::size_t begin = std::min(block * size, count);
+        std::size_t end = std::min(begin + size, count);
+        futures.push_back(std::async(std::launch::async, func, block, begin, end));
+    }
+
+    func(std::size_t(0), std::size_t(0), std::min(size, count));
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    return blocks;
+}
+
 }  // namespace MeshCore
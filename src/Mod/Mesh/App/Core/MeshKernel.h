@@ -511,6 +511,7 @@ private:
     friend class MeshAlgorithm;
     friend class MeshTopoAlgorithm;
     friend class MeshFixDuplicatePoints;
+    friend class MeshFixDefects;
     friend class MeshBuilder;
     friend class MeshTrimming;
 };
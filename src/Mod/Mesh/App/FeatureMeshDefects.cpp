@@ -204,6 +204,34 @@ App::DocumentObjectExecReturn* FixDegenerations::execute()
 
 // ----------------------------------------------------------------------
 
+PROPERTY_SOURCE(Mesh::RepairDefects, Mesh::FixDefects)
+
+RepairDefects::RepairDefects() = default;
+
+App::DocumentObjectExecReturn* RepairDefects::execute()
+{
+    App::DocumentObject* link = Source.getValue();
+    if (!link) {
+        return new App::DocumentObjectExecReturn("No mesh linked");
+    }
+    App::Property* prop = link->getPropertyByName("Mesh");
+    if (prop && prop->is<Mesh::PropertyMeshKernel>()) {
+        Mesh::PropertyMeshKernel* kernel = static_cast<Mesh::PropertyMeshKernel*>(prop);
+        std::unique_ptr<MeshObject> mesh(new MeshObject);
+        *mesh = kernel->getValue();
+        float fEps = static_cast<float>(Epsilon.getValue());
+        if (fEps <= 0.0F) {
+            fEps = MeshCore::MeshDefinitions::_fMinPointDistanceP2;
+        }
+        mesh->repairDefects(fEps);
+        this->Mesh.setValuePtr(mesh.release());
+    }
+
+    return App::DocumentObject::StdReturn;
+}
+
+// ----------------------------------------------------------------------
+
 PROPERTY_SOURCE(Mesh::FixDeformations, Mesh::FixDefects)
 
 FixDeformations::FixDeformations()
@@ -175,6 +175,25 @@ public:
     //@}
 };
 
+/**
+ * The RepairDefects class checks for all common defects in one pass and repairs them at once.
+ * @see MeshCore::MeshEvalDefects
+ */
+class MeshExport RepairDefects: public Mesh::FixDefects
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(Mesh::RepairDefects);
+
+public:
+    /// Constructor
+    RepairDefects();
+
+    /** @name methods override Feature */
+    //@{
+    /// recalculate the Feature
+    App::DocumentObjectExecReturn* execute() override;
+    //@}
+};
+
 /**
  * The FixDeformations class tries to repair deformed faces by swapping edge operations.
  * @author Werner Mayer
@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 
+#include "Core/Boolean.h"
 #include "Core/Iterator.h"
 #include "Core/SetOperations.h"
 
@@ -32,6 +33,8 @@
 using namespace Mesh;
 using namespace std;
 
+const char* SetOperations::AlgorithmEnums[] = {"Standard", "Robust", nullptr};
+
 PROPERTY_SOURCE(Mesh::SetOperations, Mesh::Feature)
 
 
@@ -40,6 +43,15 @@ SetOperations::SetOperations()
     ADD_PROPERTY(Source1, (nullptr));
     ADD_PROPERTY(Source2, (nullptr));
     ADD_PROPERTY(OperationType, ("union"));
+    ADD_PROPERTY_TYPE(
+        Algorithm,
+        (long(0)),
+        nullptr,
+        App::Prop_None,
+        "Standard: the grid based set operations\n"
+        "Robust: exact predicates, handles coplanar facets and runs in parallel"
+    );
+    Algorithm.setEnums(AlgorithmEnums);
 }
 
 short SetOperations::mustExecute() const
@@ -54,6 +66,9 @@ short SetOperations::mustExecute() const
         if (OperationType.isTouched()) {
             return 1;
         }
+        if (Algorithm.isTouched()) {
+            return 1;
+        }
     }
 
     return 0;
@@ -94,14 +109,25 @@ App::DocumentObjectExecReturn* SetOperations::execute()
             );
         }
 
-        MeshCore::SetOperations setOp(
-            meshKernel1.getKernel(),
-            meshKernel2.getKernel(),
-            pcKernel->getKernel(),
-            type,
-            1.0e-5F
-        );
-        setOp.Do();
+        if (Algorithm.getValue() == 1) {
+            MeshCore::MeshBoolean boolean(
+                meshKernel1.getKernel(),
+                meshKernel2.getKernel(),
+                pcKernel->getKernel(),
+                type
+            );
+            boolean.Do();
+        }
+        else {
+            MeshCore::SetOperations setOp(
+                meshKernel1.getKernel(),
+                meshKernel2.getKernel(),
+                pcKernel->getKernel(),
+                type,
+                1.0e-5F
+            );
+            setOp.Do();
+        }
         Mesh.setValuePtr(pcKernel.release());
     }
     else {
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <App/PropertyLinks.h>
+#include <App/PropertyStandard.h>
 
 #include "MeshFeature.h"
 
@@ -47,6 +48,7 @@ public:
     App::PropertyLink Source1;
     App::PropertyLink Source2;
     App::PropertyString OperationType;
+    App::PropertyEnumeration Algorithm;
 
     /** @name methods override Feature */
     //@{
@@ -54,6 +56,9 @@ public:
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
     //@}
+
+private:
+    static const char* AlgorithmEnums[];
 };
 
 }  // namespace Mesh
@@ -1109,6 +1109,24 @@ void MeshObject::decimate(int targetSize)
     dm.simplify(targetSize);
 }
 
+void MeshObject::decimate(const MeshCore::MeshQuadricDecimation::Parameters& param)
+{
+    std::vector<std::vector<FacetIndex>> segm;
+    segm.reserve(this->_segments.size());
+    for (const auto& segment : this->_segments) {
+        segm.push_back(segment.getIndices());
+    }
+
+    MeshCore::MeshQuadricDecimation dm(this->_kernel);
+    dm.SetSegments(segm);
+    dm.Decimate(param);
+
+    segm = dm.GetSegments();
+    for (std::size_t index = 0; index < segm.size(); index++) {
+        this->_segments[index]._indices = segm[index];
+    }
+}
+
 Base::Vector3d MeshObject::getPointNormal(PointIndex index) const
 {
     std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
@@ -1775,6 +1793,21 @@ void MeshObject::validateDegenerations(float fEps)
     }
 }
 
+void MeshObject::repairDefects(float fEps)
+{
+    MeshCore::MeshEvalDefects eval(_kernel, fEps);
+    if (!eval.Evaluate()) {
+        MeshCore::MeshFixDefects fix(_kernel, eval.GetReport());
+        fix.Fixup();
+        if (!eval.GetReport().duplicatedPoints.empty()) {
+            this->_segments.clear();
+        }
+        else {
+            deletedFacets(fix.GetDeletedFaces());
+        }
+    }
+}
+
 void MeshObject::removeDuplicatedPoints()
 {
     unsigned long count = _kernel.CountFacets();
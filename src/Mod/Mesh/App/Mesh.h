@@ -36,6 +36,7 @@
 #include <Base/Matrix.h>
 #include <Base/Tools3D.h>
 
+#include "Core/Decimation.h"
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
@@ -283,6 +284,8 @@ public:
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
+    /** Decimates the mesh with the quadric error metric, segment borders are kept if requested */
+    void decimate(const MeshCore::MeshQuadricDecimation::Parameters&);
     Base::Vector3d getPointNormal(PointIndex) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(
@@ -375,6 +378,8 @@ public:
     void mergeFacets();
     bool hasPointsOnEdge() const;
     void removePointsOnEdge(bool fillBoundary);
+    /** Checks the mesh for the most common defects in one pass and repairs them in one batch */
+    void repairDefects(float fEps);
     //@}
 
     /** @name Mesh segments */
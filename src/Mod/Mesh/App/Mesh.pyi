@@ -349,6 +349,14 @@ class Mesh(ComplexGeoData):
         """Remove duplicated facets"""
         ...
 
+    def repairDefects(self, epsilon: float = ...) -> Any:
+        """repairDefects([epsilon]) -> None
+
+        Check the mesh for wrong oriented facets, non-manifolds, duplicated points and
+        facets, degenerated facets, folds and self-intersections in a single pass and
+        repair all of them in one batch"""
+        ...
+
     def refine(self) -> Any:
         """Refine the mesh"""
         ...
@@ -451,6 +459,21 @@ class Mesh(ComplexGeoData):
         mesh.decimate(0.5, 0.9) # reduction by up to 90 percent"""
         ...
 
+    def decimateQuadric(self, **kwargs) -> Any:
+        """Decimate the mesh with the quadric error metric
+        decimateQuadric([TargetSize=0, MaxError=DBL_MAX, MaxDistance=DBL_MAX,
+                        PreserveBoundary=True, PreserveSegments=True, CreaseAngle=0.0])
+        TargetSize: number of facets to reduce the mesh to
+        MaxError: maximum quadric error of a single edge collapse
+        MaxDistance: hard bound for the distance of the original points to the decimated mesh
+        PreserveBoundary: keep boundary edges as feature lines
+        PreserveSegments: keep the borders of the segments as feature lines
+        CreaseAngle: keep edges with a larger dihedral angle (in degree) as feature lines,
+                     zero disables the crease detection
+        Example:
+        mesh.decimateQuadric(TargetSize=2000000, MaxDistance=0.05, CreaseAngle=45)"""
+        ...
+
     def mergeFacets(self) -> Any:
         """Merge facets to optimize topology"""
         ...
@@ -1513,6 +1513,22 @@ PyObject* MeshPy::removeDuplicatedFacets(PyObject* args)
     Py_Return;
 }
 
+PyObject* MeshPy::repairDefects(PyObject* args)
+{
+    float fEpsilon = MeshCore::MeshDefinitions::_fMinPointDistanceP2;
+    if (!PyArg_ParseTuple(args, "|f", &fEpsilon)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        getMeshObjectPtr()->repairDefects(fEpsilon);
+    }
+    PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject* MeshPy::refine(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -2095,6 +2111,56 @@ PyObject* MeshPy::decimate(PyObject* args)
     return nullptr;
 }
 
+PyObject* MeshPy::decimateQuadric(PyObject* args, PyObject* kwds)
+{
+    int targetSize = 0;
+    double maxError = std::numeric_limits<double>::max();
+    double maxDistance = std::numeric_limits<double>::max();
+    PyObject* boundary = Py_True;
+    PyObject* segments = Py_True;
+    double creaseAngle = 0.0;
+    static const std::array<const char*, 7> keywords_decimate {
+        "TargetSize",
+        "MaxError",
+        "MaxDistance",
+        "PreserveBoundary",
+        "PreserveSegments",
+        "CreaseAngle",
+        nullptr
+    };
+    if (!Base::Wrapped_ParseTupleAndKeywords(
+            args,
+            kwds,
+            "|iddO!O!d",
+            keywords_decimate,
+            &targetSize,
+            &maxError,
+            &maxDistance,
+            &PyBool_Type,
+            &boundary,
+            &PyBool_Type,
+            &segments,
+            &creaseAngle
+        )) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        MeshCore::MeshQuadricDecimation::Parameters param;
+        param.targetSize = static_cast<std::size_t>(std::max(targetSize, 0));
+        param.maxError = maxError;
+        param.maxDistance = maxDistance;
+        param.preserveBoundary = Base::asBoolean(boundary);
+        param.preserveSegments = Base::asBoolean(segments);
+        param.creaseAngle = Base::toRadians(creaseAngle);
+        getMeshObjectPtr()->decimate(param);
+    }
+    PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject* MeshPy::nearestFacetOnRay(PyObject* args) const
 {
     PyObject* pnt_p {};
@@ -272,6 +272,16 @@ bool ImportExportSettings::getExpandCompound() const
     return pGroup->GetBool("ExpandCompound", false);
 }
 
+void ImportExportSettings::setLinkDuplicates(bool on)
+{
+    pGroup->SetBool("LinkDuplicates", on);
+}
+
+bool ImportExportSettings::getLinkDuplicates() const
+{
+    return pGroup->GetBool("LinkDuplicates", false);
+}
+
 void ImportExportSettings::setShowProgress(bool on)
 {
     pGroup->SetBool("ShowProgress", on);
@@ -100,6 +100,9 @@ public:
     void setExpandCompound(bool);
     bool getExpandCompound() const;
 
+    void setLinkDuplicates(bool);
+    bool getLinkDuplicates() const;
+
     void setShowProgress(bool);
     bool getShowProgress() const;
 
@@ -49,6 +49,7 @@
 #include "PartFeature.h"
 #include "PartPyCXX.h"
 #include "PropertyTopoShape.h"
+#include "TessellationCache.h"
 #include "TopoShapePy.h"
 #include "PartFeature.h"
 
@@ -549,10 +550,14 @@ void PropertyPartShape::afterRestore()
 }
 
 // The following function is copied from OCCT BRepTools.cxx and modified
-// to disable saving of triangulation
+// to make saving of triangulation optional
 //
 
-static Standard_Boolean BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File)
+static Standard_Boolean BRepTools_Write(
+    const TopoDS_Shape& Sh,
+    const Standard_CString File,
+    Standard_Boolean withTriangles
+)
 {
     std::ofstream os;
     OSD_OpenStream(os, File, std::ios::out);
@@ -574,7 +579,7 @@ static Standard_Boolean BRepTools_Write(const TopoDS_Shape& Sh, const Standard_C
         VERSION_3 = 3
     };
 
-    BRepTools_ShapeSet SS(Standard_False);
+    BRepTools_ShapeSet SS(withTriangles);
     SS.SetFormatNb(VERSION_1);
     // SS.SetProgress(PR);
     SS.Add(Sh);
@@ -595,6 +600,15 @@ static Standard_Boolean BRepTools_Write(const TopoDS_Shape& Sh, const Standard_C
     return isGood;
 }
 
+// The triangulation of the faces is saved so that the shapes don't need to be meshed again
+// for the display when the document is loaded. This makes the files considerably bigger.
+static bool saveTessellation()
+{
+    return App::GetApplication()
+        .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/General")
+        ->GetBool("SaveTessellation", false);
+}
+
 void PropertyPartShape::saveToFile(Base::Writer& writer) const
 {
     // create a temporary file and copy the content to the zip stream
@@ -603,7 +617,11 @@ void PropertyPartShape::saveToFile(Base::Writer& writer) const
     static Base::FileInfo fi(App::Application::getTempFileName());
 
     TopoDS_Shape myShape = _Shape.getShape();
-    if (!BRepTools_Write(myShape, static_cast<Standard_CString>(fi.filePath().c_str()))) {
+    if (!BRepTools_Write(
+            myShape,
+            static_cast<Standard_CString>(fi.filePath().c_str()),
+            saveTessellation() ? Standard_True : Standard_False
+        )) {
         // Note: Do NOT throw an exception here because if the tmp. file could
         // not be created we should not abort.
         // We only print an error message but continue writing the next files to the
@@ -720,7 +738,7 @@ void PropertyPartShape::SaveDocFile(Base::Writer& writer) const
     if (writer.getMode("BinaryBrep")) {
         TopoShape shape;
         shape.setShape(myShape);
-        shape.exportBinary(writer.Stream());
+        shape.exportBinary(writer.Stream(), saveTessellation());
     }
     else {
         bool direct = App::GetApplication()
@@ -732,7 +750,7 @@ void PropertyPartShape::SaveDocFile(Base::Writer& writer) const
         else {
             TopoShape shape;
             shape.setShape(myShape);
-            shape.exportBrep(writer.Stream());
+            shape.exportBrep(writer.Stream(), saveTessellation());
         }
     }
 }
@@ -774,6 +792,9 @@ void PropertyPartShape::RestoreDocFile(Base::Reader& reader)
         shape = getValue();
     }
 
+    // a saved triangulation can be used for the display
+    TessellationCache::instance().addRestored(shape.getShape());
+
     // restore the element map
     shape.Hasher = hasher;
     shape.resetElementMap(elementMap);
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+
+#include <BRep_Tool.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include "TessellationCache.h"
+
+using namespace Part;
+
+TessellationCache& TessellationCache::instance()
+{
+    static TessellationCache cache;
+    return cache;
+}
+
+TessellationCache::Triangulations TessellationCache::getTriangulations(const TopoDS_Shape& shape)
+{
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+
+    Triangulations triangulations;
+    triangulations.reserve(faceMap.Extent());
+    for (int i = 1; i <= faceMap.Extent(); i++) {
+        TopLoc_Location loc;
+        triangulations.push_back(BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), loc));
+    }
+    return triangulations;
+}
+
+bool TessellationCache::contains(const TopoDS_Shape& shape, const Parameters& params)
+{
+    if (shape.IsNull()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(shape.TShape().get());
+    if (it == entries.end()) {
+        return false;
+    }
+
+    Entry& entry = it->second;
+    if (!entry.restored && !params.accepts(entry.params)) {
+        return false;
+    }
+    if (getTriangulations(shape) != entry.triangulations) {
+        lru.erase(entry.lru);
+        entries.erase(it);
+        return false;
+    }
+
+    if (entry.restored) {
+        entry.params = params;
+        entry.restored = false;
+    }
+    lru.splice(lru.begin(), lru, entry.lru);
+    return true;
+}
+
+void TessellationCache::add(const TopoDS_Shape& shape, const Parameters& params)
+{
+    insert(shape, params, false);
+}
+
+void TessellationCache::addRestored(const TopoDS_Shape& shape)
+{
+    insert(shape, Parameters(), true);
+}
+
+void TessellationCache::insert(const TopoDS_Shape& shape, const Parameters& params, bool restored)
+{
+    if (shape.IsNull()) {
+        return;
+    }
+
+    // Without faces there is nothing that can be checked for modifications
+    Triangulations triangulations = getTriangulations(shape);
+    if (triangulations.empty()) {
+        return;
+    }
+    if (restored
+        && std::any_of(triangulations.begin(), triangulations.end(), [](const auto& mesh) {
+               return mesh.IsNull();
+           })) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const TopoDS_TShape* key = shape.TShape().get();
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        lru.push_front(key);
+        it = entries.emplace(key, Entry()).first;
+        it->second.lru = lru.begin();
+    }
+    else {
+        lru.splice(lru.begin(), lru, it->second.lru);
+    }
+
+    Entry& entry = it->second;
+    entry.params = params;
+    entry.restored = restored;
+    entry.triangulations = std::move(triangulations);
+    entry.tshape = shape.TShape();
+
+    if (entries.size() > maxSize) {
+        prune();
+    }
+}
+
+void TessellationCache::prune()
+{
+    // Drop the entries of shapes that are only referenced by the cache
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.tshape->GetRefCount() == 1) {
+            lru.erase(it->second.lru);
+            it = entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Make some room so that this isn't done for every new entry
+    std::size_t limit = maxSize - maxSize / 4;
+    while (entries.size() > limit) {
+        entries.erase(lru.back());
+        lru.pop_back();
+    }
+}
+
+void TessellationCache::remove(const TopoDS_Shape& shape)
+{
+    if (shape.IsNull()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(shape.TShape().get());
+    if (it != entries.end()) {
+        lru.erase(it->second.lru);
+        entries.erase(it);
+    }
+}
+
+void TessellationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lru.clear();
+}
+
+std::size_t TessellationCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t TessellationCache::getMaxSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxSize;
+}
+
+void TessellationCache::setMaxSize(std::size_t num)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    maxSize = std::max<std::size_t>(num, 1);
+    if (entries.size() > maxSize) {
+        prune();
+    }
+}
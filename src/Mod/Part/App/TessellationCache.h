@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <Poly_Triangulation.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_TShape.hxx>
+
+#include <Mod/Part/PartGlobal.h>
+
+namespace Part
+{
+
+/** Book keeping of the triangulations that have been created to display shapes.
+ * BRepMesh_IncrementalMesh stores the triangulation in the faces of a shape, so it is shared by
+ * all shapes with the same TShape, independent of their location. The cache remembers with which
+ * parameters the faces of a TShape have been meshed. Displaying the shape again with the same
+ * parameters, e.g. after a placement or color change, for a copy or link of it or after a
+ * recompute that didn't modify the geometry, can then reuse the triangulation.
+ *
+ * For each face the cache holds a handle to its triangulation. If any face has been meshed again
+ * in the meantime, e.g. by an export with other parameters, the entry doesn't match any more.
+ * An entry keeps its TShape alive, so that its address can't be reused by another shape. Entries
+ * of shapes that aren't used elsewhere any more are dropped when the cache grows beyond its limit.
+ * All methods are thread-safe.
+ */
+class PartExport TessellationCache
+{
+public:
+    /// The default maximum number of shapes whose triangulation is remembered
+    static constexpr std::size_t DefaultMaxSize = 10000;
+
+    struct Parameters
+    {
+        double deflection {0.0};
+        double angularDeflection {0.0};
+
+        /** Returns true if a triangulation created with \a other can be used for these
+         * parameters. The display deflection is derived from the bounding box of a shape which
+         * slightly differs before and after meshing, so a small difference is tolerated.
+         */
+        bool accepts(const Parameters& other) const
+        {
+            return angularDeflection == other.angularDeflection
+                && std::abs(deflection - other.deflection) <= 0.01 * deflection;
+        }
+    };
+
+    static TessellationCache& instance();
+
+    /** Returns true if all faces of \a shape carry the triangulation that has been created with
+     * \a params. If the triangulation of the shape has been restored from a file then it's
+     * accepted for any parameters and from now on it's considered as created with \a params.
+     */
+    bool contains(const TopoDS_Shape& shape, const Parameters& params);
+    /// Remembers that the faces of \a shape have just been meshed with \a params
+    void add(const TopoDS_Shape& shape, const Parameters& params);
+    /** Remembers that the faces of \a shape carry a triangulation that has been read from a file.
+     * Nothing is done if any face has no triangulation.
+     */
+    void addRestored(const TopoDS_Shape& shape);
+    void remove(const TopoDS_Shape& shape);
+    void clear();
+
+    std::size_t size() const;
+    std::size_t getMaxSize() const;
+    void setMaxSize(std::size_t num);
+
+private:
+    TessellationCache() = default;
+
+    using Triangulations = std::vector<Handle(Poly_Triangulation)>;
+    static Triangulations getTriangulations(const TopoDS_Shape& shape);
+
+    void insert(const TopoDS_Shape& shape, const Parameters& params, bool restored);
+    void prune();
+
+private:
+    struct Entry
+    {
+        Parameters params;
+        bool restored {false};
+        Triangulations triangulations;
+        Handle(TopoDS_TShape) tshape;
+        std::list<const TopoDS_TShape*>::iterator lru;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<const TopoDS_TShape*, Entry> entries;
+    std::list<const TopoDS_TShape*> lru;
+    std::size_t maxSize {DefaultMaxSize};
+};
+
+}  // namespace Part
@@ -757,6 +757,9 @@ bool TopoShape::canMapElement(const TopoShape& other) const
 
 namespace
 {
+/// Element maps of shapes with fewer elements of a type are encoded serially
+constexpr size_t MinParallelElements = 128;
+
 size_t checkSubshapeCount(
     const TopoShape& topoShape1,
     const TopoShape& topoShape2,
@@ -955,7 +958,6 @@ void TopoShape::mapSubElement(const TopoShape& other, const char* op, bool force
             checkHasher(other);
         }
         const char* shapetype = shapeName(type).c_str();
-        std::ostringstream ss;
 
         bool forward;
         int count;
@@ -967,6 +969,11 @@ void TopoShape::mapSubElement(const TopoShape& other, const char* op, bool force
             forward = false;
             count = shapeMap.count();
         }
+        // Look up the names of the matching elements of the other shape first. This is cheap, and
+        // it may update the location cached in the ancestry, so it stays serial.
+        std::vector<std::pair<int, std::vector<std::pair<Data::MappedName, Data::ElementIDRefs>>>>
+            elements;
+        elements.reserve(count);
         for (int k = 1; k <= count; ++k) {
             int i, idx;
             if (forward) {
@@ -983,10 +990,11 @@ void TopoShape::mapSubElement(const TopoShape& other, const char* op, bool force
                     continue;
                 }
             }
-            Data::IndexedName element = Data::IndexedName::fromConst(shapetype, idx);
-            for (auto& v :
-                 other.getElementMappedNames(Data::IndexedName::fromConst(shapetype, i), true)) {
-                auto& name = v.first;
+            elements.emplace_back(
+                idx,
+                other.getElementMappedNames(Data::IndexedName::fromConst(shapetype, i), true)
+            );
+            for (auto& v : elements.back().second) {
                 auto& sids = v.second;
                 if (sids.size()) {
                     if (!Hasher) {
@@ -1000,10 +1008,41 @@ void TopoShape::mapSubElement(const TopoShape& other, const char* op, bool force
                         sids.clear();
                     }
                 }
-                ss.str("");
+            }
+        }
+
+        if (elements.empty()) {
+            continue;
+        }
 
-                ensureElementMap()->encodeElementName(shapetype[0], name, ss, &sids, Tag, op, other.Tag);
-                ensureElementMap()->setElementName(element, name, Tag, &sids);
+        // Encoding the names walks their history and hashes them, which is the expensive part.
+        // The element map is only read here and the hasher is thread-safe, so the names are
+        // encoded in parallel and then added to the map in order.
+        auto map = ensureElementMap();
+        OSD_Parallel::For(
+            0,
+            static_cast<int>(elements.size()),
+            [&](int j) {
+                std::ostringstream ss;
+                for (auto& v : elements[j].second) {
+                    ss.str("");
+                    map->encodeElementName(
+                        shapetype[0],
+                        v.first,
+                        ss,
+                        &v.second,
+                        Tag,
+                        op,
+                        other.Tag
+                    );
+                }
+            },
+            elements.size() < MinParallelElements
+        );
+        for (auto& element : elements) {
+            auto name = Data::IndexedName::fromConst(shapetype, element.first);
+            for (auto& v : element.second) {
+                map->setElementName(name, v.first, Tag, &v.second);
             }
         }
     }
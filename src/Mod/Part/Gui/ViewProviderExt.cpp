@@ -23,13 +23,16 @@
  ***************************************************************************/
 
 #include <Bnd_Box.hxx>
+#include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
 #include <BRepTools.hxx>
 #include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <gp_Trsf.hxx>
+#include <OSD_Parallel.hxx>
 #include <Precision.hxx>
 #include <Poly_Array1OfTriangle.hxx>
 #include <Poly_Polygon3D.hxx>
@@ -49,8 +52,14 @@
 #include <TopTools_IndexedMapOfShape.hxx>
 
 #include <QAction>
+#include <QFutureWatcher>
 #include <QMenu>
+#include <QtConcurrentRun>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include <Inventor/SoPickedPoint.h>
 #include <Inventor/details/SoFaceDetail.h>
@@ -84,6 +93,7 @@
 #include <Gui/Utilities.h>
 
 #include <Mod/Part/App/ShapeMapHasher.h>
+#include <Mod/Part/App/TessellationCache.h>
 #include <Mod/Part/App/Tools.h>
 
 #include "ViewProviderExt.h"
@@ -100,6 +110,41 @@ using namespace PartGui;
 
 PROPERTY_SOURCE(PartGui::ViewProviderPartExt, Gui::ViewProviderGeometryObject)
 
+namespace
+{
+
+// The content of the Coin nodes of a shape that has been built in the background
+struct CoinMeshBuffers
+{
+    std::vector<SbVec3f> verts;
+    std::vector<SbVec3f> norms;
+    std::vector<int32_t> index;
+    std::vector<int32_t> parts;
+    std::vector<int32_t> lines;
+    int vertexOffset {0};
+    // the meshed shape and the parameters of its triangulation
+    TopoDS_Shape shape;
+    Part::TessellationCache::Parameters params;
+    // the reason why the buffers couldn't be built
+    std::string error;
+};
+
+}  // namespace
+
+// The refinement of the tessellation of the shape that runs in the background
+struct ViewProviderPartExt::BackgroundTessellation
+{
+    // the shape whose tessellation is refined, without location
+    TopoDS_Shape shape;
+    QFutureWatcher<std::shared_ptr<CoinMeshBuffers>> watcher;
+    std::shared_ptr<std::atomic<bool>> canceled = std::make_shared<std::atomic<bool>>(false);
+
+    ~BackgroundTessellation()
+    {
+        *canceled = true;
+    }
+};
+
 
 //**************************************************************************
 // Construction/Destruction
@@ -1031,37 +1076,43 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
     }
 }
 
-void ViewProviderPartExt::setupCoinGeometry(
-    TopoDS_Shape shape,
-    SoCoordinate3* coords,
-    SoBrepFaceSet* faceset,
-    SoNormal* norm,
-    SoBrepEdgeSet* lineset,
-    SoBrepPointSet* nodeset,
+namespace
+{
+
+// The triangulation of a face and its location in the Coin buffers
+struct FaceMeshData
+{
+    Handle(Poly_Triangulation) mesh;
+    TopLoc_Location loc;
+    // the indexes of the edges of the face and their polygons on its triangulation
+    std::vector<int> edges;
+    std::vector<Handle(Poly_PolygonOnTriangulation)> polygons;
+    // the edges that are drawn with their polygon on this face
+    std::vector<int> ownedEdges;
+    int nodeOffset {0};
+    int triaOffset {0};
+};
+
+// The polygon of an edge and its location in the Coin buffers
+struct EdgeMeshData
+{
+    bool onFace {false};
+    Handle(Poly_PolygonOnTriangulation) polygonOnFace;
+    // the polygon of a free edge
+    Handle(Poly_Polygon3D) polygon;
+    TopLoc_Location loc;
+    int nodeOffset {0};
+    int numLineNodes {0};
+    int lineOffset {0};
+};
+
+// The parameters to mesh a shape for the display
+IMeshTools_Parameters getMeshParameters(
+    const TopoDS_Shape& shape,
     double deviation,
-    double angularDeflection,
-    bool normalsFromUV
+    double angularDeflection
 )
 {
-    if (Part::Tools::isShapeEmpty(shape)) {
-        coords->point.setNum(0);
-        norm->vector.setNum(0);
-        faceset->coordIndex.setNum(0);
-        faceset->partIndex.setNum(0);
-        lineset->coordIndex.setNum(0);
-        nodeset->startIndex.setValue(0);
-        return;
-    }
-
-    // time measurement and book keeping
-    Base::TimeElapsed startTime;
-
-    [[maybe_unused]]
-    int numTriangles = 0,
-        numNodes = 0, numNorms = 0, numFaces = 0, numEdges = 0, numLines = 0;
-
-    std::set<int> faceEdges;
-
     // calculating the deflection value
     Standard_Real deflection = Part::Tools::getDeflection(shape, deviation);
 
@@ -1085,238 +1136,297 @@ void ViewProviderPartExt::setupCoinGeometry(
     meshParams.Angle = AngDeflectionRads;
     meshParams.InParallel = Standard_True;
     meshParams.AllowQualityDecrease = Standard_True;
+    return meshParams;
+}
 
-    // Clear triangulation and PCurves from geometry which can slow down the process
-#if OCC_VERSION_HEX < 0x070600
-    BRepTools::Clean(shape);
-#else
-    BRepTools::Clean(shape, Standard_True);
-#endif
+// The triangulations and polygons of a meshed shape and where they go in the Coin buffers.
+// The buffers are built in two phases: collect() determines the sizes and offsets of all
+// faces and edges, fill() writes into the preallocated buffers. Both run in parallel.
+class CoinMeshLayout
+{
+public:
+    void collect(const TopoDS_Shape& shape);
+    void fill(
+        SbVec3f* verts,
+        SbVec3f* norms,
+        int32_t* index,
+        int32_t* parts,
+        int32_t* lines,
+        bool normalsFromUV
+    ) const;
+
+    int numTriangles {0};
+    int numNodes {0};
+    int numNorms {0};
+    int numFaces {0};
+    int numEdges {0};
+    int numLines {0};
+    // the index of the first coordinate of the vertices
+    int vertexOffset {0};
+
+private:
+    // small shapes are not worth the overhead of the threads
+    Standard_Boolean isSingleThreaded() const
+    {
+        return numFaces + numEdges < 64;
+    }
+
+private:
+    TopTools_IndexedMapOfShape faceMap;
+    TopTools_IndexedMapOfShape edgeMap;
+    TopTools_IndexedMapOfShape vertexMap;
+    std::vector<FaceMeshData> faceData;
+    std::vector<EdgeMeshData> edgeData;
+};
 
-    BRepMesh_IncrementalMesh(shape, meshParams);
+void CoinMeshLayout::collect(const TopoDS_Shape& shape)
+{
+    // Collect the triangulations of the faces and the polygons of their edges. This
+    // runs in parallel because faces without a triangulation are meshed on the fly.
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+    TopExp::MapShapes(shape, TopAbs_VERTEX, vertexMap);
 
-    // We must reset the location here because the transformation data
-    // are set in the placement property
-    TopLoc_Location aLoc;
-    shape.Location(aLoc);
+    numFaces = faceMap.Extent();
+    numEdges = edgeMap.Extent();
 
-    // count triangles and nodes in the mesh
-    TopTools_IndexedMapOfShape faceMap;
-    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
-    for (int i = 1; i <= faceMap.Extent(); i++) {
-        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), aLoc);
+    faceData.resize(numFaces);
+    OSD_Parallel::For(
+        0,
+        numFaces,
+        [&](int i) {
+            const TopoDS_Face& face = TopoDS::Face(faceMap(i + 1));
+            FaceMeshData& data = faceData[i];
+            data.mesh = BRep_Tool::Triangulation(face, data.loc);
+            if (data.mesh.IsNull()) {
+                data.mesh = Part::Tools::triangulationOfFace(face);
+            }
 
-        if (mesh.IsNull()) {
-            mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
-        }
+            for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+                const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+                data.edges.push_back(edgeMap.FindIndex(edge));
+                if (data.mesh.IsNull()) {
+                    data.polygons.emplace_back();
+                }
+                else {
+                    // this holds the indices of the edge's triangulation to the current polygon
+                    data.polygons.push_back(
+                        BRep_Tool::PolygonOnTriangulation(edge, data.mesh, data.loc)
+                    );
+                }
+            }
+        },
+        isSingleThreaded()
+    );
+
+    // Each edge lying on a face is drawn with its polygon on the first face where it exists.
+    // The nodes of the faces come first in the coordinates, and the triangles in the same order.
+    edgeData.resize(numEdges + 1);
+    for (int i = 0; i < numFaces; i++) {
+        FaceMeshData& data = faceData[i];
+        data.nodeOffset = numNodes;
+        data.triaOffset = numTriangles;
 
         // Note: we must also count empty faces
-        if (!mesh.IsNull()) {
-            numTriangles += mesh->NbTriangles();
-            numNodes += mesh->NbNodes();
-            numNorms += mesh->NbNodes();
+        if (!data.mesh.IsNull()) {
+            numTriangles += data.mesh->NbTriangles();
+            numNodes += data.mesh->NbNodes();
         }
 
-        TopExp_Explorer xp;
-        for (xp.Init(faceMap(i), TopAbs_EDGE); xp.More(); xp.Next()) {
-            faceEdges.insert(Part::ShapeMapHasher {}(xp.Current()));
+        for (std::size_t j = 0; j < data.edges.size(); j++) {
+            EdgeMeshData& edge = edgeData[data.edges[j]];
+            edge.onFace = true;
+            if (!edge.polygonOnFace.IsNull() || data.polygons[j].IsNull()) {
+                continue;
+            }
+            edge.polygonOnFace = data.polygons[j];
+            edge.numLineNodes = edge.polygonOnFace->NbNodes();
+            data.ownedEdges.push_back(data.edges[j]);
         }
-        numFaces++;
     }
+    numNorms = numNodes;
+
+    // handling of the free edges that are not associated to a face
+    // Note: The assumption that if for an edge BRep_Tool::Polygon3D
+    // returns a valid object is wrong. This e.g. happens for ruled
+    // surfaces which gets created by two edges or wires.
+    OSD_Parallel::For(
+        1,
+        numEdges + 1,
+        [&](int i) {
+            EdgeMeshData& data = edgeData[i];
+            if (!data.onFace) {
+                data.polygon = Part::Tools::polygonOfEdge(TopoDS::Edge(edgeMap(i)), data.loc);
+                if (!data.polygon.IsNull()) {
+                    data.numLineNodes = data.polygon->NbNodes();
+                }
+            }
+        },
+        isSingleThreaded()
+    );
 
-    // get an indexed map of edges
-    TopTools_IndexedMapOfShape edgeMap;
-    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
-
-    // key is the edge number, value the coord indexes. This is needed to keep the same order as
+    // The nodes of the free edges follow the nodes of the faces. The lines keep the order of
     // the edges.
-    std::map<int, std::vector<int32_t>> lineSetMap;
-    std::set<int> edgeIdxSet;
-    std::vector<int32_t> edgeVector;
-
-    // count and index the edges
-    for (int i = 1; i <= edgeMap.Extent(); i++) {
-        edgeIdxSet.insert(i);
-        numEdges++;
-
-        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-        TopLoc_Location aLoc;
-
-        // handling of the free edge that are not associated to a face
-        // Note: The assumption that if for an edge BRep_Tool::Polygon3D
-        // returns a valid object is wrong. This e.g. happens for ruled
-        // surfaces which gets created by two edges or wires.
-        // So, we have to store the hashes of the edges associated to a face.
-        // If the hash of a given edge is not in this list we know it's really
-        // a free edge.
-        int hash = Part::ShapeMapHasher {}(aEdge);
-        if (faceEdges.find(hash) == faceEdges.end()) {
-            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
-            if (!aPoly.IsNull()) {
-                int nbNodesInEdge = aPoly->NbNodes();
-                numNodes += nbNodesInEdge;
-            }
+    for (int i = 1; i <= numEdges; i++) {
+        EdgeMeshData& data = edgeData[i];
+        if (!data.polygon.IsNull()) {
+            data.nodeOffset = numNodes;
+            numNodes += data.numLineNodes;
+        }
+        if (data.numLineNodes > 0) {
+            data.lineOffset = numLines;
+            numLines += data.numLineNodes + 1;
         }
     }
 
     // handling of the vertices
-    TopTools_IndexedMapOfShape vertexMap;
-    TopExp::MapShapes(shape, TopAbs_VERTEX, vertexMap);
+    vertexOffset = numNodes;
     numNodes += vertexMap.Extent();
+}
 
-    // create memory for the nodes and indexes
-    coords->point.setNum(numNodes);
-    norm->vector.setNum(numNorms);
-    faceset->coordIndex.setNum(numTriangles * 4);
-    faceset->partIndex.setNum(numFaces);
-
-    // get the raw memory for fast fill up
-    SbVec3f* verts = coords->point.startEditing();
-    SbVec3f* norms = norm->vector.startEditing();
-    int32_t* index = faceset->coordIndex.startEditing();
-    int32_t* parts = faceset->partIndex.startEditing();
-
-    // preset the normal vector with null vector
-    for (int i = 0; i < numNorms; i++) {
-        norms[i] = SbVec3f(0.0, 0.0, 0.0);
-    }
-
-    int ii = 0, faceNodeOffset = 0, faceTriaOffset = 0;
-    for (int i = 1; i <= faceMap.Extent(); i++, ii++) {
-        TopLoc_Location aLoc;
-        const TopoDS_Face& actFace = TopoDS::Face(faceMap(i));
-        // get the mesh of the shape
-        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace, aLoc);
-        if (mesh.IsNull()) {
-            mesh = Part::Tools::triangulationOfFace(actFace);
-        }
-        if (mesh.IsNull()) {
-            parts[ii] = 0;
-            continue;
-        }
+void CoinMeshLayout::fill(
+    SbVec3f* verts,
+    SbVec3f* norms,
+    int32_t* index,
+    int32_t* parts,
+    int32_t* lines,
+    bool normalsFromUV
+) const
+{
+    // Each face and each free edge writes only to its own ranges
+    OSD_Parallel::For(
+        0,
+        numFaces,
+        [&](int i) {
+            const FaceMeshData& data = faceData[i];
+            const TopoDS_Face& actFace = TopoDS::Face(faceMap(i + 1));
+            const Handle(Poly_Triangulation)& mesh = data.mesh;
+            if (mesh.IsNull()) {
+                parts[i] = 0;
+                return;
+            }
 
-        // getting the transformation of the shape/face
-        gp_Trsf myTransf;
-        Standard_Boolean identity = true;
-        if (!aLoc.IsIdentity()) {
-            identity = false;
-            myTransf = aLoc.Transformation();
-        }
+            // getting the transformation of the shape/face
+            gp_Trsf myTransf;
+            Standard_Boolean identity = true;
+            if (!data.loc.IsIdentity()) {
+                identity = false;
+                myTransf = data.loc.Transformation();
+            }
 
-        // getting size of node and triangle array of this face
-        int nbNodesInFace = mesh->NbNodes();
-        int nbTriInFace = mesh->NbTriangles();
-        // check orientation
-        TopAbs_Orientation orient = actFace.Orientation();
+            // getting size of node and triangle array of this face
+            int nbNodesInFace = mesh->NbNodes();
+            int nbTriInFace = mesh->NbTriangles();
+            int faceNodeOffset = data.nodeOffset;
+            int faceTriaOffset = data.triaOffset;
+            // check orientation
+            TopAbs_Orientation orient = actFace.Orientation();
+
+            // preset the normal vector with null vector
+            for (int j = 0; j < nbNodesInFace; j++) {
+                norms[faceNodeOffset + j] = SbVec3f(0.0, 0.0, 0.0);
+            }
 
-        // cycling through the poly mesh
+            // cycling through the poly mesh
 #if OCC_VERSION_HEX < 0x070600
-        const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
-        const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
-        TColgp_Array1OfDir Normals(Nodes.Lower(), Nodes.Upper());
+            const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
+            const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
+            TColgp_Array1OfDir Normals(Nodes.Lower(), Nodes.Upper());
 #else
-        int numNodes = mesh->NbNodes();
-        TColgp_Array1OfDir Normals(1, numNodes);
+            TColgp_Array1OfDir Normals(1, nbNodesInFace);
 #endif
-        if (normalsFromUV) {
-            Part::Tools::getPointNormals(actFace, mesh, Normals);
-        }
+            if (normalsFromUV) {
+                Part::Tools::getPointNormals(actFace, mesh, Normals);
+            }
 
-        for (int g = 1; g <= nbTriInFace; g++) {
-            // Get the triangle
-            Standard_Integer N1, N2, N3;
+            for (int g = 1; g <= nbTriInFace; g++) {
+                // Get the triangle
+                Standard_Integer N1, N2, N3;
 #if OCC_VERSION_HEX < 0x070600
-            Triangles(g).Get(N1, N2, N3);
+                Triangles(g).Get(N1, N2, N3);
 #else
-            mesh->Triangle(g).Get(N1, N2, N3);
+                mesh->Triangle(g).Get(N1, N2, N3);
 #endif
 
-            // change orientation of the triangle if the face is reversed
-            if (orient != TopAbs_FORWARD) {
-                Standard_Integer tmp = N1;
-                N1 = N2;
-                N2 = tmp;
-            }
+                // change orientation of the triangle if the face is reversed
+                if (orient != TopAbs_FORWARD) {
+                    Standard_Integer tmp = N1;
+                    N1 = N2;
+                    N2 = tmp;
+                }
 
-            // get the 3 points of this triangle
+                // get the 3 points of this triangle
 #if OCC_VERSION_HEX < 0x070600
-            gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
+                gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
 #else
-            gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
+                gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
 #endif
 
-            // get the 3 normals of this triangle
-            gp_Vec NV1, NV2, NV3;
-            if (normalsFromUV) {
-                NV1.SetXYZ(Normals(N1).XYZ());
-                NV2.SetXYZ(Normals(N2).XYZ());
-                NV3.SetXYZ(Normals(N3).XYZ());
-            }
-            else {
-                gp_Vec v1 = Base::convertTo<gp_Vec>(V1);
-                gp_Vec v2 = Base::convertTo<gp_Vec>(V2);
-                gp_Vec v3 = Base::convertTo<gp_Vec>(V3);
-
-                gp_Vec normal = (v2 - v1) ^ (v3 - v1);
-                NV1 = normal;
-                NV2 = normal;
-                NV3 = normal;
-            }
-
-            // transform the vertices and normals to the place of the face
-            if (!identity) {
-                V1.Transform(myTransf);
-                V2.Transform(myTransf);
-                V3.Transform(myTransf);
+                // get the 3 normals of this triangle
+                gp_Vec NV1, NV2, NV3;
                 if (normalsFromUV) {
-                    NV1.Transform(myTransf);
-                    NV2.Transform(myTransf);
-                    NV3.Transform(myTransf);
+                    NV1.SetXYZ(Normals(N1).XYZ());
+                    NV2.SetXYZ(Normals(N2).XYZ());
+                    NV3.SetXYZ(Normals(N3).XYZ());
+                }
+                else {
+                    gp_Vec v1 = Base::convertTo<gp_Vec>(V1);
+                    gp_Vec v2 = Base::convertTo<gp_Vec>(V2);
+                    gp_Vec v3 = Base::convertTo<gp_Vec>(V3);
+
+                    gp_Vec normal = (v2 - v1) ^ (v3 - v1);
+                    NV1 = normal;
+                    NV2 = normal;
+                    NV3 = normal;
                 }
+
+                // transform the vertices and normals to the place of the face
+                if (!identity) {
+                    V1.Transform(myTransf);
+                    V2.Transform(myTransf);
+                    V3.Transform(myTransf);
+                    if (normalsFromUV) {
+                        NV1.Transform(myTransf);
+                        NV2.Transform(myTransf);
+                        NV3.Transform(myTransf);
+                    }
+                }
+
+                // add the normals for all points of this triangle
+                norms[faceNodeOffset + N1 - 1] += Base::convertTo<SbVec3f>(NV1);
+                norms[faceNodeOffset + N2 - 1] += Base::convertTo<SbVec3f>(NV2);
+                norms[faceNodeOffset + N3 - 1] += Base::convertTo<SbVec3f>(NV3);
+
+                // set the vertices
+                verts[faceNodeOffset + N1 - 1] = Base::convertTo<SbVec3f>(V1);
+                verts[faceNodeOffset + N2 - 1] = Base::convertTo<SbVec3f>(V2);
+                verts[faceNodeOffset + N3 - 1] = Base::convertTo<SbVec3f>(V3);
+
+                // set the index vector with the 3 point indexes and the end delimiter
+                index[faceTriaOffset * 4 + 4 * (g - 1)] = faceNodeOffset + N1 - 1;
+                index[faceTriaOffset * 4 + 4 * (g - 1) + 1] = faceNodeOffset + N2 - 1;
+                index[faceTriaOffset * 4 + 4 * (g - 1) + 2] = faceNodeOffset + N3 - 1;
+                index[faceTriaOffset * 4 + 4 * (g - 1) + 3] = SO_END_FACE_INDEX;
             }
 
-            // add the normals for all points of this triangle
-            norms[faceNodeOffset + N1 - 1] += Base::convertTo<SbVec3f>(NV1);
-            norms[faceNodeOffset + N2 - 1] += Base::convertTo<SbVec3f>(NV2);
-            norms[faceNodeOffset + N3 - 1] += Base::convertTo<SbVec3f>(NV3);
-
-            // set the vertices
-            verts[faceNodeOffset + N1 - 1] = Base::convertTo<SbVec3f>(V1);
-            verts[faceNodeOffset + N2 - 1] = Base::convertTo<SbVec3f>(V2);
-            verts[faceNodeOffset + N3 - 1] = Base::convertTo<SbVec3f>(V3);
-
-            // set the index vector with the 3 point indexes and the end delimiter
-            index[faceTriaOffset * 4 + 4 * (g - 1)] = faceNodeOffset + N1 - 1;
-            index[faceTriaOffset * 4 + 4 * (g - 1) + 1] = faceNodeOffset + N2 - 1;
-            index[faceTriaOffset * 4 + 4 * (g - 1) + 2] = faceNodeOffset + N3 - 1;
-            index[faceTriaOffset * 4 + 4 * (g - 1) + 3] = SO_END_FACE_INDEX;
-        }
+            // normalize the normals of this face
+            for (int j = 0; j < nbNodesInFace; j++) {
+                norms[faceNodeOffset + j].normalize();
+            }
 
-        parts[ii] = nbTriInFace;  // new part
-
-        // handling the edges lying on this face
-        TopExp_Explorer Exp;
-        for (Exp.Init(actFace, TopAbs_EDGE); Exp.More(); Exp.Next()) {
-            const TopoDS_Edge& curEdge = TopoDS::Edge(Exp.Current());
-            // get the overall index of this edge
-            int edgeIndex = edgeMap.FindIndex(curEdge);
-            edgeVector.push_back((int32_t)edgeIndex - 1);
-            // already processed this index ?
-            if (edgeIdxSet.find(edgeIndex) != edgeIdxSet.end()) {
-
-                // this holds the indices of the edge's triangulation to the current polygon
-                Handle(Poly_PolygonOnTriangulation)
-                    aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
-                if (aPoly.IsNull()) {
-                    continue;  // polygon does not exist
-                }
+            parts[i] = nbTriInFace;  // new part
+
+            // handling the edges whose polygon is taken from this face
+            for (int edgeIndex : data.ownedEdges) {
+                const EdgeMeshData& edge = edgeData[edgeIndex];
+                int32_t* line = lines + edge.lineOffset;
 
                 // getting the indexes of the edge polygon
-                const TColStd_Array1OfInteger& indices = aPoly->Nodes();
-                for (Standard_Integer i = indices.Lower(); i <= indices.Upper(); i++) {
-                    int nodeIndex = indices(i);
+                const TColStd_Array1OfInteger& indices = edge.polygonOnFace->Nodes();
+                for (Standard_Integer j = indices.Lower(); j <= indices.Upper(); j++) {
+                    int nodeIndex = indices(j);
                     int index = faceNodeOffset + nodeIndex - 1;
-                    lineSetMap[edgeIndex].push_back(index);
+                    *line++ = index;
 
                     // usually the coordinates for this edge are already set by the
                     // triangles of the face this edge belongs to. However, there are
@@ -1333,83 +1443,244 @@ void ViewProviderPartExt::setupCoinGeometry(
                     }
                     verts[index] = Base::convertTo<SbVec3f>(p);
                 }
+                *line = -1;
+            }
+        },
+        isSingleThreaded()
+    );
 
-                // remove the handled edge index from the set
-                edgeIdxSet.erase(edgeIndex);
+    // handling of the free edges
+    OSD_Parallel::For(
+        1,
+        numEdges + 1,
+        [&](int i) {
+            const EdgeMeshData& data = edgeData[i];
+            if (data.polygon.IsNull()) {
+                return;
             }
-        }
 
-        edgeVector.push_back(-1);
+            gp_Trsf myTransf;
+            Standard_Boolean identity = true;
+            if (!data.loc.IsIdentity()) {
+                identity = false;
+                myTransf = data.loc.Transformation();
+            }
+
+            const TColgp_Array1OfPnt& aNodes = data.polygon->Nodes();
+            int32_t* line = lines + data.lineOffset;
+            for (Standard_Integer j = 1; j <= data.numLineNodes; j++) {
+                gp_Pnt pnt = aNodes(j);
+                if (!identity) {
+                    pnt.Transform(myTransf);
+                }
+                int index = data.nodeOffset + j - 1;
+                verts[index] = Base::convertTo<SbVec3f>(pnt);
+                *line++ = index;
+            }
+            if (data.numLineNodes > 0) {
+                *line = -1;
+            }
+        },
+        isSingleThreaded()
+    );
+
+    // handling of the vertices
+    for (int i = 0; i < vertexMap.Extent(); i++) {
+        const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i + 1));
+        gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
 
-        // counting up the per Face offsets
-        faceNodeOffset += nbNodesInFace;
-        faceTriaOffset += nbTriInFace;
+        verts[vertexOffset + i] = Base::convertTo<SbVec3f>(pnt);
     }
+}
 
-    // handling of the free edges
-    for (int i = 1; i <= edgeMap.Extent(); i++) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-        Standard_Boolean identity = true;
-        gp_Trsf myTransf;
-        TopLoc_Location aLoc;
-
-        // handling of the free edge that are not associated to a face
-        int hash = Part::ShapeMapHasher {}(aEdge);
-        if (faceEdges.find(hash) == faceEdges.end()) {
-            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
-            if (!aPoly.IsNull()) {
-                if (!aLoc.IsIdentity()) {
-                    identity = false;
-                    myTransf = aLoc.Transformation();
-                }
+// Meshes a copy of a shape with the given parameters and builds the content of the Coin
+// nodes. This runs in a worker thread, so it must not touch any shape or node that is used
+// elsewhere. It returns null if it has been canceled.
+std::shared_ptr<CoinMeshBuffers> buildCoinMesh(
+    TopoDS_Shape shape,
+    double deviation,
+    double angularDeflection,
+    bool normalsFromUV,
+    std::shared_ptr<std::atomic<bool>> canceled
+)
+{
+    auto buffers = std::make_shared<CoinMeshBuffers>();
+    try {
+        IMeshTools_Parameters meshParams = getMeshParameters(shape, deviation, angularDeflection);
+        BRepMesh_IncrementalMesh(shape, meshParams);
+        buffers->shape = shape;
+        buffers->params = {meshParams.Deflection, meshParams.Angle};
+        if (*canceled) {
+            return nullptr;
+        }
 
-                const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
-                int nbNodesInEdge = aPoly->NbNodes();
+        CoinMeshLayout layout;
+        layout.collect(shape);
+        if (*canceled) {
+            return nullptr;
+        }
 
-                gp_Pnt pnt;
-                for (Standard_Integer j = 1; j <= nbNodesInEdge; j++) {
-                    pnt = aNodes(j);
-                    if (!identity) {
-                        pnt.Transform(myTransf);
-                    }
-                    int index = faceNodeOffset + j - 1;
-                    verts[index] = Base::convertTo<SbVec3f>(pnt);
-                    lineSetMap[i].push_back(index);
-                }
+        buffers->verts.resize(layout.numNodes);
+        buffers->norms.resize(layout.numNorms);
+        buffers->index.resize(layout.numTriangles * 4);
+        buffers->parts.resize(layout.numFaces);
+        buffers->lines.resize(layout.numLines);
+        buffers->vertexOffset = layout.vertexOffset;
+        layout.fill(
+            buffers->verts.data(),
+            buffers->norms.data(),
+            buffers->index.data(),
+            buffers->parts.data(),
+            buffers->lines.data(),
+            normalsFromUV
+        );
+    }
+    catch (const Standard_Failure& e) {
+        buffers->error = e.GetMessageString();
+    }
+    catch (...) {
+        buffers->error = "unknown error";
+    }
+    return buffers;
+}
+
+// Sets the triangulation of the faces and edges of \a source to the same sub-shapes of \a target.
+// Both shapes must have the same topology, e.g. because one is a copy of the other.
+void transferTriangulation(const TopoDS_Shape& source, const TopoDS_Shape& target)
+{
+#if OCC_VERSION_HEX < 0x070600
+    BRepTools::Clean(target);
+#else
+    BRepTools::Clean(target, Standard_True);
+#endif
 
-                faceNodeOffset += nbNodesInEdge;
+    BRep_Builder builder;
+    TopExp_Explorer srcFace(source, TopAbs_FACE);
+    TopExp_Explorer dstFace(target, TopAbs_FACE);
+    for (; srcFace.More() && dstFace.More(); srcFace.Next(), dstFace.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(srcFace.Current());
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, loc);
+        if (mesh.IsNull()) {
+            continue;
+        }
+        builder.UpdateFace(TopoDS::Face(dstFace.Current()), mesh);
+
+        TopExp_Explorer srcEdge(face, TopAbs_EDGE);
+        TopExp_Explorer dstEdge(dstFace.Current(), TopAbs_EDGE);
+        for (; srcEdge.More() && dstEdge.More(); srcEdge.Next(), dstEdge.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(srcEdge.Current());
+            const TopoDS_Edge& other = TopoDS::Edge(dstEdge.Current());
+            if (BRep_Tool::IsClosed(edge, face)) {
+                // a seam edge has a polygon for each side
+                builder.UpdateEdge(
+                    other,
+                    BRep_Tool::PolygonOnTriangulation(
+                        TopoDS::Edge(edge.Oriented(TopAbs_FORWARD)),
+                        mesh,
+                        loc
+                    ),
+                    BRep_Tool::PolygonOnTriangulation(
+                        TopoDS::Edge(edge.Oriented(TopAbs_REVERSED)),
+                        mesh,
+                        loc
+                    ),
+                    mesh,
+                    loc
+                );
+            }
+            else {
+                Handle(Poly_PolygonOnTriangulation) polygon
+                    = BRep_Tool::PolygonOnTriangulation(edge, mesh, loc);
+                if (!polygon.IsNull()) {
+                    builder.UpdateEdge(other, polygon, mesh, loc);
+                }
             }
         }
     }
 
-    nodeset->startIndex.setValue(faceNodeOffset);
-    for (int i = 0; i < vertexMap.Extent(); i++) {
-        const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i + 1));
-        gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
-
-        verts[faceNodeOffset + i] = Base::convertTo<SbVec3f>(pnt);
+    TopExp_Explorer srcEdge(source, TopAbs_EDGE, TopAbs_FACE);
+    TopExp_Explorer dstEdge(target, TopAbs_EDGE, TopAbs_FACE);
+    for (; srcEdge.More() && dstEdge.More(); srcEdge.Next(), dstEdge.Next()) {
+        TopLoc_Location loc;
+        Handle(Poly_Polygon3D) polygon = BRep_Tool::Polygon3D(TopoDS::Edge(srcEdge.Current()), loc);
+        if (!polygon.IsNull()) {
+            builder.UpdateEdge(TopoDS::Edge(dstEdge.Current()), polygon, loc);
+        }
     }
+}
 
-    // normalize all normals
-    for (int i = 0; i < numNorms; i++) {
-        norms[i].normalize();
+}  // namespace
+
+void ViewProviderPartExt::setupCoinGeometry(
+    TopoDS_Shape shape,
+    SoCoordinate3* coords,
+    SoBrepFaceSet* faceset,
+    SoNormal* norm,
+    SoBrepEdgeSet* lineset,
+    SoBrepPointSet* nodeset,
+    double deviation,
+    double angularDeflection,
+    bool normalsFromUV
+)
+{
+    if (Part::Tools::isShapeEmpty(shape)) {
+        coords->point.setNum(0);
+        norm->vector.setNum(0);
+        faceset->coordIndex.setNum(0);
+        faceset->partIndex.setNum(0);
+        lineset->coordIndex.setNum(0);
+        nodeset->startIndex.setValue(0);
+        return;
     }
 
-    std::vector<int32_t> lineSetCoords;
-    for (const auto& it : lineSetMap) {
-        lineSetCoords.insert(lineSetCoords.end(), it.second.begin(), it.second.end());
-        lineSetCoords.push_back(-1);
+    // time measurement and book keeping
+    Base::TimeElapsed startTime;
+
+    // We must reset the location here because the transformation data
+    // are set in the placement property. This also makes the deflection
+    // independent of the placement.
+    TopLoc_Location aLoc;
+    shape.Location(aLoc);
+
+    IMeshTools_Parameters meshParams = getMeshParameters(shape, deviation, angularDeflection);
+
+    // The triangulation is stored in the faces and thus shared by all shapes with the same
+    // TShape. If it has already been created with the same parameters, e.g. before the placement
+    // was changed or for a copy of the shape, it can be reused.
+    Part::TessellationCache::Parameters cacheParams {meshParams.Deflection, meshParams.Angle};
+    Part::TessellationCache& cache = Part::TessellationCache::instance();
+    if (!cache.contains(shape, cacheParams)) {
+        // Clear triangulation and PCurves from geometry which can slow down the process
+#if OCC_VERSION_HEX < 0x070600
+        BRepTools::Clean(shape);
+#else
+        BRepTools::Clean(shape, Standard_True);
+#endif
+
+        BRepMesh_IncrementalMesh(shape, meshParams);
+        cache.add(shape, cacheParams);
     }
 
-    // preset the index vector size
-    numLines = lineSetCoords.size();
-    lineset->coordIndex.setNum(numLines);
+    CoinMeshLayout layout;
+    layout.collect(shape);
+
+    // create memory for the nodes and indexes
+    coords->point.setNum(layout.numNodes);
+    norm->vector.setNum(layout.numNorms);
+    faceset->coordIndex.setNum(layout.numTriangles * 4);
+    faceset->partIndex.setNum(layout.numFaces);
+    lineset->coordIndex.setNum(layout.numLines);
+
+    // get the raw memory for fast fill up
+    SbVec3f* verts = coords->point.startEditing();
+    SbVec3f* norms = norm->vector.startEditing();
+    int32_t* index = faceset->coordIndex.startEditing();
+    int32_t* parts = faceset->partIndex.startEditing();
     int32_t* lines = lineset->coordIndex.startEditing();
 
-    int l = 0;
-    for (auto it = lineSetCoords.begin(); it != lineSetCoords.end(); ++it, l++) {
-        lines[l] = *it;
-    }
+    layout.fill(verts, norms, index, parts, lines, normalsFromUV);
+    nodeset->startIndex.setValue(layout.vertexOffset);
 
     // end the editing of the nodes
     coords->point.finishEditing();
@@ -1425,11 +1696,11 @@ void ViewProviderPartExt::setupCoinGeometry(
     );
     Base::Console().log(
         "Shape mesh info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",
-        numFaces,
-        numEdges,
-        numNodes,
-        numTriangles,
-        numLines
+        layout.numFaces,
+        layout.numEdges,
+        layout.numNodes,
+        layout.numTriangles,
+        layout.numLines
     );
 #endif
 }
@@ -1487,7 +1758,23 @@ void ViewProviderPartExt::updateVisual()
     haction.apply(this->lineset);
     haction.apply(this->nodeset);
 
+    // a refinement of the previous shape is obsolete
+    background.reset();
+
     try {
+        double deviation = Deviation.getValue();
+        double angularDeflection = AngularDeflection.getValue();
+        bool progressive = useProgressiveTessellation(shape);
+        if (progressive) {
+            // show a coarse tessellation immediately and refine it in the background
+            ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+                "User parameter:BaseApp/Preferences/Mod/Part"
+            );
+            double factor = std::max(1.0, hGrp->GetFloat("ProgressiveTessellationFactor", 4.0));
+            deviation = std::min(deviation * factor, tessRange.UpperBound);
+            angularDeflection = std::min(angularDeflection * 2.0, 90.0);
+        }
+
         setupCoinGeometry(
             shape,
             coords,
@@ -1495,11 +1782,15 @@ void ViewProviderPartExt::updateVisual()
             norm,
             lineset,
             nodeset,
-            Deviation.getValue(),
-            AngularDeflection.getValue(),
+            deviation,
+            angularDeflection,
             NormalsFromUV
         );
 
+        if (progressive) {
+            startBackgroundTessellation(shape);
+        }
+
         lastRenderedShape = shape;
 
         VisualTouched = false;
@@ -1520,6 +1811,110 @@ void ViewProviderPartExt::updateVisual()
     setHighlightedPoints(PointColorArray.getValue());
 }
 
+bool ViewProviderPartExt::useProgressiveTessellation(const TopoDS_Shape& shape) const
+{
+    // the caller needs the final geometry right now
+    if (isUpdateForced() || Part::Tools::isShapeEmpty(shape)) {
+        return false;
+    }
+
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part"
+    );
+    if (!hGrp->GetBool("ProgressiveTessellation", true)) {
+        return false;
+    }
+
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    if (faceMap.Extent() < hGrp->GetInt("ProgressiveTessellationFaces", 1000)) {
+        return false;
+    }
+
+    // nothing to gain if the final triangulation already exists
+    TopoDS_Shape located = shape;
+    located.Location(TopLoc_Location());
+    IMeshTools_Parameters meshParams
+        = getMeshParameters(located, Deviation.getValue(), AngularDeflection.getValue());
+    return !Part::TessellationCache::instance().contains(
+        located,
+        {meshParams.Deflection, meshParams.Angle}
+    );
+}
+
+void ViewProviderPartExt::startBackgroundTessellation(const TopoDS_Shape& shape)
+{
+    // The worker meshes a copy of the shape so that it doesn't interfere with anything that
+    // uses the shape in the meantime. The copy has the same topology, so the coordinates and
+    // indexes of all elements match.
+    TopoDS_Shape copy = BRepBuilderAPI_Copy(shape, Standard_False, Standard_False).Shape();
+    copy.Location(TopLoc_Location());
+
+    background = std::make_unique<BackgroundTessellation>();
+    background->shape = shape.Located(TopLoc_Location());
+    QObject::connect(
+        &background->watcher,
+        &QFutureWatcherBase::finished,
+        &background->watcher,
+        [this]() { finishBackgroundTessellation(); }
+    );
+    background->watcher.setFuture(QtConcurrent::run(
+        buildCoinMesh,
+        copy,
+        static_cast<double>(Deviation.getValue()),
+        static_cast<double>(AngularDeflection.getValue()),
+        NormalsFromUV,
+        background->canceled
+    ));
+}
+
+void ViewProviderPartExt::finishBackgroundTessellation()
+{
+    std::shared_ptr<CoinMeshBuffers> buffers = background->watcher.result();
+    if (!buffers) {
+        return;
+    }
+    if (!buffers->error.empty()) {
+        FC_ERR(
+            "Cannot refine the Inventor representation for the shape of "
+            << pcObject->getFullName() << ": " << buffers->error
+        );
+        return;
+    }
+    if (static_cast<int>(buffers->parts.size()) != faceset->partIndex.getNum()) {
+        return;
+    }
+
+    // Keep the refined triangulation in the shape itself, so that the next update of the
+    // visual and other users of the shape can reuse it
+    try {
+        transferTriangulation(buffers->shape, background->shape);
+        Part::TessellationCache::instance().add(background->shape, buffers->params);
+    }
+    catch (const Standard_Failure& e) {
+        FC_WARN(
+            "Cannot keep the refined triangulation of the shape of "
+            << pcObject->getFullName() << ": " << e.GetMessageString()
+        );
+    }
+
+    Gui::SoUpdateVBOAction action;
+    action.apply(this->faceset);
+
+    // Selection, highlighting and colors refer to the elements by their index and are kept
+    auto assign = [](auto& field, const auto& values) {
+        field.setNum(static_cast<int>(values.size()));
+        std::copy(values.begin(), values.end(), field.startEditing());
+        field.finishEditing();
+    };
+    assign(coords->point, buffers->verts);
+    assign(norm->vector, buffers->norms);
+    assign(faceset->coordIndex, buffers->index);
+    assign(faceset->partIndex, buffers->parts);
+    assign(lineset->coordIndex, buffers->lines);
+    nodeset->startIndex.setValue(buffers->vertexOffset);
+}
+
 void ViewProviderPartExt::forceUpdate(bool enable)
 {
     if (enable) {
@@ -28,6 +28,7 @@
 
 
 #include <map>
+#include <memory>
 
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
@@ -210,6 +211,10 @@ protected:
     void onChanged(const App::Property* prop) override;
     bool loadParameter();
     void updateVisual();
+    /// Returns true if a coarse tessellation of the shape is shown until the final one is ready
+    bool useProgressiveTessellation(const TopoDS_Shape& shape) const;
+    void startBackgroundTessellation(const TopoDS_Shape& shape);
+    void finishBackgroundTessellation();
     void handleChangedPropertyName(
         Base::XMLReader& reader,
         const char* TypeName,
@@ -253,6 +258,9 @@ private:
 
     // shape that was last rendered so if it does not change we don't re-render it without need
     TopoDS_Shape lastRenderedShape;
+
+    struct BackgroundTessellation;
+    std::unique_ptr<BackgroundTessellation> background;
 };
 
 }  // namespace PartGui
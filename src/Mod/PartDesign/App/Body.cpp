@@ -44,6 +44,13 @@ PROPERTY_SOURCE(PartDesign::Body, Part::BodyBase)
 Body::Body()
 {
     ADD_PROPERTY_TYPE(AllowCompound, (true), "Base", App::Prop_None, "Allow multiple solids in Body");
+    ADD_PROPERTY_TYPE(
+        LazyRecompute,
+        (false),
+        "Base",
+        App::Prop_None,
+        "Only recompute the features up to the Tip and skip features whose inputs are unchanged"
+    );
 
     _GroupTouched.setStatus(App::Property::Output, true);
 }
@@ -437,6 +444,14 @@ void Body::onSettingDocument()
     Part::BodyBase::onSettingDocument();
 }
 
+void Body::onBeforeChange(const App::Property* prop)
+{
+    if (prop == &Tip) {
+        previousTip = Tip.getValue();
+    }
+    Part::BodyBase::onBeforeChange(prop);
+}
+
 void Body::onChanged(const App::Property* prop)
 {
     // we neither load a project nor perform undo/redo
@@ -481,6 +496,22 @@ void Body::onChanged(const App::Property* prop)
                 feature->enforceRecompute();
             }
         }
+        else if (prop == &Tip && LazyRecompute.getValue()) {
+            // The features up to the new Tip may have been skipped while they were after the Tip
+            for (auto feature : Group.getValues()) {
+                if (isSolidFeature(feature) && isAfter(feature, previousTip)
+                    && !isAfter(feature, Tip.getValue())) {
+                    feature->enforceRecompute();
+                }
+            }
+        }
+        else if (prop == &LazyRecompute && !LazyRecompute.getValue()) {
+            for (auto feature : Group.getValues()) {
+                if (isSolidFeature(feature) && isAfter(feature, Tip.getValue())) {
+                    feature->enforceRecompute();
+                }
+            }
+        }
         else if (prop == &ShapeMaterial) {
             std::vector<App::DocumentObject*> features = Group.getValues();
             if (!features.empty()) {
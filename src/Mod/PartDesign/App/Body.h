@@ -44,6 +44,7 @@ class PartDesignExport Body: public Part::BodyBase
 
 public:
     App::PropertyBool AllowCompound;
+    App::PropertyBool LazyRecompute;
 
     /// True if this body feature is active or was active when the document was last closed
     // App::PropertyBool IsActive;
@@ -151,6 +152,8 @@ public:
 protected:
     void onSettingDocument() override;
 
+    /// Remembers the Tip before it is changed
+    void onBeforeChange(const App::Property* prop) override;
     /// Adjusts the first solid's feature's base on BaseFeature getting set
     void onChanged(const App::Property* prop) override;
 
@@ -164,6 +167,8 @@ protected:
 private:
     fastsignals::scoped_connection connection;
     bool showTip = false;
+    /// The Tip before its last change. Only used for comparisons, it may have been deleted.
+    const App::DocumentObject* previousTip = nullptr;
 };
 
 }  // namespace PartDesign
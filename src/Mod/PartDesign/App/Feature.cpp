@@ -23,6 +23,11 @@
  ***************************************************************************/
 
 
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <string>
+
 #include <BRep_Tool.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepCheck_Solid.hxx>
@@ -53,6 +58,35 @@
 FC_LOG_LEVEL_INIT("PartDesign", true, true)
 
 
+namespace
+{
+
+void hashCombine(std::size_t& seed, std::size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);  // NOLINT
+}
+
+std::size_t hashShape(const Part::TopoShape& shape)
+{
+    if (shape.isNull()) {
+        return 0;
+    }
+
+    std::ostringstream str;
+    shape.exportBinary(str);
+    std::size_t seed = std::hash<std::string>()(str.str());
+
+    std::string names;
+    for (const auto& element : shape.getElementMap()) {
+        element.index.appendToStringBuffer(names);
+        element.name.appendToBuffer(names);
+    }
+    hashCombine(seed, std::hash<std::string>()(names));
+    return seed;
+}
+
+}  // namespace
+
 namespace PartDesign
 {
 
@@ -94,13 +128,95 @@ App::DocumentObjectExecReturn* Feature::recompute()
     setMaterialToBodyMaterial();
 
     if (Suppressed.getValue()) {
+        // the shape is the base shape now, so it must be computed when unsuppressed
+        inputHashes.reset();
         Shape.setValue(getBaseTopoShape(true));
         updateSuppressedShape();
         return App::DocumentObject::StdReturn;
     }
 
     SuppressedShape.setValue(TopoShape());
-    return Part::Feature::recompute();
+
+    auto body = getFeatureBody();
+    if (!body || !body->LazyRecompute.getValue()) {
+        inputHashes.reset();
+        return Part::Feature::recompute();
+    }
+
+    // The features after the Tip are recomputed when the Tip is moved past them. Their own
+    // changes are forgotten after this recompute, so they mustn't be skipped then.
+    auto tip = body->Tip.getValue();
+    if (tip && body->isAfter(this, tip)) {
+        FC_LOG("Defer recompute of " << getFullName() << " after tip");
+        inputHashes.reset();
+        return App::DocumentObject::StdReturn;
+    }
+
+    std::vector<std::size_t> hashes = getInputHashes();
+    if (canSkipRecompute(hashes)) {
+        FC_LOG("Skip recompute of " << getFullName() << " with unchanged inputs");
+        return App::DocumentObject::StdReturn;
+    }
+
+    inputHashes.reset();
+    auto ret = Part::Feature::recompute();
+    if (ret == App::DocumentObject::StdReturn) {
+        inputHashes = std::move(hashes);
+    }
+    return ret;
+}
+
+bool Feature::canSkipRecompute(const std::vector<std::size_t>& hashes) const
+{
+    if (!inputHashes || *inputHashes != hashes || Shape.getShape().isNull()) {
+        return false;
+    }
+
+    // mustExecute() only checks the properties a feature knows to change its result. Any own
+    // property that was changed since the last recompute may change it as well.
+    std::vector<App::Property*> props;
+    getPropertyList(props);
+    return std::none_of(props.begin(), props.end(), [this](const App::Property* prop) {
+        return prop->isTouched() && prop != &SuppressedShape && !isOutputProperty(prop)
+            && !(prop->getType() & App::Prop_NoRecompute);
+    });
+}
+
+std::vector<std::size_t> Feature::getInputHashes() const
+{
+    std::vector<std::size_t> hashes;
+    for (auto obj : getOutList()) {
+        // the shape of the body is the result of its Tip and not an input
+        if (obj->isDerivedFrom<Body>()) {
+            continue;
+        }
+        std::size_t seed = std::hash<const void*>()(obj);
+        if (auto pdFeature = freecad_cast<PartDesign::Feature*>(obj)) {
+            hashCombine(seed, pdFeature->getShapeHash());
+        }
+        else if (auto partFeature = freecad_cast<Part::Feature*>(obj)) {
+            hashCombine(seed, hashShape(partFeature->Shape.getShape()));
+        }
+        if (auto geo = freecad_cast<App::GeoFeature*>(obj)) {
+            Base::Matrix4D matrix = geo->Placement.getValue().toMatrix();
+            for (int i = 0; i < 4; ++i) {
+                for (int j = 0; j < 4; ++j) {
+                    hashCombine(seed, std::hash<double>()(matrix[i][j]));
+                }
+            }
+        }
+        hashes.push_back(seed);
+    }
+    return hashes;
+}
+
+std::size_t Feature::getShapeHash() const
+{
+    // the shape is hashed at most once after each change, as it is an input of the next feature
+    if (!shapeHash) {
+        shapeHash = hashShape(Shape.getShape());
+    }
+    return *shapeHash;
 }
 
 App::DocumentObjectExecReturn* Feature::recomputePreview()
@@ -231,6 +347,9 @@ bool Feature::relinkToMatchingSubelements(
 
 void Feature::onChanged(const App::Property* prop)
 {
+    if (prop == &Shape) {
+        shapeHash.reset();
+    }
     if (!this->isRestoring() && this->getDocument()
         && !this->getDocument()->isPerformingTransaction()) {
         if (prop == &Visibility || prop == &BaseFeature) {
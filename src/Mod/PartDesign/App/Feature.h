@@ -25,6 +25,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <optional>
+#include <vector>
+
 #include <App/PropertyStandard.h>
 #include <App/PropertyLinks.h>
 #include <App/SuppressibleExtension.h>
@@ -94,6 +98,11 @@ public:
     virtual const TopoDS_Shape& getBaseShape() const;
     /// Returns the BaseFeature property's TopoShape (if any)
     Part::TopoShape getBaseTopoShape(bool silent = false) const;
+    /** Returns a hash of the shape with its element names.
+     * It is used to detect unchanged inputs if the body recomputes lazily, see
+     * Body::LazyRecompute.
+     */
+    std::size_t getShapeHash() const;
 
     // Fills up information about which sub-shapes were generated by the feature
     virtual void getGeneratedShapes(
@@ -164,6 +173,15 @@ protected:
     // TODO: Toponaming April 2024 Deprecated in favor of TopoShape method.  Remove when possible.
     static TopoDS_Shape makeShapeFromPlane(const App::DocumentObject* obj);
     static TopoShape makeTopoShapeFromPlane(const App::DocumentObject* obj);
+
+private:
+    bool canSkipRecompute(const std::vector<std::size_t>& hashes) const;
+    std::vector<std::size_t> getInputHashes() const;
+
+private:
+    /// The hashes of the inputs of the last successful execution, if the body recomputes lazily
+    std::optional<std::vector<std::size_t>> inputHashes;
+    mutable std::optional<std::size_t> shapeHash;
 };
 
 using FeaturePython = App::FeaturePythonT<Feature>;
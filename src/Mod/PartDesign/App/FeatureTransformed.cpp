@@ -51,6 +51,8 @@
 #include "FeatureLinearPattern.h"
 #include "FeaturePolarPattern.h"
 #include "FeatureSketchBased.h"
+#include "PartDesignParameter.h"
+#include "PatternBoolean.h"
 #include "Mod/Part/App/TopoShapeOpCode.h"
 
 
@@ -403,6 +405,34 @@ App::DocumentObjectExecReturn* Transformed::execute()
         return shapes;
     };
 
+    // Big patterns can be split into slabs that are computed in parallel. This is optional
+    // because the element names differ from the ones of the plain boolean.
+    auto makePartitionedBoolean = [&](const char* maker, const std::vector<TopoShape>& shapes) {
+        auto param = PartDesignParameter::instance();
+        if (!param->getPatternPartitioning()) {
+            return false;
+        }
+        PatternBoolean boolean(maker, shapes);
+        if (!boolean.partition(std::max(param->getPatternPartitionSize(), 1L))) {
+            return false;
+        }
+        try {
+            supportShape = boolean.perform();
+            return true;
+        }
+        catch (const Base::CADKernelError& e) {
+            if (Base::Sequencer().wasCanceled()) {
+                throw;
+            }
+            Base::Console().warning(
+                "%s: %s. Using a single boolean instead.\n",
+                getFullLabel().c_str(),
+                e.what()
+            );
+            return false;
+        }
+    };
+
     switch (mode) {
         case Mode::Features:
             // NOTE: It would be possible to build a compound from all original addShapes/subShapes
@@ -442,14 +472,18 @@ App::DocumentObjectExecReturn* Transformed::execute()
                     if (Base::Sequencer().wasCanceled()) {
                         return new App::DocumentObjectExecReturn("User aborted");
                     }
-                    supportShape.makeElementFuse(shapes);
+                    if (!makePartitionedBoolean(Part::OpCodes::Fuse, shapes)) {
+                        supportShape.makeElementFuse(shapes);
+                    }
                 }
                 if (!cutShape.isNull()) {
                     auto shapes = getTransformedCompShape(supportShape, cutShape);
                     if (Base::Sequencer().wasCanceled()) {
                         return new App::DocumentObjectExecReturn("User aborted");
                     }
-                    supportShape.makeElementCut(shapes);
+                    if (!makePartitionedBoolean(Part::OpCodes::Cut, shapes)) {
+                        supportShape.makeElementCut(shapes);
+                    }
                 }
             }
             break;
@@ -31,6 +31,8 @@ void PartDesignParameter::setup()
 {
     // NOLINTBEGIN
     addParameter("AllowCompoundDefault", Bool {true});
+    addParameter("PatternPartitioning", Bool {false});
+    addParameter("PatternPartitionSize", Int {64});
     // NOLINTEND
 }
 
@@ -50,3 +52,5 @@ PartDesignParameter* PartDesignParameter::instance()
 }
 
 FC_PARAM_GETSET_IMP(PartDesignParameter, AllowCompoundDefault, bool)
+FC_PARAM_GETSET_IMP(PartDesignParameter, PatternPartitioning, bool)
+FC_PARAM_GETSET_IMP(PartDesignParameter, PatternPartitionSize, long)
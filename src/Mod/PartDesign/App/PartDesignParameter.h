@@ -43,6 +43,10 @@ public:
 
     bool getAllowCompoundDefault() const;
     void setAllowCompoundDefault(bool v);
+    bool getPatternPartitioning() const;
+    void setPatternPartitioning(bool v);
+    long getPatternPartitionSize() const;
+    void setPatternPartitionSize(long v);
 
 private:
     void setup();
@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <BRep_Tool.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
+#include <ShapeUpgrade_UnifySameDomain.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_MapOfShape.hxx>
+
+#include <Base/Exception.h>
+#include <Mod/Part/App/TopoShapeOpCode.h>
+
+#include "PatternBoolean.h"
+
+using namespace PartDesign;
+using Part::TopoShape;
+
+namespace
+{
+
+std::pair<double, double> getRange(const Bnd_Box& box, int axis)
+{
+    double min[3];
+    double max[3];
+    box.Get(min[0], min[1], min[2], max[0], max[1], max[2]);
+    return {min[axis], max[axis]};
+}
+
+double getTolerance(const TopoDS_Shape& shape)
+{
+    switch (shape.ShapeType()) {
+        case TopAbs_EDGE:
+            return BRep_Tool::Tolerance(TopoDS::Edge(shape));
+        case TopAbs_VERTEX:
+            return BRep_Tool::Tolerance(TopoDS::Vertex(shape));
+        default:
+            return Precision::Confusion();
+    }
+}
+
+}  // namespace
+
+PatternBoolean::PatternBoolean(const char* maker, std::vector<TopoShape> shapes)
+    : maker(maker)
+    , shapes(std::move(shapes))
+{}
+
+bool PatternBoolean::partition(std::size_t minSlabSize)
+{
+    slabs.clear();
+    seams.clear();
+    extent.SetVoid();
+    minSlabSize = std::max<std::size_t>(minSlabSize, 1);
+    if (shapes.size() < 2 * minSlabSize + 1) {
+        return false;
+    }
+
+    std::vector<Bnd_Box> boxes(shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); ++i) {
+        if (shapes[i].isNull()) {
+            return false;
+        }
+        BRepBndLib::Add(shapes[i].getShape(), boxes[i]);
+        if (boxes[i].IsVoid()) {
+            return false;
+        }
+        extent.Add(boxes[i]);
+    }
+
+    // Split along the axis where the centers of the instances are spread the most
+    double spread = -1.0;
+    for (int i = 0; i < 3; ++i) {
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        for (std::size_t j = 1; j < boxes.size(); ++j) {
+            auto range = getRange(boxes[j], i);
+            double center = (range.first + range.second) / 2.0;
+            min = std::min(min, center);
+            max = std::max(max, center);
+        }
+        if (max - min > spread) {
+            spread = max - min;
+            axis = i;
+        }
+    }
+
+    struct Interval
+    {
+        double min;
+        double max;
+        std::size_t index;
+    };
+    std::vector<Interval> intervals;
+    intervals.reserve(shapes.size() - 1);
+    double length = 0.0;
+    for (std::size_t i = 1; i < boxes.size(); ++i) {
+        auto range = getRange(boxes[i], axis);
+        intervals.push_back({range.first, range.second, i});
+        length += range.second - range.first;
+    }
+    std::sort(intervals.begin(), intervals.end(), [](const Interval& a, const Interval& b) {
+        return a.min < b.min;
+    });
+
+    // A seam must keep some distance to the instances, otherwise the faces of the slab boxes
+    // nearly coincide with the faces of the instances and the booleans get fragile.
+    double minGap = std::max(Precision::Confusion() * 100, 0.01 * length / intervals.size());
+
+    // Aim at two slabs per thread to balance the load, but not at slabs with fewer instances
+    // than requested
+    std::size_t numSlabs = 2 * std::max(1U, std::thread::hardware_concurrency());
+    std::size_t slabSize = std::max(minSlabSize, (intervals.size() + numSlabs - 1) / numSlabs);
+
+    std::vector<std::size_t> slab;
+    double reach = std::numeric_limits<double>::lowest();
+    for (std::size_t i = 0; i < intervals.size(); ++i) {
+        slab.push_back(intervals[i].index);
+        reach = std::max(reach, intervals[i].max);
+        std::size_t remaining = intervals.size() - i - 1;
+        if (slab.size() < slabSize || remaining < minSlabSize) {
+            continue;
+        }
+        double next = intervals[i + 1].min;
+        if (next - reach > minGap) {
+            seams.push_back((reach + next) / 2.0);
+            slabs.push_back(std::move(slab));
+            slab.clear();
+        }
+    }
+    slabs.push_back(std::move(slab));
+
+    if (slabs.size() < 2) {
+        slabs.clear();
+        seams.clear();
+        return false;
+    }
+
+    extent.Enlarge(std::max(1.0, 0.01 * std::sqrt(extent.SquareExtent())));
+    return true;
+}
+
+TopoDS_Shape PatternBoolean::makeSlabBox(std::size_t slab) const
+{
+    double lower[3];
+    double upper[3];
+    extent.Get(lower[0], lower[1], lower[2], upper[0], upper[1], upper[2]);
+    if (slab > 0) {
+        lower[axis] = seams[slab - 1];
+    }
+    if (slab < seams.size()) {
+        upper[axis] = seams[slab];
+    }
+    gp_Pnt pnt1(lower[0], lower[1], lower[2]);
+    gp_Pnt pnt2(upper[0], upper[1], upper[2]);
+    return BRepPrimAPI_MakeBox(pnt1, pnt2).Shape();
+}
+
+TopoShape PatternBoolean::performSlab(std::size_t slab, const TopoShape& support) const
+{
+    TopoShape region(makeSlabBox(slab), 0, support.Hasher);
+    TopoShape part(support.Tag, support.Hasher);
+    part.makeElementBoolean(Part::OpCodes::Common, {support, region});
+
+    std::vector<TopoShape> operands;
+    if (part.countSubShapes(TopAbs_SOLID) > 0) {
+        operands.push_back(part);
+    }
+    else if (strcmp(maker, Part::OpCodes::Cut) == 0) {
+        // nothing of the support is left to cut in this slab
+        return {};
+    }
+    for (std::size_t index : slabs[slab]) {
+        operands.push_back(shapes[index]);
+    }
+    if (operands.size() == 1) {
+        return operands.front();
+    }
+
+    TopoShape result(support.Tag, support.Hasher);
+    result.makeElementBoolean(maker, operands);
+    return result;
+}
+
+bool PatternBoolean::isOnSeam(const TopoDS_Shape& shape) const
+{
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box, Standard_False);
+    if (box.IsVoid()) {
+        return false;
+    }
+
+    auto range = getRange(box, axis);
+    double tol = 2.0 * getTolerance(shape) + Precision::Confusion();
+    return std::any_of(seams.begin(), seams.end(), [&](double seam) {
+        return range.first >= seam - tol && range.second <= seam + tol;
+    });
+}
+
+TopoShape PatternBoolean::unifySeams(const TopoShape& shape) const
+{
+    // Only the edges and vertices on the seams may be removed. The faces that are split
+    // elsewhere are kept as they are because the plain boolean doesn't refine either.
+    TopTools_MapOfShape keep;
+    for (auto type : {TopAbs_EDGE, TopAbs_VERTEX}) {
+        TopTools_IndexedMapOfShape map;
+        TopExp::MapShapes(shape.getShape(), type, map);
+        for (int i = 1; i <= map.Extent(); ++i) {
+            if (!isOnSeam(map(i))) {
+                keep.Add(map(i));
+            }
+        }
+    }
+
+    ShapeUpgrade_UnifySameDomain
+        unify(shape.getShape(), Standard_True, Standard_True, Standard_False);
+    unify.KeepShapes(keep);
+    unify.Build();
+
+    TopoShape result(shape.Tag, shape.Hasher);
+    result.makeShapeWithElementMap(
+        unify.Shape(),
+        Part::MapperHistory(unify.History()),
+        {shape},
+        Part::OpCodes::Refine
+    );
+    return result;
+}
+
+TopoShape PatternBoolean::perform() const
+{
+    // Copies of a TopoShape share its cache and element map, which are filled lazily on access.
+    // So each slab gets a support with a cache and an element map of its own. The map of the
+    // original support is only read while the slabs are computed.
+    const TopoShape& support = shapes.front();
+    bool mapped = support.getElementMapSize() > 0;
+    std::vector<TopoShape> supports;
+    supports.reserve(slabs.size());
+    for (std::size_t i = 0; i < slabs.size(); ++i) {
+        supports.emplace_back(support.Tag, support.Hasher, support.getShape());
+        if (mapped) {
+            supports.back().copyElementMap(support);
+        }
+    }
+
+    std::vector<TopoShape> pieces(slabs.size());
+    std::vector<std::string> errors(slabs.size());
+    OSD_Parallel::For(0, static_cast<int>(slabs.size()), [&](int slab) {
+        try {
+            pieces[slab] = performSlab(slab, supports[slab]);
+        }
+        catch (const Standard_Failure& e) {
+            errors[slab] = e.GetMessageString();
+        }
+        catch (const Base::Exception& e) {
+            errors[slab] = e.what();
+        }
+    });
+
+    for (const auto& error : errors) {
+        if (!error.empty()) {
+            FC_THROWM(Base::CADKernelError, "Boolean of pattern instances failed: " << error);
+        }
+    }
+
+    pieces.erase(
+        std::remove_if(pieces.begin(), pieces.end(), [](const TopoShape& piece) {
+            return piece.isNull();
+        }),
+        pieces.end()
+    );
+    if (pieces.empty()) {
+        FC_THROWM(Base::CADKernelError, "Boolean of pattern instances has no result");
+    }
+
+    TopoShape result(support.Tag, support.Hasher);
+    if (pieces.size() == 1) {
+        result = pieces.front();
+    }
+    else {
+        result.makeElementFuse(pieces);
+    }
+
+    try {
+        result = unifySeams(result);
+    }
+    catch (const Standard_Failure& e) {
+        FC_THROWM(
+            Base::CADKernelError,
+            "Failed to unify the faces of pattern instances: " << e.GetMessageString()
+        );
+    }
+    return result;
+}
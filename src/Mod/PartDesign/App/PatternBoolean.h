@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <Bnd_Box.hxx>
+
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/PartDesign/PartDesignGlobal.h>
+
+namespace PartDesign
+{
+
+/** Boolean operation of a support shape with the many instances of a pattern.
+ *
+ * One boolean of the support with all instances gets very slow for big patterns. Instead the
+ * instances are grouped into slabs along the axis where they are spread the most. The slab
+ * boundaries are only put into gaps between the instances, so that each instance lies in exactly
+ * one slab. The part of the support inside each slab is cut or fused with the instances of the
+ * slab in parallel, the slabs are fused again and the faces that were split at the slab
+ * boundaries are unified.
+ *
+ * The geometry of the result is the same as of the plain boolean, but the element names differ.
+ */
+class PartDesignExport PatternBoolean
+{
+public:
+    /** \a shapes is the support followed by the instances, like for
+     * Part::TopoShape::makeElementBoolean(). \a maker must be Part::OpCodes::Fuse or
+     * Part::OpCodes::Cut.
+     */
+    PatternBoolean(const char* maker, std::vector<Part::TopoShape> shapes);
+
+    /** Groups the instances into slabs of at least \a minSlabSize instances.
+     * Returns false if there are fewer than two slabs, e.g. because the instances overlap
+     * along every axis. In this case the plain boolean must be used.
+     */
+    bool partition(std::size_t minSlabSize);
+    std::size_t countSlabs() const
+    {
+        return slabs.size();
+    }
+    /** Returns the result of the boolean with the tag and hasher of the support.
+     * partition() must have succeeded before. Throws Base::CADKernelError if the boolean of a
+     * slab failed.
+     */
+    Part::TopoShape perform() const;
+
+private:
+    TopoDS_Shape makeSlabBox(std::size_t slab) const;
+    Part::TopoShape performSlab(std::size_t slab, const Part::TopoShape& support) const;
+    Part::TopoShape unifySeams(const Part::TopoShape& shape) const;
+    bool isOnSeam(const TopoDS_Shape& shape) const;
+
+private:
+    const char* maker;
+    std::vector<Part::TopoShape> shapes;
+    Bnd_Box extent;
+    int axis {0};
+    /// The positions of the boundaries between the slabs along the axis
+    std::vector<double> seams;
+    /// The indices into shapes of the instances of each slab
+    std::vector<std::vector<std::size_t>> slabs;
+};
+
+}  // namespace PartDesign
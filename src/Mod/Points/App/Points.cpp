@@ -28,6 +28,8 @@
 #include <iostream>
 
 
+#include <Base/Console.h>
+#include <Base/FileInfo.h>
 #include <Base/Matrix.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
@@ -45,15 +47,25 @@ using namespace std;
 
 TYPESYSTEM_SOURCE(Points::PointKernel, Data::ComplexGeoData)
 
+PointKernel::size_type PointKernel::tiledThreshold = 20000000;
+
 PointKernel::PointKernel(const PointKernel& pts)
     : _Mtrx(pts._Mtrx)
-    , _Points(pts._Points)
-{}
+{
+    std::lock_guard<std::mutex> lock(pts._TilesMutex);
+    _Points = pts._Points;
+    _Tiles = pts._Tiles;
+    _TilesLoaded = pts._TilesLoaded.load();
+}
 
 PointKernel::PointKernel(PointKernel&& pts) noexcept
     : _Mtrx(pts._Mtrx)
     , _Points(std::move(pts._Points))
-{}
+    , _Tiles(std::move(pts._Tiles))
+    , _TilesLoaded(pts._TilesLoaded.load())
+{
+    pts._TilesLoaded = false;
+}
 
 std::vector<const char*> PointKernel::getElementTypes() const
 {
@@ -81,6 +93,72 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
     return nullptr;
 }
 
+void PointKernel::setTiledStore(std::shared_ptr<const TiledPointStore> store)
+{
+    _Points.clear();
+    _Points.shrink_to_fit();
+    _Tiles = std::move(store);
+    _TilesLoaded = false;
+}
+
+void PointKernel::setTiledThreshold(size_type num)
+{
+    tiledThreshold = num;
+}
+
+PointKernel::size_type PointKernel::getTiledThreshold()
+{
+    return tiledThreshold;
+}
+
+std::shared_ptr<TiledPointStore> PointKernel::createTiledStore()
+{
+    return std::make_shared<TiledPointStore>(Base::FileInfo::getTempFileName("FCPoints"));
+}
+
+void PointKernel::copyTiles() const
+{
+    std::lock_guard<std::mutex> lock(_TilesMutex);
+    if (_TilesLoaded.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // this defeats the out-of-core storage, so make it visible
+    Base::Console().log("Copy the %zu points of the tiled store into memory\n", _Tiles->size());
+    std::vector<value_type> points;
+    points.reserve(_Tiles->size());
+    for (const auto& tile : *_Tiles) {
+        points.insert(points.end(), tile.begin(), tile.end());
+    }
+    _Points.swap(points);
+    _TilesLoaded.store(true, std::memory_order_release);
+}
+
+PointKernel::value_type PointKernel::getKernelPoint(size_type index) const
+{
+    if (_Tiles && !_TilesLoaded.load(std::memory_order_acquire)) {
+        return _Tiles->getPoint(index);
+    }
+    return _Points[index];
+}
+
+template<typename Func>
+void PointKernel::forEachPoint(Func&& func) const
+{
+    if (_Tiles) {
+        for (const auto& tile : *_Tiles) {
+            for (const auto& pnt : tile) {
+                func(pnt);
+            }
+        }
+    }
+    else {
+        for (const auto& pnt : _Points) {
+            func(pnt);
+        }
+    }
+}
+
 void PointKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
     std::vector<value_type>& kernel = getBasicPoints();
@@ -114,6 +192,20 @@ Base::BoundBox3d PointKernel::getBoundBox() const
 {
     Base::BoundBox3d bnd;
 
+    if (_Tiles) {
+        // like for meshes the transformed corners of the boxes are used, but per tile
+        for (std::size_t i = 0; i < _Tiles->countTiles(); ++i) {
+            const Base::BoundBox3f& box = _Tiles->getTileInfo(i).box;
+            if (!box.IsValid()) {
+                continue;
+            }
+            for (unsigned short j = 0; j < 8; ++j) {
+                bnd.Add(transformPointToOutside(box.CalcPoint(j)));
+            }
+        }
+        return bnd;
+    }
+
 #ifdef _MSC_VER
     // Thread-local bounding boxes
     Concurrency::combinable<Base::BoundBox3d> bbs;
@@ -138,7 +230,10 @@ PointKernel& PointKernel::operator=(const PointKernel& Kernel)
     if (this != &Kernel) {
         // copy the mesh structure
         setTransform(Kernel._Mtrx);
+        std::lock_guard<std::mutex> lock(Kernel._TilesMutex);
         this->_Points = Kernel._Points;
+        this->_Tiles = Kernel._Tiles;
+        this->_TilesLoaded = Kernel._TilesLoaded.load();
     }
 
     return *this;
@@ -150,6 +245,9 @@ PointKernel& PointKernel::operator=(PointKernel&& Kernel) noexcept
         // copy the mesh structure
         setTransform(Kernel._Mtrx);
         this->_Points = std::move(Kernel._Points);
+        this->_Tiles = std::move(Kernel._Tiles);
+        this->_TilesLoaded = Kernel._TilesLoaded.load();
+        Kernel._TilesLoaded = false;
     }
 
     return *this;
@@ -157,17 +255,21 @@ PointKernel& PointKernel::operator=(PointKernel&& Kernel) noexcept
 
 unsigned int PointKernel::getMemSize() const
 {
+    // tiles are only mapped temporarily and thus not counted
+    if (_Tiles) {
+        return _Tiles->countTiles() * sizeof(TiledPointStore::TileInfo);
+    }
     return _Points.size() * sizeof(value_type);
 }
 
 PointKernel::size_type PointKernel::countValid() const
 {
     size_type num = 0;
-    for (const auto& it : *this) {
+    forEachPoint([&num](const value_type& it) {
         if (!(boost::math::isnan(it.x) || boost::math::isnan(it.y) || boost::math::isnan(it.z))) {
             num++;
         }
-    }
+    });
     return num;
 }
 
@@ -175,15 +277,16 @@ std::vector<PointKernel::value_type> PointKernel::getValidPoints() const
 {
     std::vector<PointKernel::value_type> valid;
     valid.reserve(countValid());
-    for (const auto& it : *this) {
+    forEachPoint([this, &valid](const value_type& it) {
         if (!(boost::math::isnan(it.x) || boost::math::isnan(it.y) || boost::math::isnan(it.z))) {
+            Base::Vector3d pnt = _Mtrx * Base::Vector3d(it.x, it.y, it.z);
             valid.emplace_back(
-                static_cast<float_type>(it.x),
-                static_cast<float_type>(it.y),
-                static_cast<float_type>(it.z)
+                static_cast<float_type>(pnt.x),
+                static_cast<float_type>(pnt.y),
+                static_cast<float_type>(pnt.z)
             );
         }
-    }
+    });
     return valid;
 }
 
@@ -202,6 +305,10 @@ void PointKernel::SaveDocFile(Base::Writer& writer) const
     uint32_t uCt = (uint32_t)size();
     str << uCt;
     // store the data without transforming it
+    if (_Tiles) {
+        _Tiles->write(str);
+        return;
+    }
     for (const auto& pnt : _Points) {
         str << pnt.x << pnt.y << pnt.z;
     }
@@ -229,6 +336,15 @@ void PointKernel::RestoreDocFile(Base::Reader& reader)
     Base::InputStream str(reader);
     uint32_t uCt = 0;
     str >> uCt;
+    if (uCt >= tiledThreshold) {
+        // keep the order because per-point properties are saved in the same order
+        std::shared_ptr<TiledPointStore> store = createTiledStore();
+        store->read(str, uCt, TiledPointStore::Order::Keep);
+        setTiledStore(store);
+        return;
+    }
+
+    releaseTiles();
     _Points.resize(uCt);
     for (unsigned long i = 0; i < uCt; i++) {
         float x {};
@@ -253,9 +369,9 @@ void PointKernel::load(const char* file)
 void PointKernel::save(std::ostream& out) const
 {
     out << "# ASCII" << std::endl;
-    for (const auto& pnt : _Points) {
+    forEachPoint([&out](const value_type& pnt) {
         out << pnt.x << " " << pnt.y << " " << pnt.z << std::endl;
-    }
+    });
 }
 
 void PointKernel::getPoints(
@@ -265,27 +381,18 @@ void PointKernel::getPoints(
     uint16_t /*flags*/
 ) const
 {
-    unsigned long ctpoints = _Points.size();
-    Points.reserve(ctpoints);
-    for (unsigned long i = 0; i < ctpoints; i++) {
-        Points.push_back(this->getPoint(i));
-    }
+    Points.reserve(size());
+    forEachPoint([this, &Points](const value_type& pnt) {
+        Points.push_back(transformPointToOutside(pnt));
+    });
 }
 
 // ----------------------------------------------------------------------------
 
-PointKernel::const_point_iterator::const_point_iterator(
-    const PointKernel* kernel,
-    std::vector<kernel_type>::const_iterator index
-)
+PointKernel::const_point_iterator::const_point_iterator(const PointKernel* kernel, size_type index)
     : _kernel(kernel)
-    , _p_it(index)
-{
-    if (_p_it != kernel->_Points.end()) {
-        value_type vertd(_p_it->x, _p_it->y, _p_it->z);
-        this->_point = _kernel->_Mtrx * vertd;
-    }
-}
+    , _index(index)
+{}
 
 PointKernel::const_point_iterator::const_point_iterator(
     const PointKernel::const_point_iterator& fi
@@ -307,7 +414,20 @@ PointKernel::const_point_iterator& PointKernel::const_point_iterator::operator=(
 
 void PointKernel::const_point_iterator::dereference()
 {
-    value_type vertd(_p_it->x, _p_it->y, _p_it->z);
+    kernel_type pnt;
+    const auto& tiles = _kernel->_Tiles;
+    if (tiles && !_kernel->_TilesLoaded.load(std::memory_order_acquire)) {
+        // keep the tile mapped while iterating over its points
+        if (!_tile || _index < _tile->getInfo().first
+            || _index >= _tile->getInfo().first + _tile->size()) {
+            _tile = tiles->getTile(tiles->findTile(_index));
+        }
+        pnt = (*_tile)[_index - _tile->getInfo().first];
+    }
+    else {
+        pnt = _kernel->_Points[_index];
+    }
+    value_type vertd(pnt.x, pnt.y, pnt.z);
     this->_point = _kernel->_Mtrx * vertd;
 }
 
@@ -325,7 +445,7 @@ const PointKernel::const_point_iterator::value_type* PointKernel::const_point_it
 
 bool PointKernel::const_point_iterator::operator==(const PointKernel::const_point_iterator& pi) const
 {
-    return (this->_kernel == pi._kernel) && (this->_p_it == pi._p_it);
+    return (this->_kernel == pi._kernel) && (this->_index == pi._index);
 }
 
 bool PointKernel::const_point_iterator::operator!=(const PointKernel::const_point_iterator& pi) const
@@ -335,27 +455,27 @@ bool PointKernel::const_point_iterator::operator!=(const PointKernel::const_poin
 
 PointKernel::const_point_iterator& PointKernel::const_point_iterator::operator++()
 {
-    ++(this->_p_it);
+    ++(this->_index);
     return *this;
 }
 
 PointKernel::const_point_iterator PointKernel::const_point_iterator::operator++(int)
 {
     PointKernel::const_point_iterator tmp = *this;
-    ++(this->_p_it);
+    ++(this->_index);
     return tmp;
 }
 
 PointKernel::const_point_iterator& PointKernel::const_point_iterator::operator--()
 {
-    --(this->_p_it);
+    --(this->_index);
     return *this;
 }
 
 PointKernel::const_point_iterator PointKernel::const_point_iterator::operator--(int)
 {
     PointKernel::const_point_iterator tmp = *this;
-    --(this->_p_it);
+    --(this->_index);
     return tmp;
 }
 
@@ -373,13 +493,13 @@ PointKernel::const_point_iterator PointKernel::const_point_iterator::operator-(d
 
 PointKernel::const_point_iterator& PointKernel::const_point_iterator::operator+=(difference_type off)
 {
-    (this->_p_it) += off;
+    this->_index += off;
     return *this;
 }
 
 PointKernel::const_point_iterator& PointKernel::const_point_iterator::operator-=(difference_type off)
 {
-    (this->_p_it) -= off;
+    this->_index -= off;
     return *this;
 }
 
@@ -387,5 +507,5 @@ PointKernel::difference_type PointKernel::const_point_iterator::operator-(
     const PointKernel::const_point_iterator& right
 ) const
 {
-    return this->_p_it - right._p_it;
+    return static_cast<difference_type>(this->_index) - static_cast<difference_type>(right._index);
 }
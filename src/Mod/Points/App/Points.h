@@ -25,7 +25,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 #include <App/ComplexGeoData.h>
@@ -38,6 +42,8 @@
 
 #include <Mod/Points/PointsGlobal.h>
 
+#include "TiledPointStore.h"
+
 namespace Points
 {
 
@@ -87,21 +93,51 @@ public:
     }
     std::vector<value_type>& getBasicPoints()
     {
+        detachTiles();
         return this->_Points;
     }
+    /// Copies the points of a tiled store into memory, see setTiledStore()
     const std::vector<value_type>& getBasicPoints() const
     {
+        loadTiles();
         return this->_Points;
     }
     void setBasicPoints(const std::vector<value_type>& pts)
     {
+        releaseTiles();
         this->_Points = pts;
     }
     void swap(std::vector<value_type>& pts)
     {
+        detachTiles();
         this->_Points.swap(pts);
     }
 
+    /** @name Out-of-core storage */
+    //@{
+    /** Uses the finished \a store as point storage instead of the array of points.
+     * getPoint() and the point iterators read the points from the tiles. Only methods that need
+     * the array of points, like getBasicPoints(), copy the tiles back into memory, which is
+     * logged. The const methods keep the store, so that they can be called from several
+     * threads, while methods that modify the points drop it. Algorithms that must cope with
+     * huge point clouds should iterate over the tiles of getTiledStore() if isTiled() is true.
+     */
+    void setTiledStore(std::shared_ptr<const TiledPointStore> store);
+    std::shared_ptr<const TiledPointStore> getTiledStore() const
+    {
+        return _Tiles;
+    }
+    bool isTiled() const
+    {
+        return static_cast<bool>(_Tiles);
+    }
+    /// Point clouds with at least this number of points are loaded into a tiled store
+    static void setTiledThreshold(size_type num);
+    static size_type getTiledThreshold();
+    /// Creates an empty tiled store in the temporary directory
+    static std::shared_ptr<TiledPointStore> createTiledStore();
+    //@}
+
     void getPoints(
         std::vector<Base::Vector3d>& Points,
         std::vector<Base::Vector3d>& Normals,
@@ -126,33 +162,66 @@ public:
     void load(std::istream&);
     //@}
 
+private:
+    void loadTiles() const
+    {
+        if (_Tiles && !_TilesLoaded.load(std::memory_order_acquire)) {
+            copyTiles();
+        }
+    }
+    void detachTiles()
+    {
+        loadTiles();
+        releaseTiles();
+    }
+    void releaseTiles()
+    {
+        _Tiles.reset();
+        _TilesLoaded = false;
+    }
+    void copyTiles() const;
+    value_type getKernelPoint(size_type index) const;
+    template<typename Func>
+    void forEachPoint(Func&& func) const;
+
 private:
     Base::Matrix4D _Mtrx;
-    std::vector<value_type> _Points;
+    // The points are either kept in the array or in the tiled store. The array is filled lazily
+    // from the store when it is needed, that's why it is mutable. The const methods may be
+    // called concurrently, so filling it is guarded by the mutex.
+    mutable std::vector<value_type> _Points;
+    std::shared_ptr<const TiledPointStore> _Tiles;
+    mutable std::mutex _TilesMutex;
+    mutable std::atomic<bool> _TilesLoaded {false};
+    static size_type tiledThreshold;
 
 public:
     /// number of points stored
     size_type size() const
     {
-        return this->_Points.size();
+        return _Tiles ? _Tiles->size() : this->_Points.size();
     }
     size_type countValid() const;
     std::vector<value_type> getValidPoints() const;
     void resize(size_type n)
     {
+        detachTiles();
         _Points.resize(n);
     }
     void reserve(size_type n)
     {
+        detachTiles();
         _Points.reserve(n);
     }
     inline void erase(size_type first, size_type last)
     {
+        detachTiles();
         _Points.erase(_Points.begin() + first, _Points.begin() + last);
     }
 
     void clear()
     {
+        releaseTiles();
         _Points.clear();
     }
 
@@ -160,16 +229,18 @@ public:
     /// get the points
     inline const Base::Vector3d getPoint(const int idx) const
     {
-        return transformPointToOutside(_Points[idx]);
+        return transformPointToOutside(getKernelPoint(idx));
     }
     /// set the points
     inline void setPoint(const int idx, const Base::Vector3d& point)
     {
+        detachTiles();
         _Points[idx] = transformPointToInside(point);
     }
     /// insert the points
     inline void push_back(const Base::Vector3d& point)
     {
+        detachTiles();
         _Points.push_back(transformPointToInside(point));
     }
 
@@ -178,13 +249,12 @@ public:
     public:
         using kernel_type = PointKernel::value_type;
         using value_type = Base::Vector3d;
-        using iter_type = std::vector<kernel_type>::const_iterator;
-        using difference_type = iter_type::difference_type;
-        using iterator_category = iter_type::iterator_category;
+        using difference_type = PointKernel::difference_type;
+        using iterator_category = std::random_access_iterator_tag;
         using pointer = const value_type*;
         using reference = const value_type&;
 
-        const_point_iterator(const PointKernel*, std::vector<kernel_type>::const_iterator index);
+        const_point_iterator(const PointKernel*, size_type index);
         const_point_iterator(const const_point_iterator& pi);
         const_point_iterator(const_point_iterator&& pi);
         ~const_point_iterator();
@@ -209,7 +279,9 @@ public:
         void dereference();
         const PointKernel* _kernel;
         value_type _point;
-        std::vector<kernel_type>::const_iterator _p_it;
+        size_type _index;
+        /// The tile of the current point if the points are in a tiled store
+        std::optional<TiledPointStore::TileView> _tile;
     };
 
     using const_iterator = const_point_iterator;
@@ -219,11 +291,11 @@ public:
     //@{
     const_point_iterator begin() const
     {
-        return {this, _Points.begin()};
+        return {this, 0};
     }
     const_point_iterator end() const
     {
-        return {this, _Points.end()};
+        return {this, size()};
     }
     const_reverse_iterator rbegin() const
     {
@@ -27,13 +27,23 @@
 #ifdef FC_OS_LINUX
 # include <unistd.h>
 #endif
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <sstream>
+#include <thread>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>  // needed for compilation on some systems
-#include <boost/regex.hpp>
 
 #include <Base/Console.h>
 #include <Base/Converter.h>
@@ -48,83 +58,517 @@
 
 using namespace Points;
 
-void PointsAlgos::Load(PointKernel& points, const char* FileName)
+namespace
 {
-    Base::FileInfo File(FileName);
+// Number of rows the PLY and PCD readers convert at once
+constexpr Eigen::Index BlockSize = 65536;
+// Number of bytes of an ASCII file that are parsed by one task
+constexpr std::size_t ChunkSize = 4 * 1024 * 1024;
 
-    // checking on the file
-    if (!File.isReadable()) {
-        throw Base::FileException("File to load not existing or not readable", FileName);
+bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool matchWord(const char* begin, const char* end, const char* word)
+{
+    for (; begin != end && *word; ++begin, ++word) {
+        if (std::tolower(static_cast<unsigned char>(*begin)) != *word) {
+            return false;
+        }
     }
+    return begin == end && *word == '\0';
+}
 
-    if (File.hasExtension("asc")) {
-        LoadAscii(points, FileName);
+/**
+ * Converts the text [begin, end) into a number independent of the locale.
+ * Returns false if the text isn't a decimal number, "nan" or "inf".
+ */
+bool parseNumber(const char* begin, const char* end, double& value)
+{
+    const char* ptr = begin;
+    bool negative = false;
+    if (ptr != end && (*ptr == '-' || *ptr == '+')) {
+        negative = (*ptr == '-');
+        ++ptr;
+    }
+
+    // keep 19 significant digits which always fit into 64 bits
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    for (; ptr != end && isDigit(*ptr); ++ptr) {
+        hasDigits = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + uint64_t(*ptr - '0');
+            digits += (mantissa > 0) ? 1 : 0;
+        }
+        else {
+            exponent++;
+        }
+    }
+    if (ptr != end && *ptr == '.') {
+        for (++ptr; ptr != end && isDigit(*ptr); ++ptr) {
+            hasDigits = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + uint64_t(*ptr - '0');
+                digits += (mantissa > 0) ? 1 : 0;
+                exponent--;
+            }
+        }
+    }
+
+    if (!hasDigits) {
+        if (matchWord(ptr, end, "nan")) {
+            value = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+        if (matchWord(ptr, end, "inf") || matchWord(ptr, end, "infinity")) {
+            value = negative ? -std::numeric_limits<double>::infinity()
+                             : std::numeric_limits<double>::infinity();
+            return true;
+        }
+        return false;
+    }
+
+    if (ptr != end && (*ptr == 'e' || *ptr == 'E')) {
+        ++ptr;
+        bool negativeExp = false;
+        if (ptr != end && (*ptr == '-' || *ptr == '+')) {
+            negativeExp = (*ptr == '-');
+            ++ptr;
+        }
+        if (ptr == end || !isDigit(*ptr)) {
+            return false;
+        }
+        int exp = 0;
+        for (; ptr != end && isDigit(*ptr); ++ptr) {
+            exp = std::min(exp * 10 + (*ptr - '0'), 100000);
+        }
+        exponent += negativeExp ? -exp : exp;
+    }
+
+    if (ptr != end) {
+        return false;
+    }
+
+    // mantissa and power of ten are exact in double precision, so the result is correctly rounded
+    static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    double result = double(mantissa);
+    if (mantissa == 0) {
+        result = 0.0;
+    }
+    else if (mantissa < (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
     }
     else {
-        throw Base::RuntimeError("Unknown ending");
+        result *= std::pow(10.0, double(exponent));
     }
+
+    value = negative ? -result : result;
+    return true;
 }
 
-void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
+/**
+ * Parses the numeric table of an ASCII point cloud file. The file is memory-mapped and split
+ * into chunks at line boundaries. The chunks are parsed in parallel and handed over in file
+ * order, so the memory usage only depends on the chunk size and the number of threads.
+ */
+class AsciiTableParser
 {
-    boost::regex rx(
-        "^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$"
-    );
-    // boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    // boost::regex
-    // rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
+public:
+    using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using Rows = Eigen::Map<const RowMatrix>;
 
-    Base::Vector3d pt;
-    int LineCnt = 0;
-    std::string line;
-    Base::FileInfo fi(FileName);
+    /// Maps the file \a filename from the byte position \a offset on
+    AsciiTableParser(const std::string& filename, std::size_t offset)
+    {
+        std::size_t size = std::filesystem::file_size(Base::FileInfo::stringToPath(filename));
+        if (offset < size) {
+            namespace bip = boost::interprocess;
+            mapping = bip::file_mapping(filename.c_str(), bip::read_only);
+            region = bip::mapped_region(
+                mapping,
+                bip::read_only,
+                bip::offset_t(offset),
+                size - offset
+            );
+            cur = static_cast<const char*>(region.get_address());
+            end = cur + region.get_size();
+        }
+    }
 
-    Base::ifstream tmp_str(fi, std::ios::in);
+    /// Skips the given number of non-empty lines
+    void skipLines(std::size_t num)
+    {
+        while (num > 0 && cur < end) {
+            const char* eol = std::find(cur, end, '\n');
+            if (eol != cur) {
+                num--;
+            }
+            cur = eol < end ? eol + 1 : eol;
+        }
+    }
 
-    // estimating size
-    while (std::getline(tmp_str, line)) {
-        LineCnt++;
+    /// Returns the number of columns of the first line that only consists of numbers
+    std::size_t countColumns() const
+    {
+        const char* ptr = cur;
+        for (int line = 0; line < 1000 && ptr < end; line++) {
+            const char* eol = std::find(ptr, end, '\n');
+            std::vector<double> values;
+            if (parseLine(ptr, eol, 0, values) && !values.empty()) {
+                return values.size();
+            }
+            ptr = eol < end ? eol + 1 : eol;
+        }
+        return 0;
     }
 
-    // resize the PointKernel
-    points.resize(LineCnt);
+    /**
+     * Returns the lower-case words of the last line before the first line that only consists of
+     * numbers. Leading comment characters are removed.
+     */
+    std::vector<std::string> headerWords() const
+    {
+        std::vector<std::string> words;
+        std::vector<double> values;
+        const char* ptr = cur;
+        for (int line = 0; line < 1000 && ptr < end; line++) {
+            const char* eol = std::find(ptr, end, '\n');
+            if (parseLine(ptr, eol, 0, values)) {
+                if (!values.empty()) {
+                    break;
+                }
+            }
+            else {
+                words.clear();
+                for (const char* it = ptr; it < eol;) {
+                    while (it < eol && (isBlank(*it) || *it == ',' || *it == '#' || *it == '/')) {
+                        ++it;
+                    }
+                    std::string word;
+                    for (; it < eol && !isBlank(*it) && *it != ','; ++it) {
+                        word += char(std::tolower(static_cast<unsigned char>(*it)));
+                    }
+                    if (!word.empty()) {
+                        words.push_back(word);
+                    }
+                }
+            }
+            ptr = eol < end ? eol + 1 : eol;
+        }
+        return words;
+    }
 
-    Base::SequencerLauncher seq("Loading points…", LineCnt);
+    /// Returns up to \a maxRows rows of exactly \a numFields numbers without consuming them
+    std::vector<double> peekRows(std::size_t numFields, std::size_t maxRows) const
+    {
+        std::vector<double> rows;
+        std::vector<double> values;
+        const char* ptr = cur;
+        for (std::size_t num = 0; num < maxRows && ptr < end;) {
+            const char* eol = std::find(ptr, end, '\n');
+            if (parseLine(ptr, eol, 0, values) && values.size() == numFields) {
+                rows.insert(rows.end(), values.begin(), values.end());
+                num++;
+            }
+            ptr = eol < end ? eol + 1 : eol;
+        }
+        return rows;
+    }
+
+    /**
+     * Parses at most \a maxRows rows of \a numFields columns and passes them in blocks to
+     * \a func. In strict mode lines that don't consist of exactly \a numFields numbers are
+     * skipped. Otherwise only empty lines are skipped, missing columns are set to zero, extra
+     * columns are ignored and invalid numbers raise an exception.
+     */
+    void parse(
+        std::size_t numFields,
+        std::size_t maxRows,
+        bool strict,
+        const std::function<void(const Rows&)>& func
+    )
+    {
+        std::size_t numThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        std::size_t batchSize = numThreads * ChunkSize;
+        std::size_t numBatches = std::size_t(end - cur) / batchSize + 1;
+        Base::SequencerLauncher seq("Loading points...", numBatches);
+
+        std::size_t rows = 0;
+        while (cur < end && rows < maxRows) {
+            std::vector<Chunk> chunks;
+            for (std::size_t i = 0; i < numThreads && cur < end; i++) {
+                const char* last = cur + std::min<std::size_t>(ChunkSize, std::size_t(end - cur));
+                last = std::find(last, end, '\n');
+                last = last < end ? last + 1 : last;
+                chunks.push_back({cur, last, {}, 0, false});
+                cur = last;
+            }
 
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
+            QtConcurrent::blockingMap(chunks, [numFields, strict](Chunk& chunk) {
+                parseChunk(chunk, numFields, strict);
+            });
 
-    try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
+            for (const auto& chunk : chunks) {
+                if (chunk.failed) {
+                    throw Base::BadFormatError("Invalid number in point cloud file");
+                }
+                std::size_t num = std::min(chunk.rows, maxRows - rows);
+                if (num > 0) {
+                    func(Rows(chunk.values.data(), Eigen::Index(num), Eigen::Index(numFields)));
+                    rows += num;
+                }
+            }
+            seq.next();
+        }
+    }
 
-                points.setPoint(LineCnt, pt);
-                seq.next();
-                LineCnt++;
+private:
+    struct Chunk
+    {
+        const char* begin;
+        const char* end;
+        std::vector<double> values;
+        std::size_t rows;
+        bool failed;
+    };
+
+    /// Parses the numbers of a line. If \a maxFields is not zero further columns are ignored.
+    static bool parseLine(
+        const char* ptr,
+        const char* eol,
+        std::size_t maxFields,
+        std::vector<double>& values
+    )
+    {
+        values.clear();
+        while (true) {
+            while (ptr < eol && isBlank(*ptr)) {
+                ++ptr;
+            }
+            if (ptr == eol || (maxFields > 0 && values.size() == maxFields)) {
+                return true;
+            }
+            const char* token = ptr;
+            while (ptr < eol && !isBlank(*ptr)) {
+                ++ptr;
             }
+            double value {};
+            if (!parseNumber(token, ptr, value)) {
+                return false;
+            }
+            values.push_back(value);
         }
     }
-    catch (...) {
-        points.clear();
-        throw Base::BadFormatError("Reading in points failed.");
+
+    static void parseChunk(Chunk& chunk, std::size_t numFields, bool strict)
+    {
+        std::vector<double> values;
+        values.reserve(numFields + 1);
+        const char* ptr = chunk.begin;
+        while (ptr < chunk.end) {
+            const char* eol = std::find(ptr, chunk.end, '\n');
+            bool valid = parseLine(ptr, eol, strict ? 0 : numFields, values);
+            ptr = eol < chunk.end ? eol + 1 : eol;
+
+            if (strict) {
+                if (!valid || values.size() != numFields) {
+                    continue;
+                }
+            }
+            else if (!valid) {
+                chunk.failed = true;
+                return;
+            }
+            else if (values.empty()) {
+                continue;
+            }
+
+            values.resize(numFields, 0.0);
+            chunk.values.insert(chunk.values.end(), values.begin(), values.end());
+            chunk.rows++;
+        }
+    }
+
+private:
+    boost::interprocess::file_mapping mapping;
+    boost::interprocess::mapped_region region;
+    const char* cur {nullptr};
+    const char* end {nullptr};
+};
+
+/**
+ * Collects the points of a reader. Huge point clouds are moved to a tiled store, either from
+ * the beginning if the number of points is known or as soon as the threshold is exceeded.
+ */
+class PointCollector
+{
+public:
+    PointCollector(PointKernel& kernel, std::size_t expected)
+        : kernel(kernel)
+    {
+        if (expected >= PointKernel::getTiledThreshold()) {
+            store = PointKernel::createTiledStore();
+        }
+        else {
+            kernel.reserve(expected);
+        }
+    }
+
+    void add(double x, double y, double z)
+    {
+        if (!store && kernel.size() >= PointKernel::getTiledThreshold()) {
+            store = PointKernel::createTiledStore();
+            std::vector<PointKernel::value_type> points;
+            kernel.swap(points);
+            store->append(points.data(), points.size());
+        }
+
+        if (store) {
+            store->append(Base::Vector3f(float(x), float(y), float(z)));
+        }
+        else {
+            kernel.push_back(Base::Vector3d(x, y, z));
+        }
+    }
+
+    /// Passes the tiled store to the kernel. Per-point data must be reordered with the store.
+    std::shared_ptr<TiledPointStore> finish(TiledPointStore::Order order)
+    {
+        if (store) {
+            store->finish(order);
+            kernel.setTiledStore(store);
+        }
+        return store;
+    }
+
+private:
+    PointKernel& kernel;
+    std::shared_ptr<TiledPointStore> store;
+};
+
+/// The columns of the optional data of an ASCII point cloud, -1 if there is no such data
+struct AsciiColumns
+{
+    int color {-1};
+    int normal {-1};
+    int intensity {-1};
+};
+
+/**
+ * Determines the columns from a header line like "x y z nx ny nz". Returns false if the
+ * words don't start with the coordinates. Unknown columns are ignored.
+ */
+bool columnsFromHeader(const std::vector<std::string>& words, AsciiColumns& columns)
+{
+    if (words.size() < 3 || words[0] != "x" || words[1] != "y" || words[2] != "z") {
+        return false;
+    }
+
+    auto findTriple = [&words](std::initializer_list<std::array<const char*, 3>> names) {
+        for (std::size_t i = 3; i + 2 < words.size(); i++) {
+            for (const auto& name : names) {
+                if (words[i] == name[0] && words[i + 1] == name[1] && words[i + 2] == name[2]) {
+                    return int(i);
+                }
+            }
+        }
+        return -1;
+    };
+
+    columns.color = findTriple({{"r", "g", "b"}, {"red", "green", "blue"}});
+    columns.normal = findTriple(
+        {{"nx", "ny", "nz"}, {"normal_x", "normal_y", "normal_z"}, {"normalx", "normaly", "normalz"}}
+    );
+    for (std::size_t i = 3; i < words.size(); i++) {
+        if (words[i] == "i" || words[i] == "intensity") {
+            columns.intensity = int(i);
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks whether the three columns starting at \a column hold unit vectors. Vectors that only
+ * consist of zeros and ones may as well be pure colors so that at least one vector must differ.
+ */
+bool isNormalColumn(const std::vector<double>& rows, std::size_t numFields, std::size_t column)
+{
+    bool isUnitAxis = true;
+    for (std::size_t i = column; i + 2 < rows.size(); i += numFields) {
+        Base::Vector3d vec(rows[i], rows[i + 1], rows[i + 2]);
+        if (std::fabs(vec.Length() - 1.0) > 0.01) {
+            return false;
+        }
+        for (std::size_t j = 0; j < 3; j++) {
+            if (vec[j] != 0.0 && vec[j] != 1.0) {
+                isUnitAxis = false;
+            }
+        }
+    }
+    return !rows.empty() && !isUnitAxis;
+}
+
+/**
+ * Determines the columns of a table without a header from the number of columns. Three extra
+ * columns are either colors or normals which is decided from the values of the first rows.
+ */
+AsciiColumns columnsFromValues(const AsciiTableParser& parser, std::size_t numFields)
+{
+    AsciiColumns columns;
+    if (numFields == 4 || numFields == 7) {
+        columns.intensity = int(numFields) - 1;
+    }
+    if (numFields == 6 || numFields == 7 || numFields == 9) {
+        std::vector<double> rows = parser.peekRows(numFields, 1000);
+        if (isNormalColumn(rows, numFields, 3)) {
+            columns.normal = 3;
+            columns.color = numFields == 9 ? 6 : -1;
+        }
+        else {
+            columns.color = 3;
+            columns.normal = numFields == 9 ? 6 : -1;
+        }
+    }
+    return columns;
+}
+}  // namespace
+
+void PointsAlgos::Load(PointKernel& points, const char* FileName)
+{
+    Base::FileInfo File(FileName);
+
+    // checking on the file
+    if (!File.isReadable()) {
+        throw Base::FileException("File to load not existing or not readable", FileName);
     }
 
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size()) {
-        points.erase(LineCnt, points.size());
+    if (File.hasExtension("asc")) {
+        LoadAscii(points, FileName);
+    }
+    else {
+        throw Base::RuntimeError("Unknown ending");
     }
 }
 
+void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
+{
+    AscReader reader;
+    reader.read(FileName);
+    points = reader.getPoints();
+}
+
 // ----------------------------------------------------------------------------
 
 Reader::Reader() = default;
@@ -199,7 +643,63 @@ AscReader::AscReader() = default;
 
 void AscReader::read(const std::string& filename)
 {
-    points.load(filename.c_str());
+    clear();
+
+    AsciiTableParser parser(filename, 0);
+    std::size_t numFields = parser.countColumns();
+    AsciiColumns columns;
+    if (!columnsFromHeader(parser.headerWords(), columns)) {
+        columns = columnsFromValues(parser, numFields);
+    }
+    int lastColumn = std::max({2, columns.color + 2, columns.normal + 2, columns.intensity});
+    if (std::size_t(lastColumn) >= numFields) {
+        columns = AsciiColumns();
+    }
+    numFields = std::max<std::size_t>(numFields, 3);
+
+    // the number of points is unknown until the whole file is parsed
+    PointCollector collector(points, 0);
+    float maxColor = 0.0F;
+    auto addRows = [&](const AsciiTableParser::Rows& data) {
+        for (Eigen::Index i = 0; i < data.rows(); i++) {
+            collector.add(data(i, 0), data(i, 1), data(i, 2));
+
+            if (columns.color >= 0) {
+                float r = static_cast<float>(data(i, columns.color));
+                float g = static_cast<float>(data(i, columns.color + 1));
+                float b = static_cast<float>(data(i, columns.color + 2));
+                maxColor = std::max({maxColor, r, g, b});
+                colors.emplace_back(r, g, b);
+            }
+
+            if (columns.intensity >= 0) {
+                intensity.push_back(static_cast<float>(data(i, columns.intensity)));
+            }
+
+            if (columns.normal >= 0) {
+                normals.emplace_back(
+                    data(i, columns.normal),
+                    data(i, columns.normal + 1),
+                    data(i, columns.normal + 2)
+                );
+            }
+        }
+    };
+    parser.parse(numFields, std::numeric_limits<std::size_t>::max(), true, addRows);
+
+    // colors are either given in the range [0, 1] or [0, 255]
+    if (maxColor > 1.0F) {
+        for (auto& col : colors) {
+            col.set(col.r / 255.0F, col.g / 255.0F, col.b / 255.0F);
+        }
+    }
+
+    if (auto store = collector.finish(TiledPointStore::Order::Octree)) {
+        store->reorder(normals);
+        store->reorder(intensity);
+        store->reorder(colors);
+    }
+
     this->height = 1;
     this->width = points.size();
 }
@@ -573,17 +1073,6 @@ void PlyReader::read(const std::string& filename)
     this->width = numPoints;
     this->height = 1;
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
     std::vector<std::string>::iterator it;
     Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
 
@@ -675,59 +1164,76 @@ void PlyReader::read(const std::string& filename)
     bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (red != max_size && green != max_size && blue != max_size);
+    bool hasCharColor = hasColor && types[red] == "uchar";
+    bool hasFloatColor = hasColor && types[red] == "float";
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
-        }
-    }
-
+    PointCollector collector(points, hasData ? std::size_t(numPoints) : 0);
     if (hasData && hasNormal) {
         normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
-        }
     }
-
     if (hasData && hasIntensity) {
         intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
-        }
     }
-
     if (hasData && hasColor) {
         colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
+    }
+
+    auto addRows = [&](const auto& data) {
+        for (Eigen::Index i = 0; i < data.rows(); i++) {
+            collector.add(data(i, x), data(i, y), data(i, z));
+
+            if (hasNormal) {
+                normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+            }
+
+            if (hasIntensity) {
+                intensity.push_back(static_cast<float>(data(i, greyvalue)));
+            }
+
+            if (hasCharColor || hasFloatColor) {
                 float r = static_cast<float>(data(i, red));
                 float g = static_cast<float>(data(i, green));
                 float b = static_cast<float>(data(i, blue));
+                float a = 1.0;
                 if (alpha != max_size) {
                     a = static_cast<float>(data(i, alpha));
                 }
-                colors.emplace_back(
-                    static_cast<float>(r) / 255.0F,
-                    static_cast<float>(g) / 255.0F,
-                    static_cast<float>(b) / 255.0F,
-                    static_cast<float>(a) / 255.0F
-                );
+                if (hasCharColor) {
+                    colors.emplace_back(r / 255.0F, g / 255.0F, b / 255.0F, a / 255.0F);
+                }
+                else {
+                    colors.emplace_back(r, g, b, a);
+                }
             }
         }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(r, g, b, a);
+    };
+
+    if (hasData && format == "ascii") {
+        AsciiTableParser parser(filename, static_cast<std::size_t>(inp.tellg()));
+        parser.skipLines(offset);
+        parser.parse(fields.size(), std::size_t(numPoints), false, addRows);
+    }
+    else if (hasData) {
+        // read the data in blocks so that the whole file never has to be kept as doubles
+        Eigen::MatrixXd data;
+        for (Eigen::Index start = 0; start < numPoints; start += BlockSize) {
+            data.resize(std::min(BlockSize, numPoints - start), Eigen::Index(fields.size()));
+            if (format == "binary_little_endian") {
+                readBinary(false, inp, offset, types, sizes, data);
             }
+            else if (format == "binary_big_endian") {
+                readBinary(true, inp, offset, types, sizes, data);
+            }
+            offset = 0;
+            addRows(data);
         }
     }
+
+    if (auto store = collector.finish(TiledPointStore::Order::Octree)) {
+        store->reorder(normals);
+        store->reorder(intensity);
+        store->reorder(colors);
+    }
 }
 
 std::size_t PlyReader::readHeader(
@@ -902,39 +1408,6 @@ std::size_t PlyReader::readHeader(
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
 void PlyReader::readBinary(
     bool swapByteOrder,
     std::istream& inp,
@@ -1053,33 +1526,6 @@ void PcdReader::read(const std::string& filename)
     std::vector<int> sizes;
     Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
-
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
-        }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
-        }
-    }
-
     std::vector<std::string>::iterator it;
     Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
 
@@ -1156,49 +1602,98 @@ void PcdReader::read(const std::string& filename)
     bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (rgba != max_size);
+    bool hasPackedColor = hasColor && (types[rgba] == "U" || types[rgba] == "F");
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
-        }
-    }
-
+    PointCollector collector(points, hasData ? std::size_t(numPoints) : 0);
     if (hasData && hasNormal) {
         normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
-        }
     }
-
     if (hasData && hasIntensity) {
         intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
-        }
     }
-
     if (hasData && hasColor) {
         colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
+    }
+
+    // the compressed format stores the data field by field, so it cannot be read in blocks
+    Eigen::Index blockSize = BlockSize;
+    std::vector<char> uncompressed;
+    if (hasData && format == "binary_compressed") {
+        unsigned int c {};
+        unsigned int u {};
+        Base::InputStream str(inp);
+        str >> c >> u;
+
+        std::vector<char> compressed(c);
+        inp.read(compressed.data(), c);
+        uncompressed.resize(u);
+        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) != u) {
+            throw Base::BadFormatError("Failed to decompress binary data");
         }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t), "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
+        blockSize = std::max<Eigen::Index>(numPoints, 1);
+    }
+    DataStreambuf ibuf(uncompressed);
+    std::istream istr(nullptr);
+    istr.rdbuf(&ibuf);
+
+    auto addRows = [&](const auto& data) {
+        for (Eigen::Index i = 0; i < data.rows(); i++) {
+            collector.add(data(i, x), data(i, y), data(i, z));
+
+            if (hasNormal) {
+                normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+            }
+
+            if (hasIntensity) {
+                intensity.push_back(data(i, greyvalue));
+            }
+
+            if (hasPackedColor) {
                 uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
+                if (types[rgba] == "U") {
+                    packed = static_cast<uint32_t>(data(i, rgba));
+                }
+                else {
+                    static_assert(
+                        sizeof(float) == sizeof(uint32_t),
+                        "float and uint32_t have different sizes"
+                    );
+                    float f = static_cast<float>(data(i, rgba));
+                    std::memcpy(&packed, &f, sizeof(packed));
+                }
                 Base::Color col;
                 col.setPackedARGB(packed);
                 colors.emplace_back(col);
             }
         }
+    };
+
+    if (hasData && format == "ascii") {
+        AsciiTableParser parser(filename, static_cast<std::size_t>(inp.tellg()));
+        parser.parse(fields.size(), std::size_t(numPoints), false, addRows);
+    }
+    else if (hasData) {
+        // read the data in blocks so that the whole file never has to be kept as doubles
+        Eigen::MatrixXd data;
+        for (Eigen::Index start = 0; start < numPoints; start += blockSize) {
+            data.resize(std::min(blockSize, numPoints - start), Eigen::Index(fields.size()));
+            if (format == "binary") {
+                readBinary(false, inp, types, sizes, data);
+            }
+            else if (format == "binary_compressed") {
+                readBinary(true, istr, types, sizes, data);
+            }
+            addRows(data);
+        }
+    }
+
+    // structured point clouds must keep their order
+    bool structured = this->width > 1 && this->height > 1;
+    auto order = structured ? TiledPointStore::Order::Keep : TiledPointStore::Order::Octree;
+    if (auto store = collector.finish(order)) {
+        store->reorder(normals);
+        store->reorder(intensity);
+        store->reorder(colors);
     }
 }
 
@@ -1275,34 +1770,6 @@ std::size_t PcdReader::readHeader(
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
 void PcdReader::readBinary(
     bool transpose,
     std::istream& inp,
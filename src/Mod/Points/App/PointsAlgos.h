@@ -82,6 +82,18 @@ protected:
     // NOLINTEND
 };
 
+/** Reads ASCII files with a point per line.
+ * Besides the coordinates a line may hold optional columns, their meaning depends on the number
+ * of columns:
+ * \li 4: x y z intensity
+ * \li 6: x y z r g b
+ * \li 7: x y z r g b intensity
+ * \li 9: x y z r g b nx ny nz
+ * A header line like "x y z nx ny nz" before the first line of numbers overrides this. Without
+ * a header three extra columns are read as normals if they hold unit vectors and as colors
+ * otherwise. Colors are either given in the range [0, 1] or [0, 255]. Lines that don't match
+ * the number of columns of the first line of numbers are ignored.
+ */
 class PointsExport AscReader: public Reader
 {
 public:
@@ -104,7 +116,6 @@ private:
         std::vector<std::string>& types,
         std::vector<int>& sizes
     );
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
     void readBinary(
         bool swapByteOrder,
         std::istream&,
@@ -129,7 +140,6 @@ private:
         std::vector<std::string>& types,
         std::vector<int>& sizes
     );
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
     void readBinary(
         bool transpose,
         std::istream&,
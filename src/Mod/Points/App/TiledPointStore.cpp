@@ -0,0 +1,429 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "TiledPointStore.h"
+
+
+using namespace Points;
+namespace bip = boost::interprocess;
+
+namespace
+{
+// The finest grid used for the octree order has 2^7 cells along each axis
+constexpr int MaxLevel = 7;
+// Number of points read or written at once when streaming the spool file
+constexpr std::size_t BlockSize = 65536;
+
+static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float), "Unexpected padding of Vector3f");
+
+bool isValid(const Base::Vector3f& pnt)
+{
+    return std::isfinite(pnt.x) && std::isfinite(pnt.y) && std::isfinite(pnt.z);
+}
+
+std::size_t interleave(std::size_t x, std::size_t y, std::size_t z, int level)
+{
+    std::size_t code = 0;
+    for (int i = 0; i < level; i++) {
+        code |= ((x >> i) & 1) << (3 * i);
+        code |= ((y >> i) & 1) << (3 * i + 1);
+        code |= ((z >> i) & 1) << (3 * i + 2);
+    }
+    return code;
+}
+
+std::size_t gridIndex(float value, float minimum, float length, std::size_t num)
+{
+    if (length <= 0.0F) {
+        return 0;
+    }
+    float pos = (value - minimum) / length * float(num);
+    return std::min(num - 1, std::size_t(std::max(pos, 0.0F)));
+}
+
+/**
+ * Groups the cells of the octree node [first, last) into ranges of at most \a tileSize points.
+ * Consecutive children of the node are merged as long as they fit into a tile and children with
+ * too many points are split further, so that a tile never crosses the boundary of a node that
+ * holds too many points. Single cells with too many points become a tile of their own.
+ */
+void splitCells(
+    const std::vector<std::size_t>& offsets,
+    std::size_t first,
+    std::size_t last,
+    std::size_t tileSize,
+    std::vector<std::pair<std::size_t, std::size_t>>& ranges
+)
+{
+    std::size_t step = (last - first) / 8;
+    std::size_t begin = first;
+    for (std::size_t child = first; child < last; child += step) {
+        std::size_t end = child + step;
+        if (offsets[end] - offsets[begin] <= tileSize) {
+            continue;
+        }
+
+        if (offsets[child] > offsets[begin]) {
+            ranges.emplace_back(begin, child);
+        }
+        if (offsets[end] - offsets[child] > tileSize && step > 1) {
+            splitCells(offsets, child, end, tileSize, ranges);
+            begin = end;
+        }
+        else {
+            begin = child;
+        }
+    }
+
+    if (offsets[last] > offsets[begin]) {
+        ranges.emplace_back(begin, last);
+    }
+}
+
+void createFile(const std::string& fileName, std::size_t size)
+{
+    Base::ofstream str(Base::FileInfo(fileName), std::ios::out | std::ios::binary);
+    str.close();
+    std::filesystem::resize_file(Base::FileInfo::stringToPath(fileName), size);
+}
+
+void removeFile(const std::string& fileName)
+{
+    std::error_code ec;
+    std::filesystem::remove(Base::FileInfo::stringToPath(fileName), ec);
+}
+}  // namespace
+
+class TiledPointStore::TileData
+{
+public:
+    TileData(const bip::file_mapping& file, std::size_t offset, std::size_t size)
+        : region(file, bip::read_only, bip::offset_t(offset), size)
+    {}
+
+    const value_type* points() const
+    {
+        return static_cast<const value_type*>(region.get_address());
+    }
+
+private:
+    bip::mapped_region region;
+};
+
+struct TiledPointStore::Private
+{
+    Base::ofstream spool;
+    std::unique_ptr<bip::file_mapping> mapping;
+};
+
+// ----------------------------------------------------------------------------
+
+TiledPointStore::TileView::TileView(std::shared_ptr<const TileData> data, const TileInfo* info)
+    : data(std::move(data))
+    , info(info)
+    , points(this->data->points())
+{}
+
+// ----------------------------------------------------------------------------
+
+TiledPointStore::TiledPointStore(const std::string& cacheFile, size_type tileSize)
+    : cacheFile(cacheFile)
+    , indexFile(cacheFile + ".idx")
+    , spoolFile(cacheFile + ".spool")
+    , tileSize(std::max<size_type>(tileSize, 1))
+    , d(new Private)
+{
+    d->spool.open(Base::FileInfo(spoolFile), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!d->spool) {
+        throw Base::FileException("Cannot create point cache", spoolFile.c_str());
+    }
+    spoolBuffer.reserve(BlockSize);
+}
+
+TiledPointStore::~TiledPointStore()
+{
+    cache.clear();
+    d->spool.close();
+    d->mapping.reset();
+    removeFile(spoolFile);
+    removeFile(indexFile);
+    removeFile(cacheFile);
+}
+
+void TiledPointStore::append(const value_type& pnt)
+{
+    if (finished) {
+        throw Base::RuntimeError("Cannot add points to a finished point cache");
+    }
+
+    spoolBuffer.push_back(pnt);
+    if (isValid(pnt)) {
+        boundBox.Add(pnt);
+    }
+    numPoints++;
+    if (spoolBuffer.size() == BlockSize) {
+        flushSpool();
+    }
+}
+
+void TiledPointStore::append(const value_type* pnts, size_type count)
+{
+    for (size_type i = 0; i < count; i++) {
+        append(pnts[i]);
+    }
+}
+
+void TiledPointStore::flushSpool()
+{
+    d->spool.write(
+        reinterpret_cast<const char*>(spoolBuffer.data()),  // NOLINT
+        std::streamsize(spoolBuffer.size() * sizeof(value_type))
+    );
+    if (!d->spool) {
+        throw Base::FileException("Cannot write point cache", spoolFile.c_str());
+    }
+    spoolBuffer.clear();
+}
+
+void TiledPointStore::readSpool(const std::function<void(size_type, const value_type&)>& func) const
+{
+    Base::ifstream str(Base::FileInfo(spoolFile), std::ios::in | std::ios::binary);
+    std::vector<value_type> block(BlockSize);
+    for (size_type first = 0; first < numPoints; first += BlockSize) {
+        size_type count = std::min(BlockSize, numPoints - first);
+        str.read(
+            reinterpret_cast<char*>(block.data()),  // NOLINT
+            std::streamsize(count * sizeof(value_type))
+        );
+        if (!str) {
+            throw Base::FileException("Cannot read point cache", spoolFile.c_str());
+        }
+        for (size_type i = 0; i < count; i++) {
+            func(first + i, block[i]);
+        }
+    }
+}
+
+void TiledPointStore::finish(Order order)
+{
+    if (finished) {
+        return;
+    }
+
+    flushSpool();
+    d->spool.close();
+    finished = true;
+
+    if (order == Order::Octree && numPoints > tileSize) {
+        sortSpool();
+    }
+    else {
+        for (size_type first = 0; first < numPoints; first += tileSize) {
+            TileInfo tile;
+            tile.first = first;
+            tile.count = std::min(tileSize, numPoints - first);
+            tiles.push_back(tile);
+        }
+        readSpool([this](size_type index, const value_type& pnt) {
+            if (isValid(pnt)) {
+                tiles[index / tileSize].box.Add(pnt);
+            }
+        });
+
+        removeFile(cacheFile);
+        std::filesystem::rename(
+            Base::FileInfo::stringToPath(spoolFile),
+            Base::FileInfo::stringToPath(cacheFile)
+        );
+    }
+
+    if (numPoints > 0) {
+        d->mapping = std::make_unique<bip::file_mapping>(cacheFile.c_str(), bip::read_only);
+    }
+}
+
+int TiledPointStore::computeLevel() const
+{
+    // aim at around eight non-empty cells per tile so that tiles can be filled up well
+    size_type numCells = 8 * (numPoints / tileSize + 1);
+    int level = 0;
+    while (level < MaxLevel && (size_type(1) << (3 * level)) < numCells) {
+        level++;
+    }
+    return level;
+}
+
+TiledPointStore::size_type TiledPointStore::computeCell(const value_type& pnt, int level) const
+{
+    if (!isValid(pnt)) {
+        return 0;
+    }
+
+    size_type num = size_type(1) << level;
+    size_type x = gridIndex(pnt.x, boundBox.MinX, boundBox.LengthX(), num);
+    size_type y = gridIndex(pnt.y, boundBox.MinY, boundBox.LengthY(), num);
+    size_type z = gridIndex(pnt.z, boundBox.MinZ, boundBox.LengthZ(), num);
+    return interleave(x, y, z, level);
+}
+
+void TiledPointStore::sortSpool()
+{
+    // first pass: count the points per cell
+    int level = computeLevel();
+    size_type numCells = size_type(1) << (3 * level);
+    std::vector<size_type> offsets(numCells + 1, 0);
+    readSpool([&](size_type, const value_type& pnt) { offsets[computeCell(pnt, level) + 1]++; });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // the cells are in octree order, so the tiles are ranges of cells
+    std::vector<std::pair<size_type, size_type>> ranges;
+    if (numPoints <= tileSize || numCells == 1) {
+        ranges.emplace_back(0, numCells);
+    }
+    else {
+        splitCells(offsets, 0, numCells, tileSize, ranges);
+    }
+
+    std::vector<uint32_t> cellTile(numCells, 0);
+    for (const auto& [first, last] : ranges) {
+        TileInfo tile;
+        tile.first = offsets[first];
+        tile.count = offsets[last] - offsets[first];
+        std::fill(cellTile.begin() + first, cellTile.begin() + last, uint32_t(tiles.size()));
+        tiles.push_back(tile);
+    }
+
+    // second pass: scatter the points into the mapped cache file
+    createFile(cacheFile, numPoints * sizeof(value_type));
+    createFile(indexFile, numPoints * sizeof(uint64_t));
+    {
+        bip::file_mapping pointMapping(cacheFile.c_str(), bip::read_write);
+        bip::mapped_region pointRegion(pointMapping, bip::read_write);
+        bip::file_mapping indexMapping(indexFile.c_str(), bip::read_write);
+        bip::mapped_region indexRegion(indexMapping, bip::read_write);
+
+        auto points = static_cast<value_type*>(pointRegion.get_address());
+        auto sources = static_cast<uint64_t*>(indexRegion.get_address());
+        readSpool([&](size_type index, const value_type& pnt) {
+            size_type cell = computeCell(pnt, level);
+            size_type pos = offsets[cell]++;
+            points[pos] = pnt;
+            sources[pos] = index;
+            if (isValid(pnt)) {
+                tiles[cellTile[cell]].box.Add(pnt);
+            }
+        });
+    }
+
+    removeFile(spoolFile);
+    reordered = true;
+}
+
+TiledPointStore::TileView TiledPointStore::getTile(size_type index) const
+{
+    const TileInfo& info = tiles[index];
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+        if (it->index == index) {
+            cache.splice(cache.begin(), cache, it);
+            return {it->data, &info};
+        }
+    }
+
+    auto data = std::make_shared<const TileData>(
+        *d->mapping,
+        info.first * sizeof(value_type),
+        info.count * sizeof(value_type)
+    );
+    cache.push_front({index, data});
+    while (cache.size() > cacheSize) {
+        cache.pop_back();
+    }
+
+    return {data, &info};
+}
+
+TiledPointStore::size_type TiledPointStore::findTile(size_type index) const
+{
+    // tiles without points have the same first index as the next tile
+    auto it = std::upper_bound(
+        tiles.begin(),
+        tiles.end(),
+        index,
+        [](size_type i, const TileInfo& tile) { return i < tile.first; }
+    );
+    return static_cast<size_type>(std::distance(tiles.begin(), it)) - 1;
+}
+
+TiledPointStore::value_type TiledPointStore::getPoint(size_type index) const
+{
+    size_type tile = findTile(index);
+    return getTile(tile)[index - tiles[tile].first];
+}
+
+void TiledPointStore::setCacheSize(size_type numTiles)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    cacheSize = numTiles;
+    while (cache.size() > cacheSize) {
+        cache.pop_back();
+    }
+}
+
+void TiledPointStore::forEachSource(const std::function<void(size_type, size_type)>& func) const
+{
+    if (!reordered) {
+        for (size_type i = 0; i < numPoints; i++) {
+            func(i, i);
+        }
+        return;
+    }
+
+    bip::file_mapping file(indexFile.c_str(), bip::read_only);
+    for (size_type first = 0; first < numPoints; first += BlockSize) {
+        size_type count = std::min(BlockSize, numPoints - first);
+        bip::mapped_region region(
+            file,
+            bip::read_only,
+            bip::offset_t(first * sizeof(uint64_t)),
+            count * sizeof(uint64_t)
+        );
+        auto sources = static_cast<const uint64_t*>(region.get_address());
+        for (size_type i = 0; i < count; i++) {
+            func(first + i, size_type(sources[i]));
+        }
+    }
+}
+
+void TiledPointStore::write(Base::OutputStream& str) const
+{
+    for (const auto& tile : *this) {
+        for (const auto& pnt : tile) {
+            str << pnt.x << pnt.y << pnt.z;
+        }
+    }
+}
+
+void TiledPointStore::read(Base::InputStream& str, size_type count, Order order)
+{
+    for (size_type i = 0; i < count; i++) {
+        float x {};
+        float y {};
+        float z {};
+        str >> x >> y >> z;
+        append(value_type(x, y, z));
+    }
+    finish(order);
+}
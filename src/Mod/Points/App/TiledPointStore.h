@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+#include <Mod/Points/PointsGlobal.h>
+
+namespace Base
+{
+class InputStream;
+class OutputStream;
+}  // namespace Base
+
+namespace Points
+{
+
+/** Out-of-core storage of a point cloud.
+ * The points are grouped into tiles which are kept in a disk cache file and only mapped into
+ * memory when they are accessed. At most a fixed number of tiles stays mapped, so the memory
+ * usage doesn't depend on the size of the point cloud.
+ *
+ * With octree order the points are sorted by the Morton code of a regular grid over the bounding
+ * box, so each tile holds spatially close points. Otherwise the tiles are consecutive ranges of
+ * the appended points.
+ *
+ * The store is filled once with append() and finish() and is read-only afterwards. Filling
+ * doesn't need the whole point cloud in memory: the points are spooled to disk and then
+ * scattered into the cache file in two streaming passes.
+ * The cache files are removed when the store is destroyed.
+ */
+class PointsExport TiledPointStore
+{
+public:
+    using value_type = Base::Vector3f;
+    using size_type = std::size_t;
+
+    /// The default maximum number of points of a tile
+    static constexpr size_type DefaultTileSize = 65536;
+    /// The default maximum number of tiles mapped into memory at the same time
+    static constexpr size_type DefaultCacheSize = 64;
+
+    enum class Order
+    {
+        Keep,
+        Octree
+    };
+
+    struct TileInfo
+    {
+        Base::BoundBox3f box;
+        size_type first {0};
+        size_type count {0};
+    };
+
+    class TileData;
+
+    /** A tile mapped into memory.
+     * The mapping stays valid as long as the view exists, even if the tile was dropped from the
+     * cache of the store in the meantime.
+     */
+    class PointsExport TileView
+    {
+    public:
+        TileView(std::shared_ptr<const TileData>, const TileInfo*);
+
+        const TileInfo& getInfo() const
+        {
+            return *info;
+        }
+        const value_type* begin() const
+        {
+            return points;
+        }
+        const value_type* end() const
+        {
+            return points + info->count;
+        }
+        size_type size() const
+        {
+            return info->count;
+        }
+        const value_type& operator[](size_type index) const
+        {
+            return points[index];
+        }
+
+    private:
+        std::shared_ptr<const TileData> data;
+        const TileInfo* info;
+        const value_type* points;
+    };
+
+    class PointsExport const_tile_iterator
+    {
+    public:
+        using value_type = TileView;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::input_iterator_tag;
+        using pointer = const TileView*;
+        using reference = TileView;
+
+        const_tile_iterator(const TiledPointStore* store, size_type index)
+            : store(store)
+            , index(index)
+        {}
+        TileView operator*() const
+        {
+            return store->getTile(index);
+        }
+        const_tile_iterator& operator++()
+        {
+            ++index;
+            return *this;
+        }
+        bool operator==(const const_tile_iterator& it) const
+        {
+            return store == it.store && index == it.index;
+        }
+        bool operator!=(const const_tile_iterator& it) const
+        {
+            return !operator==(it);
+        }
+
+    private:
+        const TiledPointStore* store;
+        size_type index;
+    };
+
+    /** Creates an empty store that keeps its points in \a cacheFile.
+     * An existing file with this name is overwritten.
+     */
+    explicit TiledPointStore(const std::string& cacheFile, size_type tileSize = DefaultTileSize);
+    ~TiledPointStore();
+
+    TiledPointStore(const TiledPointStore&) = delete;
+    TiledPointStore(TiledPointStore&&) = delete;
+    TiledPointStore& operator=(const TiledPointStore&) = delete;
+    TiledPointStore& operator=(TiledPointStore&&) = delete;
+
+    /** @name Filling */
+    //@{
+    void append(const value_type& pnt);
+    void append(const value_type* pnts, size_type count);
+    /** Groups the appended points into tiles. Afterwards no more points can be added.
+     * If the points are sorted into octree order then reorder() must be used to bring any
+     * per-point data into the same order.
+     */
+    void finish(Order order);
+    bool isFinished() const
+    {
+        return finished;
+    }
+    //@}
+
+    /** @name Access */
+    //@{
+    size_type size() const
+    {
+        return numPoints;
+    }
+    size_type countTiles() const
+    {
+        return tiles.size();
+    }
+    const TileInfo& getTileInfo(size_type index) const
+    {
+        return tiles[index];
+    }
+    Base::BoundBox3f getBoundBox() const
+    {
+        return boundBox;
+    }
+    const std::string& getCacheFile() const
+    {
+        return cacheFile;
+    }
+    /// Maps the tile into memory if needed. This method is thread-safe.
+    TileView getTile(size_type index) const;
+    /// Returns the index of the tile that holds the point at \a index
+    size_type findTile(size_type index) const;
+    /** Returns the point at \a index. This maps its tile into memory if needed and is therefore
+     * slower than iterating over the tiles. This method is thread-safe.
+     */
+    value_type getPoint(size_type index) const;
+    /// Sets the maximum number of tiles that stay mapped after they have been accessed
+    void setCacheSize(size_type numTiles);
+
+    const_tile_iterator begin() const
+    {
+        return {this, 0};
+    }
+    const_tile_iterator end() const
+    {
+        return {this, tiles.size()};
+    }
+    //@}
+
+    /** @name Order */
+    //@{
+    /// Returns true if the points are stored in a different order than they were appended
+    bool isReordered() const
+    {
+        return reordered;
+    }
+    /** Calls \a func(index, source) for each point where \a index is the position in the store
+     * and \a source the position when it was appended.
+     */
+    void forEachSource(const std::function<void(size_type, size_type)>& func) const;
+    /// Brings per-point data given in the order of appending into the order of the store
+    template<typename T>
+    void reorder(std::vector<T>& values) const
+    {
+        if (!reordered || values.size() != numPoints) {
+            return;
+        }
+
+        std::vector<T> sorted(values.size());
+        forEachSource([&](size_type index, size_type source) { sorted[index] = values[source]; });
+        values.swap(sorted);
+    }
+    //@}
+
+    /** @name I/O */
+    //@{
+    /// Writes the coordinates of all points tile by tile
+    void write(Base::OutputStream& str) const;
+    /// Appends \a count points read from \a str and finishes the store
+    void read(Base::InputStream& str, size_type count, Order order);
+    //@}
+
+private:
+    void flushSpool();
+    void sortSpool();
+    int computeLevel() const;
+    size_type computeCell(const value_type& pnt, int level) const;
+    void readSpool(const std::function<void(size_type, const value_type&)>& func) const;
+
+private:
+    std::string cacheFile;
+    std::string indexFile;
+    std::string spoolFile;
+    size_type tileSize;
+    size_type numPoints {0};
+    bool finished {false};
+    bool reordered {false};
+    Base::BoundBox3f boundBox;
+    std::vector<TileInfo> tiles;
+    std::vector<value_type> spoolBuffer;
+
+    struct Private;
+    std::unique_ptr<Private> d;
+
+    struct CachedTile
+    {
+        size_type index;
+        std::shared_ptr<const TileData> data;
+    };
+    mutable std::mutex mutex;
+    mutable std::list<CachedTile> cache;
+    size_type cacheSize {DefaultCacheSize};
+};
+
+}  // namespace Points
@@ -719,11 +719,21 @@ void ViewProviderPointsBuilder::createPoints(
 
     // get all points
     std::size_t idx = 0;
-    const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
-    for (std::vector<Points::PointKernel::value_type>::const_iterator it = kernel.begin();
-         it != kernel.end();
-         ++it, idx++) {
-        vec[idx].setValue(it->x, it->y, it->z);
+    if (cPts.isTiled()) {
+        // copy tile by tile to avoid loading the whole point cloud into memory
+        for (const auto& tile : *cPts.getTiledStore()) {
+            for (const auto& pnt : tile) {
+                vec[idx++].setValue(pnt.x, pnt.y, pnt.z);
+            }
+        }
+    }
+    else {
+        const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
+        for (std::vector<Points::PointKernel::value_type>::const_iterator it = kernel.begin();
+             it != kernel.end();
+             ++it, idx++) {
+            vec[idx].setValue(it->x, it->y, it->z);
+        }
     }
 
     points->numPoints = cPts.size();
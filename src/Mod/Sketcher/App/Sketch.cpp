@@ -22,8 +22,15 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <mutex>
 
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRep_Builder.hxx>
@@ -70,6 +77,7 @@ Sketch::Sketch()
     : SolveTime(0)
     , RecalculateInitialSolutionWhileMovingPoint(false)
     , resolveAfterGeometryUpdated(false)
+    , concurrentFallback(false)
     , GCSsys()
     , ConstraintsCounter(0)
     , isInitMove(false)
@@ -4979,11 +4987,18 @@ int Sketch::internalSolve(std::string& solvername, int level)
         if (debugMode == GCS::Minimal || debugMode == GCS::IterationLevel) {
 
             Base::Console().log("Sketcher::Solve()-%s- Failed!! Falling back...\n", solvername.c_str());
+            logClusterResults(solvername);
         }
     }
 
     if (!valid_solution && !isInitMove) {  // Fall back to other solvers
-        for (int soltype = 0; soltype < 4; soltype++) {
+        int firstsoltype = 0;
+        if (concurrentFallback) {
+            // only the SQP solver is left to be tried one after another
+            valid_solution = solveFallbackConcurrently(solvername, defaultsoltype, ret);
+            firstsoltype = valid_solution ? 4 : 3;
+        }
+        for (int soltype = firstsoltype; soltype < 4; soltype++) {
 
             if (soltype == defaultsoltype) {
                 continue;  // skip default solver
@@ -5041,6 +5056,7 @@ int Sketch::internalSolve(std::string& solvername, int level)
                         "Sketcher::Solve()-%s- Failed!! Falling back...\n",
                         solvername.c_str()
                     );
+                    logClusterResults(solvername);
                 }
             }
 
@@ -5085,6 +5101,146 @@ int Sketch::internalSolve(std::string& solvername, int level)
     return ret;
 }
 
+void Sketch::logClusterResults(const std::string& solvername) const
+{
+    GCS::VEC_I results;
+    GCSsys.getComponentResults(results);
+    if (results.size() > 1) {
+        auto failed = std::ranges::count_if(results, [](int result) {
+            return result == GCS::Converged || result == GCS::Failed;
+        });
+        Base::Console().log(
+            "Sketcher::Solve()-%s- %d of %d independent clusters not solved\n",
+            solvername.c_str(),
+            int(failed),
+            int(results.size())
+        );
+    }
+}
+
+bool Sketch::solveFallbackConcurrently(std::string& solvername, int defaultsoltype, int& ret)
+{
+    struct Candidate
+    {
+        const char* name;
+        GCS::Algorithm alg;
+        std::unique_ptr<GCS::System> system;
+        std::future<int> result;
+    };
+
+    // the candidates must be destroyed first as this waits for the running solvers
+    std::atomic<bool> cancel {false};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::deque<std::size_t> finishOrder;
+    std::vector<Candidate> candidates;
+
+    const std::array<std::pair<const char*, GCS::Algorithm>, 3> solvers {
+        {{"DogLeg", GCS::DogLeg},
+         {"LevenbergMarquardt", GCS::LevenbergMarquardt},
+         {"BFGS", GCS::BFGS}}
+    };
+    for (int soltype = 0; soltype < int(solvers.size()); soltype++) {
+        if (soltype != defaultsoltype) {
+            auto system = GCSsys.copyForSolving();
+            system->setCancelFlag(&cancel);
+            candidates.push_back(
+                {solvers[soltype].first, solvers[soltype].second, std::move(system), {}}
+            );
+        }
+    }
+
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        candidates[i].result = std::async(std::launch::async, [&, i, fine = isFine]() {
+            Candidate& candidate = candidates[i];
+            candidate.system->initSolution(candidate.alg);
+            int result = candidate.system->solve(fine, candidate.alg);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finishOrder.push_back(i);
+            }
+            finished.notify_one();
+            return result;
+        });
+    }
+
+    // applies the solution of a candidate, the other solvers must not run meanwhile
+    auto applyCandidate = [&](Candidate& candidate) {
+        GCSsys.applySolution(*candidate.system);
+        if (!updateGeometry()) {
+            GCSsys.undoSolution();
+            updateGeometry();
+            Base::Console().warning("Invalid solution from %s solver.\n", solvername.c_str());
+            ret = GCS::SuccessfulSolutionInvalid;
+            return false;
+        }
+        updateNonDrivingConstraints();
+        return true;
+    };
+
+    Candidate* winner = nullptr;
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        std::size_t index {};
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&finishOrder]() { return !finishOrder.empty(); });
+            index = finishOrder.front();
+            finishOrder.pop_front();
+        }
+
+        Candidate& candidate = candidates[index];
+        solvername = candidate.name;
+        ret = candidate.result.get();
+        if (ret == GCS::Success) {
+            winner = &candidate;
+            break;
+        }
+        if (debugMode == GCS::Minimal || debugMode == GCS::IterationLevel) {
+            Base::Console().log(
+                "Sketcher::Solve()-%s- Failed!! Falling back...\n",
+                solvername.c_str()
+            );
+        }
+    }
+
+    // stop the solvers that are still running and wait for them
+    cancel = true;
+    for (auto& candidate : candidates) {
+        if (candidate.result.valid()) {
+            candidate.result.wait();
+        }
+    }
+
+    bool valid_solution = false;
+    if (winner) {
+        valid_solution = applyCandidate(*winner);
+
+        // If the solution is invalid the solvers that have been stopped are run again one
+        // after another, starting from the initial parameters
+        for (auto& candidate : candidates) {
+            if (valid_solution || !candidate.result.valid()) {
+                continue;
+            }
+            candidate.result.get();
+            candidate.system = GCSsys.copyForSolving();
+            solvername = candidate.name;
+            candidate.system->initSolution(candidate.alg);
+            ret = candidate.system->solve(isFine, candidate.alg);
+            if (ret == GCS::Success) {
+                valid_solution = applyCandidate(candidate);
+            }
+        }
+    }
+
+    if (valid_solution) {
+        Base::Console().log(
+            "Important: the %s solver succeeded where the default solver had failed.\n",
+            solvername.c_str()
+        );
+    }
+    return valid_solution;
+}
+
 int Sketch::initMove(const std::vector<GeoElementId>& geoEltIds, bool fine)
 {
     if (hasConflicts()) {
@@ -5322,6 +5478,8 @@ int Sketch::initMove(const std::vector<GeoElementId>& geoEltIds, bool fine)
     InitParameters = MoveParameters;
 
     GCSsys.initSolution();
+    // only the clusters containing the moved geometry have to be solved while dragging
+    GCSsys.restrictToComponentsWithTag(GCS::DefaultTemporaryConstraint);
     isInitMove = true;
 
     return 0;
@@ -5399,6 +5557,8 @@ int Sketch::initBSplinePieceMove(int geoId, PointPos pos, const Base::Vector3d&
     InitParameters = MoveParameters;
 
     GCSsys.initSolution();
+    // only the clusters containing the moved geometry have to be solved while dragging
+    GCSsys.restrictToComponentsWithTag(GCS::DefaultTemporaryConstraint);
     isInitMove = true;
     return 0;
 }
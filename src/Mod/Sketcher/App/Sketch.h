@@ -583,6 +583,10 @@ private:
     // non-driving constraints)
     bool resolveAfterGeometryUpdated;
 
+    // if the default solver fails the other solvers are run concurrently on copies of the system
+    // and the first valid solution is taken
+    bool concurrentFallback;
+
 private:
     /// container element to store and work with the geometric elements of this sketch
     struct GeoDef
@@ -697,6 +701,15 @@ public:
     {
         GCSsys.autoQRThreshold = val;
     }
+    inline void setAutoSparseThreshold(int val)
+    {
+        GCSsys.autoSparseThreshold = val;
+    }
+    /// if enabled the fallback solvers race each other in separate threads
+    inline void setConcurrentFallback(bool val)
+    {
+        concurrentFallback = val;
+    }
     inline void setSketchAutoAlgo(bool val)
     {
         GCSsys.autoChooseAlgorithm = val;
@@ -811,6 +824,8 @@ private:
     void buildInternalAlignmentGeometryMap(const std::vector<Constraint*>& constraintList);
 
     int internalSolve(std::string& solvername, int level = 0);
+    bool solveFallbackConcurrently(std::string& solvername, int defaultsoltype, int& ret);
+    void logClusterResults(const std::string& solvername) const;
 
     /// checks if the index bounds and converts negative indices to positive
     int checkGeoId(int geoId) const;
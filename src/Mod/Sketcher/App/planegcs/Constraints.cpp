@@ -36,6 +36,7 @@
 #endif
 
 #include <boost/graph/graph_concepts.hpp>
+#include <Eigen/Core>
 
 #include "Constraints.h"
 
@@ -74,6 +75,22 @@ void Constraint::revertParams()
     reconstructGeomPointers();
 }
 
+void Constraint::substituteParams(const MAP_pD_pD& substitutions)
+{
+    for (auto& param : origpvec) {
+        MAP_pD_pD::const_iterator it = substitutions.find(param);
+        if (it != substitutions.end()) {
+            param = it->second;
+        }
+    }
+    revertParams();
+}
+
+Constraint* Constraint::copy() const
+{
+    return new Constraint(*this);
+}
+
 ConstraintType Constraint::getTypeId()
 {
     return None;
@@ -114,6 +131,11 @@ ConstraintEqual::ConstraintEqual(double* p1, double* p2, double p1p2ratio)
     rescale();
 }
 
+Constraint* ConstraintEqual::copy() const
+{
+    return new ConstraintEqual(*this);
+}
+
 ConstraintType ConstraintEqual::getTypeId()
 {
     return Equal;
@@ -157,6 +179,11 @@ ConstraintWeightedLinearCombination::ConstraintWeightedLinearCombination(
     rescale();
 }
 
+Constraint* ConstraintWeightedLinearCombination::copy() const
+{
+    return new ConstraintWeightedLinearCombination(*this);
+}
+
 ConstraintType ConstraintWeightedLinearCombination::getTypeId()
 {
     return WeightedLinearCombination;
@@ -230,6 +257,11 @@ ConstraintCenterOfGravity::ConstraintCenterOfGravity(
     rescale();
 }
 
+Constraint* ConstraintCenterOfGravity::copy() const
+{
+    return new ConstraintCenterOfGravity(*this);
+}
+
 ConstraintType ConstraintCenterOfGravity::getTypeId()
 {
     return CenterOfGravity;
@@ -321,6 +353,11 @@ ConstraintSlopeAtBSplineKnot::ConstraintSlopeAtBSplineKnot(BSpline& b, Line& l,
     ConstraintSlopeAtBSplineKnot::rescale();
 }
 
+Constraint* ConstraintSlopeAtBSplineKnot::copy() const
+{
+    return new ConstraintSlopeAtBSplineKnot(*this);
+}
+
 ConstraintType ConstraintSlopeAtBSplineKnot::getTypeId()
 {
     return SlopeAtBSplineKnot;
@@ -524,6 +561,11 @@ ConstraintPointOnBSpline::ConstraintPointOnBSpline(
     rescale();
 }
 
+Constraint* ConstraintPointOnBSpline::copy() const
+{
+    return new ConstraintPointOnBSpline(*this);
+}
+
 ConstraintType ConstraintPointOnBSpline::getTypeId()
 {
     return PointOnBSpline;
@@ -638,6 +680,11 @@ ConstraintDifference::ConstraintDifference(double* p1, double* p2, double* d)
     rescale();
 }
 
+Constraint* ConstraintDifference::copy() const
+{
+    return new ConstraintDifference(*this);
+}
+
 ConstraintType ConstraintDifference::getTypeId()
 {
     return Difference;
@@ -684,6 +731,11 @@ ConstraintP2PDistance::ConstraintP2PDistance(Point& p1, Point& p2, double* d)
     rescale();
 }
 
+Constraint* ConstraintP2PDistance::copy() const
+{
+    return new ConstraintP2PDistance(*this);
+}
+
 ConstraintType ConstraintP2PDistance::getTypeId()
 {
     return P2PDistance;
@@ -786,6 +838,11 @@ ConstraintP2PAngle::ConstraintP2PAngle(Point& p1, Point& p2, double* a, double d
     rescale();
 }
 
+Constraint* ConstraintP2PAngle::copy() const
+{
+    return new ConstraintP2PAngle(*this);
+}
+
 ConstraintType ConstraintP2PAngle::getTypeId()
 {
     return P2PAngle;
@@ -874,6 +931,11 @@ ConstraintP2LDistance::ConstraintP2LDistance(Point& p, Line& l, double* d, bool
     rescale();
 }
 
+Constraint* ConstraintP2LDistance::copy() const
+{
+    return new ConstraintP2LDistance(*this);
+}
+
 ConstraintType ConstraintP2LDistance::getTypeId()
 {
     return P2LDistance;
@@ -1024,6 +1086,11 @@ ConstraintPointOnLine::ConstraintPointOnLine(Point& p, Point& lp1, Point& lp2)
     rescale();
 }
 
+Constraint* ConstraintPointOnLine::copy() const
+{
+    return new ConstraintPointOnLine(*this);
+}
+
 ConstraintType ConstraintPointOnLine::getTypeId()
 {
     return PointOnLine;
@@ -1101,6 +1168,11 @@ ConstraintPointOnPerpBisector::ConstraintPointOnPerpBisector(Point& p, Point& lp
     rescale();
 }
 
+Constraint* ConstraintPointOnPerpBisector::copy() const
+{
+    return new ConstraintPointOnPerpBisector(*this);
+}
+
 ConstraintType ConstraintPointOnPerpBisector::getTypeId()
 {
     return PointOnPerpBisector;
@@ -1147,6 +1219,11 @@ ConstraintParallel::ConstraintParallel(Line& l1, Line& l2)
     ConstraintParallel::rescale();
 }
 
+Constraint* ConstraintParallel::copy() const
+{
+    return new ConstraintParallel(*this);
+}
+
 ConstraintType ConstraintParallel::getTypeId()
 {
     return Parallel;
@@ -1247,6 +1324,11 @@ ConstraintPerpendicular::ConstraintPerpendicular(Point& l1p1, Point& l1p2, Line&
     ConstraintPerpendicular::rescale();
 }
 
+Constraint* ConstraintPerpendicular::copy() const
+{
+    return new ConstraintPerpendicular(*this);
+}
+
 ConstraintType ConstraintPerpendicular::getTypeId()
 {
     return Perpendicular;
@@ -1335,6 +1417,11 @@ ConstraintL2LAngle::ConstraintL2LAngle(Point& l1p1, Point& l1p2, Point& l2p1, Po
     rescale();
 }
 
+Constraint* ConstraintL2LAngle::copy() const
+{
+    return new ConstraintL2LAngle(*this);
+}
+
 ConstraintType ConstraintL2LAngle::getTypeId()
 {
     return L2LAngle;
@@ -1470,6 +1557,11 @@ ConstraintMidpointOnLine::ConstraintMidpointOnLine(Point& l1p1, Point& l1p2, Poi
     rescale();
 }
 
+Constraint* ConstraintMidpointOnLine::copy() const
+{
+    return new ConstraintMidpointOnLine(*this);
+}
+
 ConstraintType ConstraintMidpointOnLine::getTypeId()
 {
     return MidpointOnLine;
@@ -1553,6 +1645,11 @@ ConstraintTangentCircumf::ConstraintTangentCircumf(
     rescale();
 }
 
+Constraint* ConstraintTangentCircumf::copy() const
+{
+    return new ConstraintTangentCircumf(*this);
+}
+
 ConstraintType ConstraintTangentCircumf::getTypeId()
 {
     return TangentCircumf;
@@ -1650,6 +1747,11 @@ ConstraintPointOnEllipse::ConstraintPointOnEllipse(Point& p, Ellipse& e)
     rescale();
 }
 
+Constraint* ConstraintPointOnEllipse::copy() const
+{
+    return new ConstraintPointOnEllipse(*this);
+}
+
 ConstraintType ConstraintPointOnEllipse::getTypeId()
 {
     return PointOnEllipse;
@@ -1747,6 +1849,11 @@ void ConstraintEllipseTangentLine::reconstructGeomPointers()
     e.ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintEllipseTangentLine::copy() const
+{
+    return new ConstraintEllipseTangentLine(*this);
+}
+
 ConstraintType ConstraintEllipseTangentLine::getTypeId()
 {
     return TangentEllipseLine;
@@ -1816,6 +1923,11 @@ void ConstraintInternalAlignmentPoint2Ellipse::reconstructGeomPointers()
     e.ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintInternalAlignmentPoint2Ellipse::copy() const
+{
+    return new ConstraintInternalAlignmentPoint2Ellipse(*this);
+}
+
 ConstraintType ConstraintInternalAlignmentPoint2Ellipse::getTypeId()
 {
     return InternalAlignmentPoint2Ellipse;
@@ -1910,6 +2022,11 @@ void ConstraintInternalAlignmentPoint2Hyperbola::reconstructGeomPointers()
     e.ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintInternalAlignmentPoint2Hyperbola::copy() const
+{
+    return new ConstraintInternalAlignmentPoint2Hyperbola(*this);
+}
+
 ConstraintType ConstraintInternalAlignmentPoint2Hyperbola::getTypeId()
 {
     return InternalAlignmentPoint2Hyperbola;
@@ -1993,6 +2110,18 @@ ConstraintEqualMajorAxesConic::ConstraintEqualMajorAxesConic(MajorRadiusConic* a
     rescale();
 }
 
+ConstraintEqualMajorAxesConic::ConstraintEqualMajorAxesConic(
+    const ConstraintEqualMajorAxesConic& other
+)
+    : Constraint(other)
+    , ownedE1(static_cast<MajorRadiusConic*>(other.e1->Copy()))
+    , ownedE2(static_cast<MajorRadiusConic*>(other.e2->Copy()))
+    , e1(ownedE1.get())
+    , e2(ownedE2.get())
+{
+    reconstructGeomPointers();
+}
+
 void ConstraintEqualMajorAxesConic::reconstructGeomPointers()
 {
     int i = 0;
@@ -2000,6 +2129,11 @@ void ConstraintEqualMajorAxesConic::reconstructGeomPointers()
     e2->ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintEqualMajorAxesConic::copy() const
+{
+    return new ConstraintEqualMajorAxesConic(*this);
+}
+
 ConstraintType ConstraintEqualMajorAxesConic::getTypeId()
 {
     return EqualMajorAxesConic;
@@ -2031,6 +2165,18 @@ ConstraintEqualFocalDistance::ConstraintEqualFocalDistance(ArcOfParabola* a1, Ar
     rescale();
 }
 
+ConstraintEqualFocalDistance::ConstraintEqualFocalDistance(
+    const ConstraintEqualFocalDistance& other
+)
+    : Constraint(other)
+    , ownedE1(other.e1->Copy())
+    , ownedE2(other.e2->Copy())
+    , e1(ownedE1.get())
+    , e2(ownedE2.get())
+{
+    reconstructGeomPointers();
+}
+
 void ConstraintEqualFocalDistance::reconstructGeomPointers()
 {
     int i = 0;
@@ -2038,6 +2184,11 @@ void ConstraintEqualFocalDistance::reconstructGeomPointers()
     e2->ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintEqualFocalDistance::copy() const
+{
+    return new ConstraintEqualFocalDistance(*this);
+}
+
 ConstraintType ConstraintEqualFocalDistance::getTypeId()
 {
     return EqualFocalDistance;
@@ -2087,6 +2238,13 @@ ConstraintCurveValue::ConstraintCurveValue(Point& p, double* pcoord, Curve& c, d
     rescale();
 }
 
+ConstraintCurveValue::ConstraintCurveValue(const ConstraintCurveValue& other)
+    : Constraint(other)
+    , crv(other.crv->Copy())
+{
+    reconstructGeomPointers();
+}
+
 ConstraintCurveValue::~ConstraintCurveValue()
 {
     delete this->crv;
@@ -2105,6 +2263,11 @@ void ConstraintCurveValue::reconstructGeomPointers()
     this->crv->ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintCurveValue::copy() const
+{
+    return new ConstraintCurveValue(*this);
+}
+
 ConstraintType ConstraintCurveValue::getTypeId()
 {
     return CurveValue;
@@ -2178,6 +2341,11 @@ ConstraintPointOnHyperbola::ConstraintPointOnHyperbola(Point& p, ArcOfHyperbola&
     rescale();
 }
 
+Constraint* ConstraintPointOnHyperbola::copy() const
+{
+    return new ConstraintPointOnHyperbola(*this);
+}
+
 ConstraintType ConstraintPointOnHyperbola::getTypeId()
 {
     return PointOnHyperbola;
@@ -2290,6 +2458,13 @@ ConstraintPointOnParabola::ConstraintPointOnParabola(Point& p, ArcOfParabola& e)
     rescale();
 }
 
+ConstraintPointOnParabola::ConstraintPointOnParabola(const ConstraintPointOnParabola& other)
+    : Constraint(other)
+    , parab(other.parab->Copy())
+{
+    reconstructGeomPointers();
+}
+
 ConstraintPointOnParabola::~ConstraintPointOnParabola()
 {
     delete this->parab;
@@ -2306,6 +2481,11 @@ void ConstraintPointOnParabola::reconstructGeomPointers()
     this->parab->ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintPointOnParabola::copy() const
+{
+    return new ConstraintPointOnParabola(*this);
+}
+
 ConstraintType ConstraintPointOnParabola::getTypeId()
 {
     return PointOnParabola;
@@ -2361,6 +2541,14 @@ ConstraintAngleViaPoint::ConstraintAngleViaPoint(Curve& acrv1, Curve& acrv2, Poi
     rescale();
 }
 
+ConstraintAngleViaPoint::ConstraintAngleViaPoint(const ConstraintAngleViaPoint& other)
+    : Constraint(other)
+    , crv1(other.crv1->Copy())
+    , crv2(other.crv2->Copy())
+{
+    reconstructGeomPointers();
+}
+
 ConstraintAngleViaPoint::~ConstraintAngleViaPoint()
 {
     delete crv1;
@@ -2381,6 +2569,11 @@ void ConstraintAngleViaPoint::reconstructGeomPointers()
     crv2->ReconstructOnNewPvec(pvec, cnt);
 }
 
+Constraint* ConstraintAngleViaPoint::copy() const
+{
+    return new ConstraintAngleViaPoint(*this);
+}
+
 ConstraintType ConstraintAngleViaPoint::getTypeId()
 {
     return AngleViaPoint;
@@ -2448,6 +2641,14 @@ ConstraintAngleViaTwoPoints::ConstraintAngleViaTwoPoints(
     rescale();
 }
 
+ConstraintAngleViaTwoPoints::ConstraintAngleViaTwoPoints(const ConstraintAngleViaTwoPoints& other)
+    : Constraint(other)
+    , crv1(other.crv1->Copy())
+    , crv2(other.crv2->Copy())
+{
+    reconstructGeomPointers();
+}
+
 ConstraintAngleViaTwoPoints::~ConstraintAngleViaTwoPoints()
 {
     delete crv1;
@@ -2472,6 +2673,11 @@ void ConstraintAngleViaTwoPoints::reconstructGeomPointers()
     crv2->ReconstructOnNewPvec(pvec, cnt);
 }
 
+Constraint* ConstraintAngleViaTwoPoints::copy() const
+{
+    return new ConstraintAngleViaTwoPoints(*this);
+}
+
 ConstraintType ConstraintAngleViaTwoPoints::getTypeId()
 {
     return AngleViaTwoPoints;
@@ -2545,6 +2751,16 @@ ConstraintAngleViaPointAndParam::ConstraintAngleViaPointAndParam(
     rescale();
 }
 
+ConstraintAngleViaPointAndParam::ConstraintAngleViaPointAndParam(
+    const ConstraintAngleViaPointAndParam& other
+)
+    : Constraint(other)
+    , crv1(other.crv1->Copy())
+    , crv2(other.crv2->Copy())
+{
+    reconstructGeomPointers();
+}
+
 ConstraintAngleViaPointAndParam::~ConstraintAngleViaPointAndParam()
 {
     delete crv1;
@@ -2566,6 +2782,11 @@ void ConstraintAngleViaPointAndParam::reconstructGeomPointers()
     crv2->ReconstructOnNewPvec(pvec, cnt);
 }
 
+Constraint* ConstraintAngleViaPointAndParam::copy() const
+{
+    return new ConstraintAngleViaPointAndParam(*this);
+}
+
 ConstraintType ConstraintAngleViaPointAndParam::getTypeId()
 {
     return AngleViaPointAndParam;
@@ -2642,6 +2863,16 @@ ConstraintAngleViaPointAndTwoParams::ConstraintAngleViaPointAndTwoParams(
     rescale();
 }
 
+ConstraintAngleViaPointAndTwoParams::ConstraintAngleViaPointAndTwoParams(
+    const ConstraintAngleViaPointAndTwoParams& other
+)
+    : Constraint(other)
+    , crv1(other.crv1->Copy())
+    , crv2(other.crv2->Copy())
+{
+    reconstructGeomPointers();
+}
+
 ConstraintAngleViaPointAndTwoParams::~ConstraintAngleViaPointAndTwoParams()
 {
     delete crv1;
@@ -2664,6 +2895,11 @@ void ConstraintAngleViaPointAndTwoParams::reconstructGeomPointers()
     crv2->ReconstructOnNewPvec(pvec, cnt);
 }
 
+Constraint* ConstraintAngleViaPointAndTwoParams::copy() const
+{
+    return new ConstraintAngleViaPointAndTwoParams(*this);
+}
+
 ConstraintType ConstraintAngleViaPointAndTwoParams::getTypeId()
 {
     return AngleViaPointAndTwoParams;
@@ -2745,6 +2981,17 @@ ConstraintSnell::ConstraintSnell(
     rescale();
 }
 
+ConstraintSnell::ConstraintSnell(const ConstraintSnell& other)
+    : Constraint(other)
+    , ray1(other.ray1->Copy())
+    , ray2(other.ray2->Copy())
+    , boundary(other.boundary->Copy())
+    , flipn1(other.flipn1)
+    , flipn2(other.flipn2)
+{
+    reconstructGeomPointers();
+}
+
 ConstraintSnell::~ConstraintSnell()
 {
     delete ray1;
@@ -2769,6 +3016,11 @@ void ConstraintSnell::reconstructGeomPointers()
     boundary->ReconstructOnNewPvec(pvec, cnt);
 }
 
+Constraint* ConstraintSnell::copy() const
+{
+    return new ConstraintSnell(*this);
+}
+
 ConstraintType ConstraintSnell::getTypeId()
 {
     return Snell;
@@ -2823,6 +3075,11 @@ void ConstraintEqualLineLength::reconstructGeomPointers()
     l2.ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintEqualLineLength::copy() const
+{
+    return new ConstraintEqualLineLength(*this);
+}
+
 ConstraintType ConstraintEqualLineLength::getTypeId()
 {
     return EqualLineLength;
@@ -2911,6 +3168,11 @@ void ConstraintC2CDistance::reconstructGeomPointers()
     c2.ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintC2CDistance::copy() const
+{
+    return new ConstraintC2CDistance(*this);
+}
+
 ConstraintType ConstraintC2CDistance::getTypeId()
 {
     return C2CDistance;
@@ -3013,6 +3275,11 @@ ConstraintC2LDistance::ConstraintC2LDistance(Circle& c, Line& l, double* d, bool
     rescale();
 }
 
+Constraint* ConstraintC2LDistance::copy() const
+{
+    return new ConstraintC2LDistance(*this);
+}
+
 ConstraintType ConstraintC2LDistance::getTypeId()
 {
     return C2LDistance;
@@ -3108,6 +3375,11 @@ ConstraintP2CDistance::ConstraintP2CDistance(Point& p, Circle& c, double* d)
     rescale();
 }
 
+Constraint* ConstraintP2CDistance::copy() const
+{
+    return new ConstraintP2CDistance(*this);
+}
+
 ConstraintType ConstraintP2CDistance::getTypeId()
 {
     return P2CDistance;
@@ -3183,6 +3455,11 @@ void ConstraintArcLength::reconstructGeomPointers()
     arc.ReconstructOnNewPvec(pvec, i);
 }
 
+Constraint* ConstraintArcLength::copy() const
+{
+    return new ConstraintArcLength(*this);
+}
+
 ConstraintType ConstraintArcLength::getTypeId()
 {
     return ArcLength;
@@ -3229,4 +3506,227 @@ void ConstraintArcLength::evaluate()
     *distance() = (endA - startA) * *arc.rad;
 }
 
+// --------------------------------------------------------
+// Batch
+namespace
+{
+// the k-th parameter (or derivative) of all n constraints of a batch
+Eigen::Map<Eigen::ArrayXd> column(VEC_D& values, std::size_t n, int k)
+{
+    return {values.data() + k * n, Eigen::Index(n)};
+}
+}  // namespace
+
+ConstraintBatch::ConstraintBatch(ConstraintType type)
+    : type(type)
+{
+    switch (type) {
+        case Equal:
+            nparams = 2;
+            break;
+        case Difference:
+            nparams = 3;
+            break;
+        case P2PDistance:
+            nparams = 5;
+            break;
+        case PointOnLine:
+            nparams = 6;
+            break;
+        case Parallel:
+        case Perpendicular:
+            nparams = 8;
+            break;
+        default:
+            nparams = 0;
+            break;
+    }
+}
+
+bool ConstraintBatch::isSupported(ConstraintType type)
+{
+    return ConstraintBatch(type).nparams > 0;
+}
+
+bool ConstraintBatch::add(Constraint* constr)
+{
+    if (nparams == 0 || constr->getTypeId() != type || int(constr->pvec.size()) != nparams) {
+        return false;
+    }
+
+    constraints.push_back(constr);
+    if (type == Equal) {
+        ratios.push_back(static_cast<ConstraintEqual*>(constr)->ratio);
+    }
+    return true;
+}
+
+void ConstraintBatch::update()
+{
+    std::size_t n = constraints.size();
+    pointers.resize(nparams * n);
+    values.resize(nparams * n);
+    derivs.resize(nparams * n);
+    scales.resize(n);
+    errors.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+        const Constraint* constr = constraints[i];
+        for (int k = 0; k < nparams; k++) {
+            pointers[k * n + i] = constr->pvec[k];
+        }
+        scales[i] = constr->scale;
+    }
+}
+
+void ConstraintBatch::evaluate(bool withGrad)
+{
+    if (constraints.empty()) {
+        return;
+    }
+
+    if (pointers.size() != nparams * constraints.size()) {
+        update();
+    }
+    for (std::size_t j = 0; j < pointers.size(); j++) {
+        values[j] = *pointers[j];
+    }
+    switch (type) {
+        case Equal:
+            evaluateEqual(withGrad);
+            break;
+        case Difference:
+            evaluateDifference(withGrad);
+            break;
+        case P2PDistance:
+            evaluateP2PDistance(withGrad);
+            break;
+        case PointOnLine:
+            evaluatePointOnLine(withGrad);
+            break;
+        case Parallel:
+            evaluateParallel(withGrad);
+            break;
+        case Perpendicular:
+            evaluatePerpendicular(withGrad);
+            break;
+        default:
+            break;
+    }
+}
+
+void ConstraintBatch::evaluateEqual(bool withGrad)
+{
+    std::size_t n = constraints.size();
+    auto p1 = column(values, n, 0);
+    auto p2 = column(values, n, 1);
+    auto ratio = column(ratios, n, 0);
+    column(errors, n, 0) = column(scales, n, 0) * (p1 - ratio * p2);
+
+    // see ConstraintEqual::grad(), the ratio isn't taken into account
+    if (withGrad) {
+        column(derivs, n, 0).setConstant(1.);
+        column(derivs, n, 1).setConstant(-1.);
+    }
+}
+
+void ConstraintBatch::evaluateDifference(bool withGrad)
+{
+    std::size_t n = constraints.size();
+    auto p1 = column(values, n, 0);
+    auto p2 = column(values, n, 1);
+    auto difference = column(values, n, 2);
+    column(errors, n, 0) = column(scales, n, 0) * ((p2 - p1) - difference);
+
+    if (withGrad) {
+        column(derivs, n, 0).setConstant(-1.);
+        column(derivs, n, 1).setConstant(1.);
+        column(derivs, n, 2).setConstant(-1.);
+    }
+}
+
+void ConstraintBatch::evaluateP2PDistance(bool withGrad)
+{
+    std::size_t n = constraints.size();
+    Eigen::ArrayXd dx = column(values, n, 0) - column(values, n, 2);
+    Eigen::ArrayXd dy = column(values, n, 1) - column(values, n, 3);
+    Eigen::ArrayXd d = (dx * dx + dy * dy).sqrt();
+    column(errors, n, 0) = column(scales, n, 0) * (d - column(values, n, 4));
+
+    if (withGrad) {
+        column(derivs, n, 0) = dx / d;
+        column(derivs, n, 1) = dy / d;
+        column(derivs, n, 2) = -dx / d;
+        column(derivs, n, 3) = -dy / d;
+        column(derivs, n, 4).setConstant(-1.);
+    }
+}
+
+void ConstraintBatch::evaluatePointOnLine(bool withGrad)
+{
+    std::size_t n = constraints.size();
+    auto x0 = column(values, n, 0);
+    auto y0 = column(values, n, 1);
+    auto x1 = column(values, n, 2);
+    auto y1 = column(values, n, 3);
+    auto x2 = column(values, n, 4);
+    auto y2 = column(values, n, 5);
+    Eigen::ArrayXd dx = x2 - x1;
+    Eigen::ArrayXd dy = y2 - y1;
+    Eigen::ArrayXd d2 = dx * dx + dy * dy;
+    Eigen::ArrayXd d = d2.sqrt();
+    Eigen::ArrayXd area = -x0 * dy + y0 * dx + x1 * y2 - x2 * y1;
+    column(errors, n, 0) = column(scales, n, 0) * area / d;
+
+    if (withGrad) {
+        column(derivs, n, 0) = (y1 - y2) / d;
+        column(derivs, n, 1) = (x2 - x1) / d;
+        column(derivs, n, 2) = ((y2 - y0) * d + (dx / d) * area) / d2;
+        column(derivs, n, 3) = ((x0 - x2) * d + (dy / d) * area) / d2;
+        column(derivs, n, 4) = ((y0 - y1) * d - (dx / d) * area) / d2;
+        column(derivs, n, 5) = ((x1 - x0) * d - (dy / d) * area) / d2;
+    }
+}
+
+void ConstraintBatch::evaluateParallel(bool withGrad)
+{
+    std::size_t n = constraints.size();
+    Eigen::ArrayXd dx1 = column(values, n, 0) - column(values, n, 2);
+    Eigen::ArrayXd dy1 = column(values, n, 1) - column(values, n, 3);
+    Eigen::ArrayXd dx2 = column(values, n, 4) - column(values, n, 6);
+    Eigen::ArrayXd dy2 = column(values, n, 5) - column(values, n, 7);
+    column(errors, n, 0) = column(scales, n, 0) * (dx1 * dy2 - dy1 * dx2);
+
+    if (withGrad) {
+        column(derivs, n, 0) = dy2;
+        column(derivs, n, 1) = -dx2;
+        column(derivs, n, 2) = -dy2;
+        column(derivs, n, 3) = dx2;
+        column(derivs, n, 4) = -dy1;
+        column(derivs, n, 5) = dx1;
+        column(derivs, n, 6) = dy1;
+        column(derivs, n, 7) = -dx1;
+    }
+}
+
+void ConstraintBatch::evaluatePerpendicular(bool withGrad)
+{
+    std::size_t n = constraints.size();
+    Eigen::ArrayXd dx1 = column(values, n, 0) - column(values, n, 2);
+    Eigen::ArrayXd dy1 = column(values, n, 1) - column(values, n, 3);
+    Eigen::ArrayXd dx2 = column(values, n, 4) - column(values, n, 6);
+    Eigen::ArrayXd dy2 = column(values, n, 5) - column(values, n, 7);
+    column(errors, n, 0) = column(scales, n, 0) * (dx1 * dx2 + dy1 * dy2);
+
+    if (withGrad) {
+        column(derivs, n, 0) = dx2;
+        column(derivs, n, 1) = dy2;
+        column(derivs, n, 2) = -dx2;
+        column(derivs, n, 3) = -dy2;
+        column(derivs, n, 4) = dx1;
+        column(derivs, n, 5) = dy1;
+        column(derivs, n, 6) = -dx1;
+        column(derivs, n, 7) = -dy1;
+    }
+}
+
 }  // namespace GCS
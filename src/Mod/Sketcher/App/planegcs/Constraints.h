@@ -26,6 +26,7 @@
 
 #include "../../SketcherGlobal.h"
 #include "Geo.h"
+#include <memory>
 #include <optional>
 
 // This enables debugging code intended to extract information to file bug reports against Eigen,
@@ -109,8 +110,11 @@ enum InternalAlignmentType
     HyperbolaNegativeMinorY = 17
 };
 
+class ConstraintBatch;
+
 class SketcherExport Constraint
 {
+    friend class ConstraintBatch;
 
 public:
     enum class Alignment
@@ -170,6 +174,10 @@ public:
 
 
     virtual ConstraintType getTypeId();
+    /// Creates an independent copy that can be redirected to other parameters
+    virtual Constraint* copy() const;
+    /// Replaces the parameters of the constraint according to \a substitutions
+    void substituteParams(const MAP_pD_pD& substitutions);
     virtual void rescale(double coef = 1.);
     virtual void reconstructGeomPointers();
 
@@ -201,7 +209,7 @@ public:
 
         return deriv * scale;
     };
-    // virtual void grad(MAP_pD_D &deriv);  --> TODO: vectorized grad version
+    // see ConstraintBatch for the vectorized error and gradient of many constraints
     virtual double maxStep(MAP_pD_D& dir, double lim = 1.);
 
     // Evaluates the value of the constraint and assigns it to
@@ -219,8 +227,10 @@ public:
 };
 
 // Equal
-class ConstraintEqual: public Constraint
+class SketcherExport ConstraintEqual: public Constraint
 {
+    friend class ConstraintBatch;
+
 private:
     double ratio;
     double* param1()
@@ -235,6 +245,7 @@ private:
 public:
     ConstraintEqual(double* p1, double* p2, double p1p2ratio = 1.0);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     void evaluate() override;
@@ -262,6 +273,7 @@ public:
         const std::vector<double>& givenweights
     );
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
 
@@ -305,6 +317,7 @@ public:
         const std::vector<double>& givenfactors
     );
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
 
@@ -351,6 +364,7 @@ public:
     // Constrains the slope at a (C1 continuous) knot of the b-spline
     ConstraintSlopeAtBSplineKnot(BSpline& b, Line& l, size_t knotindex);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
@@ -389,6 +403,7 @@ public:
     /// coordidx = 0 if x, 1 if y
     ConstraintPointOnBSpline(double* point, double* initparam, int coordidx, BSpline& b);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     size_t numpoints;
@@ -397,7 +412,7 @@ public:
 };
 
 // Difference
-class ConstraintDifference: public Constraint
+class SketcherExport ConstraintDifference: public Constraint
 {
 private:
     double* param1()
@@ -417,13 +432,14 @@ private:
 public:
     ConstraintDifference(double* p1, double* p2, double* d);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     void evaluate() override;
 };
 
 // P2PDistance
-class ConstraintP2PDistance: public Constraint
+class SketcherExport ConstraintP2PDistance: public Constraint
 {
 private:
     double* p1x()
@@ -455,6 +471,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
@@ -494,6 +511,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
@@ -544,6 +562,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
@@ -552,7 +571,7 @@ public:
 };
 
 // PointOnLine
-class ConstraintPointOnLine: public Constraint
+class SketcherExport ConstraintPointOnLine: public Constraint
 {
 private:
     double* p0x()
@@ -588,6 +607,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
 };
@@ -629,10 +649,11 @@ public:
     ConstraintPointOnPerpBisector() {};
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 // Parallel
-class ConstraintParallel: public Constraint
+class SketcherExport ConstraintParallel: public Constraint
 {
 private:
     double* l1p1x()
@@ -675,13 +696,14 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
 };
 
 // Perpendicular
-class ConstraintPerpendicular: public Constraint
+class SketcherExport ConstraintPerpendicular: public Constraint
 {
 private:
     double* l1p1x()
@@ -726,6 +748,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
@@ -780,6 +803,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
@@ -831,6 +855,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
 };
@@ -878,6 +903,7 @@ public:
         return internal;
     };
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
 };
@@ -922,6 +948,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
 };
@@ -938,6 +965,7 @@ private:
 public:
     ConstraintEllipseTangentLine(Line& l, Ellipse& e);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 class ConstraintInternalAlignmentPoint2Ellipse: public Constraint
@@ -945,6 +973,7 @@ class ConstraintInternalAlignmentPoint2Ellipse: public Constraint
 public:
     ConstraintInternalAlignmentPoint2Ellipse(Ellipse& e, Point& p1, InternalAlignmentType alignmentType);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 
 private:
     void errorgrad(double* err, double* grad, double* param) override;
@@ -964,6 +993,7 @@ public:
         InternalAlignmentType alignmentType
     );
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 
 private:
     void errorgrad(double* err, double* grad, double* param) override;
@@ -977,6 +1007,9 @@ private:
 class ConstraintEqualMajorAxesConic: public Constraint
 {
 private:
+    // only set for copies, the original constraint works on the curves it was created with
+    std::unique_ptr<MajorRadiusConic> ownedE1;
+    std::unique_ptr<MajorRadiusConic> ownedE2;
     MajorRadiusConic* e1;
     MajorRadiusConic* e2;
     // writes pointers in pvec to the parameters of crv1, crv2 and poa
@@ -985,12 +1018,18 @@ private:
 
 public:
     ConstraintEqualMajorAxesConic(MajorRadiusConic* a1, MajorRadiusConic* a2);
+    ConstraintEqualMajorAxesConic(const ConstraintEqualMajorAxesConic& other);
+    ConstraintEqualMajorAxesConic& operator=(const ConstraintEqualMajorAxesConic&) = delete;
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 class ConstraintEqualFocalDistance: public Constraint
 {
 private:
+    // only set for copies, the original constraint works on the curves it was created with
+    std::unique_ptr<ArcOfParabola> ownedE1;
+    std::unique_ptr<ArcOfParabola> ownedE2;
     ArcOfParabola* e1;
     ArcOfParabola* e2;
     // writes pointers in pvec to the parameters of crv1, crv2 and poa
@@ -999,7 +1038,10 @@ private:
 
 public:
     ConstraintEqualFocalDistance(ArcOfParabola* a1, ArcOfParabola* a2);
+    ConstraintEqualFocalDistance(const ConstraintEqualFocalDistance& other);
+    ConstraintEqualFocalDistance& operator=(const ConstraintEqualFocalDistance&) = delete;
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 class ConstraintCurveValue: public Constraint
@@ -1030,8 +1072,11 @@ public:
      * @param u : pointer to u parameter corresponding to the point
      */
     ConstraintCurveValue(Point& p, double* pcoord, Curve& crv, double* u);
+    ConstraintCurveValue(const ConstraintCurveValue& other);
+    ConstraintCurveValue& operator=(const ConstraintCurveValue&) = delete;
     ~ConstraintCurveValue() override;
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
 };
 
@@ -1076,6 +1121,7 @@ public:
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
 };
@@ -1093,12 +1139,15 @@ private:
 public:
     ConstraintPointOnParabola(Point& p, Parabola& e);
     ConstraintPointOnParabola(Point& p, ArcOfParabola& a);
+    ConstraintPointOnParabola(const ConstraintPointOnParabola& other);
+    ConstraintPointOnParabola& operator=(const ConstraintPointOnParabola&) = delete;
     ~ConstraintPointOnParabola() override;
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     ConstraintPointOnParabola()
     {}
 #endif
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 class ConstraintAngleViaPoint: public Constraint
@@ -1126,8 +1175,11 @@ private:
 
 public:
     ConstraintAngleViaPoint(Curve& acrv1, Curve& acrv2, Point p, double* angle);
+    ConstraintAngleViaPoint(const ConstraintAngleViaPoint& other);
+    ConstraintAngleViaPoint& operator=(const ConstraintAngleViaPoint&) = delete;
     ~ConstraintAngleViaPoint() override;
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
 };
@@ -1160,8 +1212,11 @@ private:
 
 public:
     ConstraintAngleViaTwoPoints(Curve& acrv1, Curve& acrv2, Point p1, Point p2, double* angle);
+    ConstraintAngleViaTwoPoints(const ConstraintAngleViaTwoPoints& other);
+    ConstraintAngleViaTwoPoints& operator=(const ConstraintAngleViaTwoPoints&) = delete;
     ~ConstraintAngleViaTwoPoints() override;
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     void evaluate() override;
@@ -1210,8 +1265,11 @@ public:
         bool flipn1,
         bool flipn2
     );
+    ConstraintSnell(const ConstraintSnell& other);
+    ConstraintSnell& operator=(const ConstraintSnell&) = delete;
     ~ConstraintSnell() override;
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 class ConstraintAngleViaPointAndParam: public Constraint
@@ -1243,8 +1301,11 @@ private:
 public:
     // We assume first curve needs param1
     ConstraintAngleViaPointAndParam(Curve& acrv1, Curve& acrv2, Point p, double* param1, double* angle);
+    ConstraintAngleViaPointAndParam(const ConstraintAngleViaPointAndParam& other);
+    ConstraintAngleViaPointAndParam& operator=(const ConstraintAngleViaPointAndParam&) = delete;
     ~ConstraintAngleViaPointAndParam() override;
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     void evaluate() override;
@@ -1290,8 +1351,13 @@ public:
         double* param2,
         double* angle
     );
+    ConstraintAngleViaPointAndTwoParams(const ConstraintAngleViaPointAndTwoParams& other);
+    ConstraintAngleViaPointAndTwoParams& operator=(
+        const ConstraintAngleViaPointAndTwoParams&
+    ) = delete;
     ~ConstraintAngleViaPointAndTwoParams() override;
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
     double error() override;
     double grad(double*) override;
     void evaluate() override;
@@ -1309,6 +1375,7 @@ private:
 public:
     ConstraintEqualLineLength(Line& l1, Line& l2);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 class ConstraintC2CDistance: public Constraint
@@ -1331,6 +1398,7 @@ private:
 public:
     ConstraintC2CDistance(Circle& c1, Circle& c2, double* d, std::optional<bool> c1Bigger);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 // C2LDistance
@@ -1356,6 +1424,7 @@ private:
 public:
     ConstraintC2LDistance(Circle& c, Line& l, double* d, bool ccw, bool internal);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 // P2CDistance
@@ -1376,6 +1445,7 @@ private:
 public:
     ConstraintP2CDistance(Point& p, Circle& c, double* d);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
 };
 
 // ArcLength
@@ -1395,6 +1465,88 @@ private:
 public:
     ConstraintArcLength(Arc& a, double* d);
     ConstraintType getTypeId() override;
+    Constraint* copy() const override;
+};
+
+// Batch
+/** Evaluates the errors and gradients of many constraints of the same type at once.
+ * The parameter values of all constraints are gathered into one array per parameter of the
+ * constraint type (structure of arrays). So, instead of a virtual call for the error and for each
+ * parameter of each constraint, the batch is computed in a few vectorized passes over these
+ * arrays. The results are the same as from Constraint::error() and Constraint::grad().
+ */
+class SketcherExport ConstraintBatch
+{
+public:
+    explicit ConstraintBatch(ConstraintType type);
+
+    /// Returns true if constraints of the type can be evaluated in a batch
+    static bool isSupported(ConstraintType type);
+
+    ConstraintType getTypeId() const
+    {
+        return type;
+    }
+    /// The number of parameters of each constraint of the batch
+    int paramsNum() const
+    {
+        return nparams;
+    }
+    std::size_t size() const
+    {
+        return constraints.size();
+    }
+    Constraint* getConstraint(std::size_t i) const
+    {
+        return constraints[i];
+    }
+    /// Adds a constraint, returns false if it isn't of the type of the batch
+    bool add(Constraint* constr);
+    /** Reads the parameter pointers and the scales of the constraints again.
+     * Must be called after the parameters of the constraints were redirected or reverted, or
+     * after the constraints were rescaled.
+     */
+    void update();
+
+    /// Evaluates all constraints of the batch
+    void evaluate(bool withGrad = true);
+    /// The error of the \a i-th constraint, see Constraint::error()
+    double error(std::size_t i) const
+    {
+        return errors[i];
+    }
+    /** The derivative of the unscaled error of the \a i-th constraint by its \a k-th parameter.
+     * Constraint::grad() is the sum of the derivatives of all parameters of the constraint that
+     * point to the same value, multiplied by the scale.
+     */
+    double derivative(std::size_t i, int k) const
+    {
+        return derivs[k * constraints.size() + i];
+    }
+    double getScale(std::size_t i) const
+    {
+        return scales[i];
+    }
+
+private:
+    void evaluateEqual(bool withGrad);
+    void evaluateDifference(bool withGrad);
+    void evaluateP2PDistance(bool withGrad);
+    void evaluatePointOnLine(bool withGrad);
+    void evaluateParallel(bool withGrad);
+    void evaluatePerpendicular(bool withGrad);
+
+private:
+    ConstraintType type;
+    int nparams;
+    std::vector<Constraint*> constraints;
+    VEC_D ratios;  // only used by Equal
+    // the k-th parameter of the i-th constraint is at k * size() + i
+    VEC_pD pointers;
+    VEC_D values;
+    VEC_D derivs;
+    VEC_D scales;
+    VEC_D errors;
 };
 
 }  // namespace GCS
@@ -49,10 +49,14 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <future>
 #include <iostream>
 #include <limits>
 #include <numbers>
+#include <thread>
+#include <unordered_map>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -459,6 +463,33 @@ void SolverReportingManager::LogMatrix(const std::string str, MatrixIndexType ma
 
 using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
 
+namespace
+{
+// Calls func for each component on a number of threads, each thread takes the next component
+// that isn't solved yet
+template<typename Func>
+void solveComponentsInParallel(const std::vector<int>& cids, Func func)
+{
+    std::size_t numThreads = std::max(1U, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, cids.size());
+
+    std::atomic<std::size_t> next {0};
+    auto worker = [&]() {
+        for (std::size_t index = next++; index < cids.size(); index = next++) {
+            func(cids[index]);
+        }
+    };
+    std::vector<std::future<void>> futures;
+    for (std::size_t i = 1; i < numThreads; i++) {
+        futures.push_back(std::async(std::launch::async, worker));
+    }
+    worker();
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+}  // namespace
+
 ///////////////////////////////////////
 // Solver
 ///////////////////////////////////////
@@ -488,6 +519,10 @@ System::System()
     , qrAlgorithm(EigenSparseQR)
     , autoChooseAlgorithm(true)
     , autoQRThreshold(1000)
+    , autoSparseThreshold(1000)
+    , autoParallelThreshold(200)
+    , incrementalDiagnosis(true)
+    , batchedEvaluation(true)
     , dogLegGaussStep(FullPivLU)
     , qrpivotThreshold(1E-13)
     , debugMode(Minimal)
@@ -535,6 +570,7 @@ void System::clear()
 
     reference.clear();
     clearSubSystems();
+    componentResults.clear();
     deleteAllContent(clist);
     drivenConstraints.clear();
     c2p.clear();
@@ -1853,6 +1889,7 @@ void System::initSolution(Algorithm alg)
 
     // calculates subSystems and subSystemsAux from clists, plists and reductionmaps
     clearSubSystems();
+    componentResults.assign(clists.size(), Success);
     subSystems.resize(clists.size(), nullptr);
     subSystemsAux.resize(clists.size(), nullptr);
     for (std::size_t cid = 0; cid < clists.size(); ++cid) {
@@ -1865,10 +1902,12 @@ void System::initSolution(Algorithm alg)
         );
 
         if (!clist0.empty()) {
-            subSystems[cid] = new SubSystem(clist0, plists[cid], reductionmaps[cid]);
+            subSystems[cid] =
+                new SubSystem(clist0, plists[cid], reductionmaps[cid], batchedEvaluation);
         }
         if (!clist1.empty()) {
-            subSystemsAux[cid] = new SubSystem(clist1, plists[cid], reductionmaps[cid]);
+            subSystemsAux[cid] =
+                new SubSystem(clist1, plists[cid], reductionmaps[cid], batchedEvaluation);
         }
     }
 
@@ -1902,30 +1941,137 @@ int System::solve(VEC_pD& params, bool isFine, Algorithm alg, bool isRedundantso
     return solve(isFine, alg, isRedundantsolving);
 }
 
+std::unique_ptr<System> System::copyForSolving() const
+{
+    auto copy = std::make_unique<System>();
+    copy->maxIter = maxIter;
+    copy->maxIterRedundant = maxIterRedundant;
+    copy->sketchSizeMultiplier = sketchSizeMultiplier;
+    copy->sketchSizeMultiplierRedundant = sketchSizeMultiplierRedundant;
+    copy->convergence = convergence;
+    copy->convergenceRedundant = convergenceRedundant;
+    copy->qrAlgorithm = qrAlgorithm;
+    copy->autoChooseAlgorithm = autoChooseAlgorithm;
+    copy->autoQRThreshold = autoQRThreshold;
+    copy->autoSparseThreshold = autoSparseThreshold;
+    copy->autoParallelThreshold = autoParallelThreshold;
+    copy->incrementalDiagnosis = incrementalDiagnosis;
+    copy->batchedEvaluation = batchedEvaluation;
+    copy->dogLegGaussStep = dogLegGaussStep;
+    copy->qrpivotThreshold = qrpivotThreshold;
+    copy->debugMode = debugMode;
+    copy->LM_eps = LM_eps;
+    copy->LM_eps1 = LM_eps1;
+    copy->LM_tau = LM_tau;
+    copy->DL_tolg = DL_tolg;
+    copy->DL_tolx = DL_tolx;
+    copy->DL_tolf = DL_tolf;
+    copy->LM_epsRedundant = LM_epsRedundant;
+    copy->LM_eps1Redundant = LM_eps1Redundant;
+    copy->LM_tauRedundant = LM_tauRedundant;
+    copy->DL_tolgRedundant = DL_tolgRedundant;
+    copy->DL_tolxRedundant = DL_tolxRedundant;
+    copy->DL_tolfRedundant = DL_tolfRedundant;
+
+    // the copy must not reallocate its unknowns once the constraints point to them
+    copy->ownedParams.reserve(plist.size());
+    VEC_pD params;
+    MAP_pD_pD substitutions;
+    for (const auto param : plist) {
+        params.push_back(&copy->ownedParams.emplace_back(*param));
+        substitutions[param] = params.back();
+    }
+
+    // driven constraints only evaluate the solution, this is left to this system
+    std::map<Constraint*, Constraint*> copies;
+    for (const auto constr : clist) {
+        if (constr->isDriving()) {
+            Constraint* constrCopy = constr->copy();
+            constrCopy->substituteParams(substitutions);
+            copy->addConstraint(constrCopy);
+            copies[constr] = constrCopy;
+        }
+    }
+    copy->declareUnknowns(params);
+
+    // keep the diagnosis, so that the copy solves exactly the same system
+    for (const auto constr : redundant) {
+        auto it = copies.find(constr);
+        if (it != copies.end()) {
+            copy->redundant.insert(it->second);
+        }
+    }
+    copy->dofs = dofs;
+    copy->conflictingTags = conflictingTags;
+    copy->redundantTags = redundantTags;
+    copy->partiallyRedundantTags = partiallyRedundantTags;
+    copy->emptyDiagnoseMatrix = emptyDiagnoseMatrix;
+    copy->hasDiagnosis = hasDiagnosis;
+    return copy;
+}
+
+void System::restrictToComponentsWithTag(int tagId)
+{
+    activeComponents.assign(clists.size(), false);
+    for (std::size_t cid = 0; cid < clists.size(); ++cid) {
+        activeComponents[cid] = std::ranges::any_of(clists[cid], [tagId](auto constr) {
+            return constr->getTag() == tagId;
+        });
+    }
+}
+
 int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
 {
     if (!isInit) {
         return Failed;
     }
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
+    std::vector<int> cids;
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-            resetToReference();
-            isReset = true;
+        if (!isActiveComponent(cid)) {
+            componentResults[cid] = -1;
+        }
+        else if (subSystems[cid] || subSystemsAux[cid]) {
+            cids.push_back(cid);
         }
+        else {
+            componentResults[cid] = Success;
+        }
+    }
+    if (!cids.empty()) {
+        resetToReference();
+    }
+
+    // The components have disjoint unknowns and constraints, so they can be solved concurrently.
+    // Each result is stored per component and merged afterwards in a fixed order.
+    auto solveComponent = [&](int cid) {
         if (subSystems[cid] && subSystemsAux[cid]) {
-            res = std::max(res, solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
+            componentResults[cid] =
+                solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
         }
         else if (subSystems[cid]) {
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
+            componentResults[cid] = solve(subSystems[cid], isFine, alg, isRedundantsolving);
         }
-        else if (subSystemsAux[cid]) {
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+        else {
+            componentResults[cid] = solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
         }
+    };
+    if (cids.size() > 1 && int(plist.size()) >= autoParallelThreshold) {
+        // start with the big components to balance the load of the threads
+        std::ranges::stable_sort(cids, std::greater<>(), [this](int cid) {
+            return plists[cid].size();
+        });
+        solveComponentsInParallel(cids, solveComponent);
+    }
+    else {
+        std::ranges::for_each(cids, solveComponent);
+    }
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = Success;
+    for (int cid : cids) {
+        res = std::max(res, componentResults[cid]);
     }
     if (res == Success) {
         for (std::set<Constraint*>::const_iterator constr = redundant.begin();
@@ -2014,7 +2160,7 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     double divergingLim = 1e6 * err + 1e12;
     double h_norm {};
 
-    for (int iter = 1; iter < maxIterNumber; ++iter) {
+    for (int iter = 1; iter < maxIterNumber && !isCancelled(); ++iter) {
         h_norm = h.norm();
         if (h_norm <= convCriterion || err <= smallF) {
             if (debugMode == IterationLevel) {
@@ -2087,7 +2233,166 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     return Failed;
 }
 
+namespace
+{
+// Normal equations J^T * J of the Levenberg-Marquardt method
+Eigen::MatrixXd normalMatrix(const Eigen::MatrixXd& J)
+{
+    return J.transpose() * J;
+}
+
+Eigen::SparseMatrix<double> normalMatrix(const SparseJacobian& J)
+{
+    return Eigen::SparseMatrix<double>(J.transpose() * J);
+}
+
+// Solves the augmented normal equations (A + mu * I) * h = g
+bool solveAugmented(
+    const Eigen::MatrixXd& A,
+    double mu,
+    const Eigen::VectorXd& g,
+    Eigen::VectorXd& h
+)
+{
+    Eigen::MatrixXd Aaug = A;
+    Aaug.diagonal().array() += mu;
+    h = Aaug.fullPivLu().solve(g);
+    return (Aaug * h - g).norm() / g.norm() < 1e-5;
+}
+
+bool solveAugmented(
+    const Eigen::SparseMatrix<double>& A,
+    double mu,
+    const Eigen::VectorXd& g,
+    Eigen::VectorXd& h
+)
+{
+    Eigen::SparseMatrix<double> identity(A.rows(), A.cols());
+    identity.setIdentity();
+    Eigen::SparseMatrix<double> Aaug = A + mu * identity;
+
+    // A is positive semi-definite, so the augmented matrix is positive definite
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(Aaug);
+    if (ldlt.info() != Eigen::Success) {
+        return false;
+    }
+    h = ldlt.solve(g);
+    return (Aaug * h - g).norm() / g.norm() < 1e-5;
+}
+
+// Computes the Gauss-Newton step of the DogLeg method, J * h = -fx
+// https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
+// https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
+bool solveGaussNewton(
+    const Eigen::MatrixXd& J,
+    const Eigen::VectorXd& fx,
+    DogLegGaussStep mode,
+    Eigen::VectorXd& h
+)
+{
+    switch (mode) {
+        case FullPivLU:
+            h = J.fullPivLu().solve(-fx);
+            break;
+        case LeastNormFullPivLU:
+            h = J.adjoint() * (J * J.adjoint()).fullPivLu().solve(-fx);
+            break;
+        case LeastNormLdlt:
+            h = J.adjoint() * (J * J.adjoint()).ldlt().solve(-fx);
+            break;
+    }
+    return true;
+}
+
+// Computes the least norm solution of J * h = -fx with a rank revealing QR of J^T. Unlike the
+// normal equations J * J^T it neither squares the condition number nor fails for redundant
+// constraints.
+bool solveLeastNormQR(const SparseJacobian& J, const Eigen::VectorXd& fx, Eigen::VectorXd& h)
+{
+    // With J^T * P = Q * R it is P^T * J = R^T * Q^T, which gives the least norm solution
+    // h = Q * z with R^T * z = -P^T * fx. The rank of R drops redundant equations.
+    Eigen::SparseMatrix<double> JT(J.transpose());
+    Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> qr(JT);
+    if (qr.info() != Eigen::Success) {
+        return false;
+    }
+    Eigen::Index rank = qr.rank();
+    Eigen::VectorXd c = qr.colsPermutation().transpose() * (-fx);
+    const Eigen::SparseMatrix<double>& R = qr.matrixR();
+    Eigen::VectorXd z = Eigen::VectorXd::Zero(J.cols());
+    for (Eigen::Index k = 0; k < rank; k++) {
+        // forward substitution with the k-th column of R
+        double sum = c[k];
+        double diag = 0.0;
+        for (Eigen::SparseMatrix<double>::InnerIterator it(R, k); it; ++it) {
+            if (it.row() < k) {
+                sum -= it.value() * z[it.row()];
+            }
+            else if (it.row() == k) {
+                diag = it.value();
+            }
+        }
+        z[k] = sum / diag;
+    }
+    h = qr.matrixQ() * z;
+    return h.allFinite();
+}
+
+// The sparse counterparts: the least norm solution of the normal equations with sparse LDLT or
+// LU is by far the fastest, but it fails or gets inaccurate if the constraints are redundant,
+// i.e. J doesn't have full row rank. Then the rank revealing QR of J^T is used instead.
+bool solveGaussNewton(
+    const SparseJacobian& J,
+    const Eigen::VectorXd& fx,
+    DogLegGaussStep mode,
+    Eigen::VectorXd& h
+)
+{
+    Eigen::SparseMatrix<double> JJt = J * J.transpose();
+    bool solved = false;
+    switch (mode) {
+        case FullPivLU:
+        case LeastNormLdlt: {
+            Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(JJt);
+            if (ldlt.info() == Eigen::Success) {
+                h = J.transpose() * ldlt.solve(-fx);
+                solved = true;
+            }
+        } break;
+        case LeastNormFullPivLU: {
+            Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> lu(JJt);
+            if (lu.info() == Eigen::Success) {
+                h = J.transpose() * lu.solve(-fx);
+                solved = true;
+            }
+        } break;
+    }
+
+    if (solved && h.allFinite() && (J * h + fx).norm() <= 1e-5 * fx.norm()) {
+        return true;
+    }
+    return solveLeastNormQR(J, fx, h);
+}
+}  // namespace
+
 int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
+{
+    if (subsys->pSize() >= autoSparseThreshold) {
+        return solveLM<SparseJacobian>(subsys, isRedundantsolving);
+    }
+    return solveLM<Eigen::MatrixXd>(subsys, isRedundantsolving);
+}
+
+int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
+{
+    if (subsys->pSize() >= autoSparseThreshold) {
+        return solveDL<SparseJacobian>(subsys, isRedundantsolving);
+    }
+    return solveDL<Eigen::MatrixXd>(subsys, isRedundantsolving);
+}
+
+template<typename JacobianMatrix>
+int System::solveLM(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     extractSubsystem(subsys, isRedundantsolving);
@@ -2102,8 +2407,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd e(csize),
         e_new(csize);  // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);  // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    JacobianMatrix J(csize, xsize);  // Jacobi of the subsystem
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
     subsys->redirectParams();
@@ -2152,16 +2456,20 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
             stop = 6;
             break;
         }
+        else if (isCancelled()) {
+            stop = 8;
+            break;
+        }
 
         // J^T J, J^T e
         subsys->calcJacobi(J);
 
-        A = J.transpose() * J;
+        auto A = normalMatrix(J);
         g = J.transpose() * e;
 
         // Compute ||J^T e||_inf
         double g_inf = g.lpNorm<Eigen::Infinity>();
-        diag_A = A.diagonal();  // save diagonal entries so that augmentation can be later canceled
+        diag_A = A.diagonal();
 
         // check for convergence
         if (g_inf <= eps1) {
@@ -2178,17 +2486,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         // determine increment using adaptive damping
         int k = 0;
         while (k < 50) {
-            // augment normal equations A = A+uI
-            for (int i = 0; i < xsize; ++i) {
-                A(i, i) += mu;
-            }
-
-            // solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
-            double rel_error = (A * h - g).norm() / g.norm();
-
-            // check if solving works
-            if (rel_error < 1e-5) {
+            // solve augmented functions (A+uI)*h=-g and check if solving works
+            if (solveAugmented(A, mu, g, h)) {
                 // restrict h according to maxStep
                 double scale = subsys->maxStep(h);
                 if (scale < 1.) {
@@ -2235,9 +2534,6 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
             mu *= nu;
             nu *= 2.0;
-            for (int i = 0; i < xsize; ++i) {  // restore diagonal J^T J entries
-                A(i, i) = diag_A(i);
-            }
 
             k++;
         }
@@ -2266,7 +2562,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
     return (stop == 1) ? Success : Failed;
 }
 
-int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
+template<typename JacobianMatrix>
+int System::solveDL(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     extractSubsystem(subsys, isRedundantsolving);
@@ -2310,7 +2607,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    JacobianMatrix Jx(csize, xsize), Jx_new(csize, xsize);
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
     subsys->redirectParams();
@@ -2356,28 +2653,24 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
             stop = 6;
             break;
         }
+        else if (isCancelled()) {
+            stop = 7;
+            break;
+        }
 
         // get the steepest descent direction
         alpha = g.squaredNorm() / (Jx * g).squaredNorm();
         h_sd = alpha * g;
 
-        // get the gauss-newton step
-        // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
-        // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-        switch (dogLegGaussStep) {
-            case FullPivLU:
-                h_gn = Jx.fullPivLu().solve(-fx);
-                break;
-            case LeastNormFullPivLU:
-                h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
-                break;
-            case LeastNormLdlt:
-                h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
-                break;
+        // get the gauss-newton step, fail if it can't be computed
+        if (!solveGaussNewton(Jx, fx, dogLegGaussStep, h_gn)) {
+            stop = 3;
+            break;
         }
 
         double rel_error = (Jx * h_gn + fx).norm() / fx.norm();
         if (rel_error > 1e15) {
+            stop = 3;
             break;
         }
 
@@ -4698,6 +4991,9 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
 void System::applySolution()
 {
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
+        if (!isActiveComponent(cid)) {
+            continue;
+        }
         if (subSystemsAux[cid]) {
             subSystemsAux[cid]->applySolution();
         }
@@ -4719,6 +5015,15 @@ void System::evaluateDrivenConstraints()
     }
 }
 
+void System::applySolution(System& copy)
+{
+    copy.applySolution();
+    for (std::size_t i = 0; i < plist.size() && i < copy.ownedParams.size(); ++i) {
+        *plist[i] = copy.ownedParams[i];
+    }
+    evaluateDrivenConstraints();
+}
+
 void System::undoSolution()
 {
     resetToReference();
@@ -4743,6 +5048,12 @@ void System::makeReducedJacobian(
 
     J = Eigen::MatrixXd::Zero(clist.size(), pdiagnoselist.size());
 
+    // a constraint only has a gradient for its own parameters
+    std::unordered_map<double*, int> paramCols;
+    for (int j = 0; j < int(pdiagnoselist.size()); j++) {
+        paramCols[pdiagnoselist[j]] = j;
+    }
+
     int jacobianconstraintcount = 0;
     int allcount = 0;
     for (auto& constr : clist) {
@@ -4750,8 +5061,11 @@ void System::makeReducedJacobian(
         ++allcount;
         if (constr->getTag() >= 0 && constr->isDriving()) {
             jacobianconstraintcount++;
-            for (int j = 0; j < int(pdiagnoselist.size()); j++) {
-                J(jacobianconstraintcount - 1, j) = constr->grad(pdiagnoselist[j]);
+            for (double* param : constr->params()) {
+                auto it = paramCols.find(param);
+                if (it != paramCols.end()) {
+                    J(jacobianconstraintcount - 1, it->second) = constr->grad(param);
+                }
             }
 
             // parallel processing: create tag multiplicity map
@@ -4916,6 +5230,11 @@ int System::diagnose(Algorithm alg)
     // From here on, presuming `J.rows() > 0`.
     emptyDiagnoseMatrix = false;
 
+    int rowsNum = int(jacobianconstraintmap.size());
+    if (incrementalDiagnosis && diagnoseIncrementally(J, rowsNum, pdiagnoselist)) {
+        return dofs;
+    }
+
     if (qrAlgorithm == EigenDenseQR) {
 #ifdef PROFILE_DIAGNOSE
         Base::TimeElapsed DenseQR_start_time;
@@ -4960,6 +5279,8 @@ int System::diagnose(Algorithm alg)
 
         dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
 
+        updateDiagnosisCache(J, constrNum == rank ? rowsNum : -1, pdiagnoselist);
+
         // Detecting conflicting or redundant constraints
         if (constrNum > rank) {
             // conflicting or redundant constraints
@@ -5039,6 +5360,8 @@ int System::diagnose(Algorithm alg)
 
         dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
 
+        updateDiagnosisCache(J, constrNum == rank ? rowsNum : -1, pdiagnoselist);
+
         // Detecting conflicting or redundant constraints
         if (constrNum > rank) {
             int nonredundantconstrNum;
@@ -5318,6 +5641,12 @@ void System::identifyDependentParameters(
     }
 #endif
 
+    if (incrementalDiagnosis) {
+        const auto& indices = qrJ.colsPermutation().indices();
+        VEC_I colsOrder(indices.data(), indices.data() + indices.size());
+        diagnosisCache.setEchelonForm(Rparams, rank, colsOrder);
+    }
+
     pDependentParametersGroups.resize(qrJ.cols() - rank);
     for (int j = rank; j < qrJ.cols(); j++) {
         for (int row = 0; row < rank; row++) {
@@ -5350,6 +5679,217 @@ void System::identifyDependentParameters(
 #endif
 }
 
+void System::DiagnosisCache::clear()
+{
+    paramsNum = 0;
+    rows.clear();
+    pivotCols.clear();
+    freeCols.clear();
+    F.resize(0, 0);
+    appendedRows = 0;
+    dependentCols.clear();
+    dependentColGroups.clear();
+}
+
+void System::DiagnosisCache::setEchelonForm(
+    const Eigen::MatrixXd& R,
+    int rank,
+    const VEC_I& colsOrder
+)
+{
+    int freeNum = int(colsOrder.size()) - rank;
+    pivotCols.assign(colsOrder.begin(), colsOrder.begin() + rank);
+    freeCols.assign(colsOrder.begin() + rank, colsOrder.end());
+    F.resize(rank, freeNum);
+    for (int row = 0; row < rank; row++) {
+        F.row(row) = R.block(row, rank, 1, freeNum) / R(row, row);
+    }
+    appendedRows = 0;
+}
+
+bool System::DiagnosisCache::appendRow(const SparseRow& row)
+{
+    // the position of each column among the pivots and among the free columns
+    VEC_I pivotRow(paramsNum, -1);
+    VEC_I freeIndex(paramsNum, -1);
+    for (int b = 0; b < int(pivotCols.size()); b++) {
+        pivotRow[pivotCols[b]] = b;
+    }
+    for (int j = 0; j < int(freeCols.size()); j++) {
+        freeIndex[freeCols[j]] = j;
+    }
+
+    // reduce the row by the rows of the echelon form, only free columns are left
+    Eigen::RowVectorXd g = Eigen::RowVectorXd::Zero(freeCols.size());
+    double scale = 0;
+    for (const auto& [col, value] : row) {
+        scale = std::max(scale, std::fabs(value));
+        if (pivotRow[col] >= 0) {
+            g -= value * F.row(pivotRow[col]);
+        }
+        else {
+            g(freeIndex[col]) += value;
+        }
+    }
+
+    // be conservative, a nearly dependent row is left to the QR decomposition
+    Eigen::Index k = 0;
+    if (g.size() == 0 || g.cwiseAbs().maxCoeff(&k) <= 1e-8 * scale) {
+        return false;
+    }
+
+    // the free column k becomes the pivot of the new row
+    g /= g(k);
+    F -= F.col(k) * g;
+
+    int rowsNum = int(F.rows());
+    int freeNum = int(F.cols()) - 1;
+    Eigen::MatrixXd newF(rowsNum + 1, freeNum);
+    newF.topLeftCorner(rowsNum, k) = F.leftCols(k);
+    newF.topRightCorner(rowsNum, freeNum - k) = F.rightCols(freeNum - k);
+    newF.bottomLeftCorner(1, k) = g.leftCols(k);
+    newF.bottomRightCorner(1, freeNum - k) = g.rightCols(freeNum - k);
+    F.swap(newF);
+
+    pivotCols.push_back(freeCols[k]);
+    freeCols.erase(freeCols.begin() + k);
+    rows.push_back(row);
+    appendedRows++;
+    return true;
+}
+
+void System::DiagnosisCache::updateDependentCols()
+{
+    // same order as identifyDependentParameters
+    dependentCols.clear();
+    dependentColGroups.assign(freeCols.size(), VEC_I());
+    for (int j = 0; j < int(freeCols.size()); j++) {
+        for (int row = 0; row < int(pivotCols.size()); row++) {
+            if (fabs(F(row, j)) > 1e-10) {
+                dependentColGroups[j].push_back(pivotCols[row]);
+                dependentCols.push_back(pivotCols[row]);
+            }
+        }
+        dependentColGroups[j].push_back(freeCols[j]);
+        dependentCols.push_back(freeCols[j]);
+    }
+}
+
+void System::updateDiagnosisCache(
+    const Eigen::MatrixXd& J,
+    int rowsNum,
+    const VEC_pD& pdiagnoselist
+)
+{
+    // only a diagnosis without redundant constraints can be updated by adding rows
+    if (!incrementalDiagnosis || rowsNum <= 0 || int(diagnosisCache.pivotCols.size()) != rowsNum) {
+        diagnosisCache.clear();
+        return;
+    }
+
+    diagnosisCache.paramsNum = int(J.cols());
+    diagnosisCache.rows.assign(rowsNum, DiagnosisCache::SparseRow());
+    for (int i = 0; i < rowsNum; i++) {
+        for (int j = 0; j < J.cols(); j++) {
+            if (J(i, j) != 0) {
+                diagnosisCache.rows[i].emplace_back(j, J(i, j));
+            }
+        }
+    }
+
+    std::unordered_map<double*, int> paramCols;
+    for (int j = 0; j < int(pdiagnoselist.size()); j++) {
+        paramCols[pdiagnoselist[j]] = j;
+    }
+    bool complete = true;
+    auto toCols = [&paramCols, &complete](const VEC_pD& params) {
+        VEC_I cols;
+        cols.reserve(params.size());
+        for (double* param : params) {
+            auto it = paramCols.find(param);
+            if (it == paramCols.end()) {
+                complete = false;
+                break;
+            }
+            cols.push_back(it->second);
+        }
+        return cols;
+    };
+    diagnosisCache.dependentCols = toCols(pDependentParameters);
+    diagnosisCache.dependentColGroups.clear();
+    for (const auto& group : pDependentParametersGroups) {
+        diagnosisCache.dependentColGroups.push_back(toCols(group));
+    }
+
+    // the dependent parameters are left over from a former diagnosis
+    if (!complete) {
+        diagnosisCache.clear();
+    }
+}
+
+bool System::diagnoseIncrementally(
+    const Eigen::MatrixXd& J,
+    int rowsNum,
+    const VEC_pD& pdiagnoselist
+)
+{
+    if (!diagnosisCache.isValid() || diagnosisCache.paramsNum != int(J.cols())) {
+        return false;
+    }
+
+    // all cached rows must still be there, in the same order, and only rows may have been added
+    std::vector<DiagnosisCache::SparseRow> newRows;
+    std::size_t cached = 0;
+    DiagnosisCache::SparseRow row;
+    for (int i = 0; i < rowsNum; i++) {
+        row.clear();
+        for (int j = 0; j < J.cols(); j++) {
+            if (J(i, j) != 0) {
+                row.emplace_back(j, J(i, j));
+            }
+        }
+        if (cached < diagnosisCache.rows.size() && row == diagnosisCache.rows[cached]) {
+            cached++;
+        }
+        else {
+            newRows.push_back(row);
+        }
+    }
+
+    if (cached != diagnosisCache.rows.size()
+        || diagnosisCache.appendedRows + int(newRows.size()) > DiagnosisCache::maxAppendedRows) {
+        return false;
+    }
+
+    for (const auto& newRow : newRows) {
+        if (!diagnosisCache.appendRow(newRow)) {
+            // redundant or conflicting constraints need the full diagnosis
+            diagnosisCache.clear();
+            return false;
+        }
+    }
+
+    if (!newRows.empty()) {
+        diagnosisCache.updateDependentCols();
+    }
+
+    pDependentParameters.clear();
+    for (int col : diagnosisCache.dependentCols) {
+        pDependentParameters.push_back(pdiagnoselist[col]);
+    }
+    pDependentParametersGroups.clear();
+    for (const auto& group : diagnosisCache.dependentColGroups) {
+        VEC_pD params;
+        for (int col : group) {
+            params.push_back(pdiagnoselist[col]);
+        }
+        pDependentParametersGroups.push_back(params);
+    }
+
+    dofs = int(J.cols()) - rowsNum;
+    return true;
+}
+
 void System::identifyDependentGeometryParametersInTransposedJacobianDenseQRDecomposition(
     const Eigen::FullPivHouseholderQR<Eigen::MatrixXd>& qrJT,
     const GCS::VEC_pD& pdiagnoselist,
@@ -5713,6 +6253,7 @@ void System::clearSubSystems()
     deleteAllContent(subSystemsAux);
     subSystems.clear();
     subSystemsAux.clear();
+    activeComponents.clear();
 }
 
 double lineSearch(SubSystem* subsys, Eigen::VectorXd& xdir)
@@ -24,6 +24,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include <Eigen/QR>
 
 #include "../../SketcherGlobal.h"
@@ -145,9 +148,27 @@ private:
 
     bool emptyDiagnoseMatrix;  // false only if there is at least one driving constraint.
 
+    std::vector<bool> activeComponents;  // components solved by solve(), empty if all are solved
+    VEC_I componentResults;              // results of the last solve() for each component
+    bool isActiveComponent(std::size_t cid) const
+    {
+        return activeComponents.empty() || activeComponents[cid];
+    }
+
+    VEC_D ownedParams;  // the unknown parameters of a copy made by copyForSolving()
+    const std::atomic<bool>* cancelFlag {nullptr};
+    bool isCancelled() const
+    {
+        return cancelFlag && cancelFlag->load(std::memory_order_relaxed);
+    }
+
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
+    template<typename JacobianMatrix>
+    int solveLM(SubSystem* subsys, bool isRedundantsolving);
+    template<typename JacobianMatrix>
+    int solveDL(SubSystem* subsys, bool isRedundantsolving);
 
     void makeReducedJacobian(
         Eigen::MatrixXd& J,
@@ -227,6 +248,42 @@ private:
         bool silent = true
     );
 
+    // The reduced row echelon form of the Jacobian of the last diagnosis without redundant
+    // constraints. If the Jacobian only got additional rows since then, e.g. because a constraint
+    // was added, the new rows are eliminated against it instead of decomposing the whole Jacobian
+    // again. The rows are compared by value, so the cache is kept when the system is cleared and
+    // set up again.
+    struct DiagnosisCache
+    {
+        using SparseRow = std::vector<std::pair<int, double>>;
+
+        // appending more rows without a new QR decomposition risks accumulating rounding errors
+        static constexpr int maxAppendedRows = 256;
+
+        int paramsNum {0};
+        std::vector<SparseRow> rows;  // the rows of the reduced Jacobian
+        VEC_I pivotCols;              // the pivot column of each row of the echelon form
+        VEC_I freeCols;               // the columns without a pivot
+        Eigen::MatrixXd F;            // the entries of the echelon form in the free columns
+        int appendedRows {0};         // the rows appended since the last QR decomposition
+        VEC_I dependentCols;
+        std::vector<VEC_I> dependentColGroups;
+
+        bool isValid() const
+        {
+            return !rows.empty();
+        }
+        void clear();
+        void setEchelonForm(const Eigen::MatrixXd& R, int rank, const VEC_I& colsOrder);
+        // returns false if the row is linearly dependent on the rows of the echelon form
+        bool appendRow(const SparseRow& row);
+        void updateDependentCols();
+    };
+    DiagnosisCache diagnosisCache;
+
+    bool diagnoseIncrementally(const Eigen::MatrixXd& J, int rowsNum, const VEC_pD& pdiagnoselist);
+    void updateDiagnosisCache(const Eigen::MatrixXd& J, int rowsNum, const VEC_pD& pdiagnoselist);
+
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     void extractSubsystem(SubSystem* subsys, bool isRedundantsolving);
 #endif
@@ -241,6 +298,13 @@ public:
     QRAlgorithm qrAlgorithm;
     bool autoChooseAlgorithm;
     int autoQRThreshold;
+    int autoSparseThreshold;  // subsystems with at least this number of parameters are solved
+                              // with a sparse Jacobian by LM and DogLeg
+    int autoParallelThreshold;  // decoupled components are solved in parallel if the system has
+                                // at least this number of unknown parameters
+    bool incrementalDiagnosis;  // if true the diagnosis is updated when only constraints were added
+    bool batchedEvaluation;     // if true constraints of the same type are evaluated together,
+                                // see ConstraintBatch
     DogLegGaussStep dogLegGaussStep;
     double qrpivotThreshold;
     DebugMode debugMode;
@@ -608,6 +672,18 @@ public:
     void declareDrivenParams(VEC_pD& params);
     void initSolution(Algorithm alg = DogLeg);
 
+    /** Creates a copy of the system that can be solved in another thread while this system is
+     * used further. The copy holds its own unknowns, copies of the driving constraints and the
+     * diagnosis of this system. All other parameters are shared and must not be changed while
+     * the copy is solved. initSolution() must be called on the copy before solving it.
+     */
+    std::unique_ptr<System> copyForSolving() const;
+    // a running solver gives up as soon as the flag is set
+    void setCancelFlag(const std::atomic<bool>* flag)
+    {
+        cancelFlag = flag;
+    }
+
     int solve(bool isFine = true, Algorithm alg = DogLeg, bool isRedundantsolving = false);
     int solve(VEC_pD& params, bool isFine = true, Algorithm alg = DogLeg, bool isRedundantsolving = false);
     int solve(
@@ -618,7 +694,15 @@ public:
     );
     int solve(SubSystem* subsysA, SubSystem* subsysB, bool isFine = true, bool isRedundantsolving = false);
 
+    /** Restricts solve() to the decoupled components that contain a constraint tagged with
+     * \a tagId, e.g. the components affected by the temporary constraints of a drag operation.
+     * The other components keep their reference values. initSolution() removes the restriction.
+     */
+    void restrictToComponentsWithTag(int tagId);
+
     void applySolution();
+    // applies the solution of a copy made by copyForSolving() to the unknowns of this system
+    void applySolution(System& copy);
     void evaluateDrivenConstraints();
 
     void undoSolution();
@@ -662,6 +746,14 @@ public:
         return emptyDiagnoseMatrix;
     }
 
+    /** The results of the last solve() for each decoupled component, components that were not
+     * solved because of restrictToComponentsWithTag() are reported as -1.
+     */
+    void getComponentResults(VEC_I& componentResultsOut) const
+    {
+        componentResultsOut = componentResults;
+    }
+
     bool hasConflicting() const
     {
         return !(hasDiagnosis && conflictingTags.empty());
@@ -26,8 +26,10 @@
 # pragma warning(disable : 4251)
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <set>
 
 #include "SubSystem.h"
 
@@ -41,12 +43,27 @@ SubSystem::SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params)
 {
     MAP_pD_pD dummymap;
     initialize(params, dummymap);
+    initializeBatches();
 }
 
-SubSystem::SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params, MAP_pD_pD& reductionmap)
+SubSystem::SubSystem(
+    std::vector<Constraint*>& clist_,
+    VEC_pD& params,
+    MAP_pD_pD& reductionmap,
+    bool batchConstraints
+)
     : clist(clist_)
 {
     initialize(params, reductionmap);
+    if (batchConstraints) {
+        initializeBatches();
+    }
+    else {
+        batched.assign(csize, false);
+        for (int i = 0; i < csize; i++) {
+            unbatchedRows.push_back(i);
+        }
+    }
 }
 
 SubSystem::~SubSystem()
@@ -112,26 +129,138 @@ void SubSystem::initialize(VEC_pD& params, MAP_pD_pD& reductionmap)
         pmap[itr->first] = &pvals[itr->second];
     }
 
-    c2p.clear();
-    p2c.clear();
+    c2pStart.assign(1, 0);
+    c2pIndex.clear();
+    p2cStart.assign(psize + 1, 0);
     for (std::vector<Constraint*>::iterator constr = clist.begin(); constr != clist.end(); ++constr) {
         (*constr)->revertParams();  // ensure that the constraint points to the original parameters
         VEC_pD constr_params_orig = (*constr)->params();
-        SET_pD constr_params;
+        std::set<int> constr_params;
         for (VEC_pD::const_iterator p = constr_params_orig.begin(); p != constr_params_orig.end();
              ++p) {
             MAP_pD_pD::const_iterator pmapfind = pmap.find(*p);
             if (pmapfind != pmap.end()) {
-                constr_params.insert(pmapfind->second);
+                constr_params.insert(static_cast<int>(pmapfind->second - pvals.data()));
             }
         }
-        for (SET_pD::const_iterator p = constr_params.begin(); p != constr_params.end(); ++p) {
-            //            jacobi.set(*constr, *p, 0.);
-            c2p[*constr].push_back(*p);
-            p2c[*p].push_back(*constr);
+        for (int j : constr_params) {
+            c2pIndex.push_back(j);
+            p2cStart[j + 1]++;
         }
+        c2pStart.push_back(static_cast<int>(c2pIndex.size()));
         //        (*constr)->redirectParams(pmap); // redirect parameters to pvec
     }
+
+    // transpose the adjacency
+    for (int j = 0; j < psize; j++) {
+        p2cStart[j + 1] += p2cStart[j];
+    }
+    p2cIndex.resize(c2pIndex.size());
+    std::vector<int> pos(p2cStart.begin(), p2cStart.end() - 1);
+    for (int i = 0; i < csize; i++) {
+        for (int k = c2pStart[i]; k < c2pStart[i + 1]; k++) {
+            p2cIndex[pos[c2pIndex[k]]++] = i;
+        }
+    }
+}
+
+void SubSystem::initializeBatches()
+{
+    batches.clear();
+    batched.assign(csize, false);
+    unbatchedRows.clear();
+    std::map<ConstraintType, std::size_t> batchIndex;
+    for (int i = 0; i < csize; i++) {
+        Constraint* constr = clist[i];
+        ConstraintType type = constr->getTypeId();
+        if (!ConstraintBatch::isSupported(type)) {
+            unbatchedRows.push_back(i);
+            continue;
+        }
+
+        auto it = batchIndex.find(type);
+        if (it == batchIndex.end()) {
+            it = batchIndex.emplace(type, batches.size()).first;
+            batches.emplace_back(type);
+        }
+        Batch& batch = batches[it->second];
+        if (!batch.constraints.add(constr)) {
+            unbatchedRows.push_back(i);
+            continue;
+        }
+
+        batched[i] = true;
+        batch.rows.push_back(i);
+        std::set<int> positions;
+        bool shared = false;
+        constr->revertParams();  // ensure that the constraint points to the original parameters
+        for (double* param : constr->params()) {
+            int pos = -1;
+            MAP_pD_pD::const_iterator pmapfind = pmap.find(param);
+            if (pmapfind != pmap.end()) {
+                int index = static_cast<int>(pmapfind->second - pvals.data());
+                for (int k = c2pStart[i]; k < c2pStart[i + 1]; k++) {
+                    if (c2pIndex[k] == index) {
+                        pos = k;
+                        break;
+                    }
+                }
+                shared = shared || !positions.insert(pos).second;
+            }
+            batch.gradPos.push_back(pos);
+        }
+        batch.sharedPos.push_back(shared);
+    }
+
+    for (Batch& batch : batches) {
+        batch.constraints.update();
+    }
+    batchErrors.assign(csize, 0.);
+    batchGrads.assign(c2pIndex.size(), 0.);
+}
+
+void SubSystem::evaluateBatches(double* errors, double* grads)
+{
+    for (Batch& batch : batches) {
+        const ConstraintBatch& constraints = batch.constraints;
+        batch.constraints.evaluate(grads != nullptr);
+        if (errors) {
+            for (std::size_t i = 0; i < batch.rows.size(); i++) {
+                errors[batch.rows[i]] = constraints.error(i);
+            }
+        }
+        if (!grads) {
+            continue;
+        }
+
+        int nparams = constraints.paramsNum();
+        for (std::size_t i = 0; i < batch.rows.size(); i++) {
+            const int* gradPos = &batch.gradPos[i * nparams];
+            double scale = constraints.getScale(i);
+            if (!batch.sharedPos[i]) {
+                for (int k = 0; k < nparams; k++) {
+                    if (gradPos[k] >= 0) {
+                        grads[gradPos[k]] = scale * constraints.derivative(i, k);
+                    }
+                }
+                continue;
+            }
+
+            // parameters redirected to the same value add up, as in Constraint::grad()
+            int row = batch.rows[i];
+            for (int k = c2pStart[row]; k < c2pStart[row + 1]; k++) {
+                grads[k] = 0.;
+            }
+            for (int k = 0; k < nparams; k++) {
+                if (gradPos[k] >= 0) {
+                    grads[gradPos[k]] += constraints.derivative(i, k);
+                }
+            }
+            for (int k = c2pStart[row]; k < c2pStart[row + 1]; k++) {
+                grads[k] *= scale;
+            }
+        }
+    }
 }
 
 void SubSystem::redirectParams()
@@ -146,6 +275,9 @@ void SubSystem::redirectParams()
         (*constr)->revertParams();  // this line will normally not be necessary
         (*constr)->redirectParams(pmap);
     }
+    for (Batch& batch : batches) {
+        batch.constraints.update();
+    }
 }
 
 void SubSystem::revertParams()
@@ -153,6 +285,9 @@ void SubSystem::revertParams()
     for (std::vector<Constraint*>::iterator constr = clist.begin(); constr != clist.end(); ++constr) {
         (*constr)->revertParams();
     }
+    for (Batch& batch : batches) {
+        batch.constraints.update();
+    }
 }
 
 void SubSystem::getParamMap(MAP_pD_pD& pmapOut)
@@ -216,10 +351,11 @@ void SubSystem::getConstraintList(std::vector<Constraint*>& clist_)
 
 double SubSystem::error()
 {
+    evaluateBatches(batchErrors.data(), nullptr);
+
     double err = 0.;
-    for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
-         ++constr) {
-        double tmp = (*constr)->error();
+    for (int i = 0; i < csize; i++) {
+        double tmp = batched[i] ? batchErrors[i] : clist[i]->error();
         err += tmp * tmp;
     }
     err *= 0.5;
@@ -230,22 +366,18 @@ void SubSystem::calcResidual(Eigen::VectorXd& r)
 {
     assert(r.size() == csize);
 
-    int i = 0;
-    for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
-         ++constr, i++) {
-        r[i] = (*constr)->error();
+    evaluateBatches(r.data(), nullptr);
+    for (int i : unbatchedRows) {
+        r[i] = clist[i]->error();
     }
 }
 
 void SubSystem::calcResidual(Eigen::VectorXd& r, double& err)
 {
-    assert(r.size() == csize);
+    calcResidual(r);
 
-    int i = 0;
     err = 0.;
-    for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
-         ++constr, i++) {
-        r[i] = (*constr)->error();
+    for (int i = 0; i < csize; i++) {
         err += r[i] * r[i];
     }
     err *= 0.5;
@@ -266,7 +398,35 @@ void SubSystem::calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi)
 
 void SubSystem::calcJacobi(Eigen::MatrixXd& jacobi)
 {
-    calcJacobi(plist, jacobi);
+    evaluateBatches(nullptr, batchGrads.data());
+    jacobi.setZero(csize, psize);
+    for (int i = 0; i < csize; i++) {
+        for (int k = c2pStart[i]; k < c2pStart[i + 1]; k++) {
+            jacobi(i, c2pIndex[k]) =
+                batched[i] ? batchGrads[k] : clist[i]->grad(&pvals[c2pIndex[k]]);
+        }
+    }
+}
+
+void SubSystem::calcJacobi(SparseJacobian& jacobi)
+{
+    // the sparsity pattern is the adjacency, so it can be copied as it is
+    Eigen::Index nonZeros = Eigen::Index(c2pIndex.size());
+    if (jacobi.rows() != csize || jacobi.cols() != psize || jacobi.nonZeros() != nonZeros
+        || !jacobi.isCompressed()) {
+        jacobi.resize(csize, psize);
+        jacobi.resizeNonZeros(nonZeros);
+        std::copy(c2pStart.begin(), c2pStart.end(), jacobi.outerIndexPtr());
+        std::copy(c2pIndex.begin(), c2pIndex.end(), jacobi.innerIndexPtr());
+    }
+
+    double* values = jacobi.valuePtr();
+    evaluateBatches(nullptr, values);
+    for (int i : unbatchedRows) {
+        for (int k = c2pStart[i]; k < c2pStart[i + 1]; k++) {
+            values[k] = clist[i]->grad(&pvals[c2pIndex[k]]);
+        }
+    }
 }
 
 void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
@@ -277,11 +437,10 @@ void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
     for (int j = 0; j < int(params.size()); j++) {
         MAP_pD_pD::const_iterator pmapfind = pmap.find(params[j]);
         if (pmapfind != pmap.end()) {
-            std::vector<Constraint*> constrs = p2c[pmapfind->second];
-            for (std::vector<Constraint*>::const_iterator constr = constrs.begin();
-                 constr != constrs.end();
-                 ++constr) {
-                grad[j] += (*constr)->error() * (*constr)->grad(pmapfind->second);
+            int index = static_cast<int>(pmapfind->second - pvals.data());
+            for (int k = p2cStart[index]; k < p2cStart[index + 1]; k++) {
+                Constraint* constr = clist[p2cIndex[k]];
+                grad[j] += constr->error() * constr->grad(pmapfind->second);
             }
         }
     }
@@ -289,7 +448,24 @@ void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
 
 void SubSystem::calcGrad(Eigen::VectorXd& grad)
 {
-    calcGrad(plist, grad);
+    assert(grad.size() == psize);
+
+    // evaluate each constraint only once
+    evaluateBatches(batchErrors.data(), batchGrads.data());
+    grad.setZero();
+    for (int i = 0; i < csize; i++) {
+        if (batched[i]) {
+            for (int k = c2pStart[i]; k < c2pStart[i + 1]; k++) {
+                grad[c2pIndex[k]] += batchErrors[i] * batchGrads[k];
+            }
+            continue;
+        }
+
+        double err = clist[i]->error();
+        for (int k = c2pStart[i]; k < c2pStart[i + 1]; k++) {
+            grad[c2pIndex[k]] += err * clist[i]->grad(&pvals[c2pIndex[k]]);
+        }
+    }
 }
 
 double SubSystem::maxStep(VEC_pD& params, Eigen::VectorXd& xdir)
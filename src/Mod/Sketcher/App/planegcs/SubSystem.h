@@ -28,6 +28,7 @@
 #undef max
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include "Constraints.h"
 
@@ -35,7 +36,9 @@
 namespace GCS
 {
 
-class SubSystem
+using SparseJacobian = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+class SketcherExport SubSystem
 {
 private:
     int psize, csize;
@@ -44,12 +47,45 @@ private:
     MAP_pD_pD pmap;  // redirection map from the original parameters to pvals
     VEC_D pvals;     // current variables vector (psize)
                      //        JacobianMatrix jacobi;  // jacobi matrix of the residuals
-    std::map<Constraint*, VEC_pD> c2p;                // constraint to parameter adjacency list
-    std::map<double*, std::vector<Constraint*>> p2c;  // parameter to constraint adjacency list
+    // constraint to parameter adjacency in compressed row storage: the constraint clist[i]
+    // depends on pvals[c2pIndex[k]] with c2pStart[i] <= k < c2pStart[i + 1]
+    std::vector<int> c2pStart;
+    std::vector<int> c2pIndex;
+    // parameter to constraint adjacency in compressed column storage: the parameter pvals[j]
+    // is used by clist[p2cIndex[k]] with p2cStart[j] <= k < p2cStart[j + 1]
+    std::vector<int> p2cStart;
+    std::vector<int> p2cIndex;
+    // the constraints of the types supported by ConstraintBatch are evaluated in batches
+    struct Batch
+    {
+        explicit Batch(ConstraintType type)
+            : constraints(type)
+        {}
+        ConstraintBatch constraints;
+        std::vector<int> rows;     // the index in clist of each constraint of the batch
+        std::vector<int> gradPos;  // the index in c2pIndex of each parameter of each constraint
+                                   // of the batch, -1 if it isn't a parameter of the subsystem
+        std::vector<bool> sharedPos;  // true if parameters of the constraint share a gradPos
+    };
+    std::vector<Batch> batches;
+    std::vector<bool> batched;  // true if clist[i] is evaluated in a batch
+    std::vector<int> unbatchedRows;
+    VEC_D batchErrors;  // scratch for the errors in clist order
+    VEC_D batchGrads;   // scratch for the gradients in c2pIndex order
     void initialize(VEC_pD& params, MAP_pD_pD& reductionmap);  // called by the constructors
+    void initializeBatches();
+    // writes the errors and the gradients (in c2pIndex order) of the batched constraints, each
+    // may be null
+    void evaluateBatches(double* errors, double* grads);
+
 public:
     SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params);
-    SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params, MAP_pD_pD& reductionmap);
+    SubSystem(
+        std::vector<Constraint*>& clist_,
+        VEC_pD& params,
+        MAP_pD_pD& reductionmap,
+        bool batchConstraints = true
+    );
     ~SubSystem();
 
     int pSize()
@@ -79,6 +115,7 @@ public:
     void calcResidual(Eigen::VectorXd& r, double& err);
     void calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi);
     void calcJacobi(Eigen::MatrixXd& jacobi);
+    void calcJacobi(SparseJacobian& jacobi);
     void calcGrad(VEC_pD& params, Eigen::VectorXd& grad);
     void calcGrad(Eigen::VectorXd& grad);
 
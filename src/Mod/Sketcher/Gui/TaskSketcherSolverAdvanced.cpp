@@ -48,6 +48,8 @@
 #define QR_PIVOT_THRESHOLD 1E-13  // under this value a Jacobian value is regarded as zero
 #define DEFAULT_SOLVER_DEBUG 1    // None=0, Minimal=1, IterationLevel=2
 #define MAX_ITER_MULTIPLIER false
+#define CONCURRENT_FALLBACK false
+#define AUTO_SPARSE_THRESHOLD 1000  // minimum number of parameters for a sparse Jacobian
 #define DEFAULT_DOGLEG_GAUSS_STEP 0  // FullPivLU = 0, LeastNormFullPivLU = 1, LeastNormLdlt = 2
 
 using namespace SketcherGui;
@@ -69,9 +71,11 @@ TaskSketcherSolverAdvanced::TaskSketcherSolverAdvanced(ViewProviderSketch* sketc
     ui->comboBoxDogLegGaussStep->onRestore();
     ui->spinBoxMaxIter->onRestore();
     ui->checkBoxSketchSizeMultiplier->onRestore();
+    ui->checkBoxConcurrentFallback->onRestore();
     ui->lineEditConvergence->onRestore();
     ui->comboBoxQRMethod->onRestore();
     ui->spinBoxAutoQRThreshold->onRestore();
+    ui->spinBoxAutoSparseThreshold->onRestore();
     ui->checkBoxAutoChooseAlgo->onRestore();
     ui->lineEditQRPivotThreshold->onRestore();
     ui->comboBoxRedundantDefaultSolver->onRestore();
@@ -118,6 +122,12 @@ void TaskSketcherSolverAdvanced::setupConnections()
         this,
         &TaskSketcherSolverAdvanced::onSpinBoxAutoQRAlgoChanged
     );
+    connect(
+        ui->spinBoxAutoSparseThreshold,
+        qOverload<int>(&QSpinBox::valueChanged),
+        this,
+        &TaskSketcherSolverAdvanced::onSpinBoxAutoSparseThresholdChanged
+    );
 #if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
     connect(
         ui->checkBoxAutoChooseAlgo,
@@ -147,6 +157,21 @@ void TaskSketcherSolverAdvanced::setupConnections()
         this,
         &TaskSketcherSolverAdvanced::onCheckBoxSketchSizeMultiplierStateChanged
     );
+#endif
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+    connect(
+        ui->checkBoxConcurrentFallback,
+        &QCheckBox::checkStateChanged,
+        this,
+        &TaskSketcherSolverAdvanced::onCheckBoxConcurrentFallbackStateChanged
+    );
+#else
+    connect(
+        ui->checkBoxConcurrentFallback,
+        &QCheckBox::stateChanged,
+        this,
+        &TaskSketcherSolverAdvanced::onCheckBoxConcurrentFallbackStateChanged
+    );
 #endif
     connect(
         ui->lineEditConvergence,
@@ -673,6 +698,13 @@ void TaskSketcherSolverAdvanced::onSpinBoxAutoQRAlgoChanged(int i)
         .setAutoQRThreshold(i);
 }
 
+void TaskSketcherSolverAdvanced::onSpinBoxAutoSparseThresholdChanged(int i)
+{
+    ui->spinBoxAutoSparseThreshold->onSave();
+    const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
+        .setAutoSparseThreshold(i);
+}
+
 void TaskSketcherSolverAdvanced::onCheckBoxAutoQRAlgoStateChanged(int state)
 {
     if (state == Qt::Checked) {
@@ -709,6 +741,13 @@ void TaskSketcherSolverAdvanced::onCheckBoxSketchSizeMultiplierStateChanged(int
     }
 }
 
+void TaskSketcherSolverAdvanced::onCheckBoxConcurrentFallbackStateChanged(int state)
+{
+    ui->checkBoxConcurrentFallback->onSave();
+    const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
+        .setConcurrentFallback(state == Qt::Checked);
+}
+
 void TaskSketcherSolverAdvanced::onLineEditQRPivotThresholdEditingFinished()
 {
     QString text = ui->lineEditQRPivotThreshold->text();
@@ -830,9 +869,11 @@ void TaskSketcherSolverAdvanced::onPushButtonDefaultsClicked(bool checked /* = f
     hGrp->SetInt("RedundantSolverMaxIterations", MAX_ITER);
     hGrp->SetBool("SketchSizeMultiplier", MAX_ITER_MULTIPLIER);
     hGrp->SetBool("RedundantSketchSizeMultiplier", MAX_ITER_MULTIPLIER);
+    hGrp->SetBool("ConcurrentFallback", CONCURRENT_FALLBACK);
     hGrp->SetASCII("Convergence", QString::number(CONVERGENCE).toUtf8());
     hGrp->SetASCII("RedundantConvergence", QString::number(CONVERGENCE).toUtf8());
     hGrp->SetInt("QRMethod", DEFAULT_QRSOLVER);
+    hGrp->SetInt("AutoSparseThreshold", AUTO_SPARSE_THRESHOLD);
     hGrp->SetASCII("QRPivotThreshold", QString::number(QR_PIVOT_THRESHOLD).toUtf8());
     hGrp->SetInt("DebugMode", DEFAULT_SOLVER_DEBUG);
 
@@ -840,9 +881,11 @@ void TaskSketcherSolverAdvanced::onPushButtonDefaultsClicked(bool checked /* = f
     ui->comboBoxDogLegGaussStep->onRestore();
     ui->spinBoxMaxIter->onRestore();
     ui->checkBoxSketchSizeMultiplier->onRestore();
+    ui->checkBoxConcurrentFallback->onRestore();
     ui->lineEditConvergence->onRestore();
     ui->comboBoxQRMethod->onRestore();
     ui->spinBoxAutoQRThreshold->onRestore();
+    ui->spinBoxAutoSparseThreshold->onRestore();
     ui->checkBoxAutoChooseAlgo->onRestore();
     ui->lineEditQRPivotThreshold->onRestore();
     ui->comboBoxRedundantDefaultSolver->onRestore();
@@ -866,11 +909,13 @@ void TaskSketcherSolverAdvanced::updateSketchObject()
     );
     sketch.setQRAlgorithm((GCS::QRAlgorithm)ui->comboBoxQRMethod->currentIndex());
     sketch.setAutoQRThreshold(ui->spinBoxAutoQRThreshold->value());
+    sketch.setAutoSparseThreshold(ui->spinBoxAutoSparseThreshold->value());
     sketch.setSketchAutoAlgo(ui->checkBoxAutoChooseAlgo->isChecked());
     sketch.setQRPivotThreshold(ui->lineEditQRPivotThreshold->text().toDouble());
     sketch.setConvergenceRedundant(ui->lineEditRedundantConvergence->text().toDouble());
     sketch.setConvergence(ui->lineEditConvergence->text().toDouble());
     sketch.setSketchSizeMultiplier(ui->checkBoxSketchSizeMultiplier->isChecked());
+    sketch.setConcurrentFallback(ui->checkBoxConcurrentFallback->isChecked());
     sketch.setMaxIter(ui->spinBoxMaxIter->value());
     sketch.defaultSolver = static_cast<GCS::Algorithm>(ui->comboBoxDefaultSolver->currentIndex());
     sketch.setDogLegGaussStep((GCS::DogLegGaussStep)ui->comboBoxDogLegGaussStep->currentIndex());
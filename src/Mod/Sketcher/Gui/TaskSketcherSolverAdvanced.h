@@ -53,8 +53,10 @@ private:
     void onComboBoxDogLegGaussStepCurrentIndexChanged(int index);
     void onSpinBoxMaxIterValueChanged(int i);
     void onSpinBoxAutoQRAlgoChanged(int i);
+    void onSpinBoxAutoSparseThresholdChanged(int i);
     void onCheckBoxAutoQRAlgoStateChanged(int state);
     void onCheckBoxSketchSizeMultiplierStateChanged(int state);
+    void onCheckBoxConcurrentFallbackStateChanged(int state);
     void onLineEditConvergenceEditingFinished();
     void onComboBoxQRMethodCurrentIndexChanged(int index);
     void onLineEditQRPivotThresholdEditingFinished();
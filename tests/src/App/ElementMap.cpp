@@ -265,6 +265,52 @@ TEST_F(ElementMapTest, findMappedName)
     EXPECT_EQ(findResult2, element2);
 }
 
+TEST_F(ElementMapTest, findMappedNameSplitIntoPostfix)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    Data::IndexedName element("Edge", 1);
+    Data::MappedName mappedName(Data::MappedName("TEST"), ";POSTFIX");
+    elementMap.setElementName(element, mappedName, 0);
+
+    // Act
+    auto findResult = elementMap.find(Data::MappedName("TEST;POSTFIX"));
+    auto findResult2 = elementMap.find(Data::MappedName(Data::MappedName("TEST;POST"), "FIX"));
+
+    // Assert
+    EXPECT_EQ(findResult, element);
+    EXPECT_EQ(findResult2, element);
+}
+
+TEST_F(ElementMapTest, findAndEraseManyNames)
+{
+    // Arrange
+    const int count {1000};
+    Data::ElementMap elementMap;
+    for (int i = 1; i <= count; ++i) {
+        auto index = std::to_string(i);
+        elementMap.setElementName(Data::IndexedName("Edge", i), Data::MappedName("E" + index), 0);
+        elementMap.setElementName(Data::IndexedName("Face", i), Data::MappedName("F" + index), 0);
+    }
+
+    // Act
+    for (int i = 1; i <= count; i += 2) {
+        elementMap.erase(Data::MappedName("E" + std::to_string(i)));
+        elementMap.erase(Data::IndexedName("Face", i));
+    }
+
+    // Assert
+    EXPECT_EQ(elementMap.size(), count);
+    for (int i = 1; i <= count; ++i) {
+        auto index = std::to_string(i);
+        bool erased = i % 2 == 1;
+        EXPECT_EQ(elementMap.find(Data::MappedName("E" + index)),
+                  erased ? Data::IndexedName() : Data::IndexedName("Edge", i));
+        EXPECT_EQ(elementMap.find(Data::MappedName("F" + index)),
+                  erased ? Data::IndexedName() : Data::IndexedName("Face", i));
+    }
+}
+
 TEST_F(ElementMapTest, findIndexedName)
 {
     // Arrange
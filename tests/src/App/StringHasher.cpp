@@ -9,6 +9,8 @@
 
 #include <QCryptographicHash>
 #include <array>
+#include <thread>
+#include <vector>
 
 class StringIDTest: public ::testing::Test
 {
@@ -1474,6 +1476,33 @@ TEST_F(StringHasherTest, getIDFromIntegerIDBadID)  // NOLINT
 }
 
 
+TEST_F(StringHasherTest, getIDFromMultipleThreads)  // NOLINT
+{
+    // Arrange
+    const int numNames {1000};
+    const int numThreads {4};
+    std::vector<std::vector<long>> ids(numThreads, std::vector<long>(numNames));
+
+    // Act
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < numThreads; ++thread) {
+        threads.emplace_back([this, thread, &ids] {
+            for (int i = 0; i < numNames; ++i) {
+                auto name = givenMappedName("Face", (";:M;FUS;:H" + std::to_string(i)).c_str());
+                ids[thread][i] = Hasher()->getID(name, QVector<App::StringIDRef>()).value();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Assert
+    for (int thread = 1; thread < numThreads; ++thread) {
+        EXPECT_EQ(ids[0], ids[thread]);
+    }
+}
+
 TEST_F(StringHasherTest, getIDMap)  // NOLINT
 {
     // Arrange
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Boolean.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshBooleanTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+
+    void TearDown() override
+    {}
+
+    // closed, outward oriented box of 12 facets
+    static MeshCore::MeshKernel createBox(const Base::Vector3f& min, const Base::Vector3f& max)
+    {
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i < 8; i++) {
+            points.emplace_back(
+                (i & 1) ? max.x : min.x,
+                (i & 2) ? max.y : min.y,
+                (i & 4) ? max.z : min.z
+            );
+        }
+
+        MeshCore::MeshFacetArray facets;
+        const int quads[6][4] = {
+            {0, 2, 3, 1},  // bottom
+            {4, 5, 7, 6},  // top
+            {0, 1, 5, 4},  // front
+            {2, 6, 7, 3},  // back
+            {0, 4, 6, 2},  // left
+            {1, 3, 7, 5}   // right
+        };
+        for (const auto& quad : quads) {
+            facets.emplace_back(quad[0], quad[1], quad[2]);
+            facets.emplace_back(quad[0], quad[2], quad[3]);
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    static MeshCore::MeshKernel compute(
+        const MeshCore::MeshKernel& mesh1,
+        const MeshCore::MeshKernel& mesh2,
+        MeshCore::SetOperations::OperationType type
+    )
+    {
+        MeshCore::MeshKernel result;
+        MeshCore::MeshBoolean boolean(mesh1, mesh2, result, type);
+        boolean.Do();
+        return result;
+    }
+};
+
+TEST_F(MeshBooleanTest, TestOverlappingBoxes)
+{
+    MeshCore::MeshKernel box1 = createBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        createBox(Base::Vector3f(0.5F, 0.5F, 0.5F), Base::Vector3f(1.5F, 1.5F, 1.5F));
+
+    MeshCore::MeshKernel result = compute(box1, box2, MeshCore::SetOperations::Union);
+    EXPECT_TRUE(MeshCore::MeshEvalSolid(result).Evaluate());
+    EXPECT_TRUE(MeshCore::MeshEvalOrientation(result).Evaluate());
+    EXPECT_NEAR(result.GetVolume(), 1.875F, 1e-5F);
+
+    result = compute(box1, box2, MeshCore::SetOperations::Intersect);
+    EXPECT_TRUE(MeshCore::MeshEvalSolid(result).Evaluate());
+    EXPECT_NEAR(result.GetVolume(), 0.125F, 1e-5F);
+
+    result = compute(box1, box2, MeshCore::SetOperations::Difference);
+    EXPECT_TRUE(MeshCore::MeshEvalSolid(result).Evaluate());
+    EXPECT_TRUE(MeshCore::MeshEvalOrientation(result).Evaluate());
+    EXPECT_NEAR(result.GetVolume(), 0.875F, 1e-5F);
+}
+
+TEST_F(MeshBooleanTest, TestCoplanarBoxes)
+{
+    // four faces of the boxes are coplanar
+    MeshCore::MeshKernel box1 = createBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 = createBox(Base::Vector3f(0.5F, 0, 0), Base::Vector3f(1.5F, 1, 1));
+
+    MeshCore::MeshKernel result = compute(box1, box2, MeshCore::SetOperations::Union);
+    EXPECT_TRUE(MeshCore::MeshEvalSolid(result).Evaluate());
+    EXPECT_NEAR(result.GetVolume(), 1.5F, 1e-5F);
+
+    result = compute(box1, box2, MeshCore::SetOperations::Intersect);
+    EXPECT_TRUE(MeshCore::MeshEvalSolid(result).Evaluate());
+    EXPECT_NEAR(result.GetVolume(), 0.5F, 1e-5F);
+
+    result = compute(box1, box2, MeshCore::SetOperations::Difference);
+    EXPECT_TRUE(MeshCore::MeshEvalSolid(result).Evaluate());
+    EXPECT_NEAR(result.GetVolume(), 0.5F, 1e-5F);
+}
+
+TEST_F(MeshBooleanTest, TestDisjointBoxes)
+{
+    MeshCore::MeshKernel box1 = createBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 = createBox(Base::Vector3f(2, 0, 0), Base::Vector3f(3, 1, 1));
+    MeshCore::MeshKernel box3 =
+        createBox(Base::Vector3f(0.25F, 0.25F, 0.25F), Base::Vector3f(0.75F, 0.75F, 0.75F));
+
+    MeshCore::MeshKernel result = compute(box1, box2, MeshCore::SetOperations::Union);
+    EXPECT_EQ(result.CountFacets(), 24);
+
+    result = compute(box1, box2, MeshCore::SetOperations::Intersect);
+    EXPECT_EQ(result.CountFacets(), 0);
+
+    // box3 is completely inside box1
+    result = compute(box1, box3, MeshCore::SetOperations::Difference);
+    EXPECT_EQ(result.CountFacets(), 24);
+    EXPECT_NEAR(result.GetVolume(), 1.0F - 0.125F, 1e-5F);
+}
+
+TEST_F(MeshBooleanTest, TestThreads)
+{
+    MeshCore::MeshKernel box1 = createBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        createBox(Base::Vector3f(0.3F, -0.2F, 0.4F), Base::Vector3f(0.8F, 1.3F, 1.1F));
+
+    MeshCore::MeshKernel result1;
+    MeshCore::MeshBoolean boolean1(box1, box2, result1, MeshCore::SetOperations::Difference);
+    boolean1.SetThreads(1);
+    boolean1.Do();
+
+    MeshCore::MeshKernel result2;
+    MeshCore::MeshBoolean boolean2(box1, box2, result2, MeshCore::SetOperations::Difference);
+    boolean2.SetThreads(4);
+    boolean2.Do();
+
+    EXPECT_GT(boolean1.CountIntersections(), 0);
+    EXPECT_EQ(boolean1.CountIntersections(), boolean2.CountIntersections());
+    EXPECT_EQ(result1.CountFacets(), result2.CountFacets());
+    EXPECT_TRUE(MeshCore::MeshEvalSolid(result1).Evaluate());
+    EXPECT_NEAR(result1.GetVolume(), 1.0F - 0.5F * 0.6F, 1e-5F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
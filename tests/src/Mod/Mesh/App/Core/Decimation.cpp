@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshQuadricDecimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // planar grid of 2 * size * size facets
+        const int size = 20;
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (int j = 0; j <= size; j++) {
+            for (int i = 0; i <= size; i++) {
+                points.emplace_back(float(i), float(j), 0.F);
+            }
+        }
+        for (int j = 0; j < size; j++) {
+            for (int i = 0; i < size; i++) {
+                MeshCore::PointIndex p = j * (size + 1) + i;
+                facets.emplace_back(p, p + 1, p + size + 1);
+                facets.emplace_back(p + size + 1, p + 1, p + size + 2);
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(MeshQuadricDecimationTest, TestTargetSize)
+{
+    MeshCore::MeshQuadricDecimation decimation(kernel);
+    MeshCore::MeshQuadricDecimation::Parameters param;
+    param.targetSize = 100;
+    decimation.Decimate(param);
+
+    EXPECT_LE(kernel.CountFacets(), 101);
+    EXPECT_TRUE(MeshCore::MeshEvalDefects(kernel).Evaluate());
+
+    // the boundary is preserved
+    Base::BoundBox3f box = kernel.GetBoundBox();
+    EXPECT_FLOAT_EQ(box.MinX, 0.F);
+    EXPECT_FLOAT_EQ(box.MaxX, 20.F);
+    EXPECT_FLOAT_EQ(box.MinY, 0.F);
+    EXPECT_FLOAT_EQ(box.MaxY, 20.F);
+}
+
+TEST_F(MeshQuadricDecimationTest, TestMaxError)
+{
+    MeshCore::MeshQuadricDecimation decimation(kernel);
+    MeshCore::MeshQuadricDecimation::Parameters param;
+    param.maxError = 0.0;
+    param.maxDistance = 0.0;
+    EXPECT_EQ(decimation.Decimate(param), 0);
+    EXPECT_EQ(kernel.CountFacets(), 800);
+}
+
+TEST_F(MeshQuadricDecimationTest, TestOnlyMaxError)
+{
+    // bend the upper half of the grid to a paraboloid where every collapse has a positive error
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    MeshCore::MeshFacetArray facets = kernel.GetFacets();
+    for (auto& point : points) {
+        if (point.y > 10.F) {
+            float dx = point.x - 10.F;
+            float dy = point.y - 10.F;
+            point.z = 0.05F * (dx * dx + dy * dy);
+        }
+    }
+    kernel.Adopt(points, facets, false);
+
+    // neither the target size nor the distance limit stops the decimation
+    MeshCore::MeshQuadricDecimation decimation(kernel);
+    MeshCore::MeshQuadricDecimation::Parameters param;
+    param.maxError = 1e-6;
+    EXPECT_GT(decimation.Decimate(param), 0);
+    EXPECT_TRUE(MeshCore::MeshEvalDefects(kernel).Evaluate());
+
+    // only the planar half is decimated
+    std::size_t curved = 0;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        if (kernel.GetFacet(i).GetGravityPoint().y > 10.F) {
+            curved++;
+        }
+    }
+    EXPECT_EQ(curved, 400);
+    EXPECT_LT(kernel.CountFacets(), 800);
+}
+
+TEST_F(MeshQuadricDecimationTest, TestSegments)
+{
+    std::vector<MeshCore::FacetIndex> lower;
+    for (MeshCore::FacetIndex i = 0; i < 400; i++) {
+        lower.push_back(i);
+    }
+
+    MeshCore::MeshQuadricDecimation decimation(kernel);
+    decimation.SetSegments({lower});
+    MeshCore::MeshQuadricDecimation::Parameters param;
+    param.targetSize = 100;
+    decimation.Decimate(param);
+
+    // the segment border at y = 10 is kept
+    std::vector<std::vector<MeshCore::FacetIndex>> segments = decimation.GetSegments();
+    ASSERT_EQ(segments.size(), 1);
+    EXPECT_FALSE(segments[0].empty());
+    for (MeshCore::FacetIndex index : segments[0]) {
+        EXPECT_LE(kernel.GetFacet(index).GetGravityPoint().y, 10.F);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
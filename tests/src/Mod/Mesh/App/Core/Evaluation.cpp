@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshEvalDefectsTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        points.emplace_back(0.F, 0.F, 0.F);
+        points.emplace_back(1.F, 0.F, 0.F);
+        points.emplace_back(0.F, 1.F, 0.F);
+        points.emplace_back(1.F, 1.F, 0.F);
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+};
+
+TEST_F(MeshEvalDefectsTest, TestValidMesh)
+{
+    facets.emplace_back(0, 1, 2);
+    facets.emplace_back(2, 1, 3);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshEvalDefects eval(kernel);
+    EXPECT_TRUE(eval.Evaluate());
+    EXPECT_TRUE(eval.GetReport().IsValid());
+}
+
+TEST_F(MeshEvalDefectsTest, TestDuplicatedFacets)
+{
+    facets.emplace_back(0, 1, 2);
+    facets.emplace_back(2, 1, 3);
+    facets.emplace_back(1, 2, 0);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshEvalDefects eval(kernel);
+    eval.SetChecks(MeshCore::MeshEvalDefects::DuplicatedFacets);
+    EXPECT_FALSE(eval.Evaluate());
+    ASSERT_EQ(eval.GetReport().duplicatedFacets.size(), 1);
+    EXPECT_EQ(eval.GetReport().duplicatedFacets[0], 2);
+
+    MeshCore::MeshFixDefects fix(kernel, eval.GetReport());
+    EXPECT_TRUE(fix.Fixup());
+    EXPECT_EQ(kernel.CountFacets(), 2);
+}
+
+TEST_F(MeshEvalDefectsTest, TestWrongOrientation)
+{
+    facets.emplace_back(0, 1, 2);
+    facets.emplace_back(1, 2, 3);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshEvalDefects eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+    EXPECT_EQ(eval.GetReport().wrongOrientedFacets.size(), 1);
+
+    MeshCore::MeshFixDefects fix(kernel, eval.GetReport());
+    EXPECT_TRUE(fix.Fixup());
+    EXPECT_TRUE(MeshCore::MeshEvalOrientation(kernel).Evaluate());
+}
+
+TEST_F(MeshEvalDefectsTest, TestDuplicatedPoints)
+{
+    points.emplace_back(0.F, 1.F, 0.F);
+    facets.emplace_back(0, 1, 2);
+    facets.emplace_back(4, 1, 3);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshEvalDefects eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+    ASSERT_EQ(eval.GetReport().duplicatedPoints.size(), 1);
+    EXPECT_EQ(eval.GetReport().duplicatedPoints[0], 4);
+
+    MeshCore::MeshFixDefects fix(kernel, eval.GetReport());
+    EXPECT_TRUE(fix.Fixup());
+    EXPECT_EQ(kernel.CountPoints(), 4);
+    EXPECT_EQ(kernel.CountFacets(), 2);
+    EXPECT_TRUE(MeshCore::MeshEvalDefects(kernel).Evaluate());
+}
+
+TEST_F(MeshEvalDefectsTest, TestDuplicatedFacetsOfMergedPoints)
+{
+    points.emplace_back(1.F, 0.F, 0.F);
+    facets.emplace_back(0, 1, 2);
+    facets.emplace_back(2, 1, 3);
+    facets.emplace_back(0, 4, 2);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshEvalDefects eval(kernel);
+    eval.SetChecks(
+        MeshCore::MeshEvalDefects::DuplicatedPoints | MeshCore::MeshEvalDefects::DuplicatedFacets
+    );
+    EXPECT_FALSE(eval.Evaluate());
+    EXPECT_TRUE(eval.GetReport().duplicatedFacets.empty());
+
+    MeshCore::MeshFixDefects fix(kernel, eval.GetReport());
+    EXPECT_TRUE(fix.Fixup());
+    EXPECT_EQ(kernel.CountFacets(), 2);
+    EXPECT_EQ(kernel.CountPoints(), 4);
+}
+
+TEST_F(MeshEvalDefectsTest, TestNonManifoldPoints)
+{
+    points.emplace_back(2.F, 1.F, 0.F);
+    points.emplace_back(1.F, 2.F, 0.F);
+    facets.emplace_back(0, 1, 3);
+    facets.emplace_back(3, 4, 5);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshEvalDefects eval(kernel);
+    eval.SetChecks(MeshCore::MeshEvalDefects::NonManifoldPoints);
+    EXPECT_FALSE(eval.Evaluate());
+    ASSERT_EQ(eval.GetReport().nonManifoldPoints.size(), 1);
+
+    MeshCore::MeshFixDefects fix(kernel, eval.GetReport());
+    EXPECT_TRUE(fix.Fixup());
+    EXPECT_EQ(kernel.CountFacets(), 0);
+    EXPECT_EQ(fix.GetDeletedFaces().size(), 2);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
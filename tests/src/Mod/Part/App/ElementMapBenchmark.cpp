@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Benchmark of the generation of element maps (topological naming) along feature chains like
+// the ones PartDesign builds: a pad, a pocket with a pattern of holes, fillets and a pattern of
+// bosses. Each step is timed as a plain OCC operation and as the TopoShape operation that also
+// maps the element names. The remapping of all elements of the result into a compound is timed on
+// its own in the mapped column.
+// This isn't a test and isn't run by ctest.
+//
+// Usage: Part_element_map_benchmark [maximum number of holes per row]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include <BRep_Builder.hxx>
+#include <BRepAlgoAPI_Cut.hxx>
+#include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepFilletAPI_MakeFillet.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp_Ax2.hxx>
+
+#include "src/App/InitApplication.h"
+#include <App/StringHasher.h>
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/TopoShapeOpCode.h>
+
+namespace
+{
+
+using Part::TopoShape;
+
+double measure(const std::function<void()>& func)
+{
+    auto begin = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+/// A compound of rows x rows cylinders standing on a grid over the top of the pad
+TopoDS_Shape makePattern(int rows, double size, double radius, double zmin, double height)
+{
+    BRep_Builder builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    double step = size / rows;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < rows; ++j) {
+            gp_Ax2 axis(gp_Pnt((i + 0.5) * step, (j + 0.5) * step, zmin), gp::DZ());
+            builder.Add(compound, BRepPrimAPI_MakeCylinder(axis, radius * step, height).Shape());
+        }
+    }
+    return compound;
+}
+
+/// The vertical edges at the corners of the pad
+std::vector<TopoShape> cornerEdges(const TopoShape& shape, double size)
+{
+    auto isCorner = [size](double value) {
+        return value < 1e-3 || value > size - 1e-3;
+    };
+    std::vector<TopoShape> edges;
+    for (auto& edge : shape.getSubTopoShapes(TopAbs_EDGE)) {
+        Base::BoundBox3d box = edge.getBoundBox();
+        if (box.LengthZ() > 1e-3 && isCorner(box.MinX) && isCorner(box.MinY)
+            && box.LengthX() < 1e-3 && box.LengthY() < 1e-3) {
+            edges.push_back(edge);
+        }
+    }
+    return edges;
+}
+
+struct Step
+{
+    const char* name;
+    double occ {0.};
+    double mapped {0.};
+};
+
+void run(int rows)
+{
+    constexpr double size = 100.0;
+    App::StringHasherRef hasher(new App::StringHasher);
+    long tag = 0;
+
+    std::vector<Step> steps;
+    TopoDS_Shape pad = BRepPrimAPI_MakeBox(size, size, 10.0).Shape();
+    TopoShape mappedPad(pad, ++tag, hasher);
+
+    // pocket with a pattern of holes
+    TopoDS_Shape holes = makePattern(rows, size, 0.2, -1.0, 12.0);
+    Step pocket {"pocket"};
+    TopoDS_Shape pocketed;
+    pocket.occ = measure([&] { pocketed = BRepAlgoAPI_Cut(pad, holes).Shape(); });
+    TopoShape mappedPocket(++tag, hasher);
+    pocket.mapped = measure([&] {
+        mappedPocket.makeElementBoolean(
+            Part::OpCodes::Cut,
+            {mappedPad, TopoShape(holes, ++tag, hasher)}
+        );
+    });
+    steps.push_back(pocket);
+
+    // fillets of the vertical edges of the pad
+    std::vector<TopoShape> edges = cornerEdges(TopoShape(pocketed), size);
+    Step fillet {"fillet"};
+    TopoDS_Shape filleted;
+    fillet.occ = measure([&] {
+        BRepFilletAPI_MakeFillet mk(pocketed);
+        for (const auto& edge : edges) {
+            mk.Add(2.0, TopoDS::Edge(edge.getShape()));
+        }
+        filleted = mk.Shape();
+    });
+    std::vector<TopoShape> mappedEdges = cornerEdges(mappedPocket, size);
+    TopoShape mappedFillet(++tag, hasher);
+    fillet.mapped = measure([&] {
+        mappedFillet.makeElementFillet(mappedPocket, mappedEdges, 2.0, 2.0);
+    });
+    steps.push_back(fillet);
+
+    // pad with a pattern of bosses
+    TopoDS_Shape bosses = makePattern(std::max(1, rows / 2), size, 0.15, 9.0, 5.0);
+    Step boss {"bosses"};
+    TopoDS_Shape fused;
+    boss.occ = measure([&] { fused = BRepAlgoAPI_Fuse(filleted, bosses).Shape(); });
+    TopoShape mappedBoss(++tag, hasher);
+    boss.mapped = measure([&] {
+        mappedBoss.makeElementBoolean(
+            Part::OpCodes::Fuse,
+            {mappedFillet, TopoShape(bosses, ++tag, hasher)}
+        );
+    });
+    steps.push_back(boss);
+
+    // remapping all elements of the result, e.g. when it is put into a compound
+    BRep_Builder builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    builder.Add(compound, mappedBoss.getShape());
+    TopoShape mappedCompound(compound, ++tag, hasher);
+    double remap = measure([&] { mappedCompound.mapSubElement(mappedBoss); });
+
+    int faces = mappedBoss.countSubShapes(TopAbs_FACE);
+    for (const auto& step : steps) {
+        std::printf(
+            "%6d %8d %-8s %12.1f %12.1f\n",
+            rows,
+            faces,
+            step.name,
+            step.occ,
+            step.mapped
+        );
+    }
+    std::printf("%6d %8d %-8s %12s %12.1f\n", rows, faces, "remap", "", remap);
+    std::printf(
+        "%6d %8d %-8s %zu names, %zu strings\n",
+        rows,
+        faces,
+        "result",
+        mappedBoss.getElementMapSize(),
+        hasher->size()
+    );
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int maxRows = argc > 1 ? std::max(1, std::atoi(argv[1])) : 32;
+
+    tests::initApplication();
+    std::printf(
+        "%6s %8s %-8s %12s %12s\n",
+        "rows",
+        "faces",
+        "step",
+        "occ [ms]",
+        "mapped [ms]"
+    );
+    for (int rows = 4; rows <= maxRows; rows *= 2) {
+        run(rows);
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Part/App/TessellationCache.h>
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepTools.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <gp_Trsf.hxx>
+#include <TopLoc_Location.hxx>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+class TessellationCacheTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Part::TessellationCache::instance().clear();
+        maxSize = Part::TessellationCache::instance().getMaxSize();
+    }
+
+    void TearDown() override
+    {
+        Part::TessellationCache::instance().clear();
+        Part::TessellationCache::instance().setMaxSize(maxSize);
+    }
+
+    static TopoDS_Shape makeCylinder()
+    {
+        return BRepPrimAPI_MakeCylinder(2.0, 5.0).Shape();
+    }
+
+    static void mesh(const TopoDS_Shape& shape, const Part::TessellationCache::Parameters& params)
+    {
+        BRepTools::Clean(shape);
+        BRepMesh_IncrementalMesh(shape, params.deflection, Standard_False, params.angularDeflection);
+    }
+
+private:
+    std::size_t maxSize {};
+};
+
+TEST_F(TessellationCacheTest, testContains)
+{
+    // Arrange
+    auto& cache = Part::TessellationCache::instance();
+    TopoDS_Shape shape = makeCylinder();
+    Part::TessellationCache::Parameters params {0.1, 0.5};
+
+    // Act
+    bool before = cache.contains(shape, params);
+    mesh(shape, params);
+    cache.add(shape, params);
+
+    // Assert
+    EXPECT_FALSE(before);
+    EXPECT_TRUE(cache.contains(shape, params));
+    EXPECT_TRUE(cache.contains(shape, {0.1005, 0.5}));
+    EXPECT_FALSE(cache.contains(shape, {0.2, 0.5}));
+    EXPECT_FALSE(cache.contains(shape, {0.1, 0.25}));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(TessellationCacheTest, testMovedShape)
+{
+    // Arrange
+    auto& cache = Part::TessellationCache::instance();
+    TopoDS_Shape shape = makeCylinder();
+    Part::TessellationCache::Parameters params {0.1, 0.5};
+    mesh(shape, params);
+    cache.add(shape, params);
+
+    // Act
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(10.0, 20.0, 30.0));
+    TopoDS_Shape moved = shape.Moved(TopLoc_Location(trsf));
+
+    // Assert
+    EXPECT_TRUE(cache.contains(moved, params));
+    EXPECT_FALSE(cache.contains(makeCylinder(), params));
+}
+
+TEST_F(TessellationCacheTest, testMeshedAgain)
+{
+    // Arrange
+    auto& cache = Part::TessellationCache::instance();
+    TopoDS_Shape shape = makeCylinder();
+    Part::TessellationCache::Parameters params {0.1, 0.5};
+    mesh(shape, params);
+    cache.add(shape, params);
+
+    // Act
+    mesh(shape, {0.01, 0.1});
+
+    // Assert
+    EXPECT_FALSE(cache.contains(shape, params));
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(TessellationCacheTest, testRestored)
+{
+    // Arrange
+    auto& cache = Part::TessellationCache::instance();
+    TopoDS_Shape meshed = makeCylinder();
+    TopoDS_Shape unmeshed = makeCylinder();
+    mesh(meshed, {0.1, 0.5});
+
+    // Act
+    cache.addRestored(meshed);
+    cache.addRestored(unmeshed);
+
+    // Assert
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_FALSE(cache.contains(unmeshed, {0.2, 0.3}));
+    EXPECT_TRUE(cache.contains(meshed, {0.2, 0.3}));
+    EXPECT_FALSE(cache.contains(meshed, {0.1, 0.5}));
+}
+
+TEST_F(TessellationCacheTest, testShapeWithoutFaces)
+{
+    // Arrange
+    auto& cache = Part::TessellationCache::instance();
+    TopoDS_Shape edge = BRepBuilderAPI_MakeEdge(gp_Pnt(0, 0, 0), gp_Pnt(1, 0, 0)).Edge();
+    Part::TessellationCache::Parameters params {0.1, 0.5};
+    mesh(edge, params);
+
+    // Act
+    cache.add(edge, params);
+
+    // Assert
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.contains(edge, params));
+}
+
+TEST_F(TessellationCacheTest, testPrune)
+{
+    // Arrange
+    auto& cache = Part::TessellationCache::instance();
+    cache.setMaxSize(4);
+    Part::TessellationCache::Parameters params {0.1, 0.5};
+    std::vector<TopoDS_Shape> shapes;
+    for (int i = 0; i < 4; i++) {
+        shapes.push_back(BRepPrimAPI_MakeBox(1.0 + i, 1.0, 1.0).Shape());
+        mesh(shapes.back(), params);
+        cache.add(shapes.back(), params);
+    }
+
+    // Act
+    shapes.erase(shapes.begin(), shapes.begin() + 2);
+    TopoDS_Shape shape = BRepPrimAPI_MakeBox(5.0, 1.0, 1.0).Shape();
+    mesh(shape, params);
+    cache.add(shape, params);
+
+    // Assert
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_TRUE(cache.contains(shapes[0], params));
+    EXPECT_TRUE(cache.contains(shapes[1], params));
+    EXPECT_TRUE(cache.contains(shape, params));
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include "src/App/InitApplication.h"
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Mod/Part/App/Geometry.h>
+#include <Mod/PartDesign/App/Body.h>
+#include <Mod/PartDesign/App/FeaturePad.h>
+#include <Mod/Sketcher/App/SketchObject.h>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+class LazyRecomputeTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        _doc = App::GetApplication().newDocument("LazyRecompute_test", "testUser");
+        _body = _doc->addObject<PartDesign::Body>();
+        auto sketch = _doc->addObject<Sketcher::SketchObject>("Sketch");
+        _body->addObject(sketch);
+
+        sketch->AttachmentSupport.setValue(_doc->getObject("XY_Plane"), "");
+        sketch->MapMode.setValue("FlatFace");
+        Part::GeomCircle circle;
+        circle.setRadius(10.0);
+        sketch->addGeometry(&circle, false);
+
+        // two pads of the same sketch on top of each other
+        _pad1 = _doc->addObject<PartDesign::Pad>("Pad");
+        _body->addObject(_pad1);
+        _pad1->Profile.setValue(sketch, {""});
+        _pad1->Length.setValue(10.0);
+        _pad2 = _doc->addObject<PartDesign::Pad>("Pad001");
+        _body->addObject(_pad2);
+        _pad2->Profile.setValue(sketch, {""});
+        _pad2->Length.setValue(20.0);
+        _doc->recompute();
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_doc->getName());
+    }
+
+    App::Document* getDocument() const
+    {
+        return _doc;
+    }
+
+    PartDesign::Body* getBody() const
+    {
+        return _body;
+    }
+
+    PartDesign::Pad* getFirstPad() const
+    {
+        return _pad1;
+    }
+
+    PartDesign::Pad* getSecondPad() const
+    {
+        return _pad2;
+    }
+
+private:
+    App::Document* _doc = nullptr;
+    PartDesign::Body* _body = nullptr;
+    PartDesign::Pad* _pad1 = nullptr;
+    PartDesign::Pad* _pad2 = nullptr;
+};
+
+TEST_F(LazyRecomputeTest, featureAfterTipIsDeferred)
+{
+    auto doc = getDocument();
+    auto body = getBody();
+    auto pad = getSecondPad();
+    ASSERT_DOUBLE_EQ(pad->Shape.getBoundingBox().MaxZ, 20.0);
+
+    body->LazyRecompute.setValue(true);
+    body->Tip.setValue(getFirstPad());
+    pad->Length.setValue(30.0);
+    doc->recompute();
+
+    EXPECT_DOUBLE_EQ(pad->Shape.getBoundingBox().MaxZ, 20.0);
+
+    body->Tip.setValue(pad);
+    doc->recompute();
+
+    EXPECT_DOUBLE_EQ(pad->Shape.getBoundingBox().MaxZ, 30.0);
+}
+
+TEST_F(LazyRecomputeTest, featureWithUnchangedInputsIsSkipped)
+{
+    auto doc = getDocument();
+    auto body = getBody();
+    auto pad = getSecondPad();
+
+    // the first recompute in lazy mode has no hashes of the inputs to compare with
+    body->LazyRecompute.setValue(true);
+    getFirstPad()->enforceRecompute();
+    doc->recompute();
+    TopoDS_Shape shape = pad->Shape.getShape().getShape();
+
+    getFirstPad()->enforceRecompute();
+    doc->recompute();
+
+    EXPECT_TRUE(pad->Shape.getShape().getShape().IsSame(shape));
+    EXPECT_DOUBLE_EQ(pad->Shape.getBoundingBox().MaxZ, 20.0);
+}
+
+TEST_F(LazyRecomputeTest, featureWithChangedInputsIsRecomputed)
+{
+    auto doc = getDocument();
+    auto body = getBody();
+    auto pad = getSecondPad();
+
+    body->LazyRecompute.setValue(true);
+    getFirstPad()->enforceRecompute();
+    doc->recompute();
+
+    // the second pad is fused with the first one that is now higher
+    getFirstPad()->Length.setValue(25.0);
+    doc->recompute();
+
+    EXPECT_DOUBLE_EQ(pad->Shape.getBoundingBox().MaxZ, 25.0);
+}
+
+TEST_F(LazyRecomputeTest, unsuppressedFeatureIsRecomputed)
+{
+    auto doc = getDocument();
+    auto body = getBody();
+    auto pad = getSecondPad();
+
+    body->LazyRecompute.setValue(true);
+    getFirstPad()->enforceRecompute();
+    doc->recompute();
+
+    // the suppressed pad has the shape of the first one
+    pad->Suppressed.setValue(true);
+    doc->recompute();
+    ASSERT_DOUBLE_EQ(pad->Shape.getBoundingBox().MaxZ, 10.0);
+
+    // the inputs are unchanged, but the shape must not stay the one of the first pad
+    pad->Suppressed.setValue(false);
+    doc->recompute();
+
+    EXPECT_DOUBLE_EQ(pad->Shape.getBoundingBox().MaxZ, 20.0);
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
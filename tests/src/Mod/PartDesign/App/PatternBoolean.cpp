@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include "src/App/InitApplication.h"
+
+#include <BRepGProp.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <GProp_GProps.hxx>
+#include <gp_Ax2.hxx>
+
+#include <App/StringHasher.h>
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/TopoShapeOpCode.h>
+#include <Mod/PartDesign/App/PatternBoolean.h>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+class PatternBooleanTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        _hasher = new App::StringHasher;
+    }
+
+    /// A plate of 100 x 100 x 5 followed by rows x rows cylinders standing on a grid
+    std::vector<Part::TopoShape> makePlateWithPins(int rows, double zmin, double height) const
+    {
+        long tag = 0;
+        std::vector<Part::TopoShape> shapes;
+        shapes.emplace_back(BRepPrimAPI_MakeBox(100.0, 100.0, 5.0).Shape(), ++tag, _hasher);
+        double step = 100.0 / rows;
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < rows; ++j) {
+                gp_Ax2 axis(gp_Pnt((i + 0.5) * step, (j + 0.5) * step, zmin), gp::DZ());
+                shapes.emplace_back(
+                    BRepPrimAPI_MakeCylinder(axis, 0.25 * step, height).Shape(),
+                    ++tag,
+                    _hasher
+                );
+            }
+        }
+        return shapes;
+    }
+
+    static double getVolume(const Part::TopoShape& shape)
+    {
+        GProp_GProps props;
+        BRepGProp::VolumeProperties(shape.getShape(), props);
+        return props.Mass();
+    }
+
+private:
+    App::StringHasherRef _hasher;
+};
+
+TEST_F(PatternBooleanTest, cutHoles)
+{
+    // Arrange
+    auto shapes = makePlateWithPins(8, -1.0, 7.0);
+    Part::TopoShape plain(shapes.front().Tag, shapes.front().Hasher);
+    plain.makeElementCut(shapes);
+
+    // Act
+    PartDesign::PatternBoolean boolean(Part::OpCodes::Cut, shapes);
+    ASSERT_TRUE(boolean.partition(8));
+    Part::TopoShape result = boolean.perform();
+
+    // Assert
+    EXPECT_GE(boolean.countSlabs(), 2U);
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), 1);
+    EXPECT_NEAR(getVolume(result), getVolume(plain), 1e-6 * getVolume(plain));
+    // the faces split at the seams are unified again
+    EXPECT_EQ(result.countSubShapes(TopAbs_FACE), plain.countSubShapes(TopAbs_FACE));
+    EXPECT_EQ(result.countSubShapes(TopAbs_EDGE), plain.countSubShapes(TopAbs_EDGE));
+    EXPECT_GT(result.getElementMapSize(), 0U);
+}
+
+TEST_F(PatternBooleanTest, fusePins)
+{
+    // Arrange
+    auto shapes = makePlateWithPins(8, 4.0, 3.0);
+    Part::TopoShape plain(shapes.front().Tag, shapes.front().Hasher);
+    plain.makeElementFuse(shapes);
+
+    // Act
+    PartDesign::PatternBoolean boolean(Part::OpCodes::Fuse, shapes);
+    ASSERT_TRUE(boolean.partition(8));
+    Part::TopoShape result = boolean.perform();
+
+    // Assert
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), 1);
+    EXPECT_NEAR(getVolume(result), getVolume(plain), 1e-6 * getVolume(plain));
+    EXPECT_EQ(result.countSubShapes(TopAbs_FACE), plain.countSubShapes(TopAbs_FACE));
+}
+
+TEST_F(PatternBooleanTest, overlappingInstancesAreNotPartitioned)
+{
+    // Arrange
+    auto shapes = makePlateWithPins(1, -1.0, 7.0);
+    for (int i = 0; i < 20; ++i) {
+        gp_Ax2 axis(gp_Pnt(40.0 + i, 50.0, -1.0), gp::DZ());
+        shapes.emplace_back(BRepPrimAPI_MakeCylinder(axis, 2.0, 7.0).Shape());
+    }
+
+    // Act
+    PartDesign::PatternBoolean boolean(Part::OpCodes::Cut, shapes);
+
+    // Assert
+    EXPECT_FALSE(boolean.partition(4));
+    EXPECT_EQ(boolean.countSlabs(), 0U);
+}
+
+TEST_F(PatternBooleanTest, tooFewInstances)
+{
+    // Arrange
+    auto shapes = makePlateWithPins(4, -1.0, 7.0);
+
+    // Act
+    PartDesign::PatternBoolean boolean(Part::OpCodes::Cut, shapes);
+
+    // Assert
+    EXPECT_FALSE(boolean.partition(16));
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
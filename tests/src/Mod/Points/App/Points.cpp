@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <fstream>
 #include <Base/FileInfo.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
@@ -140,6 +141,102 @@ TEST_F(PointsTest, TestASCII)
     EXPECT_EQ(reader.getHeight(), 1);
 }
 
+TEST_F(PointsTest, TestASCIIWithProperties)
+{
+    std::string name = getFileName() + ".asc";
+    {
+        std::ofstream str(name);
+        str << "# x y z r g b intensity\n"
+            << "0 0 0 255 0 0 0.5\n"
+            << "\n"
+            << "1.5e0 -2 3. 0 255 0 0.25\r\n"
+            << "invalid line\n"
+            << "\t4 5 6 0 0 255 1";
+    }
+
+    Points::AscReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasIntensities());
+    EXPECT_TRUE(reader.hasColors());
+    EXPECT_FALSE(reader.hasNormals());
+    ASSERT_EQ(reader.getWidth(), 3);
+    EXPECT_EQ(reader.getPoints().getPoint(1), Base::Vector3d(1.5, -2, 3));
+    EXPECT_FLOAT_EQ(reader.getIntensities()[1], 0.25F);
+    EXPECT_FLOAT_EQ(reader.getColors()[2].b, 1.0F);
+    EXPECT_FLOAT_EQ(reader.getColors()[2].r, 0.0F);
+}
+
+TEST_F(PointsTest, TestASCIIWithNormals)
+{
+    std::string name = getFileName() + ".asc";
+    {
+        std::ofstream str(name);
+        str << "0 0 0 0 0 1\n"
+            << "1 0 0 0.6 -0.8 0\n"
+            << "0 1 0 -1 0 0\n";
+    }
+
+    Points::AscReader reader;
+    reader.read(name);
+
+    EXPECT_FALSE(reader.hasColors());
+    ASSERT_TRUE(reader.hasNormals());
+    ASSERT_EQ(reader.getWidth(), 3);
+    EXPECT_FLOAT_EQ(reader.getNormals()[1].x, 0.6F);
+    EXPECT_FLOAT_EQ(reader.getNormals()[1].y, -0.8F);
+}
+
+TEST_F(PointsTest, TestASCIIWithHeader)
+{
+    std::string name = getFileName() + ".asc";
+    {
+        std::ofstream str(name);
+        str << "// X Y Z Intensity Nx Ny Nz\n"
+            << "0 0 0 0.5 0 0 1\n"
+            << "1 0 0 0.25 0 1 0\n";
+    }
+
+    Points::AscReader reader;
+    reader.read(name);
+
+    EXPECT_FALSE(reader.hasColors());
+    ASSERT_TRUE(reader.hasNormals());
+    ASSERT_TRUE(reader.hasIntensities());
+    ASSERT_EQ(reader.getWidth(), 2);
+    EXPECT_FLOAT_EQ(reader.getIntensities()[1], 0.25F);
+    EXPECT_FLOAT_EQ(reader.getNormals()[1].y, 1.0F);
+}
+
+TEST_F(PointsTest, TestAsciiPLY)
+{
+    std::string name = getFileName() + ".ply";
+    {
+        std::ofstream str(name);
+        str << "ply\n"
+            << "format ascii 1.0\n"
+            << "element vertex 3\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "property float intensity\n"
+            << "end_header\n"
+            << "0 0 0 0.1\n"
+            << "1 2 3\n"
+            << "-1 -2 -3 0.3 0.5\n";
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasIntensities());
+    ASSERT_EQ(reader.getWidth(), 3);
+    EXPECT_EQ(reader.getPoints().getPoint(2), Base::Vector3d(-1, -2, -3));
+    EXPECT_FLOAT_EQ(reader.getIntensities()[0], 0.1F);
+    EXPECT_FLOAT_EQ(reader.getIntensities()[1], 0.0F);
+    EXPECT_FLOAT_EQ(reader.getIntensities()[2], 0.3F);
+}
+
 TEST_F(PointsTest, TestPlainPLY)
 {
     std::string name = getFileName();
@@ -240,4 +337,59 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestTiledStore)
+{
+    std::shared_ptr<Points::TiledPointStore> store = Points::PointKernel::createTiledStore();
+    store->append(getKernel().getBasicPoints().data(), getKernel().size());
+    store->finish(Points::TiledPointStore::Order::Keep);
+
+    Points::PointKernel kernel;
+    kernel.setTiledStore(store);
+    EXPECT_TRUE(kernel.isTiled());
+    EXPECT_EQ(kernel.size(), 8);
+    EXPECT_EQ(kernel.countValid(), 8);
+    EXPECT_DOUBLE_EQ(kernel.getBoundBox().MaxX, 1.0);
+
+    // reading the points keeps the store
+    const Points::PointKernel& cref = kernel;
+    EXPECT_DOUBLE_EQ(cref.getPoint(7).x, getKernel().getPoint(7).x);
+    EXPECT_TRUE(kernel.isTiled());
+
+    // the iterators read the tiles and apply the placement
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3d(1, 2, 3));
+    kernel.setTransform(mat);
+    std::vector<Base::Vector3d> points(cref.begin(), cref.end());
+    ASSERT_EQ(points.size(), 8);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(points[i], getKernel().getPoint(int(i)) + Base::Vector3d(1, 2, 3));
+    }
+    EXPECT_DOUBLE_EQ(kernel.getBoundBox().MaxZ, 4.0);
+    kernel.setTransform(Base::Matrix4D());
+
+    Points::PointKernel copy(kernel);
+    EXPECT_TRUE(copy.isTiled());
+    EXPECT_EQ(copy.getBasicPoints(), getKernel().getBasicPoints());
+    EXPECT_FALSE(copy.isTiled());
+    EXPECT_TRUE(kernel.isTiled());
+}
+
+TEST_F(PointsTest, TestTiledPLY)
+{
+    std::string name = getFileName();
+    Points::PlyWriter writer(getKernel());
+    writer.setColors(getColors());
+    writer.write(name);
+
+    Points::PointKernel::size_type threshold = Points::PointKernel::getTiledThreshold();
+    Points::PointKernel::setTiledThreshold(1);
+    Points::PlyReader reader;
+    reader.read(name);
+    Points::PointKernel::setTiledThreshold(threshold);
+
+    EXPECT_TRUE(reader.getPoints().isTiled());
+    EXPECT_EQ(reader.getPoints().size(), 8);
+    EXPECT_EQ(reader.getColors().size(), 8);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
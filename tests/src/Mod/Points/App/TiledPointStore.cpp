@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <Base/FileInfo.h>
+#include <Mod/Points/App/TiledPointStore.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class TiledPointStoreTest: public ::testing::Test
+{
+protected:
+    static std::vector<Base::Vector3f> createPoints(std::size_t num)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-10.0F, 10.0F);
+        std::vector<Base::Vector3f> points;
+        points.reserve(num);
+        for (std::size_t i = 0; i < num; i++) {
+            points.emplace_back(dist(gen), dist(gen), dist(gen));
+        }
+        return points;
+    }
+
+    static std::string getCacheFile()
+    {
+        return Base::FileInfo::getTempFileName("TiledPointStoreTest");
+    }
+
+    static bool isLess(const Base::Vector3f& p, const Base::Vector3f& q)
+    {
+        return std::tie(p.x, p.y, p.z) < std::tie(q.x, q.y, q.z);
+    }
+};
+
+TEST_F(TiledPointStoreTest, TestEmpty)
+{
+    Points::TiledPointStore store(getCacheFile());
+    store.finish(Points::TiledPointStore::Order::Octree);
+    EXPECT_EQ(store.size(), 0);
+    EXPECT_EQ(store.countTiles(), 0);
+    EXPECT_TRUE(store.begin() == store.end());
+}
+
+TEST_F(TiledPointStoreTest, TestKeepOrder)
+{
+    std::vector<Base::Vector3f> points = createPoints(1050);
+    Points::TiledPointStore store(getCacheFile(), 100);
+    store.append(points.data(), points.size());
+    store.finish(Points::TiledPointStore::Order::Keep);
+
+    EXPECT_FALSE(store.isReordered());
+    EXPECT_EQ(store.size(), 1050);
+    EXPECT_EQ(store.countTiles(), 11);
+
+    std::size_t index = 0;
+    for (const auto& tile : store) {
+        EXPECT_EQ(tile.getInfo().first, index);
+        for (const auto& pnt : tile) {
+            EXPECT_EQ(pnt, points[index++]);
+            EXPECT_TRUE(tile.getInfo().box.IsInBox(pnt));
+        }
+    }
+    EXPECT_EQ(index, 1050);
+}
+
+TEST_F(TiledPointStoreTest, TestOctreeOrder)
+{
+    std::vector<Base::Vector3f> points = createPoints(100000);
+    Points::TiledPointStore store(getCacheFile(), 1000);
+    for (const auto& pnt : points) {
+        store.append(pnt);
+    }
+    store.finish(Points::TiledPointStore::Order::Octree);
+
+    EXPECT_TRUE(store.isReordered());
+    EXPECT_EQ(store.size(), points.size());
+    EXPECT_GE(store.countTiles(), 100);
+
+    // the tiles are spatially coherent and hold all points
+    std::vector<Base::Vector3f> sorted;
+    float tileVolume = 0.0F;
+    for (const auto& tile : store) {
+        const Base::BoundBox3f& box = tile.getInfo().box;
+        EXPECT_LE(tile.size(), 1000);
+        EXPECT_EQ(tile.getInfo().first, sorted.size());
+        for (const auto& pnt : tile) {
+            EXPECT_TRUE(box.IsInBox(pnt));
+            sorted.push_back(pnt);
+        }
+        tileVolume += box.LengthX() * box.LengthY() * box.LengthZ();
+    }
+    EXPECT_LT(tileVolume, 2.0F * 20.0F * 20.0F * 20.0F);
+
+    std::vector<Base::Vector3f> original = points;
+    std::sort(original.begin(), original.end(), isLess);
+    std::vector<Base::Vector3f> stored = sorted;
+    std::sort(stored.begin(), stored.end(), isLess);
+    EXPECT_EQ(original, stored);
+
+    // per-point data follows the points
+    std::vector<std::size_t> indices(points.size());
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        indices[i] = i;
+    }
+    store.reorder(indices);
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        EXPECT_EQ(sorted[i], points[indices[i]]);
+    }
+}
+
+TEST_F(TiledPointStoreTest, TestRandomAccess)
+{
+    std::vector<Base::Vector3f> points = createPoints(5000);
+    Points::TiledPointStore store(getCacheFile(), 100);
+    store.append(points.data(), points.size());
+    store.finish(Points::TiledPointStore::Order::Octree);
+    store.setCacheSize(2);
+
+    std::vector<Base::Vector3f> sorted;
+    for (const auto& tile : store) {
+        sorted.insert(sorted.end(), tile.begin(), tile.end());
+    }
+    for (std::size_t i = 0; i < sorted.size(); i += 37) {
+        const auto& info = store.getTileInfo(store.findTile(i));
+        EXPECT_LE(info.first, i);
+        EXPECT_LT(i, info.first + info.count);
+        EXPECT_EQ(store.getPoint(i), sorted[i]);
+    }
+    EXPECT_EQ(store.getPoint(sorted.size() - 1), sorted.back());
+}
+
+TEST_F(TiledPointStoreTest, TestCacheSize)
+{
+    std::vector<Base::Vector3f> points = createPoints(500);
+    Points::TiledPointStore store(getCacheFile(), 100);
+    store.append(points.data(), points.size());
+    store.finish(Points::TiledPointStore::Order::Keep);
+    store.setCacheSize(1);
+
+    // views keep their mapping after the tile was dropped from the cache
+    std::vector<Points::TiledPointStore::TileView> views;
+    for (std::size_t i = 0; i < store.countTiles(); i++) {
+        views.push_back(store.getTile(i));
+    }
+    for (std::size_t i = 0; i < views.size(); i++) {
+        EXPECT_EQ(views[i][0], points[i * 100]);
+        EXPECT_EQ(views[i][99], points[i * 100 + 99]);
+    }
+}
+
+TEST_F(TiledPointStoreTest, TestCacheFile)
+{
+    std::string fileName;
+    {
+        Points::TiledPointStore store(getCacheFile(), 100);
+        std::vector<Base::Vector3f> points = createPoints(1000);
+        store.append(points.data(), points.size());
+        store.finish(Points::TiledPointStore::Order::Octree);
+        fileName = store.getCacheFile();
+        EXPECT_TRUE(Base::FileInfo(fileName).exists());
+    }
+    EXPECT_FALSE(Base::FileInfo(fileName).exists());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Micro-benchmark of the evaluation of the residuals and the Jacobian of the solver on synthetic
+// sketches, with and without the batched evaluation of the constraints (see
+// GCS::ConstraintBatch). This isn't a test and isn't run by ctest.
+//
+// Usage: Sketcher_planegcs_benchmark [evaluations per size]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "Mod/Sketcher/App/planegcs/Constraints.h"
+#include "Mod/Sketcher/App/planegcs/SubSystem.h"
+
+namespace
+{
+
+/** A staircase of line segments with right angles and fixed lengths, with a point on each
+ * segment. It has about 5 constraints per segment.
+ */
+class Staircase
+{
+public:
+    explicit Staircase(int numConstraints)
+        : segments(std::max(2, (numConstraints - 3) / 5))
+        , values(4 * segments + 2)
+        , constants {0.0, 1.0, 1.0 / 3.0}
+        , points(segments + 1)
+        , extraPoints(segments)
+        , lines(segments)
+    {
+        for (int i = 0; i <= segments; ++i) {
+            values[2 * i] = (i + 1) / 2 + 0.05 * std::sin(i);
+            values[2 * i + 1] = i / 2 + 0.05 * std::cos(i);
+            points[i] = GCS::Point(&values[2 * i], &values[2 * i + 1]);
+        }
+        double* extra = &values[2 * (segments + 1)];
+        for (int i = 0; i < segments; ++i) {
+            extra[2 * i] = (values[2 * i] + values[2 * i + 2]) / 2 + 0.1;
+            extra[2 * i + 1] = (values[2 * i + 1] + values[2 * i + 3]) / 2 - 0.1;
+            extraPoints[i] = GCS::Point(&extra[2 * i], &extra[2 * i + 1]);
+            lines[i].p1 = points[i];
+            lines[i].p2 = points[i + 1];
+        }
+        for (double& value : values) {
+            params.push_back(&value);
+        }
+
+        double* zero = &constants[0];
+        double* length = &constants[1];
+        double* offset = &constants[2];
+        add(new GCS::ConstraintEqual(points[0].x, zero));
+        add(new GCS::ConstraintEqual(points[0].y, zero));
+        add(new GCS::ConstraintDifference(points[0].y, points[1].y, zero));
+        for (int i = 0; i < segments; ++i) {
+            add(new GCS::ConstraintP2PDistance(points[i], points[i + 1], length));
+            if (i > 0) {
+                add(new GCS::ConstraintPerpendicular(lines[i - 1], lines[i]));
+            }
+            if (i > 1) {
+                add(new GCS::ConstraintParallel(lines[i - 2], lines[i]));
+            }
+            add(new GCS::ConstraintPointOnLine(extraPoints[i], lines[i]));
+            add(new GCS::ConstraintP2PDistance(points[i], extraPoints[i], offset));
+        }
+    }
+
+    std::vector<GCS::Constraint*>& getConstraints()
+    {
+        return clist;
+    }
+    GCS::VEC_pD& getParams()
+    {
+        return params;
+    }
+
+private:
+    void add(GCS::Constraint* constr)
+    {
+        constraints.emplace_back(constr);
+        clist.push_back(constr);
+    }
+
+private:
+    int segments;
+    std::vector<double> values;
+    std::vector<double> constants;
+    std::vector<GCS::Point> points;
+    std::vector<GCS::Point> extraPoints;
+    std::vector<GCS::Line> lines;
+    GCS::VEC_pD params;
+    std::vector<std::unique_ptr<GCS::Constraint>> constraints;
+    std::vector<GCS::Constraint*> clist;
+};
+
+struct Evaluation
+{
+    double micros {0.};  // per evaluation of the residuals and the Jacobian
+    Eigen::VectorXd residual;
+    GCS::SparseJacobian jacobi;
+};
+
+Evaluation measure(Staircase& sketch, bool batched, int evaluations)
+{
+    GCS::MAP_pD_pD reductionmap;
+    GCS::SubSystem subsys(sketch.getConstraints(), sketch.getParams(), reductionmap, batched);
+    subsys.redirectParams();
+
+    Evaluation result;
+    result.residual.resize(subsys.cSize());
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < evaluations; ++i) {
+        subsys.calcResidual(result.residual);
+        subsys.calcJacobi(result.jacobi);
+    }
+    auto end = std::chrono::steady_clock::now();
+    subsys.revertParams();
+
+    result.micros = std::chrono::duration<double, std::micro>(end - begin).count() / evaluations;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int evaluationsPerSize = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10000000;
+
+    std::printf(
+        "%12s %14s %14s %8s %10s\n",
+        "constraints",
+        "virtual [us]",
+        "batched [us]",
+        "speedup",
+        "identical"
+    );
+    for (int numConstraints : {100, 300, 1000, 3000, 10000}) {
+        Staircase sketch(numConstraints);
+        int evaluations = std::max(1, evaluationsPerSize / numConstraints);
+        Evaluation unbatched = measure(sketch, false, evaluations);
+        Evaluation batched = measure(sketch, true, evaluations);
+        bool identical = unbatched.residual == batched.residual
+            && unbatched.jacobi.isApprox(batched.jacobi, 0.)
+            && (unbatched.jacobi - batched.jacobi).norm() == 0.;
+        std::printf(
+            "%12zu %14.2f %14.2f %8.2f %10s\n",
+            sketch.getConstraints().size(),
+            unbatched.micros,
+            batched.micros,
+            unbatched.micros / batched.micros,
+            identical ? "yes" : "no"
+        );
+    }
+    return 0;
+}
@@ -178,3 +178,55 @@ TEST_F(ConstraintsTest, tangentBSplineAndArc)  // NOLINT
         0.005
     );
 }
+
+TEST_F(ConstraintsTest, batchMatchesConstraints)  // NOLINT
+{
+    // Arrange
+    std::vector<double> values {0.1, 0.2, 3.1, 0.4, 2.7, 2.2, -0.3, 1.9, 1.4, 0.6, 3.0, 0.5};
+    GCS::Point p0(&values[0], &values[1]);
+    GCS::Point p1(&values[2], &values[3]);
+    GCS::Point p2(&values[4], &values[5]);
+    GCS::Point p3(&values[6], &values[7]);
+    GCS::Point p4(&values[8], &values[9]);
+    GCS::Line l0, l1, l2;
+    l0.p1 = p0;
+    l0.p2 = p1;
+    l1.p1 = p1;
+    l1.p2 = p2;
+    l2.p1 = p2;
+    l2.p2 = p3;
+    std::vector<std::unique_ptr<GCS::Constraint>> constraints;
+    constraints.emplace_back(new GCS::ConstraintEqual(p0.x, p1.y, 2.0));
+    constraints.emplace_back(new GCS::ConstraintDifference(p0.x, p1.x, &values[10]));
+    constraints.emplace_back(new GCS::ConstraintP2PDistance(p0, p2, &values[11]));
+    constraints.emplace_back(new GCS::ConstraintPointOnLine(p4, l1));
+    constraints.emplace_back(new GCS::ConstraintParallel(l0, l2));
+    constraints.emplace_back(new GCS::ConstraintPerpendicular(l0, l1));
+    // the point is one of the points of the line
+    constraints.emplace_back(new GCS::ConstraintPointOnLine(p1, l1));
+
+    for (const auto& constr : constraints) {
+        constr->rescale(0.7);
+        GCS::ConstraintBatch batch(constr->getTypeId());
+        ASSERT_TRUE(batch.add(constr.get()));
+        ASSERT_TRUE(batch.add(constr.get()));
+
+        // Act
+        batch.evaluate();
+
+        // Assert
+        GCS::VEC_pD params = constr->params();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            EXPECT_EQ(batch.error(i), constr->error());
+            for (double* param : params) {
+                double deriv = 0.;
+                for (int k = 0; k < batch.paramsNum(); ++k) {
+                    if (params[k] == param) {
+                        deriv += batch.derivative(i, k);
+                    }
+                }
+                EXPECT_EQ(batch.getScale(i) * deriv, constr->grad(param));
+            }
+        }
+    }
+}
@@ -2,6 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
 #include "Mod/Sketcher/App/planegcs/GCS.h"
 
 class SystemTest: public GCS::System
@@ -50,3 +55,357 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, solveSparse)  // NOLINT
+{
+    // Arrange: a chain of points with fixed distances, the first point is fixed
+    const int numPoints {50};
+    std::vector<double> values(2 * numPoints + 3);
+    std::vector<GCS::Point> points(numPoints);
+    GCS::VEC_pD params;
+    for (int i = 0; i < numPoints; ++i) {
+        values[2 * i] = i * 1.1;
+        values[2 * i + 1] = (i % 2) * 0.3;
+        points[i].x = &values[2 * i];
+        points[i].y = &values[2 * i + 1];
+        params.push_back(points[i].x);
+        params.push_back(points[i].y);
+    }
+    double* distance = &values[2 * numPoints];
+    double* originX = &values[2 * numPoints + 1];
+    double* originY = &values[2 * numPoints + 2];
+    *distance = 2.0;
+    System()->addConstraintCoordinateX(points[0], originX, 1);
+    System()->addConstraintCoordinateY(points[0], originY, 1);
+    for (int i = 1; i < numPoints; ++i) {
+        System()->addConstraintP2PDistance(points[i - 1], points[i], distance, i + 1);
+    }
+    // a redundant constraint makes the Jacobian rank deficient
+    System()->addConstraintP2PDistance(points[1], points[0], distance, numPoints + 1);
+    std::vector<double> start = values;
+
+    for (auto alg : {GCS::DogLeg, GCS::LevenbergMarquardt}) {
+        // Act
+        values = start;
+        System()->autoSparseThreshold = 100000;
+        System()->declareUnknowns(params);
+        System()->initSolution(alg);
+        int denseResult = System()->solve(true, alg);
+
+        values = start;
+        System()->autoSparseThreshold = 0;
+        System()->declareUnknowns(params);
+        System()->initSolution(alg);
+        int result = System()->solve(true, alg);
+        System()->applySolution();
+
+        // Assert
+        EXPECT_EQ(result, denseResult);
+        ASSERT_NE(result, GCS::Failed);
+        EXPECT_NEAR(*points[0].x, 0.0, 1e-8);
+        EXPECT_NEAR(*points[0].y, 0.0, 1e-8);
+        for (int i = 1; i < numPoints; ++i) {
+            double dx = *points[i].x - *points[i - 1].x;
+            double dy = *points[i].y - *points[i - 1].y;
+            EXPECT_NEAR(std::sqrt(dx * dx + dy * dy), 2.0, 1e-8);
+        }
+    }
+
+    // the least norm steps can't factor the singular normal equations and use the QR instead
+    for (auto step : {GCS::LeastNormFullPivLU, GCS::LeastNormLdlt}) {
+        // Act
+        values = start;
+        System()->dogLegGaussStep = step;
+        System()->declareUnknowns(params);
+        System()->initSolution(GCS::DogLeg);
+        int result = System()->solve(true, GCS::DogLeg);
+        System()->applySolution();
+
+        // Assert
+        ASSERT_NE(result, GCS::Failed);
+        for (int i = 1; i < numPoints; ++i) {
+            double dx = *points[i].x - *points[i - 1].x;
+            double dy = *points[i].y - *points[i - 1].y;
+            EXPECT_NEAR(std::sqrt(dx * dx + dy * dy), 2.0, 1e-8);
+        }
+    }
+}
+
+TEST_F(GCSTest, solveCopy)  // NOLINT
+{
+    // Arrange: two lines with a common point, fixed lengths and a right angle between them
+    std::vector<double> values {0.0, 0.0, 1.5, 0.2, 1.8, 1.7, 2.0, 1.5, 0.0, 0.0};
+    GCS::Point p0 {&values[0], &values[1]};
+    GCS::Point p1 {&values[2], &values[3]};
+    GCS::Point p2 {&values[4], &values[5]};
+    GCS::Line line1;
+    line1.p1 = p0;
+    line1.p2 = p1;
+    GCS::Line line2;
+    line2.p1 = p1;
+    line2.p2 = p2;
+    double* distance = &values[6];
+    double* angle = &values[7];
+    GCS::VEC_pD params;
+    for (int i = 0; i < 6; ++i) {
+        params.push_back(&values[i]);
+    }
+    System()->addConstraintCoordinateX(p0, &values[8], 1);
+    System()->addConstraintCoordinateY(p0, &values[9], 2);
+    System()->addConstraintP2PDistance(p0, p1, distance, 3);
+    System()->addConstraintP2PDistance(p1, p2, distance, 4);
+    System()->addConstraintAngleViaPoint(line1, line2, p1, angle, 5);
+    System()->declareUnknowns(params);
+    System()->initSolution();
+    const std::vector<double> start = values;
+
+    ASSERT_EQ(System()->solve(true, GCS::DogLeg), GCS::Success);
+    System()->applySolution();
+    const std::vector<double> solution = values;
+    System()->undoSolution();
+
+    // Act
+    std::unique_ptr<GCS::System> copy = System()->copyForSolving();
+    int result {GCS::Failed};
+    std::thread thread([&copy, &result]() {
+        copy->initSolution();
+        result = copy->solve(true, GCS::DogLeg);
+    });
+    thread.join();
+
+    // Assert
+    EXPECT_EQ(result, GCS::Success);
+    EXPECT_EQ(values, start);
+    System()->applySolution(*copy);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_NEAR(values[i], solution[i], 1e-10);
+    }
+
+    // a cancelled solver gives up
+    System()->undoSolution();
+    std::atomic<bool> cancel {true};
+    copy = System()->copyForSolving();
+    copy->setCancelFlag(&cancel);
+    copy->initSolution();
+    EXPECT_EQ(copy->solve(true, GCS::DogLeg), GCS::Failed);
+    EXPECT_EQ(copy->solve(true, GCS::LevenbergMarquardt), GCS::Failed);
+}
+
+TEST_F(GCSTest, solveComponents)  // NOLINT
+{
+    // Arrange: independent pairs of points with a fixed distance, the first point of each pair
+    // is fixed
+    const int numPairs {20};
+    std::vector<double> values(4 * numPairs + 1);
+    std::vector<double> anchors(2 * numPairs);
+    std::vector<GCS::Point> points(2 * numPairs);
+    GCS::VEC_pD params;
+    for (int i = 0; i < 2 * numPairs; ++i) {
+        values[2 * i] = i * 0.7;
+        values[2 * i + 1] = (i % 3) * 0.4;
+        points[i].x = &values[2 * i];
+        points[i].y = &values[2 * i + 1];
+        params.push_back(points[i].x);
+        params.push_back(points[i].y);
+    }
+    double* distance = &values[4 * numPairs];
+    *distance = 1.0;
+    for (int i = 0; i < numPairs; ++i) {
+        anchors[2 * i] = values[4 * i];
+        anchors[2 * i + 1] = values[4 * i + 1];
+        System()->addConstraintCoordinateX(points[2 * i], &anchors[2 * i], 3 * i + 1);
+        System()->addConstraintCoordinateY(points[2 * i], &anchors[2 * i + 1], 3 * i + 2);
+        System()->addConstraintP2PDistance(points[2 * i], points[2 * i + 1], distance, 3 * i + 3);
+    }
+    const std::vector<double> start = values;
+
+    // Act
+    System()->autoParallelThreshold = 100000;
+    System()->declareUnknowns(params);
+    System()->initSolution();
+    ASSERT_EQ(System()->solve(true, GCS::DogLeg), GCS::Success);
+    System()->applySolution();
+    const std::vector<double> sequential = values;
+
+    values = start;
+    System()->autoParallelThreshold = 0;
+    System()->initSolution();
+    int result = System()->solve(true, GCS::DogLeg);
+    System()->applySolution();
+    GCS::VEC_I componentResults;
+    System()->getComponentResults(componentResults);
+
+    // Assert
+    EXPECT_EQ(result, GCS::Success);
+    EXPECT_EQ(values, sequential);
+    EXPECT_EQ(componentResults.size(), numPairs);
+    EXPECT_EQ(std::ranges::count(componentResults, GCS::Success), numPairs);
+
+    // Act: move the second point of the first pair, the other pairs aren't solved
+    values = start;
+    double targetX {5.0};
+    double targetY {5.0};
+    GCS::Point target {&targetX, &targetY};
+    System()->addConstraintP2PCoincident(target, points[1], GCS::DefaultTemporaryConstraint);
+    System()->initSolution();
+    System()->restrictToComponentsWithTag(GCS::DefaultTemporaryConstraint);
+    result = System()->solve(true, GCS::DogLeg);
+    System()->applySolution();
+    System()->getComponentResults(componentResults);
+
+    // Assert
+    EXPECT_NE(result, GCS::Failed);
+    EXPECT_NEAR(std::hypot(*points[1].x - *points[0].x, *points[1].y - *points[0].y), 1.0, 1e-8);
+    EXPECT_EQ(std::ranges::count(componentResults, -1), numPairs - 1);
+    EXPECT_NEAR(*points[0].x, anchors[0], 1e-8);
+    EXPECT_NEAR(*points[0].y, anchors[1], 1e-8);
+    for (int i = 4; i < 4 * numPairs; ++i) {
+        EXPECT_EQ(values[i], start[i]);
+    }
+}
+
+TEST_F(GCSTest, diagnoseIncrementally)  // NOLINT
+{
+    // Arrange: a chain of points where only the first point is fixed
+    const int numPoints {6};
+    std::vector<double> values(2 * numPoints + 3);
+    std::vector<GCS::Point> points(numPoints);
+    GCS::VEC_pD params;
+    for (int i = 0; i < numPoints; ++i) {
+        values[2 * i] = i * 1.1;
+        values[2 * i + 1] = (i % 2) * 0.3;
+        points[i].x = &values[2 * i];
+        points[i].y = &values[2 * i + 1];
+        params.push_back(points[i].x);
+        params.push_back(points[i].y);
+    }
+    double* originX = &values[2 * numPoints];
+    double* originY = &values[2 * numPoints + 1];
+    double* distance = &values[2 * numPoints + 2];
+    *distance = 1.0;
+
+    // set up the system like the sketch does after a constraint was added
+    auto setUp = [&](int extraConstraints) {
+        System()->clear();
+        System()->addConstraintCoordinateX(points[0], originX, 1);
+        System()->addConstraintCoordinateY(points[0], originY, 2);
+        for (int i = 1; i < numPoints; ++i) {
+            System()->addConstraintP2PDistance(points[i - 1], points[i], distance, i + 2);
+        }
+        if (extraConstraints > 0) {
+            System()->addConstraintHorizontal(points[1], points[2], numPoints + 2);
+        }
+        if (extraConstraints > 1) {
+            System()->addConstraintP2PDistance(points[0], points[1], distance, numPoints + 3);
+        }
+        System()->declareUnknowns(params);
+        System()->initSolution();
+    };
+    auto dependentParams = [&]() {
+        GCS::VEC_pD dependent;
+        System()->getDependentParams(dependent);
+        std::ranges::sort(dependent);
+        dependent.erase(std::unique(dependent.begin(), dependent.end()), dependent.end());
+        return dependent;
+    };
+
+    // Act
+    setUp(0);
+    int dofsBefore = System()->dofsNumber();
+    setUp(1);
+    int incrementalDofs = System()->dofsNumber();
+    GCS::VEC_pD incrementalDependent = dependentParams();
+    std::vector<GCS::VEC_pD> groups;
+    System()->getDependentParamsGroups(groups);
+
+    System()->incrementalDiagnosis = false;
+    setUp(1);
+
+    // Assert
+    EXPECT_EQ(dofsBefore, numPoints - 1);
+    EXPECT_EQ(incrementalDofs, numPoints - 2);
+    EXPECT_EQ(incrementalDofs, System()->dofsNumber());
+    EXPECT_EQ(incrementalDependent, dependentParams());
+    EXPECT_EQ(groups.size(), incrementalDofs);
+
+    // Act: a redundant constraint needs the full diagnosis
+    System()->incrementalDiagnosis = true;
+    setUp(1);
+    setUp(2);
+
+    // Assert
+    EXPECT_TRUE(System()->hasRedundant());
+    EXPECT_EQ(System()->dofsNumber(), numPoints - 2);
+}
+
+TEST_F(GCSTest, solveBatched)  // NOLINT
+{
+    // Arrange: rectangles with a point on the bottom edge, each fixed at its first corner
+    const int numRects {10};
+    const int numParams {10};
+    const int numValues {16};
+    std::vector<double> values(numValues * numRects);
+    std::vector<GCS::Point> points(5 * numRects);
+    std::vector<GCS::Line> lines(4 * numRects);
+    GCS::VEC_pD params;
+    int tag = 0;
+    for (int r = 0; r < numRects; ++r) {
+        double* v = &values[numValues * r];
+        const double corners[5][2] = {{0, 0}, {3.1, 0.2}, {2.9, 2.1}, {-0.1, 1.8}, {1.2, 0.3}};
+        for (int i = 0; i < 5; ++i) {
+            v[2 * i] = corners[i][0] + r;
+            v[2 * i + 1] = corners[i][1];
+            points[5 * r + i].x = &v[2 * i];
+            points[5 * r + i].y = &v[2 * i + 1];
+        }
+        for (int i = 0; i < numParams; ++i) {
+            params.push_back(&v[i]);
+        }
+        for (int i = 0; i < 4; ++i) {
+            lines[4 * r + i].p1 = points[5 * r + i];
+            lines[4 * r + i].p2 = points[5 * r + (i + 1) % 4];
+        }
+        v[10] = r;      // anchor x
+        v[11] = 0;      // anchor y
+        v[12] = 3.0;    // width
+        v[13] = 2.0;    // height
+        v[14] = 2.9;    // x offset of the second corner
+        v[15] = 1.0;    // distance of the point on the bottom edge
+        GCS::Point* p = &points[5 * r];
+        GCS::Line* l = &lines[4 * r];
+        System()->addConstraintEqual(p[0].x, &v[10], ++tag);
+        System()->addConstraintEqual(p[0].y, &v[11], ++tag);
+        System()->addConstraintP2PDistance(p[0], p[1], &v[12], ++tag);
+        System()->addConstraintP2PDistance(p[1], p[2], &v[13], ++tag);
+        System()->addConstraintDifference(p[0].x, p[1].x, &v[14], ++tag);
+        System()->addConstraintPerpendicular(l[0], l[1], ++tag);
+        System()->addConstraintParallel(l[0], l[2], ++tag);
+        System()->addConstraintParallel(l[1], l[3], ++tag);
+        System()->addConstraintPointOnLine(p[4], l[0], ++tag);
+        System()->addConstraintP2PDistance(p[0], p[4], &v[15], ++tag);
+    }
+    const std::vector<double> start = values;
+
+    for (auto alg : {GCS::DogLeg, GCS::LevenbergMarquardt, GCS::BFGS}) {
+        // Act
+        values = start;
+        System()->batchedEvaluation = false;
+        System()->declareUnknowns(params);
+        System()->initSolution(alg);
+        int result = System()->solve(true, alg);
+        System()->applySolution();
+        const std::vector<double> unbatched = values;
+
+        values = start;
+        System()->batchedEvaluation = true;
+        System()->declareUnknowns(params);
+        System()->initSolution(alg);
+
+        // Assert
+        EXPECT_EQ(result, GCS::Success);
+        EXPECT_EQ(System()->solve(true, alg), result);
+        System()->applySolution();
+        EXPECT_EQ(values, unbatched);
+        EXPECT_NEAR(*points[1].x - *points[0].x, 2.9, 1e-8);
+    }
+}